@@ -36,6 +36,9 @@
 #include "detail/scal.h"
 #include "detail/swap.h"
 
+// fused BLAS 1
+#include "detail/fused.h"
+
 // BLAS 2
 #include "detail/gemv.h"
 #include "detail/ger.h"
@@ -52,4 +55,21 @@
 #include "detail/trmm.h"
 #include "detail/trsm.h"
 
+// LAPACK
+#include "detail/potrf.h"
+#include "detail/getrf.h"
+#include "detail/geqrf.h"
+
+// multiple accelerators
+#include "detail/shard.h"
+
+// operands larger than accelerator memory
+#include "detail/out_of_core.h"
+
+// asynchronous interface
+#include "detail/async.h"
+
+// kernel timeline
+#include "detail/timeline.h"
+
 #endif //AMPBLAS_H
@@ -0,0 +1,37 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * ampblas_matrix.h
+ *
+ * Expression template matrix and vector classes layered over the C++ AMP
+ * BLAS templates. Expressions such as
+ *
+ *   y = alpha * A * x + beta * y;
+ *   z = x + 2 * y - w;
+ *   C = A * trans(B) + bias;
+ *
+ * are captured lazily and evaluated with the fewest kernels possible when
+ * they are assigned.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_MATRIX_H
+#define AMPBLAS_MATRIX_H
+
+#include "ampblas.h"
+#include "detail/expression.h"
+
+#endif // AMPBLAS_MATRIX_H
@@ -30,5 +30,6 @@
 #include "utility/reduction.h"
 #include "utility/parameter_check.h"
 #include "utility/storage.h"
+#include "utility/workspace.h"
 
 #endif // AMPBLAS_UTILITY_H
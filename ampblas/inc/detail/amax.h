@@ -43,9 +43,9 @@ struct amax_helper
     }
 
     // finds the maximum in a container and returns its position
-    value_type global_reduce(const std::vector<value_type>& vec) const
+    value_type global_reduce(const value_type* first, const value_type* last) const
     {
-         return *std::max_element(vec.begin(), vec.end());
+         return *std::max_element(first, last);
     }
 
     value_type init_value;
@@ -44,9 +44,9 @@ struct asum_helper
     }
 
     // reduction of container vec
-    ret_type global_reduce(const std::vector<value_type>& vec) const
+    ret_type global_reduce(const value_type* first, const value_type* last) const
     {
-         return std::accumulate(vec.begin(), vec.end(), init_value);
+         return std::accumulate(first, last, init_value);
     }
 
     value_type init_value;
@@ -0,0 +1,231 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * async.h
+ *
+ * Asynchronous forms of the templated interface. Each routine enqueues its
+ * kernels and returns a concurrency::task that completes when the work is
+ * done; routines with a scalar result deliver it through the task, so no
+ * call blocks the caller. Tasks compose with then() and when_all() to
+ * pipeline host work with BLAS work.
+ *
+ * Accelerator routines complete with a marker on the accelerator_view, so
+ * results viewed through array_views over host memory still have to be
+ * synchronized. Routines in the host namespace run the host kernels on the
+ * Concurrency Runtime's task pool; their operands must stay alive until the
+ * returned task completes.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_ASYNC_H
+#define AMPBLAS_ASYNC_H
+
+#include <ppltasks.h>
+
+#include "ampblas_dev.h"
+#include "detail/host/kernels.h"
+#include "detail/host/blas3.h"
+
+namespace ampblas {
+namespace _detail {
+
+// completes once everything enqueued on av so far has finished
+inline concurrency::task<void> marker_task(const concurrency::accelerator_view& av)
+{
+    return av.create_marker().to_task();
+}
+
+} // namespace _detail
+
+namespace async {
+
+//-------------------------------------------------------------------------
+// BLAS 1
+//-------------------------------------------------------------------------
+
+template <typename alpha_type, typename x_type, typename y_type>
+concurrency::task<void> axpy(const concurrency::accelerator_view& av, const alpha_type& alpha, const x_type& x, y_type& y)
+{
+    ampblas::axpy(av, alpha, x, y);
+    return _detail::marker_task(av);
+}
+
+template <typename x_type, typename y_type>
+concurrency::task<void> copy(const concurrency::accelerator_view& av, const x_type& x, y_type& y)
+{
+    ampblas::copy(av, x, y);
+    return _detail::marker_task(av);
+}
+
+template <typename alpha_type, typename x_type>
+concurrency::task<void> scal(const concurrency::accelerator_view& av, alpha_type alpha, x_type& x)
+{
+    ampblas::scal(av, alpha, x);
+    return _detail::marker_task(av);
+}
+
+template <typename ret_type, typename trans_op, typename array_type>
+concurrency::task<ret_type> dot(const concurrency::accelerator_view& av, const array_type& x, const array_type& y)
+{
+    // tuning sizes
+    static const unsigned int tile_size = 128;
+    static const unsigned int max_tiles = 64;
+
+    auto func = _detail::dot_helper<ret_type, ret_type, std::pair<array_type,array_type>, _detail::sum<ret_type>, trans_op>(ret_type(), _detail::sum<ret_type>());
+
+    return _detail::reduce_async<tile_size, max_tiles, ret_type, ret_type>(av, x.extent[0], std::make_pair(x,y), func);
+}
+
+// if no transpose operation is specified, use the conjugate
+template <typename ret_type, typename array_type>
+concurrency::task<ret_type> dot(const concurrency::accelerator_view& av, const array_type& x, const array_type& y)
+{
+    return dot<ret_type, _detail::conjugate, array_type>(av, x, y);
+}
+
+template <typename x_type>
+concurrency::task<typename x_type::value_type> nrm2(const concurrency::accelerator_view& av, const x_type& x)
+{
+    typedef typename x_type::value_type T;
+
+    // tuning sizes
+    static const unsigned int tile_size = 128;
+    static const unsigned int max_tiles = 64;
+
+    auto func = _detail::nrm2_helper<T, T, x_type, _detail::sum<T>>(T(), _detail::sum<T>());
+
+    return _detail::reduce_async<tile_size, max_tiles, T, T>(av, x.extent[0], x, func);
+}
+
+template <typename x_type>
+concurrency::task<typename real_type<typename x_type::value_type>::type> asum(const concurrency::accelerator_view& av, const x_type& x)
+{
+    typedef typename real_type<typename x_type::value_type>::type real_type;
+
+    // tuning parameters
+    static const unsigned int tile_size = 128;
+    static const unsigned int max_tiles = 64;
+
+    auto func = _detail::asum_helper<real_type, real_type, x_type, _detail::sum<real_type>>(real_type(), _detail::sum<real_type>());
+
+    return _detail::reduce_async<tile_size, max_tiles, real_type, real_type>(av, x.extent[0], x, func);
+}
+
+template <typename ret_type, typename alpha_type, typename x_type, typename y_type, typename z_type>
+concurrency::task<ret_type> axpy_dot(const concurrency::accelerator_view& av, const alpha_type& alpha, const x_type& x, y_type& y, const z_type& z)
+{
+    typedef _detail::vector_triple<x_type, y_type, z_type> operand_type;
+
+    // tuning sizes
+    static const unsigned int tile_size = 128;
+    static const unsigned int max_tiles = 64;
+
+    const operand_type operands = { x, y, z };
+    auto func = _detail::axpy_dot_helper<ret_type, alpha_type, operand_type, _detail::conjugate>(alpha, ret_type());
+
+    return _detail::reduce_async<tile_size, max_tiles, ret_type, ret_type>(av, x.extent[0], operands, func);
+}
+
+//-------------------------------------------------------------------------
+// BLAS 2
+//-------------------------------------------------------------------------
+
+template <typename value_type, typename x_vector_type, typename y_vector_type>
+concurrency::task<void> gemv(const concurrency::accelerator_view& av, enum class transpose transa, value_type alpha, const concurrency::array_view<const value_type,2>& a, x_vector_type& x, value_type beta, y_vector_type& y)
+{
+    ampblas::gemv(av, transa, alpha, a, x, beta, y);
+    return _detail::marker_task(av);
+}
+
+//-------------------------------------------------------------------------
+// BLAS 3
+//-------------------------------------------------------------------------
+
+template <typename scalar_type, typename a_type, typename b_type, typename c_type>
+concurrency::task<void> gemm(const concurrency::accelerator_view& av, enum class transpose transa, enum class transpose transb, scalar_type alpha, const a_type& a, const b_type& b, scalar_type beta, const c_type& c)
+{
+    ampblas::gemm(av, transa, transb, alpha, a, b, beta, c);
+    return _detail::marker_task(av);
+}
+
+template <typename scalar_type, typename a_type, typename b_type>
+concurrency::task<void> trsm(const concurrency::accelerator_view& av, enum class side side, enum class uplo uplo, enum class transpose transa, enum class diag diag, scalar_type alpha, const a_type& a, const b_type& b)
+{
+    ampblas::trsm(av, side, uplo, transa, diag, alpha, a, b);
+    return _detail::marker_task(av);
+}
+
+//-------------------------------------------------------------------------
+// host backend
+//   contiguous, column major operands; see detail/host/kernels.h and blas3.h
+//-------------------------------------------------------------------------
+
+namespace host {
+
+// y += alpha * x
+template <typename T>
+concurrency::task<void> axpy(int n, T alpha, const T* x, T* y)
+{
+    return concurrency::create_task([=] { _detail::host_axpy(n, alpha, x, y); });
+}
+
+// x' * y
+template <typename T>
+concurrency::task<T> dot(int n, const T* x, const T* y)
+{
+    return concurrency::create_task([=] { return _detail::host_dot(n, x, y); });
+}
+
+// y += alpha * x; returns y' * z
+template <typename T>
+concurrency::task<T> axpy_dot(int n, T alpha, const T* x, T* y, const T* z)
+{
+    return concurrency::create_task([=] { return _detail::host_axpy_dot(n, alpha, x, y, z); });
+}
+
+// y += alpha * A * x
+template <typename T>
+concurrency::task<void> gemv(int m, int n, T alpha, const T* a, int lda, const T* x, T* y)
+{
+    return concurrency::create_task([=] { _detail::host_gemv(m, n, alpha, a, lda, x, y); });
+}
+
+// C += alpha * A * B
+template <typename T>
+concurrency::task<void> gemm(int m, int n, int k, T alpha, const T* a, int lda, const T* b, int ldb, T* c, int ldc)
+{
+    return concurrency::create_task([=] { _detail::host_parallel_gemm(m, n, k, alpha, a, lda, b, ldb, c, ldc); });
+}
+
+// C += alpha * A * A' on one triangle
+template <typename T>
+concurrency::task<void> syrk(enum class uplo uplo, int n, int k, T alpha, const T* a, int lda, T* c, int ldc)
+{
+    return concurrency::create_task([=] { _detail::host_parallel_syrk(uplo, n, k, alpha, a, lda, c, ldc); });
+}
+
+// B = alpha * A * B with A triangular
+template <typename T>
+concurrency::task<void> trmm(enum class uplo uplo, enum class diag diag, int m, int n, T alpha, const T* a, int lda, T* b, int ldb)
+{
+    return concurrency::create_task([=] { _detail::host_parallel_trmm(uplo, diag, m, n, alpha, a, lda, b, ldb); });
+}
+
+} // namespace host
+} // namespace async
+} // namespace ampblas
+
+#endif // AMPBLAS_ASYNC_H
@@ -37,9 +37,9 @@ struct dot_helper
     }
 
     // returns the summation of all values in a container
-    ret_type global_reduce(const std::vector<value_type>& vec) const
+    ret_type global_reduce(const value_type* first, const value_type* last) const
     {
-         return std::accumulate(vec.begin(), vec.end(), init_value);
+         return std::accumulate(first, last, init_value);
     }
 
     ret_type init_value;
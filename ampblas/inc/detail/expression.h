@@ -0,0 +1,719 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * expression.h
+ *
+ * Expression nodes behind ampblas::vector and ampblas::matrix. Arithmetic on
+ * the wrappers builds a tree of nodes instead of computing anything; the
+ * tree is lowered when it is assigned to a destination:
+ *
+ *  - elementwise chains (sums, differences and scalings) become a single
+ *    parallel_for_each that reads every operand once
+ *  - matrix-vector and matrix-matrix products become gemv and gemm, with an
+ *    addend of the form beta * destination folded into the BLAS call
+ *
+ * Aliasing is detected through wrapper identities: copies of a wrapper share
+ * its identity, so a product that reads its own destination is evaluated
+ * through a temporary.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_EXPRESSION_H
+#define AMPBLAS_EXPRESSION_H
+
+#include <atomic>
+#include <memory>
+
+#include "ampblas.h"
+
+namespace ampblas {
+
+template <typename T> class vector;
+template <typename T> class matrix;
+
+namespace _detail {
+
+//
+// identities
+//
+
+// wrapper identities used for alias detection; 0 is never handed out
+template <int unused = 0>
+struct expression_ids
+{
+    static unsigned int next() { return ++counter; }
+    static std::atomic<unsigned int> counter;
+};
+
+template <int unused>
+std::atomic<unsigned int> expression_ids<unused>::counter;
+
+inline unsigned int next_expression_id()
+{
+    return expression_ids<>::next();
+}
+
+//
+// elementwise operations
+//
+
+struct plus_op
+{
+    template <typename T>
+    static T op(const T& lhs, const T& rhs) restrict(cpu, amp) { return lhs + rhs; }
+};
+
+struct minus_op
+{
+    template <typename T>
+    static T op(const T& lhs, const T& rhs) restrict(cpu, amp) { return lhs - rhs; }
+};
+
+//
+// elementwise nodes
+//
+// Every node provides value_type, rank, get_extent(), an amp restricted
+// operator[] and two queries used while lowering:
+//   references(id)        the node reads the wrapper with this identity
+//   is_scaled(id, scale)  the node is exactly scale * (wrapper with this identity)
+//
+
+template <typename derived_type>
+struct elementwise_expression
+{
+    const derived_type& self() const { return static_cast<const derived_type&>(*this); }
+};
+
+template <typename T, int R>
+struct terminal_expression : elementwise_expression<terminal_expression<T,R>>
+{
+    typedef T value_type;
+    static const int rank = R;
+
+    terminal_expression(const concurrency::array_view<const T,R>& data, unsigned int id)
+        : data(data), id(id)
+    {
+    }
+
+    concurrency::extent<R> get_extent() const { return data.extent; }
+    bool references(unsigned int target) const { return id == target; }
+    bool is_scaled(unsigned int target, T& scale) const { scale = T(1); return id == target; }
+
+    T operator[](const concurrency::index<R>& idx) const restrict(cpu, amp) { return data[idx]; }
+
+    concurrency::array_view<const T,R> data;
+    unsigned int id;
+};
+
+template <typename expr_type>
+struct scaled_expression : elementwise_expression<scaled_expression<expr_type>>
+{
+    typedef typename expr_type::value_type value_type;
+    static const int rank = expr_type::rank;
+
+    scaled_expression(const value_type& alpha, const expr_type& expr)
+        : alpha(alpha), expr(expr)
+    {
+    }
+
+    concurrency::extent<rank> get_extent() const { return expr.get_extent(); }
+    bool references(unsigned int target) const { return expr.references(target); }
+
+    bool is_scaled(unsigned int target, value_type& scale) const
+    {
+        value_type inner;
+        if (!expr.is_scaled(target, inner))
+            return false;
+
+        scale = alpha * inner;
+        return true;
+    }
+
+    value_type operator[](const concurrency::index<rank>& idx) const restrict(cpu, amp) { return alpha * expr[idx]; }
+
+    value_type alpha;
+    expr_type expr;
+};
+
+template <typename lhs_type, typename rhs_type, typename op_type>
+struct binary_expression : elementwise_expression<binary_expression<lhs_type,rhs_type,op_type>>
+{
+    typedef typename lhs_type::value_type value_type;
+    static const int rank = lhs_type::rank;
+
+    binary_expression(const lhs_type& lhs, const rhs_type& rhs)
+        : lhs(lhs), rhs(rhs)
+    {
+        if (lhs.get_extent() != rhs.get_extent())
+            argument_error("expression operands must have the same extent");
+    }
+
+    concurrency::extent<rank> get_extent() const { return lhs.get_extent(); }
+    bool references(unsigned int target) const { return lhs.references(target) || rhs.references(target); }
+    bool is_scaled(unsigned int, value_type&) const { return false; }
+
+    value_type operator[](const concurrency::index<rank>& idx) const restrict(cpu, amp) { return op_type::op(lhs[idx], rhs[idx]); }
+
+    lhs_type lhs;
+    rhs_type rhs;
+};
+
+// wrappers enter the tree as terminals; nodes are used as they are
+template <typename expr_type> struct expression_type              { typedef expr_type               type; };
+template <typename T>         struct expression_type<vector<T>>   { typedef terminal_expression<T,1> type; };
+template <typename T>         struct expression_type<matrix<T>>   { typedef terminal_expression<T,2> type; };
+
+template <typename expr_type>
+inline const expr_type& as_expression(const expr_type& expr) { return expr; }
+
+template <typename T>
+inline terminal_expression<T,1> as_expression(const vector<T>& x) { return x.expression(); }
+
+template <typename T>
+inline terminal_expression<T,2> as_expression(const matrix<T>& a) { return a.expression(); }
+
+//
+// product nodes
+//
+
+// a scaled matrix as the operand of a product, together with the operation applied to it
+template <typename T>
+struct matrix_operand
+{
+    typedef T value_type;
+
+    matrix_operand(const concurrency::array_view<const T,2>& data, enum class transpose trans, unsigned int id, const T& alpha = T(1))
+        : data(data), trans(trans), id(id), alpha(alpha)
+    {
+    }
+
+    // a scaled matrix, as produced by alpha * A
+    matrix_operand(const scaled_expression<terminal_expression<T,2>>& a)
+        : data(a.expr.data), trans(transpose::no_trans), id(a.expr.id), alpha(a.alpha)
+    {
+    }
+
+    matrix_operand scaled(const T& scale) const { return matrix_operand(data, trans, id, scale * alpha); }
+
+    // storage is column major; extent[0] counts columns
+    int rows() const { return trans == transpose::no_trans ? data.extent[1] : data.extent[0]; }
+    int cols() const { return trans == transpose::no_trans ? data.extent[0] : data.extent[1]; }
+
+    concurrency::array_view<const T,2> data;
+    enum class transpose trans;
+    unsigned int id;
+    T alpha;
+};
+
+template <typename T>
+inline matrix_operand<T> operator*(const typename matrix_operand<T>::value_type& alpha, const matrix_operand<T>& a)
+{
+    return a.scaled(alpha);
+}
+
+template <typename derived_type>
+struct product_expression
+{
+    const derived_type& self() const { return static_cast<const derived_type&>(*this); }
+};
+
+// alpha * op(A) * x
+template <typename T>
+struct gemv_expression : product_expression<gemv_expression<T>>
+{
+    typedef T value_type;
+    static const int rank = 1;
+
+    gemv_expression(const matrix_operand<T>& a, const terminal_expression<T,1>& x)
+        : alpha(a.alpha), a(a), x(x)
+    {
+        if (a.cols() != x.get_extent()[0])
+            argument_error("matrix-vector product dimensions do not agree");
+    }
+
+    gemv_expression scaled(const T& scale) const { return gemv_expression(a.scaled(scale), x); }
+
+    concurrency::extent<1> get_extent() const { return concurrency::extent<1>(a.rows()); }
+    bool references(unsigned int target) const { return x.references(target); }
+
+    T alpha;
+    matrix_operand<T> a;
+    terminal_expression<T,1> x;
+};
+
+// alpha * op(A) * op(B)
+template <typename T>
+struct gemm_expression : product_expression<gemm_expression<T>>
+{
+    typedef T value_type;
+    static const int rank = 2;
+
+    gemm_expression(const matrix_operand<T>& a, const matrix_operand<T>& b)
+        : alpha(a.alpha * b.alpha), a(a), b(b)
+    {
+        if (a.cols() != b.rows())
+            argument_error("matrix-matrix product dimensions do not agree");
+    }
+
+    gemm_expression scaled(const T& scale) const { return gemm_expression(a.scaled(scale), b); }
+
+    // column major extent of the result
+    concurrency::extent<2> get_extent() const { return concurrency::extent<2>(b.cols(), a.rows()); }
+    bool references(unsigned int target) const { return a.id == target || b.id == target; }
+
+    T alpha;
+    matrix_operand<T> a;
+    matrix_operand<T> b;
+};
+
+// product + elementwise addend
+template <typename product_type, typename addend_type>
+struct product_sum_expression
+{
+    typedef typename product_type::value_type value_type;
+    static const int rank = product_type::rank;
+
+    product_sum_expression(const product_type& product, const addend_type& addend)
+        : product(product), addend(addend)
+    {
+        if (product.get_extent() != addend.get_extent())
+            argument_error("expression operands must have the same extent");
+    }
+
+    product_type product;
+    addend_type addend;
+};
+
+//
+// operators
+//
+// These live in _detail so argument dependent lookup finds them through the
+// node types as well as through the wrappers, which derive from the node bases.
+//
+
+template <typename lhs_type, typename rhs_type>
+inline binary_expression<typename expression_type<lhs_type>::type, typename expression_type<rhs_type>::type, plus_op>
+operator+(const elementwise_expression<lhs_type>& lhs, const elementwise_expression<rhs_type>& rhs)
+{
+    typedef binary_expression<typename expression_type<lhs_type>::type, typename expression_type<rhs_type>::type, plus_op> result_type;
+    return result_type(as_expression(lhs.self()), as_expression(rhs.self()));
+}
+
+template <typename lhs_type, typename rhs_type>
+inline binary_expression<typename expression_type<lhs_type>::type, typename expression_type<rhs_type>::type, minus_op>
+operator-(const elementwise_expression<lhs_type>& lhs, const elementwise_expression<rhs_type>& rhs)
+{
+    typedef binary_expression<typename expression_type<lhs_type>::type, typename expression_type<rhs_type>::type, minus_op> result_type;
+    return result_type(as_expression(lhs.self()), as_expression(rhs.self()));
+}
+
+template <typename expr_type>
+inline scaled_expression<typename expression_type<expr_type>::type>
+operator*(const typename expression_type<expr_type>::type::value_type& alpha, const elementwise_expression<expr_type>& expr)
+{
+    return scaled_expression<typename expression_type<expr_type>::type>(alpha, as_expression(expr.self()));
+}
+
+template <typename expr_type>
+inline scaled_expression<typename expression_type<expr_type>::type>
+operator*(const elementwise_expression<expr_type>& expr, const typename expression_type<expr_type>::type::value_type& alpha)
+{
+    return alpha * expr;
+}
+
+template <typename expr_type>
+inline scaled_expression<typename expression_type<expr_type>::type>
+operator-(const elementwise_expression<expr_type>& expr)
+{
+    typedef typename expression_type<expr_type>::type::value_type value_type;
+    return value_type(-1) * expr;
+}
+
+template <typename product_type>
+inline product_type operator*(const typename product_type::value_type& alpha, const product_expression<product_type>& product)
+{
+    return product.self().scaled(alpha);
+}
+
+template <typename product_type>
+inline product_type operator*(const product_expression<product_type>& product, const typename product_type::value_type& alpha)
+{
+    return product.self().scaled(alpha);
+}
+
+template <typename product_type>
+inline product_type operator-(const product_expression<product_type>& product)
+{
+    return product.self().scaled(typename product_type::value_type(-1));
+}
+
+template <typename product_type, typename expr_type>
+inline product_sum_expression<product_type, typename expression_type<expr_type>::type>
+operator+(const product_expression<product_type>& product, const elementwise_expression<expr_type>& addend)
+{
+    typedef product_sum_expression<product_type, typename expression_type<expr_type>::type> result_type;
+    return result_type(product.self(), as_expression(addend.self()));
+}
+
+template <typename expr_type, typename product_type>
+inline product_sum_expression<product_type, typename expression_type<expr_type>::type>
+operator+(const elementwise_expression<expr_type>& addend, const product_expression<product_type>& product)
+{
+    return product + addend;
+}
+
+template <typename product_type, typename expr_type>
+inline product_sum_expression<product_type, scaled_expression<typename expression_type<expr_type>::type>>
+operator-(const product_expression<product_type>& product, const elementwise_expression<expr_type>& addend)
+{
+    return product + (-addend);
+}
+
+template <typename expr_type, typename product_type>
+inline product_sum_expression<product_type, typename expression_type<expr_type>::type>
+operator-(const elementwise_expression<expr_type>& addend, const product_expression<product_type>& product)
+{
+    return (-product) + addend;
+}
+
+//
+// lowering
+//
+
+// dst = expr as a single kernel; elementwise nodes only read the index being written, so expr may reference dst
+template <typename T, int R, typename expr_type>
+void evaluate(const concurrency::accelerator_view& av, const concurrency::array_view<T,R>& dst, const expr_type& expr)
+{
+    if (dst.extent != expr.get_extent())
+        argument_error("expression extent does not match the destination");
+
+    concurrency::parallel_for_each(
+        av,
+        dst.extent,
+        [=] (concurrency::index<R> idx) restrict(amp)
+        {
+            dst[idx] = expr[idx];
+        }
+    );
+}
+
+// dst = product + beta * dst
+template <typename T>
+void evaluate_product(const concurrency::accelerator_view& av, const concurrency::array_view<T,1>& dst, const gemv_expression<T>& p, const T& beta)
+{
+    ampblas::gemv(av, p.a.trans, p.alpha, p.a.data, p.x.data, beta, dst);
+}
+
+template <typename T>
+void evaluate_product(const concurrency::accelerator_view& av, const concurrency::array_view<T,2>& dst, const gemm_expression<T>& p, const T& beta)
+{
+    ampblas::gemm(av, p.a.trans, p.b.trans, p.alpha, p.a.data, p.b.data, beta, dst);
+}
+
+// dst = product
+template <typename T, int R, typename product_type>
+void evaluate_product(const concurrency::accelerator_view& av, const concurrency::array_view<T,R>& dst, const product_type& p)
+{
+    if (dst.extent != p.get_extent())
+        argument_error("expression extent does not match the destination");
+
+    // a zero beta keeps the kernels from reading the destination
+    evaluate_product(av, dst, p, T());
+}
+
+// dst = product + addend, using as few kernels as the addend allows
+template <typename T, int R, typename product_type, typename addend_type>
+void evaluate_product(const concurrency::accelerator_view& av, const concurrency::array_view<T,R>& dst, unsigned int dst_id, const product_sum_expression<product_type,addend_type>& expr)
+{
+    if (dst.extent != expr.product.get_extent())
+        argument_error("expression extent does not match the destination");
+
+    // addend is beta * dst: a single BLAS call
+    T beta;
+    if (expr.addend.is_scaled(dst_id, beta))
+    {
+        evaluate_product(av, dst, expr.product, beta);
+        return;
+    }
+
+    // otherwise write the addend first and accumulate the product on top
+    evaluate(av, dst, expr.addend);
+    evaluate_product(av, dst, expr.product, T(1));
+}
+
+} // namespace _detail
+
+//-------------------------------------------------------------------------
+// vector
+//   A column vector over a 1D array_view. Copies share the viewed data;
+//   assignment evaluates the right hand side into the viewed data. A vector
+//   constructed from a size views an array it allocates on av.
+//-------------------------------------------------------------------------
+
+template <typename T>
+class vector : public _detail::elementwise_expression<vector<T>>
+{
+public:
+    typedef T value_type;
+    static const int rank = 1;
+
+    explicit vector(int n, const concurrency::accelerator_view& av = concurrency::accelerator().default_view)
+        : storage(std::make_shared<concurrency::array<T,1>>(n, av)), view(*storage), av(av), id(_detail::next_expression_id())
+    {
+    }
+
+    vector(const concurrency::array_view<T,1>& data, const concurrency::accelerator_view& av = concurrency::accelerator().default_view)
+        : view(data), av(av), id(_detail::next_expression_id())
+    {
+    }
+
+    vector(const vector& rhs)
+        : storage(rhs.storage), view(rhs.view), av(rhs.av), id(rhs.id)
+    {
+    }
+
+    vector& operator=(const vector& rhs)
+    {
+        _detail::evaluate(av, view, rhs.expression());
+        return *this;
+    }
+
+    template <typename expr_type>
+    vector& operator=(const _detail::elementwise_expression<expr_type>& expr)
+    {
+        _detail::evaluate(av, view, _detail::as_expression(expr.self()));
+        return *this;
+    }
+
+    vector& operator=(const _detail::gemv_expression<T>& expr)
+    {
+        if (expr.references(id))
+            return assign_through_temporary(expr);
+
+        _detail::evaluate_product(av, view, expr);
+        return *this;
+    }
+
+    template <typename addend_type>
+    vector& operator=(const _detail::product_sum_expression<_detail::gemv_expression<T>,addend_type>& expr)
+    {
+        if (expr.product.references(id))
+            return assign_through_temporary(expr);
+
+        _detail::evaluate_product(av, view, id, expr);
+        return *this;
+    }
+
+    template <typename expr_type>
+    vector& operator+=(const _detail::elementwise_expression<expr_type>& expr)
+    {
+        return *this = *this + expr;
+    }
+
+    vector& operator+=(const _detail::gemv_expression<T>& expr)
+    {
+        return *this = expr + *this;
+    }
+
+    int size() const { return view.extent[0]; }
+    const concurrency::array_view<T,1>& data() const { return view; }
+    const concurrency::accelerator_view& get_accelerator_view() const { return av; }
+
+    _detail::terminal_expression<T,1> expression() const { return _detail::terminal_expression<T,1>(view, id); }
+
+private:
+
+    template <typename expr_type>
+    vector& assign_through_temporary(const expr_type& expr)
+    {
+        vector temp(size(), av);
+        temp = expr;
+        return *this = temp;
+    }
+
+    std::shared_ptr<concurrency::array<T,1>> storage;
+    concurrency::array_view<T,1> view;
+    concurrency::accelerator_view av;
+    unsigned int id;
+};
+
+//-------------------------------------------------------------------------
+// matrix
+//   A column major matrix over a 2D array_view whose extent is (columns, rows),
+//   matching the templated interface. Copies share the viewed data;
+//   assignment evaluates the right hand side into the viewed data. A matrix
+//   constructed from a size views an array it allocates on av.
+//-------------------------------------------------------------------------
+
+template <typename T>
+class matrix : public _detail::elementwise_expression<matrix<T>>
+{
+public:
+    typedef T value_type;
+    static const int rank = 2;
+
+    matrix(int m, int n, const concurrency::accelerator_view& av = concurrency::accelerator().default_view)
+        : storage(std::make_shared<concurrency::array<T,2>>(concurrency::extent<2>(n, m), av)), view(*storage), av(av), id(_detail::next_expression_id())
+    {
+    }
+
+    matrix(const concurrency::array_view<T,2>& data, const concurrency::accelerator_view& av = concurrency::accelerator().default_view)
+        : view(data), av(av), id(_detail::next_expression_id())
+    {
+    }
+
+    matrix(const matrix& rhs)
+        : storage(rhs.storage), view(rhs.view), av(rhs.av), id(rhs.id)
+    {
+    }
+
+    matrix& operator=(const matrix& rhs)
+    {
+        _detail::evaluate(av, view, rhs.expression());
+        return *this;
+    }
+
+    template <typename expr_type>
+    matrix& operator=(const _detail::elementwise_expression<expr_type>& expr)
+    {
+        _detail::evaluate(av, view, _detail::as_expression(expr.self()));
+        return *this;
+    }
+
+    matrix& operator=(const _detail::gemm_expression<T>& expr)
+    {
+        if (expr.references(id))
+            return assign_through_temporary(expr);
+
+        _detail::evaluate_product(av, view, expr);
+        return *this;
+    }
+
+    template <typename addend_type>
+    matrix& operator=(const _detail::product_sum_expression<_detail::gemm_expression<T>,addend_type>& expr)
+    {
+        if (expr.product.references(id))
+            return assign_through_temporary(expr);
+
+        _detail::evaluate_product(av, view, id, expr);
+        return *this;
+    }
+
+    template <typename expr_type>
+    matrix& operator+=(const _detail::elementwise_expression<expr_type>& expr)
+    {
+        return *this = *this + expr;
+    }
+
+    matrix& operator+=(const _detail::gemm_expression<T>& expr)
+    {
+        return *this = expr + *this;
+    }
+
+    int rows() const { return view.extent[1]; }
+    int cols() const { return view.extent[0]; }
+    const concurrency::array_view<T,2>& data() const { return view; }
+    const concurrency::accelerator_view& get_accelerator_view() const { return av; }
+
+    _detail::terminal_expression<T,2> expression() const { return _detail::terminal_expression<T,2>(view, id); }
+    _detail::matrix_operand<T> operand(enum class transpose trans) const { return _detail::matrix_operand<T>(view, trans, id); }
+
+private:
+
+    template <typename expr_type>
+    matrix& assign_through_temporary(const expr_type& expr)
+    {
+        matrix temp(rows(), cols(), av);
+        temp = expr;
+        return *this = temp;
+    }
+
+    std::shared_ptr<concurrency::array<T,2>> storage;
+    concurrency::array_view<T,2> view;
+    concurrency::accelerator_view av;
+    unsigned int id;
+};
+
+//-------------------------------------------------------------------------
+// products
+//-------------------------------------------------------------------------
+
+// op(A) for use in products
+template <typename T>
+inline _detail::matrix_operand<T> trans(const matrix<T>& a) { return a.operand(transpose::trans); }
+
+template <typename T>
+inline _detail::matrix_operand<T> conj_trans(const matrix<T>& a) { return a.operand(transpose::conj_trans); }
+
+// alpha * op(A) * x
+template <typename T>
+inline _detail::gemv_expression<T> operator*(const _detail::matrix_operand<T>& a, const vector<T>& x)
+{
+    return _detail::gemv_expression<T>(a, x.expression());
+}
+
+template <typename T>
+inline _detail::gemv_expression<T> operator*(const matrix<T>& a, const vector<T>& x)
+{
+    return a.operand(transpose::no_trans) * x;
+}
+
+template <typename T>
+inline _detail::gemv_expression<T> operator*(const _detail::scaled_expression<_detail::terminal_expression<T,2>>& a, const vector<T>& x)
+{
+    return _detail::matrix_operand<T>(a) * x;
+}
+
+// alpha * op(A) * op(B)
+template <typename T>
+inline _detail::gemm_expression<T> operator*(const _detail::matrix_operand<T>& a, const _detail::matrix_operand<T>& b)
+{
+    return _detail::gemm_expression<T>(a, b);
+}
+
+template <typename T>
+inline _detail::gemm_expression<T> operator*(const _detail::matrix_operand<T>& a, const matrix<T>& b)
+{
+    return a * b.operand(transpose::no_trans);
+}
+
+template <typename T>
+inline _detail::gemm_expression<T> operator*(const matrix<T>& a, const _detail::matrix_operand<T>& b)
+{
+    return a.operand(transpose::no_trans) * b;
+}
+
+template <typename T>
+inline _detail::gemm_expression<T> operator*(const matrix<T>& a, const matrix<T>& b)
+{
+    return a.operand(transpose::no_trans) * b.operand(transpose::no_trans);
+}
+
+template <typename T>
+inline _detail::gemm_expression<T> operator*(const _detail::scaled_expression<_detail::terminal_expression<T,2>>& a, const matrix<T>& b)
+{
+    return _detail::matrix_operand<T>(a) * b.operand(transpose::no_trans);
+}
+
+template <typename T>
+inline _detail::gemm_expression<T> operator*(const _detail::scaled_expression<_detail::terminal_expression<T,2>>& a, const _detail::matrix_operand<T>& b)
+{
+    return _detail::matrix_operand<T>(a) * b;
+}
+
+} // namespace ampblas
+
+#endif // AMPBLAS_EXPRESSION_H
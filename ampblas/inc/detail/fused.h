@@ -0,0 +1,215 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * fused.h
+ *
+ * Fused Level 1 routines for Krylov iterations. Each routine performs the
+ * work of two or three consecutive BLAS 1 calls in a single pass, so the
+ * shared vectors are read from memory once per iteration instead of once
+ * per call.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include "ampblas_dev.h"
+
+namespace ampblas {
+namespace _detail {
+
+//
+// vector_triple
+//   Three vector operands passed to a reduction as a single container
+//
+template <typename x_type, typename y_type, typename z_type>
+struct vector_triple
+{
+    x_type x;
+    y_type y;
+    z_type z;
+};
+
+//
+// axpy_dot_helper
+//   Functor for the AXPY_DOT reduction
+//
+template<typename value_type, typename alpha_type, typename x_type, typename trans_op>
+struct axpy_dot_helper
+{
+    axpy_dot_helper(const alpha_type& alpha, const value_type& value) restrict(cpu, amp)
+        : alpha(alpha), init_value(value)
+    {
+    }
+
+    // updates y[idx] and accumulates its product with z[idx] while the new value is still in a register
+    void local_reduce(value_type& lhs, int idx, const x_type& X) const restrict(cpu, amp)
+    {
+        const concurrency::index<1> i(idx);
+
+        value_type y = X.y[i] + alpha * X.x[i];
+        X.y[i] = y;
+
+        lhs += trans_op::op(y) * value_type(X.z[i]);
+    }
+
+    // returns the summation of all values in a container
+    value_type global_reduce(const value_type* first, const value_type* last) const
+    {
+        return std::accumulate(first, last, init_value);
+    }
+
+    alpha_type alpha;
+    value_type init_value;
+    sum<value_type> op;
+};
+
+//
+// dot2_helper
+//   Functor for the DOT2 reduction
+//
+template<typename value_type, typename x_type, typename trans_op>
+struct dot2_helper
+{
+    dot2_helper(const value_pair<value_type>& value) restrict(cpu, amp)
+        : init_value(value)
+    {
+    }
+
+    // x[idx] is loaded once and shared by both products
+    void local_reduce(value_pair<value_type>& lhs, int idx, const x_type& X) const restrict(cpu, amp)
+    {
+        const concurrency::index<1> i(idx);
+
+        value_type x = trans_op::op(value_type(X.x[i]));
+
+        lhs.first += x * value_type(X.y[i]);
+        lhs.second += x * value_type(X.z[i]);
+    }
+
+    // returns the component-wise summation of all pairs in a container
+    value_pair<value_type> global_reduce(const value_pair<value_type>* first, const value_pair<value_type>* last) const
+    {
+        return std::accumulate(first, last, init_value, op);
+    }
+
+    value_pair<value_type> init_value;
+    pair_sum<value_type> op;
+};
+
+} // namespace _detail
+
+//-------------------------------------------------------------------------
+// AXPY_DOT
+//   computes y = alpha * x + y and returns dot(y, z) with the updated y.
+//-------------------------------------------------------------------------
+
+template <typename ret_type, typename trans_op, typename alpha_type, typename x_type, typename y_type, typename z_type>
+ret_type axpy_dot(const concurrency::accelerator_view& av, const alpha_type& alpha, const x_type& x, y_type& y, const z_type& z)
+{
+    typedef _detail::vector_triple<x_type, y_type, z_type> operand_type;
+
+    const int n = x.extent[0];
+
+    // tuning sizes
+    static const unsigned int tile_size = 128;
+    static const unsigned int max_tiles = 64;
+
+    const operand_type operands = { x, y, z };
+    auto func = _detail::axpy_dot_helper<ret_type, alpha_type, operand_type, trans_op>(alpha, ret_type());
+
+    // call generic 1D reduction
+    return _detail::reduce<tile_size, max_tiles, ret_type, ret_type>(av, n, operands, func);
+}
+
+// if no transpose operation is specified, use the conjugate
+template <typename ret_type, typename alpha_type, typename x_type, typename y_type, typename z_type>
+ret_type axpy_dot(const concurrency::accelerator_view& av, const alpha_type& alpha, const x_type& x, y_type& y, const z_type& z)
+{
+    return axpy_dot<ret_type, _detail::conjugate>(av, alpha, x, y, z);
+}
+
+//-------------------------------------------------------------------------
+// DOT2
+//   computes dot(x, y) and dot(x, z) in a single pass over x.
+//-------------------------------------------------------------------------
+
+template <typename ret_type, typename trans_op, typename array_type>
+_detail::value_pair<ret_type> dot2(const concurrency::accelerator_view& av, const array_type& x, const array_type& y, const array_type& z)
+{
+    typedef _detail::vector_triple<array_type, array_type, array_type> operand_type;
+
+    const int n = x.extent[0];
+
+    // tuning sizes
+    static const unsigned int tile_size = 128;
+    static const unsigned int max_tiles = 64;
+
+    const operand_type operands = { x, y, z };
+    auto func = _detail::dot2_helper<ret_type, operand_type, trans_op>(_detail::make_value_pair(ret_type(), ret_type()));
+
+    // call generic 1D reduction
+    return _detail::reduce<tile_size, max_tiles, _detail::value_pair<ret_type>, _detail::value_pair<ret_type>>(av, n, operands, func);
+}
+
+// if no transpose operation is specified, use the conjugate
+template <typename ret_type, typename array_type>
+_detail::value_pair<ret_type> dot2(const concurrency::accelerator_view& av, const array_type& x, const array_type& y, const array_type& z)
+{
+    return dot2<ret_type, _detail::conjugate, array_type>(av, x, y, z);
+}
+
+// computes dot(x, y) and dot(x, x)
+template <typename ret_type, typename array_type>
+_detail::value_pair<ret_type> dot2(const concurrency::accelerator_view& av, const array_type& x, const array_type& y)
+{
+    return dot2<ret_type, _detail::conjugate, array_type>(av, x, y, x);
+}
+
+//-------------------------------------------------------------------------
+// AXPBY
+//   computes y = alpha * x + beta * y in place of a SCAL followed by an AXPY.
+//-------------------------------------------------------------------------
+
+template <typename alpha_type, typename beta_type, typename x_type, typename y_type>
+void axpby(const concurrency::accelerator_view& av, const alpha_type& alpha, const x_type& x, const beta_type& beta, y_type& y)
+{
+    concurrency::parallel_for_each(
+        av,
+        x.extent,
+        [=] (concurrency::index<1> idx) restrict(amp)
+        {
+            y[idx] = alpha * x[idx] + beta * y[idx];
+        }
+    );
+}
+
+//-------------------------------------------------------------------------
+// WAXPBY
+//   computes w = alpha * x + beta * y without modifying x or y.
+//-------------------------------------------------------------------------
+
+template <typename alpha_type, typename beta_type, typename x_type, typename y_type, typename w_type>
+void waxpby(const concurrency::accelerator_view& av, const alpha_type& alpha, const x_type& x, const beta_type& beta, const y_type& y, w_type& w)
+{
+    concurrency::parallel_for_each(
+        av,
+        x.extent,
+        [=] (concurrency::index<1> idx) restrict(amp)
+        {
+            w[idx] = alpha * x[idx] + beta * y[idx];
+        }
+    );
+}
+
+} // namespace ampblas
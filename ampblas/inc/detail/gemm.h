@@ -25,10 +25,28 @@
 #include "ampblas_utility.h"
 
 #include "tuning/gemm.h"
+#include "task_graph.h"
+#include "timeline.h"
 
 namespace ampblas {
 namespace _detail {
 
+//
+// Launch Counts
+//
+
+// Called by gemm_stage_4 for every kernel it launches, with whether the kernel uses IO
+// guards; the guarded kernel is the slow path taken by sizes that are not multiples of the
+// work block. Nothing is called unless a hook is installed, as the C interface does to
+// count launches in its statistics.
+template <int unused = 0>
+struct gemm_launch_hook
+{
+    static void (*count)(bool guarded);
+};
+
+template <int unused> void (*gemm_launch_hook<unused>::count)(bool) = nullptr;
+
 //
 // Execution Pipeline
 //
@@ -46,9 +64,8 @@ void gemm(const concurrency::accelerator_view& av, enum class transpose transa,
 template <typename scalar_type, typename a_type, typename b_type, typename c_type>
 void gemm_stage_2(const concurrency::accelerator_view& av, enum class transpose transa, enum class transpose transb, scalar_type alpha, const a_type& a, const b_type& b, scalar_type beta, const c_type& c)
 {
-    // obtain architecture based off information in the accelerator_view
-    std::wstring desc = av.accelerator.get_description();
-    const enum class architecture arch = get_architecture(desc);
+    // obtain architecture based off information in the accelerator_view; cached per accelerator
+    const enum class architecture arch = get_architecture(av.accelerator);
     
     if (arch == architecture::amd)
     {
@@ -136,7 +153,18 @@ void gemm_stage_4(const concurrency::accelerator_view& av, scalar_type alpha, co
     const int n = c.extent[1];
     const int k = (transa != transpose::no_trans ? a.extent[0] : a.extent[1]); 
 
-    if (tp::m_block % m || tp::n_block % n || tp::k_block % k) 
+    const bool needs_guard = (tp::m_block % m || tp::n_block % n || tp::k_block % k) != 0;
+
+    // the grid is counted in tiles of m_c_tile x n_c_tile threads, each computing a work block
+    const timeline_scope scope("gemm", "gemm_stage_4", timeline_args()
+        .add("m", m).add("n", n).add("k", k).add("guarded", needs_guard)
+        .add("grid_m", (m + tp::m_block - 1) / tp::m_block).add("grid_n", (n + tp::n_block - 1) / tp::n_block)
+        .add("tile_m", tp::m_c_tile).add("tile_n", tp::n_c_tile).add("block_k", tp::k_block).add("padding", tp::use_padding));
+
+    if (gemm_launch_hook<>::count != nullptr)
+        gemm_launch_hook<>::count(needs_guard);
+
+    if (needs_guard) 
     {
         // one or more dimensions doesn't align with work block size, must use IO guards
         const bool guarded = true;
@@ -148,6 +176,8 @@ void gemm_stage_4(const concurrency::accelerator_view& av, scalar_type alpha, co
         const bool guarded = false;
         gemm_kernel<guarded, transa, transb, tp::m_block, tp::n_block, tp::k_block, tp::m_c_tile, tp::n_c_tile, tp::m_a_tile, tp::n_a_tile, tp::m_b_tile, tp::n_b_tile, tp::use_padding>(av, alpha, a, b, beta, c);
     }
+
+    scope.wait_for(av);
 }
 
 // Stage 5: Highly parameterized GEMM
@@ -288,8 +318,10 @@ void gemm_kernel(const concurrency::accelerator_view& av, scalar_type alpha, con
 			{
 				const int n_out = j + (n*n_c_tile+j_c_idx);
 
-                scalar_type c_temp = guarded_read<guarded>(c, concurrency::index<2>(m_out, n_out));
-				c_temp = alpha*c_reg[m][n] + beta*c_temp;
+                // c is not read when beta is zero, so its contents cannot reach the result
+                scalar_type c_temp = alpha*c_reg[m][n];
+                if (beta != scalar_type())
+                    c_temp += beta*guarded_read<guarded>(c, concurrency::index<2>(m_out, n_out));
                 guarded_write<guarded>(c, concurrency::index<2>(m_out, n_out), c_temp);
 			}
 		}
@@ -334,6 +366,32 @@ void gemm(const concurrency::accelerator_view& av, enum class transpose transa,
     gemm(av, transa, transb, alpha, a.section(a_extent), b.section(b_extent), beta, c.section(c_extent)); 
 }
 
+// Records the product as a task that reads A, B and C and writes C
+template <typename scalar_type, typename a_type, typename b_type, typename c_type>
+void gemm(task_graph& graph, enum class transpose transa, enum class transpose transb, scalar_type alpha, const tracked_view<a_type>& a, const tracked_view<b_type>& b, scalar_type beta, const tracked_view<c_type>& c)
+{
+    const a_type a_data = a.data();
+    const b_type b_data = b.data();
+    const c_type c_data = c.data();
+
+    graph.add(task_regions(a.region(), b.region(), c.region()), task_regions(c.region()), [=] (const concurrency::accelerator_view& queue) {
+        _detail::gemm(queue, transa, transb, alpha, a_data, b_data, beta, c_data);
+    });
+}
+
+// Sized form of the recorded product
+template <typename scalar_type, typename a_type, typename b_type, typename c_type>
+void gemm(task_graph& graph, enum class transpose transa, enum class transpose transb, int m, int n, int k, scalar_type alpha, const tracked_view<a_type>& a, const tracked_view<b_type>& b, scalar_type beta, const tracked_view<c_type>& c)
+{
+    const order S = order::col_major;
+
+    concurrency::extent<2> a_extent = (transa == transpose::no_trans ? _detail::extent<S>(m, k) : _detail::extent<S>(k, m));
+    concurrency::extent<2> b_extent = (transb == transpose::no_trans ? _detail::extent<S>(k, n) : _detail::extent<S>(n, k));
+    concurrency::extent<2> c_extent = _detail::extent<S>(m, n);
+
+    gemm(graph, transa, transb, alpha, a.section(a_extent), b.section(b_extent), beta, c.section(c_extent));
+}
+
 } // namespace ampblas
 
 #endif // AMPBLAS_GEMM_H
@@ -49,7 +49,13 @@ void gemv(const concurrency::accelerator_view& av, value_type alpha, const concu
                 result += a_value * x[x_idx];
             }
 
-            y[y_idx] = alpha * result + beta * y[y_idx];
+            // y is not read when beta is zero, so its contents cannot reach the result
+            if (beta != value_type())
+                result = alpha * result + beta * y[y_idx];
+            else
+                result = alpha * result;
+
+            y[y_idx] = result;
         }
     );
 }
@@ -0,0 +1,139 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * geqrf.h
+ *
+ * Blocked Householder QR factorization. Panels are factored on the host and
+ * their reflectors are applied to the trailing matrix as a block reflector
+ * with three GEMMs, starting with the next panel so that its transfer and
+ * factorization overlap the rest of the update.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_GEQRF_H
+#define AMPBLAS_GEQRF_H
+
+#include <memory>
+#include <vector>
+
+#include "ampblas_dev.h"
+
+#include "gemm.h"
+#include "panel.h"
+#include "host/lapack.h"
+
+namespace ampblas {
+
+// Factors an m x n matrix as Q * R in place. R is left on and above the diagonal, and the
+// Householder vectors of Q = H(0)...H(k-1) below it with their scales in tau (k = min(m,n)).
+template <typename value_type>
+void geqrf(const concurrency::accelerator_view& av, const concurrency::array_view<value_type,2>& a, std::vector<value_type>& tau)
+{
+    const order S = order::col_major;
+
+    const int m = _detail::rows<S>(a.extent);
+    const int n = _detail::columns<S>(a.extent);
+    const int mn = std::min(m, n);
+
+    tau.assign(mn, value_type(0));
+    if (mn == 0)
+        return;
+
+    const int nb = _detail::factor_block_size<value_type>::value;
+    const value_type zero = value_type(0);
+    const value_type one = value_type(1);
+    const value_type negone = value_type(-1);
+
+    std::unique_ptr<_detail::host_panel<value_type>> panel(new _detail::host_panel<value_type>(a.section(_detail::extent<S>(m, std::min(nb, mn)))));
+
+    for (int j = 0; j < mn; j += nb)
+    {
+        const int jb = std::min(nb, mn-j);
+        const int mr = m - j;
+        const int r = j + jb;
+
+        value_type* p = panel->data();
+        _detail::host_geqr2(mr, jb, p, panel->ld(), &tau[j]);
+        panel->store();
+
+        if (r >= n)
+            break;
+
+        // block reflector I - V * T * V'
+        std::vector<value_type> v(mr * jb), t(jb * jb, zero);
+        _detail::host_explicit_reflectors(mr, jb, p, panel->ld(), v.data(), mr);
+        _detail::host_larft(mr, jb, p, panel->ld(), &tau[j], t.data(), jb);
+
+        const concurrency::array<value_type,2> v_data(_detail::extent<S>(mr,jb), v.begin(), av);
+        const concurrency::array<value_type,2> t_data(_detail::extent<S>(jb,jb), t.begin(), av);
+
+        // workspace; zeroed so that the beta = 0 products never read garbage
+        const std::vector<value_type> zeros(jb * (n-r), zero);
+        concurrency::array<value_type,2> w1_data(_detail::extent<S>(jb,n-r), zeros.begin(), av);
+        concurrency::array<value_type,2> w2_data(_detail::extent<S>(jb,n-r), zeros.begin(), av);
+
+        const concurrency::array_view<const value_type,2> vv(v_data);
+        const concurrency::array_view<const value_type,2> tv(t_data);
+        const concurrency::array_view<value_type,2> w1(w1_data);
+        const concurrency::array_view<value_type,2> w2(w2_data);
+
+        // C -= V * (T' * (V' * C)) over columns [c0, c1)
+        auto update = [&] (int c0, int c1) {
+            if (c1 <= c0)
+                return;
+
+            const int w = c1 - c0;
+            const concurrency::array_view<value_type,2> c = a.section(_detail::index<S>(j,c0), _detail::extent<S>(mr,w));
+            const concurrency::array_view<value_type,2> w1c = w1.section(_detail::index<S>(0,c0-r));
+            const concurrency::array_view<value_type,2> w2c = w2.section(_detail::index<S>(0,c0-r));
+
+            gemm(av, transpose::trans, transpose::no_trans, jb, w, mr, one, vv, c, zero, w1c);
+            gemm(av, transpose::trans, transpose::no_trans, jb, w, jb, one, tv, w1c, zero, w2c);
+            gemm(av, transpose::no_trans, transpose::no_trans, mr, w, jb, negone, vv, w2c, one, c);
+        };
+
+        if (r < mn)
+        {
+            // lookahead
+            const int nb2 = std::min(nb, mn-r);
+            update(r, r+nb2);
+
+            panel.reset(new _detail::host_panel<value_type>(a.section(_detail::index<S>(r,r), _detail::extent<S>(m-r,nb2))));
+
+            update(r+nb2, n);
+        }
+        else
+        {
+            update(r, n);
+        }
+
+        // the runtime keeps the step's buffers alive until the work using them has finished
+    }
+}
+
+namespace host {
+
+// host QR factorization of an m x n column major matrix; tau holds min(m,n) entries
+template <typename T>
+void geqrf(int m, int n, T* a, int lda, T* tau)
+{
+    _detail::host_geqrf(m, n, a, lda, tau, _detail::factor_block_size<T>::value);
+}
+
+} // namespace host
+} // namespace ampblas
+
+#endif // AMPBLAS_GEQRF_H
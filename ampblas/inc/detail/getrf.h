@@ -0,0 +1,156 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * getrf.h
+ *
+ * Blocked right-looking LU factorization with partial pivoting. Panels are
+ * factored on the host; the accelerator applies the row interchanges and
+ * runs the TRSM and GEMM updates, starting with the next panel so that its
+ * transfer and factorization overlap the rest of the update.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_GETRF_H
+#define AMPBLAS_GETRF_H
+
+#include <memory>
+#include <vector>
+
+#include "ampblas_dev.h"
+
+#include "gemm.h"
+#include "trsm.h"
+#include "panel.h"
+#include "host/lapack.h"
+
+namespace ampblas {
+namespace _detail {
+
+// applies the row interchanges ipiv[k1, k2) to every column of a
+template <typename value_type>
+void laswp(const concurrency::accelerator_view& av, const concurrency::array_view<value_type,2>& a, const concurrency::array_view<const int,1>& ipiv, int k1, int k2)
+{
+    if (a.extent[0] == 0)
+        return;
+
+    concurrency::parallel_for_each(av, concurrency::extent<1>(a.extent[0]), [=] (concurrency::index<1> idx) restrict(amp)
+    {
+        const int col = idx[0];
+
+        for (int i = k1; i < k2; i++)
+        {
+            const int p = ipiv[i];
+            if (p != i)
+            {
+                const value_type tmp = a(col, i);
+                a(col, i) = a(col, p);
+                a(col, p) = tmp;
+            }
+        }
+    });
+}
+
+} // namespace _detail
+
+// Factors an m x n matrix as P * L * U in place. ipiv receives min(m,n) 0-based row indexes:
+// row i was interchanged with row ipiv[i]. Returns 0, or the 1-based column of the first
+// exactly zero pivot; the factorization is completed in that case.
+template <typename value_type>
+int getrf(const concurrency::accelerator_view& av, const concurrency::array_view<value_type,2>& a, std::vector<int>& ipiv)
+{
+    const order S = order::col_major;
+
+    const int m = _detail::rows<S>(a.extent);
+    const int n = _detail::columns<S>(a.extent);
+    const int mn = std::min(m, n);
+
+    ipiv.assign(mn, 0);
+    if (mn == 0)
+        return 0;
+
+    const int nb = _detail::factor_block_size<value_type>::value;
+    const value_type one = value_type(1);
+    const value_type negone = value_type(-1);
+
+    std::unique_ptr<_detail::host_panel<value_type>> panel(new _detail::host_panel<value_type>(a.section(_detail::extent<S>(m, std::min(nb, mn)))));
+
+    int info = 0;
+
+    for (int j = 0; j < mn; j += nb)
+    {
+        const int jb = std::min(nb, mn-j);
+        const int r = j + jb;
+
+        // host panel
+        const int panel_info = _detail::host_getf2(m-j, jb, panel->data(), panel->ld(), &ipiv[j]);
+        for (int i = j; i < r; i++)
+            ipiv[i] += j;
+        if (panel_info && !info)
+            info = j + panel_info;
+
+        panel->store();
+
+        const concurrency::array_view<const int,1> piv(mn, ipiv);
+
+        // U12 = inv(L11) * P * A12, A22 -= L21 * U12 over columns [c0, c1)
+        auto update = [&] (int c0, int c1) {
+            if (c1 <= c0)
+                return;
+
+            const concurrency::array_view<value_type,2> a12 = a.section(_detail::index<S>(j,c0), _detail::extent<S>(jb,c1-c0));
+
+            _detail::laswp(av, a.section(_detail::index<S>(0,c0), _detail::extent<S>(m,c1-c0)), piv, j, r);
+            trsm(av, side::left, uplo::lower, transpose::no_trans, diag::unit, one, a.section(_detail::index<S>(j,j), _detail::extent<S>(jb,jb)), a12);
+            if (m > r)
+                gemm(av, transpose::no_trans, transpose::no_trans, m-r, c1-c0, jb, negone, a.section(_detail::index<S>(r,j)), a12, one, a.section(_detail::index<S>(r,c0)));
+        };
+
+        if (r < mn)
+        {
+            // lookahead
+            const int nb2 = std::min(nb, mn-r);
+            update(r, r+nb2);
+
+            panel.reset(new _detail::host_panel<value_type>(a.section(_detail::index<S>(r,r), _detail::extent<S>(m-r,nb2))));
+
+            update(r+nb2, n);
+        }
+        else
+        {
+            update(r, n);
+        }
+
+        // interchanges to the left of the panel
+        if (j > 0)
+            _detail::laswp(av, a.section(_detail::extent<S>(m,j)), piv, j, r);
+    }
+
+    return info;
+}
+
+namespace host {
+
+// host LU factorization of an m x n column major matrix; ipiv holds min(m,n) entries
+template <typename T>
+int getrf(int m, int n, T* a, int lda, int* ipiv)
+{
+    return _detail::host_getrf(m, n, a, lda, ipiv, _detail::factor_block_size<T>::value);
+}
+
+} // namespace host
+} // namespace ampblas
+
+#endif // AMPBLAS_GETRF_H
@@ -0,0 +1,115 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * blas3.h
+ *
+ * Parallel host BLAS 3 drivers. The output is split into blocks of columns
+ * that run on the NUMA node holding them (see numa.h) and each block is
+ * computed with the dispatched kernels of kernels.h. While a timeline is
+ * recorded (see timeline.h) every block is a stage on the track of the 
+ * thread that ran it.
+ *
+ * All operands are contiguous and column major.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_HOST_BLAS3_H
+#define AMPBLAS_HOST_BLAS3_H
+
+#include "ampblas_defs.h"
+#include "detail/host/kernels.h"
+#include "detail/host/numa.h"
+#include "detail/timeline.h"
+
+AMPBLAS_NAMESPACE_BEGIN
+DETAIL_NAMESPACE_BEGIN
+
+// columns per output block
+static const int host_column_block = 64;
+
+inline timeline_args host_block_args(int rows, int c0, int c1, int depth)
+{
+    return timeline_args().add("rows", rows).add("first_column", c0).add("columns", c1-c0).add("k", depth).add("column_block", host_column_block);
+}
+
+// Offsets into the operands are computed in size_t; a column index times a leading dimension
+// overflows int for large matrices.
+
+// C += alpha * A * B
+template <typename T>
+void host_parallel_gemm(int m, int n, int k, T alpha, const T* a, int lda, const T* b, int ldb, T* c, int ldc)
+{
+    host_for_column_blocks(0, n, host_column_block, c, ldc, [=] (int c0, int c1) {
+        const timeline_scope scope("gemm", "host_parallel_gemm", host_block_args(m, c0, c1, k));
+        host_gemm(m, c1-c0, k, alpha, a, lda, b + static_cast<size_t>(c0)*ldb, ldb, c + static_cast<size_t>(c0)*ldc, ldc);
+    });
+}
+
+// C += alpha * A * A' on the uplo triangle of the n x n matrix C
+template <typename T>
+void host_parallel_syrk(enum class uplo uplo, int n, int k, T alpha, const T* a, int lda, T* c, int ldc)
+{
+    host_for_column_blocks(0, n, host_column_block, c, ldc, [=] (int c0, int c1) {
+        const timeline_scope scope("syrk", "host_parallel_syrk", host_block_args(n, c0, c1, k));
+        for (int j = c0; j < c1; j++)
+        {
+            // rows [j, n) of column j when lower, [0, j] when upper
+            const int r0 = (uplo == uplo::lower ? j : 0);
+            const int h = (uplo == uplo::lower ? n-j : j+1);
+
+            for (int l = 0; l < k; l++)
+                host_axpy(h, alpha * a[j + static_cast<size_t>(l)*lda], a + r0 + static_cast<size_t>(l)*lda, c + r0 + static_cast<size_t>(j)*ldc);
+        }
+    });
+}
+
+// B = alpha * A * B with A an m x m triangle
+template <typename T>
+void host_parallel_trmm(enum class uplo uplo, enum class diag diag, int m, int n, T alpha, const T* a, int lda, T* b, int ldb)
+{
+    host_for_column_blocks(0, n, host_column_block, b, ldb, [=] (int c0, int c1) {
+        const timeline_scope scope("trmm", "host_parallel_trmm", host_block_args(m, c0, c1, m));
+        for (int j = c0; j < c1; j++)
+        {
+            T* x = b + static_cast<size_t>(j)*ldb;
+
+            // each x[l] is consumed before the rows it feeds are overwritten
+            if (uplo == uplo::upper)
+            {
+                for (int l = 0; l < m; l++)
+                {
+                    const T t = alpha * x[l];
+                    host_axpy(l, t, a + static_cast<size_t>(l)*lda, x);
+                    x[l] = (diag == diag::unit ? t : t * a[l + static_cast<size_t>(l)*lda]);
+                }
+            }
+            else
+            {
+                for (int l = m-1; l >= 0; l--)
+                {
+                    const T t = alpha * x[l];
+                    x[l] = (diag == diag::unit ? t : t * a[l + static_cast<size_t>(l)*lda]);
+                    host_axpy(m-l-1, t, a + l+1 + static_cast<size_t>(l)*lda, x + l+1);
+                }
+            }
+        }
+    });
+}
+
+DETAIL_NAMESPACE_END
+AMPBLAS_NAMESPACE_END
+
+#endif // AMPBLAS_HOST_BLAS3_H
@@ -0,0 +1,300 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * kernels.h 
+ *
+ * Host BLAS kernels with runtime instruction set dispatch. Each kernel is
+ * instantiated for every host_isa level and a table of function pointers is
+ * selected once, at load time, from the CPUID features of the machine so a
+ * single binary runs the fastest variant each host supports.
+ *
+ * All operands are contiguous and column major.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_HOST_KERNELS_H
+#define AMPBLAS_HOST_KERNELS_H
+
+#include "ampblas_config.h"
+#include "detail/tuning/tune.h"
+#include "detail/host/simd.h"
+
+AMPBLAS_NAMESPACE_BEGIN
+DETAIL_NAMESPACE_BEGIN
+
+//
+// kernel implementations
+//
+
+template <typename T, enum class host_isa isa>
+struct host_kernels
+{
+    typedef simd<T,isa> V;
+    typedef typename V::vector_type vector_type;
+
+    // y += alpha * x
+    static void axpy(int n, T alpha, const T* x, T* y)
+    {
+        const vector_type va = V::broadcast(alpha);
+
+        int i = 0;
+        for (; i + V::width <= n; i += V::width)
+            V::store(y + i, V::fmadd(va, V::load(x + i), V::load(y + i)));
+
+        for (; i < n; i++)
+            y[i] += alpha * x[i];
+    }
+
+    // x' * y
+    static T dot(int n, const T* x, const T* y)
+    {
+        // two independent accumulators hide the latency of the multiply-add chain
+        vector_type acc0 = V::zero();
+        vector_type acc1 = V::zero();
+
+        int i = 0;
+        for (; i + 2*V::width <= n; i += 2*V::width)
+        {
+            acc0 = V::fmadd(V::load(x + i), V::load(y + i), acc0);
+            acc1 = V::fmadd(V::load(x + i + V::width), V::load(y + i + V::width), acc1);
+        }
+
+        for (; i + V::width <= n; i += V::width)
+            acc0 = V::fmadd(V::load(x + i), V::load(y + i), acc0);
+
+        T sum = V::reduce(V::add(acc0, acc1));
+
+        for (; i < n; i++)
+            sum += x[i] * y[i];
+
+        return sum;
+    }
+
+    // y = alpha * x + beta * y
+    static void axpby(int n, T alpha, const T* x, T beta, T* y)
+    {
+        const vector_type va = V::broadcast(alpha);
+        const vector_type vb = V::broadcast(beta);
+
+        int i = 0;
+        for (; i + V::width <= n; i += V::width)
+            V::store(y + i, V::fmadd(va, V::load(x + i), V::mul(vb, V::load(y + i))));
+
+        for (; i < n; i++)
+            y[i] = alpha * x[i] + beta * y[i];
+    }
+
+    // w = alpha * x + beta * y
+    static void waxpby(int n, T alpha, const T* x, T beta, const T* y, T* w)
+    {
+        const vector_type va = V::broadcast(alpha);
+        const vector_type vb = V::broadcast(beta);
+
+        int i = 0;
+        for (; i + V::width <= n; i += V::width)
+            V::store(w + i, V::fmadd(va, V::load(x + i), V::mul(vb, V::load(y + i))));
+
+        for (; i < n; i++)
+            w[i] = alpha * x[i] + beta * y[i];
+    }
+
+    // y += alpha * x; returns y' * z using the updated y before it leaves the registers
+    static T axpy_dot(int n, T alpha, const T* x, T* y, const T* z)
+    {
+        const vector_type va = V::broadcast(alpha);
+        vector_type acc = V::zero();
+
+        int i = 0;
+        for (; i + V::width <= n; i += V::width)
+        {
+            const vector_type vy = V::fmadd(va, V::load(x + i), V::load(y + i));
+            V::store(y + i, vy);
+            acc = V::fmadd(vy, V::load(z + i), acc);
+        }
+
+        T sum = V::reduce(acc);
+
+        for (; i < n; i++)
+        {
+            y[i] += alpha * x[i];
+            sum += y[i] * z[i];
+        }
+
+        return sum;
+    }
+
+    // x' * y and x' * z from a single pass over x
+    static void dot2(int n, const T* x, const T* y, const T* z, T* xy, T* xz)
+    {
+        vector_type acc0 = V::zero();
+        vector_type acc1 = V::zero();
+
+        int i = 0;
+        for (; i + V::width <= n; i += V::width)
+        {
+            const vector_type vx = V::load(x + i);
+            acc0 = V::fmadd(vx, V::load(y + i), acc0);
+            acc1 = V::fmadd(vx, V::load(z + i), acc1);
+        }
+
+        T sum0 = V::reduce(acc0);
+        T sum1 = V::reduce(acc1);
+
+        for (; i < n; i++)
+        {
+            sum0 += x[i] * y[i];
+            sum1 += x[i] * z[i];
+        }
+
+        *xy = sum0;
+        *xz = sum1;
+    }
+
+    // y += alpha * A * x
+    static void gemv(int m, int n, T alpha, const T* a, int lda, const T* x, T* y)
+    {
+        for (int j = 0; j < n; j++)
+            axpy(m, alpha * x[j], a + static_cast<size_t>(j)*lda, y);
+    }
+
+    // C += alpha * A * B
+    static void gemm(int m, int n, int k, T alpha, const T* a, int lda, const T* b, int ldb, T* c, int ldc)
+    {
+        for (int j = 0; j < n; j++)
+            for (int l = 0; l < k; l++)
+                axpy(m, alpha * b[l + static_cast<size_t>(j)*ldb], a + static_cast<size_t>(l)*lda, c + static_cast<size_t>(j)*ldc);
+    }
+};
+
+//
+// dispatch tables
+//
+
+template <typename T>
+struct host_kernel_table
+{
+    enum class host_isa isa;
+    void (*axpy)(int n, T alpha, const T* x, T* y);
+    T    (*dot)(int n, const T* x, const T* y);
+    void (*axpby)(int n, T alpha, const T* x, T beta, T* y);
+    void (*waxpby)(int n, T alpha, const T* x, T beta, const T* y, T* w);
+    T    (*axpy_dot)(int n, T alpha, const T* x, T* y, const T* z);
+    void (*dot2)(int n, const T* x, const T* y, const T* z, T* xy, T* xz);
+    void (*gemv)(int m, int n, T alpha, const T* a, int lda, const T* x, T* y);
+    void (*gemm)(int m, int n, int k, T alpha, const T* a, int lda, const T* b, int ldb, T* c, int ldc);
+};
+
+template <typename T, enum class host_isa isa>
+inline host_kernel_table<T> make_host_kernel_table()
+{
+    host_kernel_table<T> table;
+
+    table.isa      = isa;
+    table.axpy     = &host_kernels<T,isa>::axpy;
+    table.dot      = &host_kernels<T,isa>::dot;
+    table.axpby    = &host_kernels<T,isa>::axpby;
+    table.waxpby   = &host_kernels<T,isa>::waxpby;
+    table.axpy_dot = &host_kernels<T,isa>::axpy_dot;
+    table.dot2     = &host_kernels<T,isa>::dot2;
+    table.gemv     = &host_kernels<T,isa>::gemv;
+    table.gemm     = &host_kernels<T,isa>::gemm;
+
+    return table;
+}
+
+// the table for a specific level; callers are responsible for checking host support
+template <typename T>
+inline host_kernel_table<T> get_host_kernel_table(enum class host_isa isa)
+{
+    switch (isa)
+    {
+    case host_isa::avx512:
+        return make_host_kernel_table<T, host_isa::avx512>();
+    case host_isa::avx2:
+        return make_host_kernel_table<T, host_isa::avx2>();
+    case host_isa::sse42:
+        return make_host_kernel_table<T, host_isa::sse42>();
+    default:
+        return make_host_kernel_table<T, host_isa::generic>();
+    }
+}
+
+// the table for the running host, resolved during static initialization
+template <typename T>
+struct host_dispatch
+{
+    static const host_kernel_table<T> table;
+};
+
+template <typename T> 
+const host_kernel_table<T> host_dispatch<T>::table = get_host_kernel_table<T>(select_host_isa(detect_host_features()));
+
+//
+// entry points
+//
+
+template <typename T>
+inline void host_axpy(int n, T alpha, const T* x, T* y)
+{
+    host_dispatch<T>::table.axpy(n, alpha, x, y);
+}
+
+template <typename T>
+inline T host_dot(int n, const T* x, const T* y)
+{
+    return host_dispatch<T>::table.dot(n, x, y);
+}
+
+template <typename T>
+inline void host_axpby(int n, T alpha, const T* x, T beta, T* y)
+{
+    host_dispatch<T>::table.axpby(n, alpha, x, beta, y);
+}
+
+template <typename T>
+inline void host_waxpby(int n, T alpha, const T* x, T beta, const T* y, T* w)
+{
+    host_dispatch<T>::table.waxpby(n, alpha, x, beta, y, w);
+}
+
+template <typename T>
+inline T host_axpy_dot(int n, T alpha, const T* x, T* y, const T* z)
+{
+    return host_dispatch<T>::table.axpy_dot(n, alpha, x, y, z);
+}
+
+template <typename T>
+inline void host_dot2(int n, const T* x, const T* y, const T* z, T* xy, T* xz)
+{
+    host_dispatch<T>::table.dot2(n, x, y, z, xy, xz);
+}
+
+template <typename T>
+inline void host_gemv(int m, int n, T alpha, const T* a, int lda, const T* x, T* y)
+{
+    host_dispatch<T>::table.gemv(m, n, alpha, a, lda, x, y);
+}
+
+template <typename T>
+inline void host_gemm(int m, int n, int k, T alpha, const T* a, int lda, const T* b, int ldb, T* c, int ldc)
+{
+    host_dispatch<T>::table.gemm(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+}
+
+DETAIL_NAMESPACE_END
+AMPBLAS_NAMESPACE_END
+
+#endif // AMPBLAS_HOST_KERNELS_H
@@ -0,0 +1,446 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * lapack.h
+ *
+ * Host factorization kernels. The unblocked kernels factor the panels of the
+ * blocked accelerator routines; the blocked drivers run a whole
+ * factorization on the host, updating the next panel first so it can be
+ * factored alongside the rest of the trailing update.
+ *
+ * Trailing updates run each block of columns on the NUMA node that holds it.
+ *
+ * All operands are contiguous and column major. Pivots are 0-based.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_HOST_LAPACK_H
+#define AMPBLAS_HOST_LAPACK_H
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <ppl.h>
+
+#include "ampblas_defs.h"
+#include "detail/host/kernels.h"
+#include "detail/host/numa.h"
+
+AMPBLAS_NAMESPACE_BEGIN
+DETAIL_NAMESPACE_BEGIN
+
+//
+// helpers
+//
+
+// dst = src'
+template <typename T>
+inline void host_transpose(int m, int n, const T* src, int lds, T* dst, int ldd)
+{
+    for (int j = 0; j < n; j++)
+        for (int i = 0; i < m; i++)
+            dst[j + i*ldd] = src[i + j*lds];
+}
+
+//
+// unblocked panel kernels
+//
+
+// Cholesky of the leading nb x nb block of an n x n matrix along with the rest of its panel:
+// the nb columns below it when lower, the nb rows to its right when upper. Returns 0 or the
+// 1-based column that is not positive definite.
+template <typename T>
+int host_potf2(enum class uplo uplo, int n, int nb, T* a, int lda)
+{
+    for (int j = 0; j < nb; j++)
+    {
+        T* ajj = a + j + j*lda;
+
+        if (uplo == uplo::lower)
+        {
+            T d = *ajj;
+            for (int k = 0; k < j; k++)
+                d -= a[j + k*lda] * a[j + k*lda];
+
+            if (!(d > T(0)))
+                return j + 1;
+
+            d = std::sqrt(d);
+            *ajj = d;
+
+            for (int k = 0; k < j; k++)
+                host_axpy(n-j-1, -a[j + k*lda], a + j+1 + k*lda, ajj + 1);
+
+            for (int i = j+1; i < n; i++)
+                a[i + j*lda] /= d;
+        }
+        else
+        {
+            T d = *ajj - host_dot(j, a + j*lda, a + j*lda);
+
+            if (!(d > T(0)))
+                return j + 1;
+
+            d = std::sqrt(d);
+            *ajj = d;
+
+            for (int i = j+1; i < n; i++)
+                a[j + i*lda] = (a[j + i*lda] - host_dot(j, a + j*lda, a + i*lda)) / d;
+        }
+    }
+
+    return 0;
+}
+
+// LU with partial pivoting of an m x n panel; ipiv receives min(m,n) row indexes relative to
+// the panel. Returns 0 or the 1-based column of the first exactly zero pivot.
+template <typename T>
+int host_getf2(int m, int n, T* a, int lda, int* ipiv)
+{
+    int info = 0;
+
+    for (int j = 0; j < std::min(m, n); j++)
+    {
+        // pivot search
+        int p = j;
+        for (int i = j+1; i < m; i++)
+            if (std::abs(a[i + j*lda]) > std::abs(a[p + j*lda]))
+                p = i;
+
+        ipiv[j] = p;
+
+        if (a[p + j*lda] == T(0))
+        {
+            if (info == 0)
+                info = j + 1;
+            continue;
+        }
+
+        if (p != j)
+            for (int c = 0; c < n; c++)
+                std::swap(a[j + c*lda], a[p + c*lda]);
+
+        // multipliers
+        const T r = T(1) / a[j + j*lda];
+        for (int i = j+1; i < m; i++)
+            a[i + j*lda] *= r;
+
+        // rank 1 update of the rest of the panel
+        for (int c = j+1; c < n; c++)
+            host_axpy(m-j-1, -a[j + c*lda], a + j+1 + j*lda, a + j+1 + c*lda);
+    }
+
+    return info;
+}
+
+// Householder QR of an m x n panel; the reflectors are left below the diagonal with an
+// implicit unit leading entry and their scales in tau
+template <typename T>
+void host_geqr2(int m, int n, T* a, int lda, T* tau)
+{
+    for (int j = 0; j < std::min(m, n); j++)
+    {
+        T* x = a + j+1 + j*lda;
+        const int len = m-j-1;
+
+        const T alpha = a[j + j*lda];
+        const T xnorm = std::sqrt(host_dot(len, x, x));
+
+        if (xnorm == T(0))
+        {
+            tau[j] = T(0);
+            continue;
+        }
+
+        T beta = std::sqrt(alpha*alpha + xnorm*xnorm);
+        if (alpha > T(0))
+            beta = -beta;
+
+        tau[j] = (beta - alpha) / beta;
+
+        const T scale = T(1) / (alpha - beta);
+        for (int i = 0; i < len; i++)
+            x[i] *= scale;
+
+        a[j + j*lda] = beta;
+
+        // apply H = I - tau * v * v' to the rest of the panel
+        for (int c = j+1; c < n; c++)
+        {
+            T* ac = a + j + c*lda;
+            const T w = tau[j] * (ac[0] + host_dot(len, x, ac + 1));
+            ac[0] -= w;
+            host_axpy(len, -w, x, ac + 1);
+        }
+    }
+}
+
+// upper triangular T of the block reflector H(0)...H(k-1) = I - V * T * V' (t must be zeroed)
+template <typename T>
+void host_larft(int m, int k, const T* v, int ldv, const T* tau, T* t, int ldt)
+{
+    std::vector<T> w(k);
+
+    for (int i = 0; i < k; i++)
+    {
+        // w = V(:,0:i)' * v_i
+        for (int c = 0; c < i; c++)
+            w[c] = v[i + c*ldv] + host_dot(m-i-1, v + i+1 + c*ldv, v + i+1 + i*ldv);
+
+        // T(0:i,i) = -tau_i * T(0:i,0:i) * w
+        for (int r = 0; r < i; r++)
+        {
+            T sum = T(0);
+            for (int c = r; c < i; c++)
+                sum += t[r + c*ldt] * w[c];
+            t[r + i*ldt] = -tau[i] * sum;
+        }
+
+        t[i + i*ldt] = tau[i];
+    }
+}
+
+// the reflectors of a factored panel with their unit diagonal and zeros above it
+template <typename T>
+void host_explicit_reflectors(int m, int k, const T* a, int lda, T* v, int ldv)
+{
+    for (int c = 0; c < k; c++)
+        for (int i = 0; i < m; i++)
+            v[i + c*ldv] = (i < c ? T(0) : i == c ? T(1) : a[i + c*lda]);
+}
+
+// applies the row interchanges ipiv[k1, k2) to n columns
+template <typename T>
+void host_laswp(int n, T* a, int lda, int k1, int k2, const int* ipiv)
+{
+    for (int c = 0; c < n; c++)
+    {
+        T* ac = a + c*lda;
+        for (int i = k1; i < k2; i++)
+            if (ipiv[i] != i)
+                std::swap(ac[i], ac[ipiv[i]]);
+    }
+}
+
+// B = inv(L) * B for a unit lower triangular m x m L
+template <typename T>
+void host_trsm_llnu(int m, int n, const T* a, int lda, T* b, int ldb)
+{
+    for (int j = 0; j < n; j++)
+        for (int k = 0; k < m; k++)
+            host_axpy(m-k-1, -b[k + j*ldb], a + k+1 + k*lda, b + k+1 + j*ldb);
+}
+
+//
+// blocked drivers
+//
+
+template <typename T>
+int host_potrf(enum class uplo uplo, int n, T* a, int lda, int nb)
+{
+    if (n == 0)
+        return 0;
+
+    int info = host_potf2(uplo, n, std::min(nb, n), a, lda);
+
+    for (int j = 0; j < n && info == 0; j += nb)
+    {
+        const int jb = std::min(nb, n-j);
+        const int r = j + jb;
+        if (r >= n)
+            break;
+
+        const int n2 = n - r;
+        const int nb2 = std::min(nb, n2);
+
+        // the finished panel (L21 or U12) and the trailing matrix
+        const T* p = (uplo == uplo::lower ? a + r + j*lda : a + j + r*lda);
+        T* c = a + r + r*lda;
+
+        // transposed panel so every update is a plain product
+        std::vector<T> pt(n2 * jb);
+        if (uplo == uplo::lower)
+            host_transpose(n2, jb, p, lda, pt.data(), jb);
+        else
+            host_transpose(jb, n2, p, lda, pt.data(), n2);
+
+        // trailing update of columns [c0, c1) of the lower triangle
+        auto update_lower = [&] (int c0, int c1) {
+            for (int jj = c0; jj < c1; jj++)
+                for (int i = jj; i < c1; i++)
+                    c[i + jj*lda] -= host_dot(jb, pt.data() + i*jb, pt.data() + jj*jb);
+
+            host_gemm(n2-c1, c1-c0, jb, T(-1), p + c1, lda, pt.data() + c0*jb, jb, c + c1 + c0*lda, lda);
+        };
+
+        // trailing update of rows [r0, r1) in columns [c0, c1) of the upper triangle
+        auto update_upper = [&] (int c0, int c1, int r0, int r1) {
+            const int top = std::min(r1, c0);
+            if (top > r0)
+                host_gemm(top-r0, c1-c0, jb, T(-1), pt.data() + r0, n2, p + c0*lda, lda, c + r0 + c0*lda, lda);
+
+            for (int jj = c0; jj < c1; jj++)
+                for (int i = std::max(r0, c0); i < std::min(r1, jj+1); i++)
+                    c[i + jj*lda] -= host_dot(jb, p + i*lda, p + jj*lda);
+        };
+
+        // lookahead: the next panel (a column block when lower, a row block when upper) is
+        // updated first and factored during the rest of the update
+        int panel_info = 0;
+        if (uplo == uplo::lower)
+        {
+            update_lower(0, nb2);
+
+            concurrency::parallel_invoke(
+                [&] { panel_info = host_potf2(uplo, n2, nb2, c, lda); },
+                [&] { host_for_column_blocks(nb2, n2, nb, c, lda, update_lower); });
+        }
+        else
+        {
+            host_for_column_blocks(0, n2, nb, c, lda, [&] (int c0, int c1) { update_upper(c0, c1, 0, nb2); });
+
+            concurrency::parallel_invoke(
+                [&] { panel_info = host_potf2(uplo, n2, nb2, c, lda); },
+                [&] { host_for_column_blocks(nb2, n2, nb, c, lda, [&] (int c0, int c1) { update_upper(c0, c1, nb2, n2); }); });
+        }
+
+        if (panel_info)
+            info = r + panel_info;
+    }
+
+    return info;
+}
+
+template <typename T>
+int host_getrf(int m, int n, T* a, int lda, int* ipiv, int nb)
+{
+    const int mn = std::min(m, n);
+    if (mn == 0)
+        return 0;
+
+    // factors the panel starting at column j and records the first zero pivot
+    int info = 0;
+    auto factor = [&] (int j, int jb) -> int {
+        const int panel_info = host_getf2(m-j, jb, a + j + j*lda, lda, ipiv + j);
+        for (int i = j; i < j+jb; i++)
+            ipiv[i] += j;
+        return panel_info ? j + panel_info : 0;
+    };
+
+    info = factor(0, std::min(nb, mn));
+
+    for (int j = 0; j < mn; j += nb)
+    {
+        const int jb = std::min(nb, mn-j);
+        const int r = j + jb;
+
+        // interchanges to the left of the panel
+        host_laswp(j, a, lda, j, r, ipiv);
+
+        if (r >= n)
+            break;
+
+        // U12 = inv(L11) * A12, A22 -= L21 * U12 over columns [c0, c1)
+        auto update = [&] (int c0, int c1) {
+            const int w = c1 - c0;
+            host_laswp(w, a + c0*lda, lda, j, r, ipiv);
+            host_trsm_llnu(jb, w, a + j + j*lda, lda, a + j + c0*lda, lda);
+            host_gemm(m-r, w, jb, T(-1), a + r + j*lda, lda, a + j + c0*lda, lda, a + r + c0*lda, lda);
+        };
+
+        if (r >= mn)
+        {
+            host_for_column_blocks(r, n, nb, a, lda, update);
+            continue;
+        }
+
+        // lookahead
+        const int nb2 = std::min(nb, mn-r);
+        update(r, r+nb2);
+
+        int panel_info = 0;
+        concurrency::parallel_invoke(
+            [&] { panel_info = factor(r, nb2); },
+            [&] { host_for_column_blocks(r+nb2, n, nb, a, lda, update); });
+
+        if (info == 0)
+            info = panel_info;
+    }
+
+    return info;
+}
+
+template <typename T>
+void host_geqrf(int m, int n, T* a, int lda, T* tau, int nb)
+{
+    const int mn = std::min(m, n);
+    if (mn == 0)
+        return;
+
+    host_geqr2(m, std::min(nb, mn), a, lda, tau);
+
+    for (int j = 0; j < mn; j += nb)
+    {
+        const int jb = std::min(nb, mn-j);
+        const int r = j + jb;
+        if (r >= n)
+            break;
+
+        const int mr = m - j;
+
+        // block reflector I - V * T * V'
+        std::vector<T> v(mr * jb), vt(jb * mr), t(jb * jb, T(0));
+        host_explicit_reflectors(mr, jb, a + j + j*lda, lda, v.data(), mr);
+        host_transpose(mr, jb, v.data(), mr, vt.data(), jb);
+        host_larft(mr, jb, a + j + j*lda, lda, tau + j, t.data(), jb);
+
+        // C -= V * (T' * (V' * C)) over columns [c0, c1)
+        auto update = [&] (int c0, int c1) {
+            const int w = c1 - c0;
+            T* c = a + j + c0*lda;
+
+            std::vector<T> w1(jb * w, T(0)), w2(jb * w, T(0));
+            host_gemm(jb, w, mr, T(1), vt.data(), jb, c, lda, w1.data(), jb);
+
+            for (int col = 0; col < w; col++)
+                for (int i = 0; i < jb; i++)
+                    for (int k = 0; k <= i; k++)
+                        w2[i + col*jb] += t[k + i*jb] * w1[k + col*jb];
+
+            host_gemm(mr, w, jb, T(-1), v.data(), mr, w2.data(), jb, c, lda);
+        };
+
+        if (r >= mn)
+        {
+            host_for_column_blocks(r, n, nb, a, lda, update);
+            continue;
+        }
+
+        // lookahead
+        const int nb2 = std::min(nb, mn-r);
+        update(r, r+nb2);
+
+        concurrency::parallel_invoke(
+            [&] { host_geqr2(m-r, nb2, a + r + r*lda, lda, tau + r); },
+            [&] { host_for_column_blocks(r+nb2, n, nb, a, lda, update); });
+    }
+}
+
+DETAIL_NAMESPACE_END
+AMPBLAS_NAMESPACE_END
+
+#endif // AMPBLAS_HOST_LAPACK_H
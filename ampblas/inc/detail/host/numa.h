@@ -0,0 +1,301 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * numa.h
+ *
+ * NUMA placement for the host backend. Column blocks of an output are run
+ * as Concurrency Runtime tasks placed on the node that holds their pages;
+ * the resource manager binds each virtual processor to a hardware thread,
+ * so a placed task runs on a core of that node unless it is stolen by an
+ * idle one elsewhere. Buffers from host_numa_alloc are split across the
+ * nodes and touched there when they are allocated, so the owner of every
+ * column block of a matrix stored in one is known before it is first used.
+ *
+ * On machines with a single node everything reduces to parallel_for and
+ * VirtualAlloc.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_HOST_NUMA_H
+#define AMPBLAS_HOST_NUMA_H
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+
+#include <new>
+#include <vector>
+#include <algorithm>
+
+#include <ppl.h>
+
+#include "ampblas_config.h"
+
+#pragma comment(lib, "psapi.lib")
+
+AMPBLAS_NAMESPACE_BEGIN
+DETAIL_NAMESPACE_BEGIN
+
+//
+// topology
+//
+
+struct host_numa_topology
+{
+    // operating system numbers of the nodes that have processors
+    std::vector<unsigned short> nodes;
+};
+
+inline host_numa_topology detect_host_numa_topology()
+{
+    host_numa_topology topology;
+
+    ULONG highest = 0;
+    if (GetNumaHighestNodeNumber(&highest))
+    {
+        for (ULONG node = 0; node <= highest; node++)
+        {
+            ULONGLONG mask = 0;
+            if (GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask) && mask != 0)
+                topology.nodes.push_back(static_cast<unsigned short>(node));
+        }
+    }
+
+    if (topology.nodes.empty())
+        topology.nodes.push_back(0);
+
+    return topology;
+}
+
+// the topology of the running host, read during static initialization
+template <int unused = 0>
+struct host_numa_cache
+{
+    static const host_numa_topology topology;
+};
+
+template <int unused>
+const host_numa_topology host_numa_cache<unused>::topology = detect_host_numa_topology();
+
+inline const host_numa_topology& get_host_numa_topology()
+{
+    return host_numa_cache<>::topology;
+}
+
+inline int host_numa_node_count()
+{
+    return static_cast<int>(get_host_numa_topology().nodes.size());
+}
+
+//
+// ownership
+//
+
+// index into the topology of the node holding the page at p, or -1 when it is not resident
+inline int host_page_node(const void* p)
+{
+    PSAPI_WORKING_SET_EX_INFORMATION info;
+    info.VirtualAddress = const_cast<void*>(p);
+
+    if (!QueryWorkingSetEx(GetCurrentProcess(), &info, sizeof(info)) || !info.VirtualAttributes.Valid)
+        return -1;
+
+    const std::vector<unsigned short>& nodes = get_host_numa_topology().nodes;
+    const std::vector<unsigned short>::const_iterator it = std::find(nodes.begin(), nodes.end(), static_cast<unsigned short>(info.VirtualAttributes.Node));
+
+    return it == nodes.end() ? -1 : static_cast<int>(it - nodes.begin());
+}
+
+// node owning columns [c0, c1) of a column major matrix; blocks that are not resident yet are
+// split evenly across the nodes in column order, which is how blocked buffers are laid out
+template <typename T>
+inline int host_column_owner(const T* a, int lda, int c0, int c1, int begin, int end)
+{
+    const int node = host_page_node(a + static_cast<size_t>((c0 + c1) / 2) * lda);
+    if (node >= 0)
+        return node;
+
+    return static_cast<int>(static_cast<long long>(c0 - begin) * host_numa_node_count() / (end - begin));
+}
+
+//
+// execution
+//
+
+// runs body(c0, c1) over blocks of nb columns in [begin, end) of a, each on the node that owns it
+template <typename T, typename functor>
+inline void host_for_column_blocks(int begin, int end, int nb, const T* a, int lda, const functor& body)
+{
+    const int blocks = (end - begin + nb - 1) / nb;
+
+    if (host_numa_node_count() < 2)
+    {
+        concurrency::parallel_for(0, blocks, [&] (int b) {
+            const int c0 = begin + b*nb;
+            body(c0, std::min(c0 + nb, end));
+        });
+        return;
+    }
+
+    const std::vector<unsigned short>& nodes = get_host_numa_topology().nodes;
+
+    concurrency::task_group tasks;
+    for (int b = 0; b < blocks; b++)
+    {
+        const int c0 = begin + b*nb;
+        const int c1 = std::min(c0 + nb, end);
+
+        concurrency::location where = concurrency::location::from_numa_node(nodes[host_column_owner(a, lda, c0, c1, begin, end)]);
+        tasks.run([&body, c0, c1] { body(c0, c1); }, where);
+    }
+
+    tasks.wait();
+}
+
+//
+// allocation
+//
+
+enum class host_placement
+{
+    // pages land on the node of the thread that first touches them
+    local,
+
+    // pages are dealt round robin across the nodes, 64KB at a time
+    interleaved,
+
+    // one contiguous range per node, in node order; matches host_column_owner
+    blocked
+};
+
+// writes one byte per page of [p, p+bytes) from a task placed on node
+inline void host_touch_pages(char* p, size_t bytes, unsigned short node, concurrency::task_group& tasks)
+{
+    concurrency::location where = concurrency::location::from_numa_node(node);
+    tasks.run([p, bytes] {
+        for (size_t offset = 0; offset < bytes; offset += 4096)
+            p[offset] = 0;
+    }, where);
+}
+
+// zeroed, page aligned memory committed with the given placement; release with host_numa_free
+inline void* host_numa_alloc(size_t bytes, enum class host_placement placement)
+{
+    static const size_t chunk = 64 * 1024;
+
+    bytes = std::max<size_t>(bytes, 1);
+
+    char* p = static_cast<char*>(VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_READWRITE));
+    if (p == nullptr)
+        throw std::bad_alloc();
+
+    const std::vector<unsigned short>& nodes = get_host_numa_topology().nodes;
+    const size_t count = nodes.size();
+    const HANDLE process = GetCurrentProcess();
+
+    bool committed = true;
+    concurrency::task_group tasks;
+
+    if (placement == host_placement::local || count < 2)
+    {
+        committed = VirtualAlloc(p, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+    }
+    else if (placement == host_placement::interleaved)
+    {
+        for (size_t offset = 0, i = 0; committed && offset < bytes; offset += chunk, i++)
+        {
+            const size_t length = std::min(chunk, bytes - offset);
+            committed = VirtualAllocExNuma(process, p + offset, length, MEM_COMMIT, PAGE_READWRITE, nodes[i % count]) != nullptr;
+            if (committed)
+                host_touch_pages(p + offset, length, nodes[i % count], tasks);
+        }
+    }
+    else
+    {
+        // page aligned split
+        const size_t pages = (bytes + 4095) / 4096;
+
+        for (size_t i = 0; committed && i < count; i++)
+        {
+            const size_t first = std::min(bytes, pages * i / count * 4096);
+            const size_t last = std::min(bytes, pages * (i+1) / count * 4096);
+            if (last == first)
+                continue;
+
+            committed = VirtualAllocExNuma(process, p + first, last - first, MEM_COMMIT, PAGE_READWRITE, nodes[i]) != nullptr;
+            if (committed)
+                host_touch_pages(p + first, last - first, nodes[i], tasks);
+        }
+    }
+
+    tasks.wait();
+
+    if (!committed)
+    {
+        VirtualFree(p, 0, MEM_RELEASE);
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+inline void host_numa_free(void* p)
+{
+    if (p != nullptr)
+        VirtualFree(p, 0, MEM_RELEASE);
+}
+
+// owning wrapper over host_numa_alloc for element types that are valid when zeroed
+template <typename T>
+class host_numa_buffer
+{
+public:
+
+    host_numa_buffer(size_t count, enum class host_placement placement = host_placement::blocked)
+        : count(count), ptr(static_cast<T*>(host_numa_alloc(count * sizeof(T), placement)))
+    {}
+
+    ~host_numa_buffer()
+    {
+        host_numa_free(ptr);
+    }
+
+    T* data() const
+    {
+        return ptr;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+private:
+
+    // non-copyable
+    host_numa_buffer(const host_numa_buffer&);
+    host_numa_buffer& operator=(const host_numa_buffer&);
+
+    size_t count;
+    T* ptr;
+};
+
+DETAIL_NAMESPACE_END
+AMPBLAS_NAMESPACE_END
+
+#endif // AMPBLAS_HOST_NUMA_H
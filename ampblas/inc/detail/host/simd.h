@@ -0,0 +1,141 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * simd.h 
+ *
+ * Thin wrappers over the SSE and AVX intrinsics used to write host kernels
+ * once and instantiate them for each supported instruction set level.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_HOST_SIMD_H
+#define AMPBLAS_HOST_SIMD_H
+
+#include <immintrin.h>
+
+#include "ampblas_config.h"
+#include "detail/tuning/tune.h"
+
+AMPBLAS_NAMESPACE_BEGIN
+DETAIL_NAMESPACE_BEGIN
+
+template <typename T, enum class host_isa isa>
+struct simd;
+
+//
+// portable fallback
+//
+
+template <typename T>
+struct simd<T, host_isa::generic>
+{
+    typedef T vector_type;
+    static const int width = 1;
+
+    static vector_type load(const T* p) { return *p; }
+    static void store(T* p, vector_type v) { *p = v; }
+    static vector_type broadcast(T v) { return v; }
+    static vector_type zero() { return T(); }
+    static vector_type add(vector_type a, vector_type b) { return a + b; }
+    static vector_type mul(vector_type a, vector_type b) { return a * b; }
+    static vector_type fmadd(vector_type a, vector_type b, vector_type c) { return a * b + c; }
+    static T reduce(vector_type v) { return v; }
+};
+
+//
+// SSE
+//
+
+template <>
+struct simd<float, host_isa::sse42>
+{
+    typedef __m128 vector_type;
+    static const int width = 4;
+
+    static vector_type load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, vector_type v) { _mm_storeu_ps(p, v); }
+    static vector_type broadcast(float v) { return _mm_set1_ps(v); }
+    static vector_type zero() { return _mm_setzero_ps(); }
+    static vector_type add(vector_type a, vector_type b) { return _mm_add_ps(a, b); }
+    static vector_type mul(vector_type a, vector_type b) { return _mm_mul_ps(a, b); }
+    static vector_type fmadd(vector_type a, vector_type b, vector_type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static float reduce(vector_type v) { v = _mm_hadd_ps(v, v); v = _mm_hadd_ps(v, v); return _mm_cvtss_f32(v); }
+};
+
+template <>
+struct simd<double, host_isa::sse42>
+{
+    typedef __m128d vector_type;
+    static const int width = 2;
+
+    static vector_type load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, vector_type v) { _mm_storeu_pd(p, v); }
+    static vector_type broadcast(double v) { return _mm_set1_pd(v); }
+    static vector_type zero() { return _mm_setzero_pd(); }
+    static vector_type add(vector_type a, vector_type b) { return _mm_add_pd(a, b); }
+    static vector_type mul(vector_type a, vector_type b) { return _mm_mul_pd(a, b); }
+    static vector_type fmadd(vector_type a, vector_type b, vector_type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static double reduce(vector_type v) { return _mm_cvtsd_f64(_mm_hadd_pd(v, v)); }
+};
+
+//
+// AVX2 + FMA
+//
+
+template <>
+struct simd<float, host_isa::avx2>
+{
+    typedef __m256 vector_type;
+    static const int width = 8;
+
+    static vector_type load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, vector_type v) { _mm256_storeu_ps(p, v); }
+    static vector_type broadcast(float v) { return _mm256_set1_ps(v); }
+    static vector_type zero() { return _mm256_setzero_ps(); }
+    static vector_type add(vector_type a, vector_type b) { return _mm256_add_ps(a, b); }
+    static vector_type mul(vector_type a, vector_type b) { return _mm256_mul_ps(a, b); }
+    static vector_type fmadd(vector_type a, vector_type b, vector_type c) { return _mm256_fmadd_ps(a, b, c); }
+    static float reduce(vector_type v) { return simd<float, host_isa::sse42>::reduce(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1))); }
+};
+
+template <>
+struct simd<double, host_isa::avx2>
+{
+    typedef __m256d vector_type;
+    static const int width = 4;
+
+    static vector_type load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, vector_type v) { _mm256_storeu_pd(p, v); }
+    static vector_type broadcast(double v) { return _mm256_set1_pd(v); }
+    static vector_type zero() { return _mm256_setzero_pd(); }
+    static vector_type add(vector_type a, vector_type b) { return _mm256_add_pd(a, b); }
+    static vector_type mul(vector_type a, vector_type b) { return _mm256_mul_pd(a, b); }
+    static vector_type fmadd(vector_type a, vector_type b, vector_type c) { return _mm256_fmadd_pd(a, b, c); }
+    static double reduce(vector_type v) { return simd<double, host_isa::sse42>::reduce(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1))); }
+};
+
+//
+// AVX-512
+//
+
+// the VS11 compiler does not provide AVX-512 intrinsics; hosts that support them run the AVX2 kernels
+template <typename T>
+struct simd<T, host_isa::avx512> : simd<T, host_isa::avx2> {};
+
+DETAIL_NAMESPACE_END
+AMPBLAS_NAMESPACE_END
+
+#endif // AMPBLAS_HOST_SIMD_H
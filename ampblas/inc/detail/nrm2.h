@@ -43,9 +43,9 @@ struct nrm2_helper
     }
 
     // returns the square of the summation of all values in a container
-    ret_type global_reduce(const std::vector<value_type>& vec) const
+    ret_type global_reduce(const value_type* first, const value_type* last) const
     {
-         return std::sqrt(std::accumulate(vec.begin(), vec.end(), init_value));
+         return std::sqrt(std::accumulate(first, last, init_value));
     }
 
     value_type init_value;
@@ -0,0 +1,327 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * out_of_core.h
+ *
+ * GEMM on host operands too large to be viewed at once. C is produced one
+ * tile at a time; for each tile the matching panels of A and B are packed
+ * into a staging array and uploaded while the product of the previous panel
+ * is still running, so the accelerator only ever holds two panels of A and
+ * B and two tiles of C. The same amount again is used for staging on the
+ * host. Finished tiles are copied back in a continuation while the next
+ * tile is computed.
+ *
+ * The host form follows the same schedule with packed panels small enough
+ * to stay in cache, and the next panel packed while the current one runs.
+ *
+ * While a timeline is recorded (see timeline.h) the waits of both forms are
+ * stages, so a pipeline that stalls on its copies shows as long waits 
+ * between the kernels.
+ *
+ * The operands are plain host pointers: ordinary allocations, mapped files,
+ * or bound buffers that have been synchronized (see the ampcblas entry
+ * points, which do this themselves).
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_OUT_OF_CORE_H
+#define AMPBLAS_OUT_OF_CORE_H
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include <ppl.h>
+#include <ppltasks.h>
+
+#include "ampblas_dev.h"
+
+#include "gemm.h"
+#include "host/blas3.h"
+#include "host/lapack.h"
+
+namespace ampblas {
+namespace _detail {
+
+// panel sizes of an out-of-core product
+struct out_of_core_plan
+{
+    int mb;
+    int nb;
+    int kb;
+};
+
+// the largest square blocks for which two panels of A and B and two tiles of C fit in budget bytes
+template <typename T>
+inline out_of_core_plan make_out_of_core_plan(int m, int n, int k, size_t budget)
+{
+    static const int granularity = 64;
+
+    int b = static_cast<int>(std::sqrt(double(budget) / (6.0 * sizeof(T))));
+    b = std::max(granularity, b / granularity * granularity);
+
+    out_of_core_plan plan = { std::min(b, m), std::min(b, n), std::min(b, k) };
+    return plan;
+}
+
+// dst = src for a rows x cols block
+template <typename T>
+inline void pack_block(int rows, int cols, const T* src, int lds, T* dst, int ldd)
+{
+    concurrency::parallel_for(0, cols, [=] (int j) {
+        std::memcpy(dst + size_t(j)*ldd, src + size_t(j)*lds, rows * sizeof(T));
+    });
+}
+
+// dst = op(src) for a rows x cols result; real types only
+template <typename T>
+inline void pack_op_block(enum class transpose trans, int rows, int cols, const T* src, int lds, T* dst, int ldd)
+{
+    if (trans == transpose::no_trans)
+        pack_block(rows, cols, src, lds, dst, ldd);
+    else
+        host_transpose(cols, rows, src, lds, dst, ldd);
+}
+
+// C = beta * C for a rows x cols block
+template <typename T>
+inline void scale_block(int rows, int cols, T beta, T* c, int ldc)
+{
+    for (int j = 0; j < cols; j++)
+        for (int i = 0; i < rows; i++)
+            c[i + size_t(j)*ldc] = (beta == T() ? T() : beta * c[i + size_t(j)*ldc]);
+}
+
+// an accelerator buffer and the staging array it is filled from and drained to
+template <typename T>
+class stream_buffer
+{
+public:
+
+    stream_buffer(int rows, int cols, const concurrency::accelerator_view& av, const concurrency::accelerator_view& cpu_av)
+        : rows(rows), staging(concurrency::extent<2>(cols, rows), cpu_av, av), device(concurrency::extent<2>(cols, rows), av)
+    {}
+
+    // packs the block at src, or zeros when src is null, and starts the upload
+    concurrency::completion_future upload(int block_rows, int block_cols, const T* src, int ld)
+    {
+        if (src == nullptr)
+            std::memset(staging.data(), 0, staging.extent.size() * sizeof(T));
+        else
+            pack_block(block_rows, block_cols, src, ld, staging.data(), rows);
+
+        return concurrency::copy_async(staging, device);
+    }
+
+    // starts copying the accelerator buffer back; it is queued behind the kernels using it
+    concurrency::completion_future download()
+    {
+        return concurrency::copy_async(device, staging);
+    }
+
+    // copies a downloaded block to dst
+    void unpack(int block_rows, int block_cols, T* dst, int ld) const
+    {
+        pack_block(block_rows, block_cols, staging.data(), rows, dst, ld);
+    }
+
+    // the block at the origin of the accelerator buffer
+    concurrency::array_view<T,2> view(int block_rows, int block_cols)
+    {
+        return concurrency::array_view<T,2>(device).section(concurrency::extent<2>(block_cols, block_rows));
+    }
+
+private:
+
+    // non-copyable
+    stream_buffer(const stream_buffer&);
+    stream_buffer& operator=(const stream_buffer&);
+
+    int rows;
+    concurrency::array<T,2> staging;
+    concurrency::array<T,2> device;
+};
+
+} // namespace _detail
+
+// default budgets; the accelerator one bounds device memory, the host one a packed working set
+static const size_t out_of_core_budget = size_t(256) << 20;
+static const size_t host_out_of_core_budget = size_t(4) << 20;
+
+// C = alpha * op(A) * op(B) + beta * C on column major host operands, with at most budget bytes of
+// accelerator memory in use
+template <typename T>
+void gemm_out_of_core(const concurrency::accelerator_view& av, enum class transpose transa, enum class transpose transb, int m, int n, int k, T alpha, const T* a, int lda, const T* b, int ldb, T beta, T* c, int ldc, size_t budget = out_of_core_budget)
+{
+    if (m == 0 || n == 0)
+        return;
+
+    if (k == 0)
+    {
+        _detail::scale_block(m, n, beta, c, ldc);
+        return;
+    }
+
+    const _detail::out_of_core_plan plan = _detail::make_out_of_core_plan<T>(m, n, k, budget);
+
+    // panels are uploaded as stored and transposed by the kernel
+    const bool ta = (transa != transpose::no_trans);
+    const bool tb = (transb != transpose::no_trans);
+
+    const concurrency::accelerator_view cpu_av = concurrency::accelerator(concurrency::accelerator::cpu_accelerator).default_view;
+
+    std::unique_ptr<_detail::stream_buffer<T>> a_buffer[2], b_buffer[2], c_buffer[2];
+    for (int s = 0; s < 2; s++)
+    {
+        a_buffer[s].reset(new _detail::stream_buffer<T>(ta ? plan.kb : plan.mb, ta ? plan.mb : plan.kb, av, cpu_av));
+        b_buffer[s].reset(new _detail::stream_buffer<T>(tb ? plan.nb : plan.kb, tb ? plan.kb : plan.nb, av, cpu_av));
+        c_buffer[s].reset(new _detail::stream_buffer<T>(plan.mb, plan.nb, av, cpu_av));
+    }
+
+    // write backs of the last two tiles
+    concurrency::task<void> written[2];
+    bool pending[2] = { false, false };
+
+    int step = 0;
+    int tile = 0;
+
+    for (int j = 0; j < n; j += plan.nb)
+    {
+        for (int i = 0; i < m; i += plan.mb, tile++)
+        {
+            const int h = std::min(plan.mb, m-i);
+            const int w = std::min(plan.nb, n-j);
+
+            _detail::stream_buffer<T>* cb = c_buffer[tile % 2].get();
+
+            {
+                const _detail::timeline_scope scope("gemm_out_of_core", "out_of_core_tile_wait", _detail::timeline_args().add("tile", tile).add("rows", h).add("columns", w));
+
+                // the staging array is reused once the tile two back has been written
+                if (pending[tile % 2])
+                    written[tile % 2].wait();
+
+                cb->upload(h, w, beta == T() ? nullptr : c + i + size_t(j)*ldc, ldc).wait();
+            }
+
+            for (int l = 0; l < k; l += plan.kb, step++)
+            {
+                const int d = std::min(plan.kb, k-l);
+
+                // overlaps the product of the previous step, which is still queued
+                _detail::stream_buffer<T>& ab = *a_buffer[step % 2];
+                _detail::stream_buffer<T>& bb = *b_buffer[step % 2];
+
+                const int a_rows = (ta ? d : h), a_cols = (ta ? h : d);
+                const int b_rows = (tb ? w : d), b_cols = (tb ? d : w);
+
+                concurrency::completion_future a_ready = ab.upload(a_rows, a_cols, ta ? a + l + size_t(i)*lda : a + i + size_t(l)*lda, lda);
+                concurrency::completion_future b_ready = bb.upload(b_rows, b_cols, tb ? b + j + size_t(l)*ldb : b + l + size_t(j)*ldb, ldb);
+                {
+                    const _detail::timeline_scope scope("gemm_out_of_core", "out_of_core_panel_wait", _detail::timeline_args().add("tile", tile).add("step", step).add("depth", d));
+                    a_ready.wait();
+                    b_ready.wait();
+                }
+
+                gemm(av, transa, transb, alpha, ab.view(a_rows, a_cols), bb.view(b_rows, b_cols), l == 0 ? beta : T(1), cb->view(h, w));
+            }
+
+            T* dst = c + i + size_t(j)*ldc;
+            written[tile % 2] = cb->download().to_task().then([=] { cb->unpack(h, w, dst, ldc); });
+            pending[tile % 2] = true;
+        }
+    }
+
+    for (int s = 0; s < 2; s++)
+        if (pending[s])
+            written[s].wait();
+}
+
+namespace host {
+
+// C = alpha * op(A) * op(B) + beta * C on the host for float and double, streaming packed panels of
+// at most budget bytes
+template <typename T>
+void gemm_out_of_core(enum class transpose transa, enum class transpose transb, int m, int n, int k, T alpha, const T* a, int lda, const T* b, int ldb, T beta, T* c, int ldc, size_t budget = host_out_of_core_budget)
+{
+    if (m == 0 || n == 0)
+        return;
+
+    if (k == 0)
+    {
+        _detail::scale_block(m, n, beta, c, ldc);
+        return;
+    }
+
+    const _detail::out_of_core_plan plan = _detail::make_out_of_core_plan<T>(m, n, k, budget);
+
+    // every step of the schedule, in order
+    struct step_type { int i, j, l; };
+    std::vector<step_type> steps;
+    for (int j = 0; j < n; j += plan.nb)
+        for (int i = 0; i < m; i += plan.mb)
+            for (int l = 0; l < k; l += plan.kb)
+            {
+                const step_type s = { i, j, l };
+                steps.push_back(s);
+            }
+
+    std::vector<T> a_panel[2], b_panel[2];
+    for (int s = 0; s < 2; s++)
+    {
+        a_panel[s].resize(size_t(plan.mb) * plan.kb);
+        b_panel[s].resize(size_t(plan.kb) * plan.nb);
+    }
+
+    // op(A) and op(B) panels of step s, packed without transposes
+    auto pack = [&] (size_t s) {
+        const step_type& p = steps[s];
+        const int h = std::min(plan.mb, m-p.i), w = std::min(plan.nb, n-p.j), d = std::min(plan.kb, k-p.l);
+        const _detail::timeline_scope scope("gemm_out_of_core", "host_out_of_core_pack", _detail::timeline_args().add("step", static_cast<long long>(s)).add("rows", h).add("columns", w).add("depth", d));
+
+        _detail::pack_op_block(transa, h, d, transa == transpose::no_trans ? a + p.i + size_t(p.l)*lda : a + p.l + size_t(p.i)*lda, lda, a_panel[s % 2].data(), h);
+        _detail::pack_op_block(transb, d, w, transb == transpose::no_trans ? b + p.l + size_t(p.j)*ldb : b + p.j + size_t(p.l)*ldb, ldb, b_panel[s % 2].data(), d);
+    };
+
+    concurrency::task<void> packed = concurrency::create_task([&] { pack(0); });
+
+    for (size_t s = 0; s < steps.size(); s++)
+    {
+        {
+            const _detail::timeline_scope scope("gemm_out_of_core", "host_out_of_core_pack_wait", _detail::timeline_args().add("step", static_cast<long long>(s)));
+            packed.wait();
+        }
+
+        if (s + 1 < steps.size())
+            packed = concurrency::create_task([&pack, s] { pack(s + 1); });
+
+        const step_type& p = steps[s];
+        const int h = std::min(plan.mb, m-p.i), w = std::min(plan.nb, n-p.j), d = std::min(plan.kb, k-p.l);
+        T* ct = c + p.i + size_t(p.j)*ldc;
+
+        if (p.l == 0)
+            _detail::scale_block(h, w, beta, ct, ldc);
+
+        _detail::host_parallel_gemm(h, w, d, alpha, a_panel[s % 2].data(), h, b_panel[s % 2].data(), d, ct, ldc);
+    }
+}
+
+} // namespace host
+} // namespace ampblas
+
+#endif // AMPBLAS_OUT_OF_CORE_H
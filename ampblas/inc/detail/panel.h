@@ -0,0 +1,81 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * panel.h
+ *
+ * Host copies of the panels of the blocked factorizations. A panel is
+ * fetched without blocking as soon as its lookahead update is enqueued, so
+ * the copy and the host factorization overlap the rest of the trailing
+ * update on the accelerator.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_PANEL_H
+#define AMPBLAS_PANEL_H
+
+#include <vector>
+
+#include "ampblas_dev.h"
+
+namespace ampblas {
+namespace _detail {
+
+// panel width of the blocked factorizations
+template <typename value_type>
+struct factor_block_size { static const int value = 128; };
+
+template <typename value_type>
+class host_panel
+{
+public:
+
+    // starts copying a column major section to the host
+    explicit host_panel(const concurrency::array_view<value_type,2>& section)
+        : view(section), data_(section.extent.size()), ld_(section.extent[1])
+    {
+        pending = concurrency::copy_async(view, data_.begin());
+    }
+
+    // the panel once the copy has finished
+    value_type* data()
+    {
+        pending.get();
+        return data_.data();
+    }
+
+    int ld() const
+    {
+        return ld_;
+    }
+
+    // writes the factored panel back
+    void store()
+    {
+        concurrency::copy(data_.begin(), data_.end(), view);
+    }
+
+private:
+
+    concurrency::array_view<value_type,2> view;
+    std::vector<value_type> data_;
+    int ld_;
+    concurrency::completion_future pending;
+};
+
+} // namespace _detail
+} // namespace ampblas
+
+#endif // AMPBLAS_PANEL_H
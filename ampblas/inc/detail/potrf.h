@@ -0,0 +1,132 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * potrf.h
+ *
+ * Blocked right-looking Cholesky factorization. Panels are factored on the
+ * host while the accelerator runs SYRK and GEMM trailing updates; the next
+ * panel is updated first so that its transfer and factorization overlap the
+ * rest of the update.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_POTRF_H
+#define AMPBLAS_POTRF_H
+
+#include <memory>
+
+#include "ampblas_dev.h"
+
+#include "gemm.h"
+#include "syrk.h"
+#include "panel.h"
+#include "host/lapack.h"
+
+namespace ampblas {
+
+// Factors a symmetric positive definite matrix as L * L' (lower) or U' * U (upper) in place.
+// Returns 0, or the 1-based order of the leading minor that is not positive definite.
+template <typename value_type>
+int potrf(const concurrency::accelerator_view& av, enum class uplo uplo, const concurrency::array_view<value_type,2>& a)
+{
+    const order S = order::col_major;
+
+    const int n = _detail::rows<S>(a.extent);
+    if (_detail::columns<S>(a.extent) != n)
+        argument_error("potrf requires a square matrix");
+
+    if (n == 0)
+        return 0;
+
+    const int nb = _detail::factor_block_size<value_type>::value;
+    const value_type one = value_type(1);
+    const value_type negone = value_type(-1);
+
+    // the panel of column j: a column block when lower, a row block when upper
+    auto panel_section = [&] (int j, int jb) {
+        return (uplo == uplo::lower ? a.section(_detail::index<S>(j,j), _detail::extent<S>(n-j,jb)) : a.section(_detail::index<S>(j,j), _detail::extent<S>(jb,n-j)));
+    };
+
+    std::unique_ptr<_detail::host_panel<value_type>> panel(new _detail::host_panel<value_type>(panel_section(0, std::min(nb, n))));
+
+    for (int j = 0; j < n; j += nb)
+    {
+        const int jb = std::min(nb, n-j);
+
+        const int info = _detail::host_potf2(uplo, n-j, jb, panel->data(), panel->ld());
+        if (info)
+        {
+            av.wait();
+            return j + info;
+        }
+
+        panel->store();
+
+        const int r = j + jb;
+        if (r >= n)
+            break;
+
+        const int n2 = n - r;
+        const int nb2 = std::min(nb, n2);
+
+        if (uplo == uplo::lower)
+        {
+            const concurrency::array_view<value_type,2> l21 = a.section(_detail::index<S>(r,j), _detail::extent<S>(n2,jb));
+
+            // lookahead
+            syrk(av, uplo, transpose::no_trans, negone, l21.section(_detail::extent<S>(nb2,jb)), one, a.section(_detail::index<S>(r,r), _detail::extent<S>(nb2,nb2)));
+            if (n2 > nb2)
+                gemm(av, transpose::no_trans, transpose::trans, n2-nb2, nb2, jb, negone, l21.section(_detail::index<S>(nb2,0)), l21, one, a.section(_detail::index<S>(r+nb2,r)));
+
+            panel.reset(new _detail::host_panel<value_type>(panel_section(r, nb2)));
+
+            // rest of the trailing matrix
+            if (n2 > nb2)
+                syrk(av, uplo, transpose::no_trans, negone, l21.section(_detail::index<S>(nb2,0)), one, a.section(_detail::index<S>(r+nb2,r+nb2)));
+        }
+        else
+        {
+            const concurrency::array_view<value_type,2> u12 = a.section(_detail::index<S>(j,r), _detail::extent<S>(jb,n2));
+
+            // lookahead
+            syrk(av, uplo, transpose::trans, negone, u12.section(_detail::extent<S>(jb,nb2)), one, a.section(_detail::index<S>(r,r), _detail::extent<S>(nb2,nb2)));
+            if (n2 > nb2)
+                gemm(av, transpose::trans, transpose::no_trans, nb2, n2-nb2, jb, negone, u12, u12.section(_detail::index<S>(0,nb2)), one, a.section(_detail::index<S>(r,r+nb2)));
+
+            panel.reset(new _detail::host_panel<value_type>(panel_section(r, nb2)));
+
+            // rest of the trailing matrix
+            if (n2 > nb2)
+                syrk(av, uplo, transpose::trans, negone, u12.section(_detail::index<S>(0,nb2)), one, a.section(_detail::index<S>(r+nb2,r+nb2)));
+        }
+    }
+
+    return 0;
+}
+
+namespace host {
+
+// host Cholesky factorization of an n x n column major matrix
+template <typename T>
+int potrf(enum class uplo uplo, int n, T* a, int lda)
+{
+    return _detail::host_potrf(uplo, n, a, lda, _detail::factor_block_size<T>::value);
+}
+
+} // namespace host
+} // namespace ampblas
+
+#endif // AMPBLAS_POTRF_H
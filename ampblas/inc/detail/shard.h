@@ -0,0 +1,234 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * shard.h
+ *
+ * Runs a single GEMM, SYRK or TRSM across a list of accelerator_views by
+ * partitioning the output into block columns or block rows, one per view.
+ * Operands every shard needs are replicated by the runtime when each view
+ * first reads them; the sections only one shard touches are streamed to it
+ * alone. The shards write disjoint sections of the output, which are joined
+ * when the caller synchronizes it.
+ *
+ * A view may appear more than once to give it a larger share of the work.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_SHARD_H
+#define AMPBLAS_SHARD_H
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "ampblas_dev.h"
+
+#include "gemm.h"
+#include "syrk.h"
+#include "trsm.h"
+
+namespace ampblas {
+namespace _detail {
+
+enum class shard_shape { uniform, lower, upper };
+
+// boundaries of the shards of [0, n) that balance work over a rectangle or a triangle
+inline std::vector<int> shard_bounds(int n, int shards, enum class shard_shape shape)
+{
+    // keeps shard edges on whole tiles
+    const int granularity = 16;
+
+    std::vector<int> bounds(shards + 1, n);
+    bounds[0] = 0;
+
+    for (int s = 1; s < shards; s++)
+    {
+        const double f = double(s) / shards;
+        const double x = (shape == shard_shape::uniform ? f : shape == shard_shape::lower ? 1 - std::sqrt(1 - f) : std::sqrt(f));
+
+        const int bound = static_cast<int>(x * n / granularity + 0.5) * granularity;
+        bounds[s] = std::min(std::max(bound, bounds[s-1]), n);
+    }
+
+    return bounds;
+}
+
+// rows [r0, r0+h) of op(A) for a k-column op(A)
+template <typename a_type>
+a_type op_rows(const a_type& a, enum class transpose trans, int r0, int h, int k)
+{
+    const order S = order::col_major;
+
+    if (trans == transpose::no_trans)
+        return a.section(index<S>(r0,0), extent<S>(h,k));
+    else
+        return a.section(index<S>(0,r0), extent<S>(k,h));
+}
+
+inline void check_shard_views(const std::vector<concurrency::accelerator_view>& views)
+{
+    if (views.empty())
+        argument_error("at least one accelerator_view is required");
+}
+
+} // namespace _detail
+
+// the default views of every accelerator that runs kernels in hardware
+inline std::vector<concurrency::accelerator_view> get_shard_views()
+{
+    std::vector<concurrency::accelerator_view> views;
+
+    const std::vector<concurrency::accelerator> accelerators = concurrency::accelerator::get_all();
+    for (size_t i = 0; i < accelerators.size(); i++)
+        if (!accelerators[i].is_emulated)
+            views.push_back(accelerators[i].default_view);
+
+    return views;
+}
+
+// C = alpha * op(A) * op(B) + beta * C, with C split into block columns (or block rows when
+// it is taller than wide) across the views
+template <typename scalar_type, typename a_type, typename b_type, typename c_type>
+void gemm(const std::vector<concurrency::accelerator_view>& views, enum class transpose transa, enum class transpose transb, scalar_type alpha, const a_type& a, const b_type& b, scalar_type beta, const c_type& c)
+{
+    const order S = order::col_major;
+
+    _detail::check_shard_views(views);
+
+    const int m = _detail::rows<S>(c.extent);
+    const int n = _detail::columns<S>(c.extent);
+    const int k = (transa == transpose::no_trans ? _detail::columns<S>(a.extent) : _detail::rows<S>(a.extent));
+
+    const int shards = static_cast<int>(views.size());
+
+    if (n >= m)
+    {
+        // A is replicated; columns of op(B) and C are streamed
+        const std::vector<int> bounds = _detail::shard_bounds(n, shards, _detail::shard_shape::uniform);
+        const enum class transpose opb = (transb == transpose::no_trans ? transpose::trans : transpose::no_trans);
+
+        for (int s = 0; s < shards; s++)
+        {
+            const int c0 = bounds[s];
+            const int w = bounds[s+1] - c0;
+            if (w == 0)
+                continue;
+
+            // columns of op(B) are rows of op(B)'
+            gemm(views[s], transa, transb, alpha, a, _detail::op_rows(b, opb, c0, w, k), beta, c.section(_detail::index<S>(0,c0), _detail::extent<S>(m,w)));
+        }
+    }
+    else
+    {
+        // B is replicated; rows of op(A) and C are streamed
+        const std::vector<int> bounds = _detail::shard_bounds(m, shards, _detail::shard_shape::uniform);
+
+        for (int s = 0; s < shards; s++)
+        {
+            const int r0 = bounds[s];
+            const int h = bounds[s+1] - r0;
+            if (h == 0)
+                continue;
+
+            gemm(views[s], transa, transb, alpha, _detail::op_rows(a, transa, r0, h, k), b, beta, c.section(_detail::index<S>(r0,0), _detail::extent<S>(h,n)));
+        }
+    }
+}
+
+// C = alpha * op(A) * op(A)' + beta * C on one triangle, split into block columns that hold
+// equal parts of the triangle
+template <typename trans_op, typename scalar_type, typename a_type, typename c_type>
+void syrk(const std::vector<concurrency::accelerator_view>& views, enum class uplo uplo, enum class transpose trans, scalar_type alpha, const a_type& a, scalar_type beta, const c_type& c)
+{
+    const order S = order::col_major;
+    typedef typename a_type::value_type value_type;
+
+    _detail::check_shard_views(views);
+
+    const int n = _detail::rows<S>(c.extent);
+    const int k = (trans == transpose::no_trans ? _detail::columns<S>(a.extent) : _detail::rows<S>(a.extent));
+
+    // 't' for noop and 'c' for complex conjugate
+    const enum class transpose trans_type = _detail::transpose_type<trans_op>::value;
+    const enum class transpose opa = (trans == transpose::no_trans ? transpose::no_trans : trans_type);
+    const enum class transpose opb = (trans == transpose::no_trans ? trans_type : transpose::no_trans);
+
+    const int shards = static_cast<int>(views.size());
+    const std::vector<int> bounds = _detail::shard_bounds(n, shards, uplo == uplo::lower ? _detail::shard_shape::lower : _detail::shard_shape::upper);
+
+    for (int s = 0; s < shards; s++)
+    {
+        const int c0 = bounds[s];
+        const int c1 = bounds[s+1];
+        const int w = c1 - c0;
+        if (w == 0)
+            continue;
+
+        // diagonal block
+        syrk<trans_op>(views[s], uplo, trans, alpha, _detail::op_rows(a, trans, c0, w, k), beta, c.section(_detail::index<S>(c0,c0), _detail::extent<S>(w,w)));
+
+        // the rest of the block column within the triangle
+        if (uplo == uplo::lower && c1 < n)
+            gemm(views[s], opa, opb, n-c1, w, k, value_type(alpha), _detail::op_rows(a, trans, c1, n-c1, k), _detail::op_rows(a, trans, c0, w, k), value_type(beta), c.section(_detail::index<S>(c1,c0)));
+        else if (uplo == uplo::upper && c0 > 0)
+            gemm(views[s], opa, opb, c0, w, k, value_type(alpha), _detail::op_rows(a, trans, 0, c0, k), _detail::op_rows(a, trans, c0, w, k), value_type(beta), c.section(_detail::index<S>(0,c0)));
+    }
+}
+
+template <typename scalar_type, typename a_type, typename c_type>
+void syrk(const std::vector<concurrency::accelerator_view>& views, enum class uplo uplo, enum class transpose trans, scalar_type alpha, const a_type& a, scalar_type beta, const c_type& c)
+{
+    syrk<_detail::noop>(views, uplo, trans, alpha, a, beta, c);
+}
+
+template <typename scalar_type, typename a_type, typename c_type>
+void herk(const std::vector<concurrency::accelerator_view>& views, enum class uplo uplo, enum class transpose trans, scalar_type alpha, const a_type& a, scalar_type beta, const c_type& c)
+{
+    syrk<_detail::conjugate>(views, uplo, trans, alpha, a, beta, c);
+}
+
+// op(A) * X = alpha * B or X * op(A) = alpha * B; the right hand sides are independent, so B is
+// split into block columns (left) or block rows (right) and A is replicated
+template <typename scalar_type, typename a_type, typename b_type>
+void trsm(const std::vector<concurrency::accelerator_view>& views, enum class side side, enum class uplo uplo, enum class transpose transa, enum class diag diag, scalar_type alpha, const a_type& a, const b_type& b)
+{
+    const order S = order::col_major;
+
+    _detail::check_shard_views(views);
+
+    const int m = _detail::rows<S>(b.extent);
+    const int n = _detail::columns<S>(b.extent);
+
+    const int shards = static_cast<int>(views.size());
+    const std::vector<int> bounds = _detail::shard_bounds(side == side::left ? n : m, shards, _detail::shard_shape::uniform);
+
+    for (int s = 0; s < shards; s++)
+    {
+        const int p0 = bounds[s];
+        const int w = bounds[s+1] - p0;
+        if (w == 0)
+            continue;
+
+        if (side == side::left)
+            trsm(views[s], side, uplo, transa, diag, alpha, a, b.section(_detail::index<S>(0,p0), _detail::extent<S>(m,w)));
+        else
+            trsm(views[s], side, uplo, transa, diag, alpha, a, b.section(_detail::index<S>(p0,0), _detail::extent<S>(w,n)));
+    }
+}
+
+} // namespace ampblas
+
+#endif // AMPBLAS_SHARD_H
@@ -24,6 +24,7 @@
 #include "ampblas_dev.h"
 
 #include "gemm.h"
+#include "task_graph.h"
 
 namespace ampblas {
 namespace _detail {
@@ -117,9 +118,22 @@ void syrk(const concurrency::accelerator_view& av, enum class uplo uplo, enum cl
     );
 }
 
+// records a diagonal block update as a task that reads A and C and writes C
+template <typename trans_op, typename scalar_type, typename a_type, typename c_type>
+void syrk(task_graph& graph, enum class uplo uplo, enum class transpose trans, scalar_type alpha, const tracked_view<a_type>& a, scalar_type beta, const tracked_view<c_type>& c)
+{
+    const a_type a_data = a.data();
+    const c_type c_data = c.data();
+
+    graph.add(task_regions(a.region(), c.region()), task_regions(c.region()), [=] (const concurrency::accelerator_view& queue) {
+        _detail::syrk<trans_op>(queue, uplo, trans, alpha, a_data, beta, c_data);
+    });
+}
+
 // tuning interface
-template <int rb, typename trans_op, typename scalar_type, typename a_type, typename c_type>
-void recursive_syrk(const concurrency::accelerator_view& av, enum class uplo uplo, enum class transpose trans, int n, int k, scalar_type alpha, const a_type& a, scalar_type beta, const c_type& c)
+//   executor_type is an accelerator_view or a task_graph recording steps on tracked views
+template <int rb, typename trans_op, typename executor_type, typename scalar_type, typename a_type, typename c_type>
+void recursive_syrk(executor_type& av, enum class uplo uplo, enum class transpose trans, int n, int k, scalar_type alpha, const a_type& a, scalar_type beta, const c_type& c)
 {
     const order S = order::col_major;
     typedef typename a_type::value_type value_type;
@@ -196,6 +210,28 @@ void syrk(const concurrency::accelerator_view& av, enum class uplo uplo, enum cl
     _detail::recursive_syrk<rb, trans_op>(av, uplo, trans, n, k, alpha, a, beta, c);
 }
 
+// record the update of tracked A and C in a task graph; the caller waits on the graph
+template <typename trans_op, typename scalar_type, typename a_type, typename c_type>
+void syrk(task_graph& graph, enum class uplo uplo, enum class transpose trans, scalar_type alpha, const tracked_view<a_type>& a, scalar_type beta, const tracked_view<c_type>& c)
+{
+    const order S = order::col_major;
+
+    const int n = _detail::rows<S>(c.extent);
+    const int a_row = _detail::rows<S>(a.extent);
+    const int a_col = _detail::columns<S>(a.extent);
+    const int k = (trans == transpose::no_trans ? a_col : a_row);
+
+    const int rb = 1024;
+
+    _detail::recursive_syrk<rb, trans_op>(graph, uplo, trans, n, k, alpha, a, beta, c);
+}
+
+template <typename scalar_type, typename a_type, typename c_type>
+void syrk(task_graph& graph, enum class uplo uplo, enum class transpose trans, scalar_type alpha, const tracked_view<a_type>& a, scalar_type beta, const tracked_view<c_type>& c)
+{
+    syrk<_detail::noop>(graph, uplo, trans, alpha, a, beta, c);
+}
+
 // implied noop interface
 template <typename scalar_type, typename a_type, typename c_type>
 void syrk(const concurrency::accelerator_view& av, enum class uplo uplo, enum class transpose trans, scalar_type alpha, const a_type& a_mat, scalar_type beta, const c_type& c_mat)
@@ -0,0 +1,306 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * task_graph.h
+ *
+ * Records BLAS calls on matrix sections as tasks and runs them out of order.
+ * Every task lists the regions it reads and writes; a task waits only for
+ * earlier tasks whose writes overlap its reads or writes, or whose reads
+ * overlap its writes. Scheduling is done with continuations on the
+ * Concurrency Runtime's work-stealing pool.
+ *
+ * Accelerator tasks are enqueued on one of the graph's queues. A task that
+ * depends only on work already enqueued on its own queue is enqueued as soon
+ * as that work has been enqueued, relying on the queue's ordering; work on
+ * other queues is waited for with markers. Queues must be accelerator_views
+ * of the same accelerator, and operands shared between queues should be
+ * array_views so the runtime keeps their sections coherent.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_TASK_GRAPH_H
+#define AMPBLAS_TASK_GRAPH_H
+
+#include <vector>
+
+#include <ppltasks.h>
+
+#include "ampblas_dev.h"
+
+namespace ampblas {
+
+//
+// task_region
+//   A rectangle of a tracked buffer in the index space of its view.
+//
+struct task_region
+{
+    int buffer;
+    concurrency::index<2> origin;
+    concurrency::extent<2> extent;
+
+    bool overlaps(const task_region& rhs) const
+    {
+        if (buffer != rhs.buffer)
+            return false;
+
+        for (int d = 0; d < 2; d++)
+        {
+            if (origin[d] >= rhs.origin[d] + rhs.extent[d] || rhs.origin[d] >= origin[d] + extent[d])
+                return false;
+        }
+
+        return true;
+    }
+};
+
+//
+// tracked_view
+//   A 2D view paired with the region it covers. Sectioning mirrors array_view so the recursive
+//   routines can be written once for plain views and tracked views.
+//
+template <typename view_type>
+class tracked_view
+{
+public:
+
+    typedef typename view_type::value_type value_type;
+
+    tracked_view(const view_type& data, const task_region& region)
+        : extent(data.extent), data_(data), region_(region)
+    {
+    }
+
+    tracked_view section(const concurrency::index<2>& origin, const concurrency::extent<2>& ext) const
+    {
+        task_region region = region_;
+        region.origin = region_.origin + origin;
+        region.extent = ext;
+        return tracked_view(data_.section(origin, ext), region);
+    }
+
+    tracked_view section(const concurrency::index<2>& origin) const
+    {
+        return section(origin, extent - origin);
+    }
+
+    tracked_view section(const concurrency::extent<2>& ext) const
+    {
+        return section(concurrency::index<2>(), ext);
+    }
+
+    const view_type& data() const { return data_; }
+    const task_region& region() const { return region_; }
+
+    concurrency::extent<2> extent;
+
+private:
+
+    view_type data_;
+    task_region region_;
+};
+
+// region lists for the common operand counts
+inline std::vector<task_region> task_regions(const task_region& r0)
+{
+    return std::vector<task_region>(1, r0);
+}
+
+inline std::vector<task_region> task_regions(const task_region& r0, const task_region& r1)
+{
+    std::vector<task_region> ret = task_regions(r0);
+    ret.push_back(r1);
+    return ret;
+}
+
+inline std::vector<task_region> task_regions(const task_region& r0, const task_region& r1, const task_region& r2)
+{
+    std::vector<task_region> ret = task_regions(r0, r1);
+    ret.push_back(r2);
+    return ret;
+}
+
+//
+// task_graph
+//
+class task_graph
+{
+public:
+
+    explicit task_graph(const concurrency::accelerator_view& av)
+        : queues(1, av), next_queue(0), next_buffer(0)
+    {
+    }
+
+    explicit task_graph(const std::vector<concurrency::accelerator_view>& views)
+        : queues(views), next_queue(0), next_buffer(0)
+    {
+        if (queues.empty())
+            argument_error("task_graph requires at least one queue");
+    }
+
+    ~task_graph()
+    {
+        // outstanding tasks capture views that may not outlive the graph
+        try { wait(); } catch (...) {}
+    }
+
+    // starts tracking a matrix; track each matrix once so that all of its sections share a buffer
+    template <typename view_type>
+    tracked_view<view_type> track(const view_type& view)
+    {
+        task_region region;
+        region.buffer = next_buffer++;
+        region.origin = concurrency::index<2>();
+        region.extent = view.extent;
+        return tracked_view<view_type>(view, region);
+    }
+
+    // records accelerator work; body(queue) enqueues it on the queue it is given
+    template <typename body_type>
+    void add(const std::vector<task_region>& reads, const std::vector<task_region>& writes, const body_type& body)
+    {
+        std::vector<size_t> deps = dependencies(reads, writes);
+
+        // stay on the queue of the latest accelerator dependency to keep chains in order for free
+        int queue = -1;
+        for (size_t i = deps.size(); i-- > 0 && queue < 0; )
+            queue = nodes[deps[i]].queue;
+        if (queue < 0)
+            queue = next_queue++ % static_cast<int>(queues.size());
+
+        std::vector<concurrency::task<void>> waits;
+        for (size_t i = 0; i < deps.size(); i++)
+        {
+            const node& dep = nodes[deps[i]];
+            waits.push_back(dep.queue == queue ? dep.submitted : dep.completed);
+        }
+
+        const concurrency::accelerator_view target = queues[queue];
+
+        node n;
+        n.reads = reads;
+        n.writes = writes;
+        n.queue = queue;
+        n.submitted = ready(waits).then([target, body] { body(target); });
+        n.completed = n.submitted.then([target] { return target.create_marker().to_task(); });
+        nodes.push_back(n);
+    }
+
+    // records host work; body() runs on the task pool
+    template <typename body_type>
+    void add_host(const std::vector<task_region>& reads, const std::vector<task_region>& writes, const body_type& body)
+    {
+        std::vector<size_t> deps = dependencies(reads, writes);
+
+        std::vector<concurrency::task<void>> waits;
+        for (size_t i = 0; i < deps.size(); i++)
+            waits.push_back(nodes[deps[i]].completed);
+
+        node n;
+        n.reads = reads;
+        n.writes = writes;
+        n.queue = -1;
+        n.submitted = ready(waits).then(body);
+        n.completed = n.submitted;
+        nodes.push_back(n);
+    }
+
+    // completes once every recorded task has finished
+    concurrency::task<void> completion() const
+    {
+        std::vector<concurrency::task<void>> waits;
+        for (size_t i = 0; i < nodes.size(); i++)
+            waits.push_back(nodes[i].completed);
+        return ready(waits);
+    }
+
+    // waits for every recorded task, rethrows the first failure, and starts a new graph
+    void wait()
+    {
+        concurrency::task<void> done = completion();
+        nodes.clear();
+        done.get();
+    }
+
+    size_t size() const
+    {
+        return nodes.size();
+    }
+
+    const std::vector<concurrency::accelerator_view>& get_queues() const
+    {
+        return queues;
+    }
+
+private:
+
+    struct node
+    {
+        std::vector<task_region> reads;
+        std::vector<task_region> writes;
+        int queue;
+        concurrency::task<void> submitted;
+        concurrency::task<void> completed;
+    };
+
+    static bool any_overlap(const std::vector<task_region>& lhs, const std::vector<task_region>& rhs)
+    {
+        for (size_t i = 0; i < lhs.size(); i++)
+            for (size_t j = 0; j < rhs.size(); j++)
+                if (lhs[i].overlaps(rhs[j]))
+                    return true;
+        return false;
+    }
+
+    // earlier tasks with a read-after-write, write-after-read or write-after-write hazard
+    std::vector<size_t> dependencies(const std::vector<task_region>& reads, const std::vector<task_region>& writes) const
+    {
+        std::vector<size_t> deps;
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            const node& n = nodes[i];
+            if (any_overlap(reads, n.writes) || any_overlap(writes, n.writes) || any_overlap(writes, n.reads))
+                deps.push_back(i);
+        }
+        return deps;
+    }
+
+    static concurrency::task<void> ready(const std::vector<concurrency::task<void>>& waits)
+    {
+        if (waits.empty())
+        {
+            concurrency::task_completion_event<void> now;
+            now.set();
+            return concurrency::create_task(now);
+        }
+
+        return concurrency::when_all(waits.begin(), waits.end());
+    }
+
+    // not copyable; recorded tasks refer to this graph's queues
+    task_graph(const task_graph&);
+    task_graph& operator=(const task_graph&);
+
+    std::vector<concurrency::accelerator_view> queues;
+    std::vector<node> nodes;
+    int next_queue;
+    int next_buffer;
+};
+
+} // namespace ampblas
+
+#endif // AMPBLAS_TASK_GRAPH_H
@@ -0,0 +1,379 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * timeline.h
+ *
+ * Kernel timeline. While a timeline is recorded, the stages of the kernel
+ * layer that launch work (a parallel_for_each, a block of host kernels, a
+ * wait in a pipeline) emit a begin and an end event carrying the routine,
+ * the stage and integer arguments such as the tile grid and the tuning
+ * parameters. Every thread appends its events to a ring buffer of its own
+ * without locks or interlocked instructions; the newest events of every
+ * ring are exported as Chrome trace event JSON, which chrome://tracing and
+ * Perfetto display as one track per thread.
+ *
+ * A parallel_for_each returns once its kernel is queued, so by default the
+ * events of an accelerator stage bracket the launch. A timeline started
+ * with wait_for_kernels waits for the kernels of each stage before its end
+ * event, which shows when they ran at the price of serializing the stages.
+ *
+ * The recorder uses only the standard library outside of its clock, so it
+ * builds wherever the instrumented code does.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_TIMELINE_H
+#define AMPBLAS_TIMELINE_H
+
+#include <atomic>
+#include <cstdio>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#define AMPBLAS_THREAD_LOCAL __declspec(thread)
+#else
+#include <chrono>
+#define AMPBLAS_THREAD_LOCAL thread_local
+#endif
+
+namespace ampblas {
+namespace _detail {
+
+//
+// events
+//
+
+static const int timeline_max_args = 10;
+static const int timeline_ring_events = 2048;
+
+// an integer argument of an event; the name is a string literal
+struct timeline_arg
+{
+    const char *name;
+    long long value;
+};
+
+// Arguments are added in a chain, timeline_args().add("m", m).add("n", n); those past
+// timeline_max_args are dropped
+class timeline_args
+{
+public:
+    timeline_args() : count(0) {}
+
+    timeline_args& add(const char *name, long long value)
+    {
+        if (count < timeline_max_args)
+        {
+            args[count].name = name;
+            args[count].value = value;
+            count++;
+        }
+        return *this;
+    }
+
+    int count;
+    timeline_arg args[timeline_max_args];
+};
+
+struct timeline_event
+{
+    long long ticks;
+    const char *routine;
+    const char *stage;
+    char phase;                                 // 'B' or 'E'
+    timeline_args args;
+};
+
+// A slot of a ring. sequence is the number of the event held plus one, and 0 while the
+// slot is being written, so a reader can tell a complete event from one being overwritten.
+struct timeline_slot
+{
+    std::atomic<unsigned long long> sequence;
+    timeline_event event;
+};
+
+// The events of one thread. Only that thread writes it; head is the number of events it has
+// written and base the number that were written when the timeline was last started.
+struct timeline_ring
+{
+    std::atomic<unsigned long long> head;
+    std::atomic<unsigned long long> base;
+    timeline_ring *next;
+    int thread;
+    timeline_slot slots[timeline_ring_events];
+};
+
+//
+// clock
+//
+
+#ifdef _WIN32
+inline long long timeline_ticks()
+{
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    return count.QuadPart;
+}
+
+inline double timeline_ticks_per_us()
+{
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    return double(frequency.QuadPart) / 1e6;
+}
+#else
+inline long long timeline_ticks()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline double timeline_ticks_per_us()
+{
+    return 1e3;
+}
+#endif
+
+//
+// recorder state
+//
+
+// rings is a list of the rings of every thread that has emitted an event, pushed without
+// a lock; rings are never freed, so a reader may walk the list at any time
+template <int unused = 0>
+struct timeline_state
+{
+    static std::atomic<int> recording;
+    static std::atomic<int> wait_for_kernels;
+    static std::atomic<timeline_ring*> rings;
+    static std::atomic<int> threads;
+    static AMPBLAS_THREAD_LOCAL timeline_ring *ring;
+};
+
+template <int unused> std::atomic<int> timeline_state<unused>::recording;
+template <int unused> std::atomic<int> timeline_state<unused>::wait_for_kernels;
+template <int unused> std::atomic<timeline_ring*> timeline_state<unused>::rings;
+template <int unused> std::atomic<int> timeline_state<unused>::threads;
+template <int unused> AMPBLAS_THREAD_LOCAL timeline_ring *timeline_state<unused>::ring = nullptr;
+
+inline bool timeline_recording()
+{
+    return timeline_state<>::recording.load(std::memory_order_relaxed) != 0;
+}
+
+// the calling thread's ring, allocated when it first emits; nullptr if it cannot be allocated
+inline timeline_ring *timeline_thread_ring()
+{
+    timeline_ring *ring = timeline_state<>::ring;
+    if (ring != nullptr)
+        return ring;
+
+    ring = new (std::nothrow) timeline_ring;
+    if (ring == nullptr)
+        return nullptr;
+
+    ring->head.store(0);
+    ring->base.store(0);
+    ring->thread = ++timeline_state<>::threads;
+    for (int i = 0; i < timeline_ring_events; i++)
+        ring->slots[i].sequence.store(0);
+
+    ring->next = timeline_state<>::rings.load();
+    while (!timeline_state<>::rings.compare_exchange_weak(ring->next, ring))
+        ;
+
+    timeline_state<>::ring = ring;
+    return ring;
+}
+
+inline void timeline_emit(char phase, const char *routine, const char *stage, const timeline_args& args)
+{
+    timeline_ring *ring = timeline_thread_ring();
+    if (ring == nullptr)
+        return;
+
+    const unsigned long long n = ring->head.load(std::memory_order_relaxed);
+    timeline_slot& slot = ring->slots[n % timeline_ring_events];
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.event.ticks = timeline_ticks();
+    slot.event.routine = routine;
+    slot.event.stage = stage;
+    slot.event.phase = phase;
+    slot.event.args = args;
+
+    slot.sequence.store(n + 1, std::memory_order_release);
+    ring->head.store(n + 1, std::memory_order_release);
+}
+
+// Emits the begin event of a stage when it is constructed and the end event when it is
+// destroyed, if a timeline was being recorded when it was constructed
+class timeline_scope
+{
+public:
+    timeline_scope(const char *routine, const char *stage, const timeline_args& args = timeline_args())
+        : routine(routine), stage(stage), active(timeline_recording())
+    {
+        if (active)
+            timeline_emit('B', routine, stage, args);
+    }
+
+    ~timeline_scope()
+    {
+        if (active)
+            timeline_emit('E', routine, stage, timeline_args());
+    }
+
+    // waits for the kernels queued on view if the timeline was started with wait_for_kernels;
+    // called by an accelerator stage before its scope ends
+    template <typename view_type>
+    void wait_for(view_type view) const
+    {
+        if (active && timeline_state<>::wait_for_kernels.load(std::memory_order_relaxed) != 0)
+            view.wait();
+    }
+
+private:
+    timeline_scope(const timeline_scope&);
+    timeline_scope& operator=(const timeline_scope&);
+
+    const char *const routine;
+    const char *const stage;
+    const bool active;
+};
+
+//
+// export
+//
+
+// Copies the complete events of ring in order. An end event whose begin was overwritten is
+// dropped, so the stages of every thread nest.
+inline void timeline_collect(timeline_ring& ring, std::vector<timeline_event>& events)
+{
+    const unsigned long long head = ring.head.load(std::memory_order_acquire);
+    const unsigned long long base = ring.base.load();
+    unsigned long long first = head > timeline_ring_events ? head - timeline_ring_events : 0;
+    if (first < base)
+        first = base;
+
+    int depth = 0;
+    for (unsigned long long n = first; n < head; n++)
+    {
+        const timeline_slot& slot = ring.slots[n % timeline_ring_events];
+        if (slot.sequence.load(std::memory_order_acquire) != n + 1)
+            continue;
+
+        const timeline_event copy = slot.event;
+
+        // overwritten while it was copied
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != n + 1)
+            continue;
+
+        if (copy.phase == 'E' && depth == 0)
+            continue;
+        depth += (copy.phase == 'B' ? 1 : -1);
+
+        events.push_back(copy);
+    }
+}
+
+inline FILE *timeline_open(const char *path)
+{
+#ifdef _MSC_VER
+    FILE *file = nullptr;
+    if (fopen_s(&file, path, "w") != 0)
+        return nullptr;
+    return file;
+#else
+    return fopen(path, "w");
+#endif
+}
+
+} // namespace _detail
+
+//-------------------------------------------------------------------------
+// Kernel timeline
+//-------------------------------------------------------------------------
+
+// start_timeline starts recording the stages of the kernel layer on every thread, dropping
+// the events recorded before. Each thread keeps its newest 2048 events. With
+// wait_for_kernels, accelerator stages wait for their kernels before they end.
+inline void start_timeline(bool wait_for_kernels = false)
+{
+    for (_detail::timeline_ring *ring = _detail::timeline_state<>::rings.load(); ring != nullptr; ring = ring->next)
+        ring->base.store(ring->head.load());
+
+    _detail::timeline_state<>::wait_for_kernels.store(wait_for_kernels ? 1 : 0);
+    _detail::timeline_state<>::recording.store(1);
+}
+
+// stop_timeline stops recording; the events recorded are kept for write_timeline
+inline void stop_timeline()
+{
+    _detail::timeline_state<>::recording.store(0);
+}
+
+// write_timeline writes the events recorded since the timeline was last started to path
+// as Chrome trace event JSON; times are in microseconds and tracks are numbered in the order
+// threads first recorded. Returns false if the file cannot be written.
+inline bool write_timeline(const char *path)
+{
+    FILE *file = _detail::timeline_open(path);
+    if (file == nullptr)
+        return false;
+
+    const double ticks_per_us = _detail::timeline_ticks_per_us();
+
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file);
+    const char *separator = "\n";
+
+    std::vector<_detail::timeline_event> events;
+    for (_detail::timeline_ring *ring = _detail::timeline_state<>::rings.load(); ring != nullptr; ring = ring->next)
+    {
+        events.clear();
+        _detail::timeline_collect(*ring, events);
+
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"ampblas thread %d\"}}", separator, ring->thread, ring->thread);
+        separator = ",\n";
+
+        for (size_t i = 0; i < events.size(); i++)
+        {
+            const _detail::timeline_event& event = events[i];
+            fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{",
+                    event.stage, event.routine, event.phase, double(event.ticks) / ticks_per_us, ring->thread);
+
+            for (int a = 0; a < event.args.count; a++)
+                fprintf(file, "%s\"%s\":%lld", a == 0 ? "" : ",", event.args.args[a].name, event.args.args[a].value);
+
+            fputs("}}", file);
+        }
+    }
+
+    fputs("\n]}\n", file);
+    const bool written = ferror(file) == 0;
+    return fclose(file) == 0 && written;
+}
+
+} // namespace ampblas
+
+#endif // AMPBLAS_TIMELINE_H
@@ -21,6 +21,7 @@
 #include "ampblas_dev.h"
 
 #include "gemm.h"
+#include "task_graph.h"
 
 namespace ampblas {
 namespace _detail {
@@ -477,9 +478,23 @@ void trsm_ru(const concurrency::accelerator_view& av, enum class transpose trans
     });
 }
 
+// records a diagonal block solve as a task that reads A and B and writes B
+template <typename scalar_type, typename a_type, typename b_type>
+void trsm(task_graph& graph, enum class side side, enum class uplo uplo, enum class transpose transa, enum class diag diag, scalar_type alpha, const tracked_view<a_type>& a, const tracked_view<b_type>& b)
+{
+    const a_type a_data = a.data();
+    const b_type b_data = b.data();
+
+    graph.add(task_regions(a.region(), b.region()), task_regions(b.region()), [=] (const concurrency::accelerator_view& queue) {
+        _detail::trsm(queue, side, uplo, transa, diag, alpha, a_data, b_data);
+    });
+}
+
 // recursive gemm-based implementation
-template <int rb, typename scalar_type, typename a_type, typename b_type>
-void recursive_trsm(const concurrency::accelerator_view& av, enum class side side, enum class uplo uplo, enum class transpose transa, enum class diag diag, int m, int n, scalar_type alpha, const a_type& a, const b_type& b) 
+//   executor_type is an accelerator_view to run each step in order, or a task_graph to record
+//   the steps on tracked views so independent updates can overlap
+template <int rb, typename executor_type, typename scalar_type, typename a_type, typename b_type>
+void recursive_trsm(executor_type& av, enum class side side, enum class uplo uplo, enum class transpose transa, enum class diag diag, int m, int n, scalar_type alpha, const a_type& a, const b_type& b) 
 {
     // only column major support for now
     const enum class order S = order::col_major;
@@ -666,6 +681,19 @@ void trsm(const concurrency::accelerator_view& av, enum class side side, enum cl
     _detail::recursive_trsm<rb>(av, side, uplo, transa, diag, m, n, alpha, a, b);
 }
 
+// record the solve of tracked A and B in a task graph; the caller waits on the graph
+template <typename scalar_type, typename a_type, typename b_type>
+void trsm(task_graph& graph, enum class side side, enum class uplo uplo, enum class transpose transa, enum class diag diag, scalar_type alpha, const tracked_view<a_type>& a, const tracked_view<b_type>& b)
+{
+    const order S = order::col_major;
+
+    const int rb = 1024;
+
+    const int m = _detail::rows<S>(b.extent);
+    const int n = _detail::columns<S>(b.extent);
+    _detail::recursive_trsm<rb>(graph, side, uplo, transa, diag, m, n, alpha, a, b);
+}
+
 // use sections of A and B specified by m and n
 template <typename scalar_type, typename a_type, typename b_type>
 void trsm(const concurrency::accelerator_view& av, enum class side side, enum class uplo uplo, enum class transpose transa, enum class diag diag, int m, int n, scalar_type alpha, const a_type& a, const b_type& b)
@@ -4,6 +4,12 @@
 #include "ampblas_dev.h"
 
 #include <string>
+#include <vector>
+#include <utility>
+
+#include <intrin.h>
+#include <immintrin.h>
+#include <concrt.h>
 
 AMPBLAS_NAMESPACE_BEGIN
 DETAIL_NAMESPACE_BEGIN
@@ -37,6 +43,148 @@ inline enum class architecture get_architecture(std::wstring& description)
     
 }
 
+// host instruction set extensions that are usable by the current process
+enum host_feature
+{
+    host_sse42   = 0x01,
+    host_avx     = 0x02,
+    host_avx2    = 0x04,
+    host_fma     = 0x08,
+    host_avx512f = 0x10
+};
+
+// queries CPUID and XCR0; AVX class features are only reported when the OS saves the wider register state
+inline unsigned int detect_host_features()
+{
+    int info[4];
+    unsigned int features = 0;
+
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    if (max_leaf < 1)
+        return features;
+
+    __cpuid(info, 1);
+    const bool sse42   = (info[2] & (1 << 20)) != 0;
+    const bool fma     = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    const bool ymm_state = (xcr0 & 0x06) == 0x06;
+    const bool zmm_state = (xcr0 & 0xe6) == 0xe6;
+
+    if (sse42)
+        features |= host_sse42;
+
+    if (avx && ymm_state)
+    {
+        features |= host_avx;
+        if (fma)
+            features |= host_fma;
+    }
+
+    if (max_leaf >= 7 && ymm_state)
+    {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5))
+            features |= host_avx2;
+        if ((info[1] & (1 << 16)) && zmm_state)
+            features |= host_avx512f;
+    }
+
+    return features;
+}
+
+// instruction set levels for which host kernels are compiled; the host counterpart of architecture
+enum class host_isa
+{
+    generic,                    // portable C++
+    sse42,                      // 128-bit SSE
+    avx2,                       // 256-bit AVX2 with FMA
+    avx512,                     // 512-bit AVX-512F (currently shares the AVX2 kernels)
+
+    // number of entries
+    count
+};
+
+// highest instruction set level for which kernels exist and the host supports
+inline enum class host_isa select_host_isa(unsigned int features)
+{
+    if ((features & host_avx512f) && (features & host_fma))
+        return host_isa::avx512;
+    else if ((features & host_avx2) && (features & host_fma))
+        return host_isa::avx2;
+    else if (features & host_sse42)
+        return host_isa::sse42;
+    else
+        return host_isa::generic;
+}
+
+// everything the library needs to know about an accelerator to select kernels
+struct architecture_info
+{
+    enum class architecture arch;
+    unsigned int host_features;
+    bool supports_double_precision;
+    bool supports_limited_double_precision;
+};
+
+// Architecture detection is performed once per accelerator and cached. Lookups compare
+// accelerator handles, so the hot path does not allocate or parse the description string.
+// The template parameter only exists to allow the static members to be defined in a header.
+template <int unused = 0>
+class architecture_cache
+{
+public:
+    static architecture_info get(const concurrency::accelerator& accl)
+    {
+        concurrency::critical_section::scoped_lock lock(cs);
+
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (it->first == accl)
+                return it->second;
+        }
+
+        // first use of this accelerator
+        std::wstring desc = accl.get_description();
+
+        architecture_info info;
+        info.arch = get_architecture(desc);
+        info.host_features = host_features();
+        info.supports_double_precision = accl.get_supports_double_precision();
+        info.supports_limited_double_precision = accl.get_supports_limited_double_precision();
+
+        entries.push_back(std::make_pair(accl, info));
+        return info;
+    }
+
+private:
+    // CPUID results do not change for the lifetime of the process
+    static unsigned int host_features()
+    {
+        static const unsigned int features = detect_host_features();
+        return features;
+    }
+
+    static concurrency::critical_section cs;
+    static std::vector<std::pair<concurrency::accelerator, architecture_info>> entries;
+};
+
+template <int unused> concurrency::critical_section architecture_cache<unused>::cs;
+template <int unused> std::vector<std::pair<concurrency::accelerator, architecture_info>> architecture_cache<unused>::entries;
+
+inline architecture_info get_architecture_info(const concurrency::accelerator& accl)
+{
+    return architecture_cache<>::get(accl);
+}
+
+inline enum class architecture get_architecture(const concurrency::accelerator& accl)
+{
+    return get_architecture_info(accl).arch;
+}
+
 DETAIL_NAMESPACE_END
 AMPBLAS_NAMESPACE_END
 
@@ -23,11 +23,44 @@
 #ifndef AMPBLAS_UTILITY_REDUCTION_H
 #define AMPBLAS_UTILITY_REDUCTION_H
 
+#include <ppltasks.h>
+
 #include "ampblas_config.h"
+#include "workspace.h"
 
 AMPBLAS_NAMESPACE_BEGIN
 DETAIL_NAMESPACE_BEGIN
 
+//
+// value_pair
+//   Two values reduced together in a single pass. This is kept as an aggregate so it can be
+//   used as the element type of tile_static buffers.
+//
+template <typename T>
+struct value_pair
+{
+    T first;
+    T second;
+};
+
+template <typename T>
+inline value_pair<T> make_value_pair(const T& first, const T& second) restrict(cpu, amp)
+{
+    value_pair<T> ret;
+    ret.first = first;
+    ret.second = second;
+    return ret;
+}
+
+template <typename T>
+struct pair_sum
+{
+    value_pair<T> operator()(const value_pair<T>& lhs, const value_pair<T>& rhs) const restrict(cpu, amp)
+    {
+        return make_value_pair(lhs.first + rhs.first, lhs.second + rhs.second);
+    }
+};
+
 template <typename T, unsigned int tile_size, typename functor>
 void tile_local_reduction(T* const mem, concurrency::tiled_index<tile_size> tid, const functor& op) restrict(amp)
 {
@@ -47,20 +80,24 @@ void tile_local_reduction(T* const mem, concurrency::tiled_index<tile_size> tid,
     if (tile_size >=    2) { if (local <   1) { mem[0] = op(mem[0], mem[  1]); } tid.barrier.wait_with_tile_static_memory_fence(); }
 }
 
-// Generic reduction of an 1D container with the reduction operation specified by a helper functor
-template <unsigned int tile_size, unsigned int max_tiles, typename ret_type, typename elm_type, typename x_type, typename functor>
-ret_type reduce(const concurrency::accelerator_view& av, int n, const x_type& X, const functor& reduce_helper)
+// number of tiles launched by a reduction over n elements
+template <unsigned int tile_size, unsigned int max_tiles>
+inline unsigned int reduce_tile_count(int n)
 {
-    // runtime sizes
     unsigned int tile_count = (n+tile_size-1) / tile_size;
-    tile_count = std::min(tile_count, max_tiles);   
+    return std::min(tile_count, max_tiles);
+}
 
+// first pass of a reduction; leaves one partial result per tile in global_buffer
+template <unsigned int tile_size, typename elm_type, typename x_type, typename functor>
+void reduce_tiles(const concurrency::accelerator_view& av, int n, const x_type& X, const functor& reduce_helper, const concurrency::array_view<elm_type,1>& global_buffer)
+{
     // simultaneous live threads
-    const unsigned int thread_count = tile_count * tile_size;
+    const unsigned int thread_count = global_buffer.extent[0] * tile_size;
 
-    // global buffer (return type)
-    concurrency::array<elm_type,1> global_buffer(tile_count);
+    // global buffer (return type); every element is written below
     concurrency::array_view<elm_type,1> global_buffer_view(global_buffer);
+    global_buffer_view.discard_data();
 
     // configuration
     concurrency::extent<1> extent(thread_count);
@@ -105,10 +142,44 @@ ret_type reduce(const concurrency::accelerator_view& av, int n, const x_type& X,
             global_buffer_view[ tid.tile[0] ] = smem;
         }
     });
+}
+
+// Generic reduction of an 1D container with the reduction operation specified by a helper functor.
+// The partial results and their host copy live in a block of the accelerator_view's workspace.
+template <unsigned int tile_size, unsigned int max_tiles, typename ret_type, typename elm_type, typename x_type, typename functor>
+ret_type reduce(const concurrency::accelerator_view& av, int n, const x_type& X, const functor& reduce_helper)
+{
+    const unsigned int tile_count = reduce_tile_count<tile_size,max_tiles>(n);
+
+    workspace_lease workspace = acquire_workspace(av, tile_count * sizeof(elm_type));
+    concurrency::array_view<elm_type,1> global_buffer = workspace->template view<elm_type>(tile_count);
+    reduce_tiles<tile_size>(av, n, X, reduce_helper, global_buffer);
 
     // 2nd pass reduction
-    std::vector<elm_type> host_buffer(global_buffer);
-    return reduce_helper.global_reduce(host_buffer);
+    elm_type* host_buffer = workspace->template host_data<elm_type>();
+    concurrency::copy(global_buffer, host_buffer);
+    return reduce_helper.global_reduce(host_buffer, host_buffer + tile_count);
+}
+
+// Asynchronous form of reduce; the partial results are copied back without blocking and the
+// 2nd pass runs as a continuation, so the returned task completes once the result is known
+template <unsigned int tile_size, unsigned int max_tiles, typename ret_type, typename elm_type, typename x_type, typename functor>
+concurrency::task<ret_type> reduce_async(const concurrency::accelerator_view& av, int n, const x_type& X, const functor& reduce_helper)
+{
+    const unsigned int tile_count = reduce_tile_count<tile_size,max_tiles>(n);
+
+    // the continuation holds the workspace until the 2nd pass is done
+    workspace_lease workspace = acquire_workspace(av, tile_count * sizeof(elm_type));
+    concurrency::array_view<elm_type,1> global_buffer = workspace->template view<elm_type>(tile_count);
+    reduce_tiles<tile_size>(av, n, X, reduce_helper, global_buffer);
+
+    elm_type* host_buffer = workspace->template host_data<elm_type>();
+    concurrency::completion_future copied = concurrency::copy_async(global_buffer, host_buffer);
+
+    return copied.to_task().then([workspace, host_buffer, tile_count, reduce_helper] () -> ret_type
+    {
+        return reduce_helper.global_reduce(host_buffer, host_buffer + tile_count);
+    });
 }
 
 DETAIL_NAMESPACE_END
@@ -0,0 +1,355 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * workspace.h
+ *
+ * Pooled scratch memory for kernel temporaries. Every accelerator_view gets
+ * an arena of power-of-two size classes from which reductions and routines
+ * needing a temporary draw their blocks, so steady-state calls do not
+ * allocate accelerator memory.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPBLAS_UTILITY_WORKSPACE_H
+#define AMPBLAS_UTILITY_WORKSPACE_H
+
+#include <climits>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <ppl.h>
+
+#include "ampblas_config.h"
+
+AMPBLAS_NAMESPACE_BEGIN
+
+//
+// workspace_stats
+//   Counters of the scratch pool of one accelerator_view. Byte counts refer to accelerator
+//   memory after rounding up to the size class of each block.
+//
+struct workspace_stats
+{
+    size_t requests;        // blocks handed out
+    size_t allocations;     // requests that could not be served from the pool
+    size_t bytes_in_use;    // held by outstanding blocks
+    size_t bytes_cached;    // idle blocks kept for reuse
+    size_t peak_bytes;      // high-water mark of bytes_in_use + bytes_cached
+};
+
+DETAIL_NAMESPACE_BEGIN
+
+// smallest pooled block and number of size classes; larger requests are allocated exactly
+// and freed as soon as they are returned
+static const size_t workspace_min_block = 256;
+static const unsigned int workspace_size_classes = 23;
+
+// idle bytes an arena keeps by default
+static const size_t workspace_default_limit = size_t(64) << 20;
+
+//
+// workspace_block
+//   Untyped accelerator storage, viewed as whatever element type the kernel needs. A host
+//   buffer of the same capacity is created on first use for reading results back.
+//
+class workspace_block
+{
+public:
+    workspace_block(const concurrency::accelerator_view& av, size_t bytes, unsigned int size_class)
+        : device(static_cast<int>(bytes / sizeof(unsigned int)), av), bytes(bytes), size_class(size_class)
+    {
+    }
+
+    // the first count elements of the block
+    template <typename value_type>
+    concurrency::array_view<value_type,1> view(int count)
+    {
+        static_assert(sizeof(value_type) % sizeof(unsigned int) == 0, "workspace elements must be a multiple of 4 bytes");
+        return concurrency::array_view<unsigned int,1>(device).reinterpret_as<value_type>().section(0, count);
+    }
+
+    // the first rows*cols elements of the block as a dense 2D view
+    template <typename value_type>
+    concurrency::array_view<value_type,2> view(int rows, int cols)
+    {
+        return view<value_type>(rows * cols).view_as(concurrency::extent<2>(rows, cols));
+    }
+
+    template <typename value_type>
+    value_type* host_data()
+    {
+        if (host.empty())
+            host.resize(bytes / sizeof(unsigned long long));
+        return reinterpret_cast<value_type*>(host.data());
+    }
+
+    size_t size() const
+    {
+        return bytes;
+    }
+
+private:
+    friend class workspace_arena;
+
+    // not copyable
+    workspace_block(const workspace_block&);
+    workspace_block& operator=(const workspace_block&);
+
+    concurrency::array<unsigned int,1> device;
+    std::vector<unsigned long long> host;
+    size_t bytes;
+    unsigned int size_class;
+};
+
+typedef std::shared_ptr<workspace_block> workspace_lease;
+
+//
+// workspace_arena
+//   Scratch pool of a single accelerator_view. Blocks go back to the pool when their lease is
+//   released unless the idle bytes would exceed the arena's limit.
+//
+class workspace_arena : public std::enable_shared_from_this<workspace_arena>
+{
+public:
+    workspace_arena(const concurrency::accelerator_view& av, size_t limit)
+        : av(av), limit(limit)
+    {
+        stats.requests = 0;
+        stats.allocations = 0;
+        stats.bytes_in_use = 0;
+        stats.bytes_cached = 0;
+        stats.peak_bytes = 0;
+    }
+
+    ~workspace_arena()
+    {
+        trim();
+    }
+
+    workspace_lease acquire(size_t bytes)
+    {
+        unsigned int size_class = 0;
+        while (size_class < workspace_size_classes && (workspace_min_block << size_class) < bytes)
+            size_class++;
+
+        // the host buffer is allocated in 8 byte words
+        const size_t block_bytes = size_class < workspace_size_classes ? workspace_min_block << size_class : (bytes + 7) & ~size_t(7);
+        if (block_bytes / sizeof(unsigned int) > size_t(INT_MAX))
+            throw std::bad_alloc();
+
+        workspace_block* block = nullptr;
+        {
+            concurrency::critical_section::scoped_lock lock(cs);
+
+            stats.requests++;
+            if (size_class < workspace_size_classes && !free_blocks[size_class].empty())
+            {
+                block = free_blocks[size_class].back();
+                free_blocks[size_class].pop_back();
+                stats.bytes_cached -= block_bytes;
+            }
+            else
+            {
+                stats.allocations++;
+            }
+
+            stats.bytes_in_use += block_bytes;
+            stats.peak_bytes = std::max(stats.peak_bytes, stats.bytes_in_use + stats.bytes_cached);
+        }
+
+        if (block == nullptr)
+        {
+            try
+            {
+                block = allocate(block_bytes, size_class);
+            }
+            catch (...)
+            {
+                concurrency::critical_section::scoped_lock lock(cs);
+                stats.bytes_in_use -= block_bytes;
+                throw;
+            }
+        }
+
+        std::shared_ptr<workspace_arena> self = shared_from_this();
+        return workspace_lease(block, [self] (workspace_block* returned) { self->release(returned); });
+    }
+
+    workspace_stats get_stats() const
+    {
+        concurrency::critical_section::scoped_lock lock(cs);
+        return stats;
+    }
+
+    // changes the idle byte limit, freeing cached blocks above it
+    void set_limit(size_t bytes)
+    {
+        std::vector<workspace_block*> freed;
+        {
+            concurrency::critical_section::scoped_lock lock(cs);
+
+            limit = bytes;
+            for (unsigned int c = workspace_size_classes; c-- > 0 && stats.bytes_cached > limit; )
+            {
+                while (!free_blocks[c].empty() && stats.bytes_cached > limit)
+                {
+                    freed.push_back(free_blocks[c].back());
+                    free_blocks[c].pop_back();
+                    stats.bytes_cached -= freed.back()->size();
+                }
+            }
+        }
+
+        for (auto it = freed.begin(); it != freed.end(); ++it)
+            delete *it;
+    }
+
+    // frees every idle block
+    void trim()
+    {
+        std::vector<workspace_block*> freed;
+        {
+            concurrency::critical_section::scoped_lock lock(cs);
+
+            for (unsigned int c = 0; c < workspace_size_classes; c++)
+            {
+                freed.insert(freed.end(), free_blocks[c].begin(), free_blocks[c].end());
+                free_blocks[c].clear();
+            }
+            stats.bytes_cached = 0;
+        }
+
+        for (auto it = freed.begin(); it != freed.end(); ++it)
+            delete *it;
+    }
+
+private:
+    // not copyable
+    workspace_arena(const workspace_arena&);
+    workspace_arena& operator=(const workspace_arena&);
+
+    // a failed allocation is retried once after the idle blocks are given back
+    workspace_block* allocate(size_t bytes, unsigned int size_class)
+    {
+        try
+        {
+            return new workspace_block(av, bytes, size_class);
+        }
+        catch (concurrency::out_of_memory&)
+        {
+            trim();
+        }
+
+        return new workspace_block(av, bytes, size_class);
+    }
+
+    void release(workspace_block* block)
+    {
+        bool cached = false;
+        {
+            concurrency::critical_section::scoped_lock lock(cs);
+
+            stats.bytes_in_use -= block->size();
+            if (block->size_class < workspace_size_classes && stats.bytes_cached + block->size() <= limit)
+            {
+                free_blocks[block->size_class].push_back(block);
+                stats.bytes_cached += block->size();
+                cached = true;
+            }
+        }
+
+        if (!cached)
+            delete block;
+    }
+
+    concurrency::accelerator_view av;
+    mutable concurrency::critical_section cs;
+    std::vector<workspace_block*> free_blocks[workspace_size_classes];
+    workspace_stats stats;
+    size_t limit;
+};
+
+// Arenas are created on the first request for an accelerator_view and live for the rest of
+// the process. The template parameter only exists to allow the static members to be defined
+// in a header.
+template <int unused = 0>
+class workspace_registry
+{
+public:
+    static std::shared_ptr<workspace_arena> get(const concurrency::accelerator_view& av)
+    {
+        concurrency::critical_section::scoped_lock lock(cs);
+
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (it->first == av)
+                return it->second;
+        }
+
+        std::shared_ptr<workspace_arena> arena = std::make_shared<workspace_arena>(av, limit);
+        entries.push_back(std::make_pair(av, arena));
+        return arena;
+    }
+
+    static void set_limit(size_t bytes)
+    {
+        concurrency::critical_section::scoped_lock lock(cs);
+
+        limit = bytes;
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+            it->second->set_limit(bytes);
+    }
+
+private:
+    static concurrency::critical_section cs;
+    static std::vector<std::pair<concurrency::accelerator_view, std::shared_ptr<workspace_arena>>> entries;
+    static size_t limit;
+};
+
+template <int unused> concurrency::critical_section workspace_registry<unused>::cs;
+template <int unused> std::vector<std::pair<concurrency::accelerator_view, std::shared_ptr<workspace_arena>>> workspace_registry<unused>::entries;
+template <int unused> size_t workspace_registry<unused>::limit = workspace_default_limit;
+
+// scratch block of at least bytes on av, returned to the pool when the last copy of the lease goes away
+inline workspace_lease acquire_workspace(const concurrency::accelerator_view& av, size_t bytes)
+{
+    return workspace_registry<>::get(av)->acquire(bytes);
+}
+
+DETAIL_NAMESPACE_END
+
+// counters of the scratch pool of av
+inline workspace_stats get_workspace_stats(const concurrency::accelerator_view& av)
+{
+    return _detail::workspace_registry<>::get(av)->get_stats();
+}
+
+// idle scratch bytes each accelerator_view may keep (64 MB by default); applies to existing pools immediately
+inline void set_workspace_limit(size_t bytes)
+{
+    _detail::workspace_registry<>::set_limit(bytes);
+}
+
+// frees the idle scratch blocks of av; blocks in use are unaffected
+inline void release_workspace(const concurrency::accelerator_view& av)
+{
+    _detail::workspace_registry<>::get(av)->trim();
+}
+
+AMPBLAS_NAMESPACE_END
+
+#endif // AMPBLAS_UTILITY_WORKSPACE_H
@@ -545,6 +545,32 @@ AMPBLAS_DLL void ampblas_ztrsm(const enum AMPBLAS_ORDER Order, const enum AMPBLA
                                const ampblas_dcomplex *alpha, const ampblas_dcomplex *A, const int lda,
                                ampblas_dcomplex *B, const int ldb);
 
+// 
+// GEMM on operands larger than accelerator memory. Panels are streamed through at most
+// budget bytes of accelerator memory (0 selects a default). The operands may be any host
+// memory; bound operands are synchronized first, and a bound C is refreshed afterwards.
+//
+AMPBLAS_DLL void ampblas_sgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA,
+                                           const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N,
+                                           const int K, const float alpha, const float *A,
+                                           const int lda, const float *B, const int ldb,
+                                           const float beta, float *C, const int ldc, const size_t budget);
+AMPBLAS_DLL void ampblas_dgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA,
+                                           const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N,
+                                           const int K, const double alpha, const double *A,
+                                           const int lda, const double *B, const int ldb,
+                                           const double beta, double *C, const int ldc, const size_t budget);
+AMPBLAS_DLL void ampblas_cgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA,
+                                           const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N,
+                                           const int K, const ampblas_fcomplex *alpha, const ampblas_fcomplex *A,
+                                           const int lda, const ampblas_fcomplex *B, const int ldb,
+                                           const ampblas_fcomplex *beta, ampblas_fcomplex *C, const int ldc, const size_t budget);
+AMPBLAS_DLL void ampblas_zgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA,
+                                           const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N,
+                                           const int K, const ampblas_dcomplex *alpha, const ampblas_dcomplex *A,
+                                           const int lda, const ampblas_dcomplex *B, const int ldb,
+                                           const ampblas_dcomplex *beta, ampblas_dcomplex *C, const int ldc, const size_t budget);
+
 
 // 
 // Routines with prefixes C and Z only
@@ -578,6 +604,119 @@ AMPBLAS_DLL void ampblas_zher2k(const enum AMPBLAS_ORDER Order, const enum AMPBL
                                 const ampblas_dcomplex *alpha, const ampblas_dcomplex *A, const int lda,
                                 const ampblas_dcomplex *B, const int ldb, const double beta,
                                 ampblas_dcomplex *C, const int ldc);
+
+//----------------------------------------------------------------------------
+// ILP64 interface
+//
+// Level 1 and 2 routines with 64-bit sizes, increments and indices, for operands
+// of 2^31 elements or more. Bound buffers of 8 GB or more are viewed in segments,
+// and each routine is run as int sized calls that stay within one segment of every
+// operand. In gemv and ger the columns are split between calls, so M and lda must
+// still fit in an int.
+//----------------------------------------------------------------------------
+
+AMPBLAS_DLL double ampblas_dsdot_64(const ampblas_int64 N, const float *X, const ampblas_int64 incX,
+                                    const float *Y, const ampblas_int64 incY);
+AMPBLAS_DLL float  ampblas_sdot_64(const ampblas_int64 N, const float  *X, const ampblas_int64 incX,
+                                   const float  *Y, const ampblas_int64 incY);
+AMPBLAS_DLL double ampblas_ddot_64(const ampblas_int64 N, const double *X, const ampblas_int64 incX,
+                                   const double *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void   ampblas_cdotu_sub_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX,
+                                        const ampblas_fcomplex *Y, const ampblas_int64 incY, ampblas_fcomplex *dotu);
+AMPBLAS_DLL void   ampblas_cdotc_sub_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX,
+                                        const ampblas_fcomplex *Y, const ampblas_int64 incY, ampblas_fcomplex *dotc);
+AMPBLAS_DLL void   ampblas_zdotu_sub_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX,
+                                        const ampblas_dcomplex *Y, const ampblas_int64 incY, ampblas_dcomplex *dotu);
+AMPBLAS_DLL void   ampblas_zdotc_sub_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX,
+                                        const ampblas_dcomplex *Y, const ampblas_int64 incY, ampblas_dcomplex *dotc);
+
+AMPBLAS_DLL float  ampblas_snrm2_64(const ampblas_int64 N, const float *X, const ampblas_int64 incX);
+AMPBLAS_DLL double ampblas_dnrm2_64(const ampblas_int64 N, const double *X, const ampblas_int64 incX);
+
+AMPBLAS_DLL float  ampblas_sasum_64(const ampblas_int64 N, const float *X, const ampblas_int64 incX);
+AMPBLAS_DLL double ampblas_dasum_64(const ampblas_int64 N, const double *X, const ampblas_int64 incX);
+AMPBLAS_DLL float  ampblas_scasum_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX);
+AMPBLAS_DLL double ampblas_dzasum_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX);
+
+AMPBLAS_DLL ampblas_int64 ampblas_isamax_64(const ampblas_int64 N, const float  *X, const ampblas_int64 incX);
+AMPBLAS_DLL ampblas_int64 ampblas_idamax_64(const ampblas_int64 N, const double *X, const ampblas_int64 incX);
+AMPBLAS_DLL ampblas_int64 ampblas_icamax_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX);
+AMPBLAS_DLL ampblas_int64 ampblas_izamax_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX);
+
+AMPBLAS_DLL void ampblas_sswap_64(const ampblas_int64 N, float *X, const ampblas_int64 incX,
+                                  float *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_dswap_64(const ampblas_int64 N, double *X, const ampblas_int64 incX,
+                                  double *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_cswap_64(const ampblas_int64 N, ampblas_fcomplex *X, const ampblas_int64 incX,
+                                  ampblas_fcomplex *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_zswap_64(const ampblas_int64 N, ampblas_dcomplex *X, const ampblas_int64 incX,
+                                  ampblas_dcomplex *Y, const ampblas_int64 incY);
+
+AMPBLAS_DLL void ampblas_scopy_64(const ampblas_int64 N, const float *X, const ampblas_int64 incX,
+                                  float *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_dcopy_64(const ampblas_int64 N, const double *X, const ampblas_int64 incX,
+                                  double *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_ccopy_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX,
+                                  ampblas_fcomplex *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_zcopy_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX,
+                                  ampblas_dcomplex *Y, const ampblas_int64 incY);
+
+AMPBLAS_DLL void ampblas_saxpy_64(const ampblas_int64 N, const float alpha, const float *X,
+                                  const ampblas_int64 incX, float *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_daxpy_64(const ampblas_int64 N, const double alpha, const double *X,
+                                  const ampblas_int64 incX, double *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_caxpy_64(const ampblas_int64 N, const ampblas_fcomplex *alpha, const ampblas_fcomplex *X,
+                                  const ampblas_int64 incX, ampblas_fcomplex *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_zaxpy_64(const ampblas_int64 N, const ampblas_dcomplex *alpha, const ampblas_dcomplex *X,
+                                  const ampblas_int64 incX, ampblas_dcomplex *Y, const ampblas_int64 incY);
+
+AMPBLAS_DLL void ampblas_srot_64(const ampblas_int64 N, float *X, const ampblas_int64 incX,
+                                 float *Y, const ampblas_int64 incY, const float c, const float s);
+AMPBLAS_DLL void ampblas_drot_64(const ampblas_int64 N, double *X, const ampblas_int64 incX,
+                                 double *Y, const ampblas_int64 incY, const double c, const double s);
+
+AMPBLAS_DLL void ampblas_sscal_64(const ampblas_int64 N, const float alpha, float *X, const ampblas_int64 incX);
+AMPBLAS_DLL void ampblas_dscal_64(const ampblas_int64 N, const double alpha, double *X, const ampblas_int64 incX);
+AMPBLAS_DLL void ampblas_cscal_64(const ampblas_int64 N, const ampblas_fcomplex *alpha, ampblas_fcomplex *X, const ampblas_int64 incX);
+AMPBLAS_DLL void ampblas_zscal_64(const ampblas_int64 N, const ampblas_dcomplex *alpha, ampblas_dcomplex *X, const ampblas_int64 incX);
+AMPBLAS_DLL void ampblas_csscal_64(const ampblas_int64 N, const float alpha, ampblas_fcomplex *X, const ampblas_int64 incX);
+AMPBLAS_DLL void ampblas_zdscal_64(const ampblas_int64 N, const double alpha, ampblas_dcomplex *X, const ampblas_int64 incX);
+
+AMPBLAS_DLL void ampblas_sgemv_64(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE TransA,
+                                  const ampblas_int64 M, const ampblas_int64 N, const float alpha,
+                                  const float *A, const ampblas_int64 lda, const float *X, const ampblas_int64 incX,
+                                  const float beta, float *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_dgemv_64(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE TransA,
+                                  const ampblas_int64 M, const ampblas_int64 N, const double alpha,
+                                  const double *A, const ampblas_int64 lda, const double *X, const ampblas_int64 incX,
+                                  const double beta, double *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_cgemv_64(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE TransA,
+                                  const ampblas_int64 M, const ampblas_int64 N, const ampblas_fcomplex *alpha,
+                                  const ampblas_fcomplex *A, const ampblas_int64 lda, const ampblas_fcomplex *X, const ampblas_int64 incX,
+                                  const ampblas_fcomplex *beta, ampblas_fcomplex *Y, const ampblas_int64 incY);
+AMPBLAS_DLL void ampblas_zgemv_64(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE TransA,
+                                  const ampblas_int64 M, const ampblas_int64 N, const ampblas_dcomplex *alpha,
+                                  const ampblas_dcomplex *A, const ampblas_int64 lda, const ampblas_dcomplex *X, const ampblas_int64 incX,
+                                  const ampblas_dcomplex *beta, ampblas_dcomplex *Y, const ampblas_int64 incY);
+
+AMPBLAS_DLL void ampblas_sger_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N,
+                                 const float alpha, const float *X, const ampblas_int64 incX,
+                                 const float *Y, const ampblas_int64 incY, float *A, const ampblas_int64 lda);
+AMPBLAS_DLL void ampblas_dger_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N,
+                                 const double alpha, const double *X, const ampblas_int64 incX,
+                                 const double *Y, const ampblas_int64 incY, double *A, const ampblas_int64 lda);
+AMPBLAS_DLL void ampblas_cgeru_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N,
+                                  const ampblas_fcomplex *alpha, const ampblas_fcomplex *X, const ampblas_int64 incX,
+                                  const ampblas_fcomplex *Y, const ampblas_int64 incY, ampblas_fcomplex *A, const ampblas_int64 lda);
+AMPBLAS_DLL void ampblas_cgerc_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N,
+                                  const ampblas_fcomplex *alpha, const ampblas_fcomplex *X, const ampblas_int64 incX,
+                                  const ampblas_fcomplex *Y, const ampblas_int64 incY, ampblas_fcomplex *A, const ampblas_int64 lda);
+AMPBLAS_DLL void ampblas_zgeru_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N,
+                                  const ampblas_dcomplex *alpha, const ampblas_dcomplex *X, const ampblas_int64 incX,
+                                  const ampblas_dcomplex *Y, const ampblas_int64 incY, ampblas_dcomplex *A, const ampblas_int64 lda);
+AMPBLAS_DLL void ampblas_zgerc_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N,
+                                  const ampblas_dcomplex *alpha, const ampblas_dcomplex *X, const ampblas_int64 incX,
+                                  const ampblas_dcomplex *Y, const ampblas_int64 incY, ampblas_dcomplex *A, const ampblas_int64 lda);
 #ifdef __cplusplus
 }
 #endif
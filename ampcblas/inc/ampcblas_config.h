@@ -21,6 +21,10 @@
 #ifndef AMPCBLAS_CONFIG_H
 #define AMPCBLAS_CONFIG_H
 
+#include <algorithm>
+#include <climits>
+#include <type_traits>
+
 // interface with ampblas complex types and options
 #include "ampblas_complex.h"
 #include "ampblas_defs.h"
@@ -151,6 +155,313 @@ inline void feature_not_implemented()
     throw feature_not_implemented_exception();
 }
 
+//---------------------------------------------------------------------------- 
+// Large index support
+//
+// The ILP64 routines take 64-bit sizes but the kernels index with int extents
+// and a view cannot span two segments of a bound buffer, so each routine runs
+// as a sequence of int sized calls over chunks that fit every operand.
+//----------------------------------------------------------------------------
+
+// checks that a 64-bit argument which is passed through unchanged fits an int
+inline int int_arg(const std::string& name, int index, ampblas_int64 value)
+{
+    if (value > INT_MAX || value < -INT_MAX)
+        argument_error(name, index);
+
+    return static_cast<int>(value);
+}
+
+// n blocks of |inc| elements starting at base, visited in reverse when inc is 
+// negative: the elements of a vector, or the columns of a matrix with inc = lda.
+// An int sized call views count blocks as count * |inc| elements, as in 
+// make_vector_view and make_matrix_view.
+template <typename value_type>
+class strided_blocks
+{
+public:
+    strided_blocks(ampblas_int64 n, value_type *base, int inc)
+        : n(n), base(base), stride(std::abs(inc)), reverse(inc < 0)
+    {
+    }
+
+    // number of blocks from the i-th that a single view can hold; this is at 
+    // least 1, see inc
+    ampblas_int64 fit(ampblas_int64 i) const
+    {
+        const void *begin;
+        const void *end;
+        _details::get_segment(block(i), begin, end);
+
+        const char *first = reinterpret_cast<const char*>(block(i));
+        const ampblas_int64 block_bytes = stride * sizeof(value_type);
+        if (reverse && first + block_bytes > end)
+            return 1;
+
+        const ampblas_int64 bytes = reverse ? first + block_bytes - static_cast<const char*>(begin)
+                                            : static_cast<const char*>(end) - first;
+
+        const ampblas_int64 count = std::min(bytes / block_bytes, ampblas_int64(INT_MAX / stride));
+        return std::max(ampblas_int64(1), std::min(count, n - i));
+    }
+
+    // number of elements from the start of the i-th block to the end of its segment
+    ampblas_int64 head(ampblas_int64 i) const
+    {
+        const void *begin;
+        const void *end;
+        _details::get_segment(block(i), begin, end);
+
+        return (static_cast<const char*>(end) - reinterpret_cast<const char*>(block(i))) / ampblas_int64(sizeof(value_type));
+    }
+
+    // first element of the i-th block
+    value_type *block(ampblas_int64 i) const
+    {
+        return base + (reverse ? n - 1 - i : i) * stride;
+    }
+
+    // lowest address of the count blocks from the i-th
+    value_type *at(ampblas_int64 i, ampblas_int64 count) const
+    {
+        return base + (reverse ? n - i - count : i) * stride;
+    }
+
+    // increment for a call over count blocks; a single element is viewed on its 
+    // own, so one that ends a segment is never viewed together with the next
+    int inc(ampblas_int64 count) const
+    {
+        return count == 1 ? 1 : static_cast<int>(reverse ? -stride : stride);
+    }
+
+private:
+    strided_blocks& operator=(const strided_blocks&);
+
+    const ampblas_int64 n;
+    value_type *const base;
+    const ampblas_int64 stride;
+    const bool reverse;
+};
+
+//---------------------------------------------------------------------------- 
+// Host dispatch
+//
+// Routines with host kernels describe the operands of a call to
+// _details::dispatch_to_host, which decides where it runs. The host kernels
+// cover the real types, and a routine selects its host path by tag dispatch
+// on has_host_kernels so the complex instantiations never reference them.
+//----------------------------------------------------------------------------
+
+template <typename value_type>
+struct has_host_kernels : std::false_type {};
+
+template <>
+struct has_host_kernels<float> : std::true_type {};
+
+template <>
+struct has_host_kernels<double> : std::true_type {};
+
+// count contiguous elements at ptr
+template <typename value_type>
+inline _details::dispatch_operand host_operand(const value_type *ptr, size_t count, bool written)
+{
+    _details::dispatch_operand operand = { ptr, count * sizeof(value_type), written };
+    return operand;
+}
+
+// a rows x cols column major matrix with leading dimension ld
+template <typename value_type>
+inline _details::dispatch_operand host_operand(const value_type *ptr, int rows, int cols, int ld, bool written)
+{
+    return host_operand(ptr, (cols == 0 ? 0 : size_t(ld) * (cols-1) + rows), written);
+}
+
+template <typename value_type, size_t count>
+inline bool dispatch_to_host(double flops, const _details::dispatch_operand (&operands)[count])
+{
+    return _details::dispatch_to_host(flops, sizeof(value_type), operands, static_cast<int>(count));
+}
+
+template <size_t count>
+inline void complete_on_host(const _details::dispatch_operand (&operands)[count])
+{
+    _details::complete_on_host(operands, static_cast<int>(count));
+}
+
+//---------------------------------------------------------------------------- 
+// Call trace and statistics
+//
+// Every C entry point describes its call with a call_shape and holds a 
+// call_trace while it runs. The call_trace counts the call in the statistics
+// of its thread (see ampblas_get_stats). When a trace is being recorded (see 
+// set_trace_file) the call is also timed until its kernels complete and 
+// appended to the trace.
+//----------------------------------------------------------------------------
+
+// routine(name, type) for every traced entry point; type is the letter of the 
+// precision of the routine's vector or matrix operands
+#define AMPCBLAS_TRACED_ROUTINES(routine) \
+    routine(isamax, s) routine(idamax, d) routine(icamax, c) routine(izamax, z) \
+    routine(isamax_64, s) routine(idamax_64, d) routine(icamax_64, c) routine(izamax_64, z) \
+    routine(sasum, s) routine(dasum, d) routine(scasum, c) routine(dzasum, z) \
+    routine(sasum_64, s) routine(dasum_64, d) routine(scasum_64, c) routine(dzasum_64, z) \
+    routine(saxpy, s) routine(daxpy, d) routine(caxpy, c) routine(zaxpy, z) \
+    routine(saxpy_64, s) routine(daxpy_64, d) routine(caxpy_64, c) routine(zaxpy_64, z) \
+    routine(scopy, s) routine(dcopy, d) routine(ccopy, c) routine(zcopy, z) \
+    routine(scopy_64, s) routine(dcopy_64, d) routine(ccopy_64, c) routine(zcopy_64, z) \
+    routine(dsdot, s) routine(sdot, s) routine(ddot, d) \
+    routine(cdotu_sub, c) routine(cdotc_sub, c) routine(zdotu_sub, z) routine(zdotc_sub, z) \
+    routine(dsdot_64, s) routine(sdot_64, s) routine(ddot_64, d) \
+    routine(cdotu_sub_64, c) routine(cdotc_sub_64, c) routine(zdotu_sub_64, z) routine(zdotc_sub_64, z) \
+    routine(snrm2, s) routine(dnrm2, d) routine(snrm2_64, s) routine(dnrm2_64, d) \
+    routine(srot, s) routine(drot, d) routine(srot_64, s) routine(drot_64, d) \
+    routine(sscal, s) routine(dscal, d) routine(cscal, c) routine(zscal, z) routine(csscal, c) routine(zdscal, z) \
+    routine(sscal_64, s) routine(dscal_64, d) routine(cscal_64, c) routine(zscal_64, z) routine(csscal_64, c) routine(zdscal_64, z) \
+    routine(sswap, s) routine(dswap, d) routine(cswap, c) routine(zswap, z) \
+    routine(sswap_64, s) routine(dswap_64, d) routine(cswap_64, c) routine(zswap_64, z) \
+    routine(sgemv, s) routine(dgemv, d) routine(cgemv, c) routine(zgemv, z) \
+    routine(sgemv_64, s) routine(dgemv_64, d) routine(cgemv_64, c) routine(zgemv_64, z) \
+    routine(sger, s) routine(dger, d) routine(cgeru, c) routine(zgeru, z) routine(cgerc, c) routine(zgerc, z) \
+    routine(sger_64, s) routine(dger_64, d) routine(cgeru_64, c) routine(zgeru_64, z) routine(cgerc_64, c) routine(zgerc_64, z) \
+    routine(ssymv, s) routine(dsymv, d) routine(chemv, c) routine(zhemv, z) \
+    routine(ssyr, s) routine(dsyr, d) routine(cher, c) routine(zher, z) \
+    routine(strmv, s) routine(dtrmv, d) routine(ctrmv, c) routine(ztrmv, z) \
+    routine(strsv, s) routine(dtrsv, d) routine(ctrsv, c) routine(ztrsv, z) \
+    routine(sgemm, s) routine(dgemm, d) routine(cgemm, c) routine(zgemm, z) \
+    routine(sgemm_out_of_core, s) routine(dgemm_out_of_core, d) routine(cgemm_out_of_core, c) routine(zgemm_out_of_core, z) \
+    routine(ssyrk, s) routine(dsyrk, d) routine(csyrk, c) routine(zsyrk, z) routine(cherk, c) routine(zherk, z) \
+    routine(ssyr2k, s) routine(dsyr2k, d) routine(csyr2k, c) routine(zsyr2k, z) routine(cher2k, c) routine(zher2k, z) \
+    routine(strmm, s) routine(dtrmm, d) routine(ctrmm, c) routine(ztrmm, z) \
+    routine(strsm, s) routine(dtrsm, d) routine(ctrsm, c) routine(ztrsm, z)
+
+#define AMPCBLAS_ROUTINE_ID(name, type) routine_##name,
+
+enum routine_id
+{
+    AMPCBLAS_TRACED_ROUTINES(AMPCBLAS_ROUTINE_ID)
+    routine_count
+};
+
+#undef AMPCBLAS_ROUTINE_ID
+
+// The arguments of a call that decide its cost. Options are the letters of the
+// Fortran interface and 'R' or 'C' for the order, with '-' for options the 
+// routine does not take; sizes and increments it does not take are 0.
+struct call_shape
+{
+    routine_id routine;
+    char order, trans_a, trans_b, uplo, side, diag;
+    ampblas_int64 m, n, k;
+    ampblas_int64 lda, ldb, ldc;
+    ampblas_int64 incx, incy;
+};
+
+inline char option(enum AMPBLAS_ORDER order)
+{
+    return order == AmpblasRowMajor ? 'R' : 'C';
+}
+
+inline char option(enum AMPBLAS_TRANSPOSE trans)
+{
+    return trans == AmpblasNoTrans ? 'N' : trans == AmpblasTrans ? 'T' : 'C';
+}
+
+inline char option(enum AMPBLAS_UPLO uplo)
+{
+    return uplo == AmpblasUpper ? 'U' : 'L';
+}
+
+inline char option(enum AMPBLAS_SIDE side)
+{
+    return side == AmpblasLeft ? 'L' : 'R';
+}
+
+inline char option(enum AMPBLAS_DIAG diag)
+{
+    return diag == AmpblasUnit ? 'U' : 'N';
+}
+
+// level 1 routines; incy is 0 for routines of one vector
+inline call_shape vector_call(routine_id routine, ampblas_int64 n, ampblas_int64 incx, ampblas_int64 incy = 0)
+{
+    call_shape shape = { routine, '-', '-', '-', '-', '-', '-', 0, n, 0, 0, 0, 0, incx, incy };
+    return shape;
+}
+
+inline call_shape gemv_call(routine_id routine, enum AMPBLAS_ORDER order, enum AMPBLAS_TRANSPOSE trans, ampblas_int64 m, ampblas_int64 n, ampblas_int64 lda, ampblas_int64 incx, ampblas_int64 incy)
+{
+    call_shape shape = { routine, option(order), option(trans), '-', '-', '-', '-', m, n, 0, lda, 0, 0, incx, incy };
+    return shape;
+}
+
+inline call_shape ger_call(routine_id routine, enum AMPBLAS_ORDER order, ampblas_int64 m, ampblas_int64 n, ampblas_int64 incx, ampblas_int64 incy, ampblas_int64 lda)
+{
+    call_shape shape = { routine, option(order), '-', '-', '-', '-', '-', m, n, 0, lda, 0, 0, incx, incy };
+    return shape;
+}
+
+// symv, hemv and the rank 1 updates syr and her, for which incy is 0
+inline call_shape symv_call(routine_id routine, enum AMPBLAS_ORDER order, enum AMPBLAS_UPLO uplo, ampblas_int64 n, ampblas_int64 lda, ampblas_int64 incx, ampblas_int64 incy)
+{
+    call_shape shape = { routine, option(order), '-', '-', option(uplo), '-', '-', 0, n, 0, lda, 0, 0, incx, incy };
+    return shape;
+}
+
+// trmv and trsv
+inline call_shape trmv_call(routine_id routine, enum AMPBLAS_ORDER order, enum AMPBLAS_UPLO uplo, enum AMPBLAS_TRANSPOSE trans, enum AMPBLAS_DIAG diag, ampblas_int64 n, ampblas_int64 lda, ampblas_int64 incx)
+{
+    call_shape shape = { routine, option(order), option(trans), '-', option(uplo), '-', option(diag), 0, n, 0, lda, 0, 0, incx, 0 };
+    return shape;
+}
+
+inline call_shape gemm_call(routine_id routine, enum AMPBLAS_ORDER order, enum AMPBLAS_TRANSPOSE transa, enum AMPBLAS_TRANSPOSE transb, ampblas_int64 m, ampblas_int64 n, ampblas_int64 k, ampblas_int64 lda, ampblas_int64 ldb, ampblas_int64 ldc)
+{
+    call_shape shape = { routine, option(order), option(transa), option(transb), '-', '-', '-', m, n, k, lda, ldb, ldc, 0, 0 };
+    return shape;
+}
+
+// syrk, herk, syr2k and her2k; ldb is 0 for the rank k updates
+inline call_shape syrk_call(routine_id routine, enum AMPBLAS_ORDER order, enum AMPBLAS_UPLO uplo, enum AMPBLAS_TRANSPOSE trans, ampblas_int64 n, ampblas_int64 k, ampblas_int64 lda, ampblas_int64 ldb, ampblas_int64 ldc)
+{
+    call_shape shape = { routine, option(order), option(trans), '-', option(uplo), '-', '-', 0, n, k, lda, ldb, ldc, 0, 0 };
+    return shape;
+}
+
+// trmm and trsm
+inline call_shape trmm_call(routine_id routine, enum AMPBLAS_ORDER order, enum AMPBLAS_SIDE side, enum AMPBLAS_UPLO uplo, enum AMPBLAS_TRANSPOSE transa, enum AMPBLAS_DIAG diag, ampblas_int64 m, ampblas_int64 n, ampblas_int64 lda, ampblas_int64 ldb)
+{
+    call_shape shape = { routine, option(order), option(transa), '-', option(uplo), option(side), option(diag), m, n, 0, lda, ldb, 0, 0, 0 };
+    return shape;
+}
+
+namespace _details {
+
+const char *routine_name(routine_id routine);
+char routine_type(routine_id routine);
+
+// enter_routine makes routine the one the calling thread runs, returning the routine it ran 
+// before in outer and the time stamp counter; leave_routine counts the call and restores outer
+unsigned long long enter_routine(routine_id routine, routine_id& outer);
+void leave_routine(const call_shape& shape, routine_id outer, unsigned long long ticks);
+
+} // namespace _details
+
+class call_trace
+{
+public:
+    explicit call_trace(const call_shape& shape);
+    ~call_trace();
+
+private:
+    call_trace(const call_trace&);
+    call_trace& operator=(const call_trace&);
+
+    const call_shape shape;
+    const long long start;
+    routine_id outer;
+    unsigned long long ticks;
+};
+
  } // namespace ampcblas 
 
 #define AMPBLAS_CHECKED_CALL(...)                        \
@@ -159,6 +470,7 @@ inline void feature_not_implemented()
     try                                                  \
     {                                                    \
         (__VA_ARGS__);                                   \
+        ampcblas::_details::release_implicit_bindings(); \
     }                                                    \
     catch (const ampcblas::argument_error_exception& e)  \
     {                                                    \
@@ -45,6 +45,12 @@ enum AMPBLAS_UPLO {AmpblasUpper=121, AmpblasLower=122};
 enum AMPBLAS_DIAG {AmpblasNonUnit=131, AmpblasUnit=132};
 enum AMPBLAS_SIDE {AmpblasLeft=141, AmpblasRight=142};
 
+// sizes, increments and indices of the ILP64 (_64 suffixed) routines
+typedef long long ampblas_int64;
+
+// options of ampblas_malloc
+enum AMPBLAS_ALLOC_FLAG {AmpblasAllocDefault=0, AmpblasAllocLargePages=0x01, AmpblasAllocNumaBlocked=0x02, AmpblasAllocNumaInterleaved=0x04};
+
 //----------------------------------------------------------------------------
 // AMPBLAS error codes
 //----------------------------------------------------------------------------
@@ -61,4 +67,100 @@ enum ampblas_result
     AMPBLAS_INTERNAL_ERROR, 
 };
 
+//----------------------------------------------------------------------------
+// Detected accelerator and host capabilities
+//----------------------------------------------------------------------------
+enum AMPBLAS_ARCHITECTURE {AmpblasArchUnknown=0, AmpblasArchAMD=1, AmpblasArchNVIDIA=2};
+enum AMPBLAS_HOST_FEATURE {AmpblasHostSSE42=0x01, AmpblasHostAVX=0x02, AmpblasHostAVX2=0x04, AmpblasHostFMA=0x08, AmpblasHostAVX512F=0x10};
+
+struct ampblas_capabilities
+{
+    enum AMPBLAS_ARCHITECTURE architecture;
+    unsigned int host_features;                 // bitwise or of AMPBLAS_HOST_FEATURE
+    int supports_double_precision;
+    int supports_limited_double_precision;
+};
+
+//----------------------------------------------------------------------------
+// Data movement between host memory and accelerators
+//----------------------------------------------------------------------------
+struct ampblas_transfer_stats
+{
+    unsigned long long bytes_to_accelerator;    // bound data copied to an accelerator
+    unsigned long long bytes_to_host;           // accelerator results copied back by synchronize
+};
+
+//----------------------------------------------------------------------------
+// Routine statistics
+//
+// Times are spent in the entry points, which wait for the kernels of a routine
+// only when it returns a result to the host. Flops are the nominal floating 
+// point operations of the calls, with four per complex multiply-add.
+//----------------------------------------------------------------------------
+#define AMPBLAS_ROUTINE_NAME_LENGTH 24
+
+struct ampblas_routine_stats
+{
+    char routine[AMPBLAS_ROUTINE_NAME_LENGTH];  // entry point name without the ampblas_ prefix
+    unsigned long long calls;
+    double total_us;
+    double max_us;                              // longest call
+    unsigned long long flops;
+    unsigned long long bytes_bound;             // bound implicitly during the calls
+    unsigned long long bytes_to_accelerator;    // copied to an accelerator during the calls
+    unsigned long long bytes_to_host;           // copied back during the calls
+};
+
+struct ampblas_stats
+{
+    unsigned long long calls;
+    double total_us;
+    unsigned long long flops;
+    unsigned long long bytes_bound;             // during the calls or by the bind functions
+    unsigned long long bytes_to_accelerator;    // during the calls or by prefetch
+    unsigned long long bytes_to_host;           // during the calls or by synchronize
+    unsigned long long gemm_guarded_launches;   // GEMM kernels that check their bounds
+    unsigned long long gemm_unguarded_launches;
+};
+
+//----------------------------------------------------------------------------
+// Host and accelerator dispatch
+//----------------------------------------------------------------------------
+enum AMPBLAS_DISPATCH_MODE {AmpblasDispatchAccelerator=0, AmpblasDispatchHost=1, AmpblasDispatchAuto=2};
+
+// Rates of an accelerator and of the host that predict where a routine call runs faster.
+// Arithmetic rates are in GFLOP/s and bandwidths in GB/s; an arithmetic rate of 0 marks
+// a precision the accelerator does not support.
+struct ampblas_dispatch_model
+{
+    double host_sgflops;
+    double host_dgflops;
+    double host_bandwidth;                      // streamed by the host kernels
+    double accelerator_sgflops;
+    double accelerator_dgflops;
+    double accelerator_bandwidth;               // streamed by the accelerator kernels
+    double transfer_bandwidth;                  // copies between host memory and the accelerator
+    double launch_overhead_us;                  // fixed cost of a routine call on the accelerator
+};
+
+//----------------------------------------------------------------------------
+// Matrix files
+//
+// A matrix file is this header followed by ld * cols elements in column major
+// order. The header is 64 bytes, so elements are aligned to their size.
+//----------------------------------------------------------------------------
+#define AMPBLAS_FILE_MAGIC   0x53414c42504d41ULL     // "AMPBLAS"
+#define AMPBLAS_FILE_VERSION 1
+
+struct ampblas_file_header
+{
+    unsigned long long magic;                   // AMPBLAS_FILE_MAGIC
+    unsigned int version;                       // AMPBLAS_FILE_VERSION
+    unsigned int element_size;                  // bytes per element
+    unsigned long long rows;
+    unsigned long long cols;
+    unsigned long long ld;                      // elements between the starts of consecutive columns
+    unsigned long long reserved[3];             // zero
+};
+
 #endif // AMPCBLAS_DEFS_H
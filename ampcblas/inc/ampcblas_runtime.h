@@ -73,7 +73,20 @@ private:
 // in host memory. The functions synchronize, discard, and 
 // refresh, respectively, serve these purposes.
 //
-// The byte length of the bound buffer needs to be multiple of 4 bytes.
+// Every view handed out for writing marks its region of the bound buffer dirty, and
+// synchronize only copies back the dirty parts of the region it is given; refresh and
+// discard clear the marks of their region. A caller may therefore synchronize a whole
+// buffer after a routine that updated a small part of it. Views obtained through
+// get_array_view are treated as written.
+//
+// The byte length of the bound buffer needs to be multiple of 4 bytes. Buffers of 8 GB 
+// or more are viewed in segments of just under 8 GB, and a region passed to an AMPBLAS 
+// routine has to lie within one segment; the ILP64 routines split their work to follow
+// this. get_segment returns the segment [begin, end) that contains buffer_ptr.
+//
+// set_segment_length is for testing: buffers the calling thread binds after the call are 
+// viewed in segments of length int32 elements, a multiple of 4, so small buffers exercise 
+// the segment splitting of the ILP64 routines. A length of 0 restores the default.
 // 
 // TODO: consider allowing multiple and concurrent bindings of the same buffer
 //
@@ -86,7 +99,61 @@ AMPBLAS_DLL bool ifbound(void *buffer_ptr, size_t byte_len);
 AMPBLAS_DLL void synchronize(void *buffer_ptr, size_t byte_len);
 AMPBLAS_DLL void discard(void *buffer_ptr, size_t byte_len);
 AMPBLAS_DLL void refresh(void *buffer_ptr, size_t byte_len);
-AMPBLAS_DLL concurrency::array_view<int32_t> get_array_view(const void *buffer_ptr, size_t byte_len);
+AMPBLAS_DLL void prefetch(const void *buffer_ptr, size_t byte_len, const concurrency::accelerator_view& accl_view);
+AMPBLAS_DLL concurrency::array_view<int32_t> get_array_view(const void *buffer_ptr, size_t byte_len, bool read_only = false);
+AMPBLAS_DLL void get_segment(const void *buffer_ptr, const void *&begin, const void *&end);
+AMPBLAS_DLL void set_segment_length(int length);
+AMPBLAS_DLL void *bind_file(const char *path, size_t offset, size_t byte_len);
+AMPBLAS_DLL void *bind_array_view(const concurrency::array_view<int32_t>& view);
+AMPBLAS_DLL void *allocate(size_t byte_len, unsigned int flags);
+AMPBLAS_DLL bool deallocate(void *buffer_ptr);
+AMPBLAS_DLL void read_file_header(const char *path, struct ampblas_file_header *header);
+AMPBLAS_DLL void create_file(const char *path, size_t element_size, size_t rows, size_t cols);
+AMPBLAS_DLL void set_implicit_binding(size_t cache_bytes);
+AMPBLAS_DLL void invalidate_implicit(const void *buffer_ptr, size_t byte_len);
+AMPBLAS_DLL void release_implicit_bindings();
+
+// An operand of a routine call that may run on the host; see set_dispatch_mode
+struct dispatch_operand
+{
+    const void *ptr;
+    size_t byte_len;
+    bool written;
+};
+
+// Bytes of a region that would have to be copied if a routine used it on an accelerator_view
+// (to_accelerator) or on the host (to_host). Results written to a region with write_back set
+// are copied back to host memory after every call on the accelerator.
+struct region_cost
+{
+    uint64_t to_accelerator;
+    uint64_t to_host;
+    bool write_back;
+};
+
+// get_region_cost returns false for regions the host cannot work on in place: imported views,
+// regions overlapping a binding, and unbound regions while implicit binding is disabled.
+// begin_host_access copies accelerator results within a region back to host memory, and
+// end_host_write drops the accelerator copies of a region the host has written.
+AMPBLAS_DLL bool get_region_cost(const void *buffer_ptr, size_t byte_len, const concurrency::accelerator_view& accl_view, region_cost& cost);
+AMPBLAS_DLL void begin_host_access(const void *buffer_ptr, size_t byte_len);
+AMPBLAS_DLL void end_host_write(const void *buffer_ptr, size_t byte_len);
+
+// dispatch_to_host decides where a call of flops operations on elements of element_size bytes
+// runs; when it returns true the operands have been made current in host memory, and the
+// routine runs its host kernel and then calls complete_on_host.
+AMPBLAS_DLL bool dispatch_to_host(double flops, size_t element_size, const dispatch_operand *operands, int count);
+AMPBLAS_DLL void complete_on_host(const dispatch_operand *operands, int count);
+AMPBLAS_DLL void set_dispatch_mode(enum AMPBLAS_DISPATCH_MODE mode);
+AMPBLAS_DLL enum AMPBLAS_DISPATCH_MODE get_dispatch_mode();
+AMPBLAS_DLL void get_dispatch_model(const concurrency::accelerator_view& accl_view, struct ampblas_dispatch_model *model);
+AMPBLAS_DLL void set_dispatch_model(const concurrency::accelerator_view& accl_view, const struct ampblas_dispatch_model *model);
+AMPBLAS_DLL void set_trace_file(const char *path);
+AMPBLAS_DLL void count_bytes_bound(size_t byte_len);
+AMPBLAS_DLL void count_bytes_to_accelerator(size_t byte_len);
+AMPBLAS_DLL void count_bytes_to_host(size_t byte_len);
+AMPBLAS_DLL void get_stats(struct ampblas_stats *stats, struct ampblas_routine_stats *routines, int *count);
+AMPBLAS_DLL void reset_stats();
 } // nampespace _details
 
 template<typename T> 
@@ -119,17 +186,143 @@ inline void refresh(T *buffer_ptr, size_t element_count)
     _details::refresh(buffer_ptr, element_count * sizeof(T));
 }
 
+// The runtime tracks which parts of a bound buffer have been copied to an accelerator and 
+// which have been written there since, so synchronize only copies back what routines wrote
+// and refresh only invalidates what was copied. Neither has to be called between routines
+// that pass the same buffers to each other.
+//
+// prefetch starts copying a region to accl_view ahead of the routines that will use it, 
+// skipping the parts that are already there, and does not wait for the copy.
+template<typename T>
+inline void prefetch(const T *buffer_ptr, size_t element_count, const concurrency::accelerator_view& accl_view)
+{
+    _details::prefetch(buffer_ptr, element_count * sizeof(T), accl_view);
+}
+
+// bind_file maps elements [element_offset, element_offset+element_count) of a matrix file
+// (see ampblas_file_header) into memory and binds them. An element_count of 0 maps to the end
+// of the file. Pages are read when they are first used; each time part of the mapping is
+// viewed for an AMPBLAS routine the operating system is asked to start reading it ahead.
+// The mapping is released by unbind. Files that cannot be opened for writing are mapped
+// copy-on-write, so changes are not written back to them.
+template<typename T>
+inline T* bind_file(const char *path, size_t element_offset = 0, size_t element_count = 0)
+{
+    return static_cast<T*>(_details::bind_file(path, element_offset * sizeof(T), element_count * sizeof(T)));
+}
+
 // This API allows binding a single dimensional array_view as an AMPBLAS pointer. It can
 // be used to import GPU-based arrays or staging arrays into the AMPBLAS sandbox.
-// TODO: not supported yet.
+//
+// Nothing is copied: the returned pointer is an opaque handle reserved in the address space, 
+// and AMPBLAS routines given addresses within it operate on the view itself. It must not be 
+// dereferenced on the host, nor passed to the out-of-core routines, which work on host 
+// memory; read results through the original view. The binding is released with unbind.
 template <typename value_type>
-void* bind_array_view(const concurrency::array_view<value_type>& av);
+inline void* bind_array_view(const concurrency::array_view<value_type>& av)
+{
+    return _details::bind_array_view(av.reinterpret_as<int32_t>());
+}
+
+// allocate returns host memory for element_count elements that is aligned to 64 bytes and
+// already bound, so it can be passed to AMPBLAS routines without a bind call. With 
+// AmpblasAllocLargePages the memory is backed by large (2 MB) pages if the process holds the
+// lock pages in memory privilege, and by ordinary pages otherwise. AmpblasAllocNumaBlocked 
+// splits the memory into one contiguous range per NUMA node, in node order, so the column 
+// blocks of a matrix stored in it are run by the host routines on the node holding them; 
+// AmpblasAllocNumaInterleaved deals it across the nodes 64 KB at a time. Each page is touched
+// on its node when the memory is allocated, and the memory is page aligned and zeroed. The
+// NUMA placements cannot be combined with each other or with AmpblasAllocLargePages, and 
+// reduce to ordinary pages on a machine with one node. Release the memory with deallocate, 
+// which also removes the binding; unbind does not accept it.
+template<typename T>
+inline T* allocate(size_t element_count, unsigned int flags = AmpblasAllocDefault)
+{
+    return static_cast<T*>(_details::allocate(element_count * sizeof(T), flags));
+}
+
+template<typename T>
+inline bool deallocate(T *buffer_ptr)
+{
+    return _details::deallocate(buffer_ptr);
+}
+
+// Implicit binding lets unmodified CBLAS style code run on AMPBLAS without bind calls. 
+// While it is enabled, a region passed to an AMPBLAS routine that is not bound is bound 
+// on first use and cached, so later calls on the same data find it on the accelerator. 
+// Cached bindings are evicted least recently used first to keep them within cache_bytes;
+// a cache_bytes of 0 disables implicit binding and releases the cache. Every routine 
+// call writes its results back to host memory before it returns, as a BLAS caller 
+// expects. 
+//
+// The cache cannot see host writes. Call invalidate_implicit after modifying, freeing or
+// reallocating host memory the cache may hold; a nullptr buffer starts a new host 
+// generation, after which every cached binding is refreshed on its next use. 
+inline void set_implicit_binding(size_t cache_bytes)
+{
+    _details::set_implicit_binding(cache_bytes);
+}
+
+template<typename T>
+inline void invalidate_implicit(const T *buffer_ptr, size_t element_count)
+{
+    _details::invalidate_implicit(buffer_ptr, element_count * sizeof(T));
+}
 
-// Conversely, a bound buffer can be obtained and manipulated as an array view.
+// The launch and transfer overhead of an accelerator dwarfs the arithmetic of small problems.
+// With AmpblasDispatchAuto, real single and double precision AXPY, DOT, GEMV and GEMM calls on
+// contiguous, column major operands are run by the host kernels whenever that is predicted to
+// be faster. The prediction weighs the arithmetic and memory traffic of the call against the
+// rates in the dispatch model of the current accelerator_view, which are measured by a short
+// benchmark when the accelerator is first used, and counts the copies each side needs given
+// where the operands currently are. AmpblasDispatchHost runs every such call on the host and
+// AmpblasDispatchAccelerator, the default, none. Other routines always run on the accelerator.
+//
+// Host calls keep bound buffers consistent: accelerator results are synchronized before they
+// are read, and accelerator copies of the results are refreshed. Imported views are never
+// used on the host.
+inline void set_dispatch_mode(enum AMPBLAS_DISPATCH_MODE mode)
+{
+    _details::set_dispatch_mode(mode);
+}
+
+// get_dispatch_model returns the model of the accelerator of accl_view, measuring it if this
+// has not been done yet. set_dispatch_model replaces it, e.g. with one saved by an earlier run
+// so the benchmark is skipped.
+inline ampblas_dispatch_model get_dispatch_model(const concurrency::accelerator_view& accl_view)
+{
+    ampblas_dispatch_model model;
+    _details::get_dispatch_model(accl_view, &model);
+    return model;
+}
+
+inline void set_dispatch_model(const concurrency::accelerator_view& accl_view, const ampblas_dispatch_model& model)
+{
+    _details::set_dispatch_model(accl_view, &model);
+}
+
+// set_trace_file starts recording every call of a C routine to a CSV file at path, replacing
+// the file if it exists and ending any trace already being recorded; a nullptr path ends the
+// trace. Each line holds the routine, its precision, order and options, the sizes, leading
+// dimensions and increments of the call, and its time in microseconds, which runs until the
+// kernels of the call complete on the current accelerator_view. The ampblas_replay tool runs
+// a trace again on synthetic data. If the AMPBLAS_TRACE environment variable names a file 
+// when the library is loaded, the trace is recorded there.
+//
+// While no trace is recorded, tracing costs each call a flag test. A trace slows the calls 
+// it records, since every call waits for its kernels.
+inline void set_trace_file(const char *path)
+{
+    _details::set_trace_file(path);
+}
+
+// Conversely, a bound buffer can be obtained and manipulated as an array view. Views
+// requested as read_only leave the region clean for synchronize, so they must not be
+// written through.
 template<typename value_type>
-inline concurrency::array_view<value_type> get_array_view(const value_type *ptr, size_t element_count)
+inline concurrency::array_view<value_type> get_array_view(const value_type *ptr, size_t element_count, bool read_only = false)
 {
-	auto av = _details::get_array_view(ptr, element_count * sizeof(value_type));
+	auto av = _details::get_array_view(ptr, element_count * sizeof(value_type), read_only);
 	return av.reinterpret_as<value_type>();
 }
 
@@ -248,7 +441,7 @@ template <typename value_type>
 inline stride_view<concurrency::array_view<value_type,1>> make_vector_view(int N, const value_type *X, int incX)
 {
     // TODO: there are a number of const-correct issues in the 1d reduction code
-    auto avX = get_array_view(const_cast<value_type*>(X), N*std::abs(incX));
+    auto avX = get_array_view(X, N*std::abs(incX), true);
     return make_stride_view(avX, incX, make_extent(N));
 }
 
@@ -261,7 +454,7 @@ inline concurrency::array_view<value_type,2> make_matrix_view(int M, int N, valu
 template <typename value_type>
 inline concurrency::array_view<const value_type,2> make_matrix_view(int M, int N, const value_type *A, int ldA) 
 {
-    return get_array_view(A, ldA*N).view_as(concurrency::extent<2>(N,ldA)).section(concurrency::extent<2>(N,M));
+    return get_array_view(A, ldA*N, true).view_as(concurrency::extent<2>(N,ldA)).section(concurrency::extent<2>(N,M));
 }
 
 } // namespace ampblas
@@ -284,10 +477,100 @@ AMPBLAS_DLL bool           ampblas_unbind(void *buffer_ptr);
 
 // This function doesn't change the last_error_code
 AMPBLAS_DLL bool           ampblas_ifbound(void *buffer_ptr, size_t byte_len);
+
+// ampblas_bind_file maps bytes [offset, offset+length) of the elements of a matrix file into
+// memory and binds them, returning the address of the first mapped element; offset is 
+// relative to the end of the header and a length of 0 maps to the end of the file. The 
+// pages are read on demand, with read ahead requested for every region that is viewed by 
+// an AMPBLAS routine. ampblas_unbind releases the mapping.
+//
+// returns nullptr and sets the last-error code on failure
+AMPBLAS_DLL void *         ampblas_bind_file(const char *path, size_t offset, size_t length);
+
+// ampblas_malloc returns byte_len bytes of host memory aligned to 64 bytes and bound for use 
+// by AMPBLAS routines; flags is a combination of AMPBLAS_ALLOC_FLAG values. ampblas_free 
+// releases the memory together with its binding. See ampcblas::allocate.
+//
+// ampblas_malloc returns nullptr and sets the last-error code on failure
+AMPBLAS_DLL void *         ampblas_malloc(size_t byte_len, unsigned int flags);
+
+// returns false if buffer_ptr was not returned by ampblas_malloc; this function doesn't 
+// change the last_error_code
+AMPBLAS_DLL bool           ampblas_free(void *buffer_ptr);
+
+// Reads the header of a matrix file 
+AMPBLAS_DLL ampblas_result ampblas_read_file_header(const char *path, struct ampblas_file_header *header);
+
+// Creates a matrix file with ld equal to rows; the elements read as zero until written
+AMPBLAS_DLL ampblas_result ampblas_create_file(const char *path, size_t element_size, size_t rows, size_t cols);
 AMPBLAS_DLL ampblas_result ampblas_synchronize(void *buffer_ptr, size_t byte_len);
 AMPBLAS_DLL ampblas_result ampblas_discard(void *buffer_ptr, size_t byte_len);
 AMPBLAS_DLL ampblas_result ampblas_refresh(void *buffer_ptr, size_t byte_len);
 
+// ampblas_prefetch starts copying the bound region [buffer_ptr, buffer_ptr+byte_len) to the
+// accelerator_view accl_view points to, or to the current accelerator_view if it is nullptr,
+// skipping the parts that are already there. See ampcblas::prefetch.
+AMPBLAS_DLL ampblas_result ampblas_prefetch(const void *buffer_ptr, size_t byte_len, void *accl_view);
+
+// ampblas_get_transfer_stats reports the bytes the runtime has copied between host memory
+// and accelerators since the process started or ampblas_reset_transfer_stats was last called.
+//
+// returns AMPBLAS_INVALID_ARG if the stats argument is nullptr
+AMPBLAS_DLL ampblas_result ampblas_get_transfer_stats(struct ampblas_transfer_stats *stats);
+AMPBLAS_DLL ampblas_result ampblas_reset_transfer_stats();
+
+// ampblas_set_implicit_binding enables implicit binding of the buffers passed to AMPBLAS
+// routines, cached up to cache_bytes; 0 disables it. ampblas_invalidate_implicit marks 
+// cached bindings overlapping [buffer_ptr, buffer_ptr+byte_len) as modified on the host, 
+// or all of them if buffer_ptr is nullptr. See ampcblas::set_implicit_binding.
+AMPBLAS_DLL ampblas_result ampblas_set_implicit_binding(size_t cache_bytes);
+AMPBLAS_DLL ampblas_result ampblas_invalidate_implicit(const void *buffer_ptr, size_t byte_len);
+
+// ampblas_set_dispatch_mode selects where the routines with host kernels run. The dispatch
+// model is that of the current accelerator_view. See ampcblas::set_dispatch_mode.
+//
+// ampblas_get_dispatch_model and ampblas_set_dispatch_model return AMPBLAS_INVALID_ARG if the
+// model argument is nullptr
+AMPBLAS_DLL ampblas_result ampblas_set_dispatch_mode(enum AMPBLAS_DISPATCH_MODE mode);
+AMPBLAS_DLL ampblas_result ampblas_get_dispatch_model(struct ampblas_dispatch_model *model);
+AMPBLAS_DLL ampblas_result ampblas_set_dispatch_model(const struct ampblas_dispatch_model *model);
+
+// ampblas_set_trace_file starts recording the routine calls of the library to a CSV file at
+// path, or ends the recording if path is nullptr. See ampcblas::set_trace_file.
+//
+// returns AMPBLAS_BAD_RESOURCE if the file cannot be created
+AMPBLAS_DLL ampblas_result ampblas_set_trace_file(const char *path);
+
+// ampblas_start_timeline starts recording the kernel timeline of the library: every stage that
+// launches work, such as a GEMM kernel or a block of host kernels, is recorded with its tile
+// grid and tuning parameters in a ring buffer of the thread that ran it. If wait_for_kernels
+// is not 0, accelerator stages wait for their kernels, which shows when the kernels ran but
+// serializes them. ampblas_stop_timeline stops recording and ampblas_write_timeline writes the
+// events recorded since the timeline was started to path as Chrome trace event JSON, for
+// chrome://tracing or Perfetto. If the AMPBLAS_TIMELINE environment variable names a file when
+// the library is loaded, the timeline is recorded from then on and written there when it is
+// unloaded. See ampblas::start_timeline.
+//
+// ampblas_write_timeline returns AMPBLAS_INVALID_ARG if the path argument is nullptr and
+// AMPBLAS_BAD_RESOURCE if the file cannot be written
+AMPBLAS_DLL ampblas_result ampblas_start_timeline(int wait_for_kernels);
+AMPBLAS_DLL ampblas_result ampblas_stop_timeline();
+AMPBLAS_DLL ampblas_result ampblas_write_timeline(const char *path);
+
+// ampblas_get_stats reports the calls of the C routines since the process started or 
+// ampblas_reset_stats was last called: totals in stats and, if routines is not nullptr, one 
+// entry per routine called. On entry *count is the number of entries routines can hold; on 
+// return it is the number of routines called, of which as many as fit are stored. count may
+// be nullptr if routines is. Every thread counts its calls apart from the 
+// others, so counting costs a call a few nanoseconds whatever the number of threads. If the 
+// AMPBLAS_STATS environment variable names a file when the library is loaded, the statistics
+// are written there as JSON when it is unloaded.
+//
+// returns AMPBLAS_INVALID_ARG if the stats argument is nullptr, or if routines is not nullptr
+// and count is nullptr or points to a negative number
+AMPBLAS_DLL ampblas_result ampblas_get_stats(struct ampblas_stats *stats, struct ampblas_routine_stats *routines, int *count);
+AMPBLAS_DLL ampblas_result ampblas_reset_stats();
+
 // ampblas_set_current_accelerator_view set the accelerator view which will be used
 // in subsequent AMPBLAS calls. If this function has not been called in current 
 // thread, the default accelerator_view associated with the default accelerator 
@@ -303,6 +586,13 @@ AMPBLAS_DLL ampblas_result ampblas_refresh(void *buffer_ptr, size_t byte_len);
 // returns AMPBLAS_INVALID_ARG if the accl_view argument is nullptr
 AMPBLAS_DLL ampblas_result ampblas_set_current_accelerator_view(void * accl_view);
 
+// ampblas_get_capabilities reports the architecture of the calling thread's current 
+// accelerator_view and the instruction set extensions available on the host. Detection
+// is performed once per accelerator and cached, so this function is inexpensive.
+//
+// returns AMPBLAS_INVALID_ARG if the caps argument is nullptr
+AMPBLAS_DLL ampblas_result ampblas_get_capabilities(struct ampblas_capabilities *caps);
+
 // Retrieves the calling thread's last-error code value. The last-error code is maintained 
 // on a per-thread basis. Multiple threads do not overwrite each other's last-error code.
 // You should call this function immediately when you want to check the status of a blas 
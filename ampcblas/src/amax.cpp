@@ -34,12 +34,47 @@ index_type amax(const int n, const value_type* x, const int incx)
 	if (x == nullptr)
 		argument_error("amax", 2);
 
-    auto x_vec = make_vector_view(n, const_cast<value_type*>(x), incx);
+    auto x_vec = make_vector_view(n, x, incx);
 
     // forward to ampblas
     return ampblas::amax<index_type>(get_current_accelerator_view(), x_vec);
 }
 
+// AMAX with 64-bit sizes and index; the maximum of each chunk is read back to compare
+// it with the others, keeping the first one on ties as within a chunk
+template <typename value_type>
+ampblas_int64 amax_64(const ampblas_int64 n, const value_type* x, const ampblas_int64 incx)
+{
+    typedef typename ampblas::real_type<value_type>::type real_type;
+
+	// Fortran indexing
+	if (n < 1 || incx <= 0)
+		return 1;
+
+	if (x == nullptr)
+		argument_error("amax", 2);
+
+    const strided_blocks<const value_type> x_blocks(n, x, int_arg("amax", 3, incx));
+
+    ampblas_int64 ret = 1;
+    real_type max_value = real_type();
+    for (ampblas_int64 i = 0, count = 0; i < n; i += count)
+    {
+        count = x_blocks.fit(i);
+        const value_type* chunk = x_blocks.at(i, count);
+        const int idx = amax<int>(static_cast<int>(count), chunk, x_blocks.inc(count));
+
+        const real_type value = ampblas::_detail::abs_1(get_array_view(x_blocks.block(i + idx - 1), 1, true)[0]);
+        if (i == 0 || value > max_value)
+        {
+            max_value = value;
+            ret = i + idx;
+        }
+    }
+
+    return ret;
+}
+
 } // namespace ampcblas
 
 extern "C" {
@@ -47,6 +82,7 @@ extern "C" {
 int ampblas_isamax(const int N, const float *X, const int incX)
 {
     int ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_isamax, N, incX));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::amax<int>(N, X, incX) );
     return ret;
 }
@@ -54,6 +90,7 @@ int ampblas_isamax(const int N, const float *X, const int incX)
 int ampblas_idamax(const int N, const double *X, const int incX)
 {
     int ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_idamax, N, incX));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::amax<int>(N, X, incX) );
     return ret;
 }
@@ -61,6 +98,7 @@ int ampblas_idamax(const int N, const double *X, const int incX)
 int ampblas_icamax(const int N, const ampblas_fcomplex *X, const int incX)
 {
     int ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_icamax, N, incX));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::amax<int>(N, ampcblas::ampblas_cast(X), incX) );
     return ret;
 }
@@ -68,8 +106,41 @@ int ampblas_icamax(const int N, const ampblas_fcomplex *X, const int incX)
 int ampblas_izamax(const int N, const ampblas_dcomplex *X, const int incX)
 {
     int ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_izamax, N, incX));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::amax<int>(N, ampcblas::ampblas_cast(X), incX) );
     return ret;
 }
 
+ampblas_int64 ampblas_isamax_64(const ampblas_int64 N, const float *X, const ampblas_int64 incX)
+{
+    ampblas_int64 ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_isamax_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::amax_64(N, X, incX) );
+    return ret;
+}
+
+ampblas_int64 ampblas_idamax_64(const ampblas_int64 N, const double *X, const ampblas_int64 incX)
+{
+    ampblas_int64 ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_idamax_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::amax_64(N, X, incX) );
+    return ret;
+}
+
+ampblas_int64 ampblas_icamax_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX)
+{
+    ampblas_int64 ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_icamax_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::amax_64(N, ampcblas::ampblas_cast(X), incX) );
+    return ret;
+}
+
+ampblas_int64 ampblas_izamax_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX)
+{
+    ampblas_int64 ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_izamax_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::amax_64(N, ampcblas::ampblas_cast(X), incX) );
+    return ret;
+}
+
 } // extern "C"
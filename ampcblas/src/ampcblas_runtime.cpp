@@ -20,12 +20,20 @@
  * Mostly, memory management of bound buffers, and error handling routines.
  *
  *---------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cstdint>
+#include <list>
 #include <map>
 #include <memory>
+#include <vector>
 #include <amp.h>
 #include <assert.h>
+#include <malloc.h>
 #include <concurrent_unordered_map.h> // Microsoft specific 
 #include "ampcblas_runtime.h"
+#include "detail/host/numa.h"
+#include "detail/timeline.h"
+#include "detail/tuning/tune.h"
 
 namespace ampcblas 
 {
@@ -77,15 +85,303 @@ namespace
 concurrency::critical_section g_allocations_cs;
 std::map<const void*, amp_buffer*> g_allocations;
 
+// The buffer find_amp_buffer returned last. Routines look up the same few buffers over and
+// over, so checking it first usually saves the search. Guarded by g_allocations_cs.
+amp_buffer *g_last_found = nullptr;
+
 // This is to store per-thread shared resources. Currently two resources last error code 
 // and current accelerator_view are stored. concurrent_unordered_map is supported by 
 // Microsoft Visual Studio. It is lock-free. You can also use thread_local feature if 
 // your development environment supports. 
 concurrency::concurrent_unordered_map<DWORD, std::unique_ptr<thread_context>> g_thread_contexts;
+
+// Implicit binding cache. Buffers bound implicitly are kept in g_implicit_lru, most recently 
+// used first, and their total size is held to g_implicit_capacity bytes; a capacity of 0 
+// disables implicit binding. g_host_generation is advanced when host memory may have changed 
+// behind the cache. Lock g_implicit_cs before g_allocations_cs when both are needed.
+concurrency::critical_section g_implicit_cs;
+std::list<amp_buffer*> g_implicit_lru;
+volatile size_t g_implicit_capacity = 0;
+size_t g_implicit_bytes = 0;
+uint64_t g_host_generation = 1;
+
+// Bytes the runtime has caused to be copied between host memory and accelerators. Copies to
+// an accelerator are counted when a region that is not resident there is viewed for a routine
+// or prefetched, copies to the host when dirty regions are synchronized.
+volatile LONGLONG g_bytes_to_accelerator = 0;
+volatile LONGLONG g_bytes_to_host = 0;
 }
 
 #define PTR_U64(ptr)      reinterpret_cast<uint64_t>(ptr)
 
+// Bound buffers are viewed in segments of at most this many int32 elements, so every view
+// has an int extent. The length is a multiple of 4 to keep elements of up to 16 bytes from
+// straddling two segments.
+static const int max_segment_length = INT_MAX - INT_MAX % 4;
+
+// The segment length of buffers the calling thread binds; only lowered by tests, see
+// set_segment_length. Per thread so tests running in parallel do not see each other's.
+static __declspec(thread) int t_segment_length = max_segment_length;
+
+// Memory from allocate is aligned to and sized in multiples of a cache line
+static const size_t allocation_alignment = 64;
+
+//----------------------------------------------------------------------------
+// file_mapping
+//
+// a view of part of a matrix file mapped into memory 
+//----------------------------------------------------------------------------
+class file_mapping
+{
+public:
+    file_mapping(HANDLE file, HANDLE mapping, void *view_base)
+        : file(file), mapping(mapping), view_base(view_base)
+    {
+    }
+
+    ~file_mapping()
+    {
+        UnmapViewOfFile(view_base);
+        CloseHandle(mapping);
+        CloseHandle(file);
+    }
+
+    // Asks the memory manager to start reading the region in, as madvise(MADV_WILLNEED) 
+    // would. PrefetchVirtualMemory is only available from Windows 8, so on older systems
+    // pages are simply read on first touch. 
+    static void prefetch(const void *buffer_ptr, size_t byte_len)
+    {
+        struct memory_range
+        {
+            void *address;
+            size_t byte_len;
+        };
+        typedef BOOL (WINAPI *prefetch_function)(HANDLE, ULONG_PTR, memory_range*, ULONG);
+
+        static const prefetch_function prefetch_virtual_memory = 
+            reinterpret_cast<prefetch_function>(GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory"));
+
+        if (prefetch_virtual_memory != nullptr && byte_len != 0)
+        {
+            memory_range range = { const_cast<void*>(buffer_ptr), byte_len };
+            prefetch_virtual_memory(GetCurrentProcess(), 1, &range, 0);
+        }
+    }
+
+private:
+    file_mapping(const file_mapping&);
+    file_mapping& operator=(const file_mapping&);
+
+    HANDLE file;
+    HANDLE mapping;
+    void *view_base;
+};
+
+//----------------------------------------------------------------------------
+// address_reservation
+//
+// a range of reserved address space standing in for data that has no host address 
+//----------------------------------------------------------------------------
+class address_reservation
+{
+public:
+    explicit address_reservation(void *base)
+        : base(base)
+    {
+    }
+
+    ~address_reservation()
+    {
+        VirtualFree(base, 0, MEM_RELEASE);
+    }
+
+private:
+    address_reservation(const address_reservation&);
+    address_reservation& operator=(const address_reservation&);
+
+    void *base;
+};
+
+//----------------------------------------------------------------------------
+// host_allocation
+//
+// host memory the runtime allocated for a buffer it bound itself
+//----------------------------------------------------------------------------
+class host_allocation
+{
+public:
+    // how the memory was obtained, and so how it is released
+    enum allocation_kind
+    {
+        aligned,
+        large_pages,
+        numa
+    };
+
+    host_allocation(void *base, allocation_kind kind)
+        : base(base), kind(kind)
+    {
+    }
+
+    ~host_allocation()
+    {
+        if (kind == large_pages)
+        {
+            VirtualFree(base, 0, MEM_RELEASE);
+        }
+        else if (kind == numa)
+        {
+            ampblas::_detail::host_numa_free(base);
+        }
+        else
+        {
+            _aligned_free(base);
+        }
+    }
+
+private:
+    host_allocation(const host_allocation&);
+    host_allocation& operator=(const host_allocation&);
+
+    void *base;
+    allocation_kind kind;
+};
+
+//----------------------------------------------------------------------------
+// range_set
+//
+// a set of disjoint byte ranges [first, second) of a bound buffer
+//----------------------------------------------------------------------------
+class range_set
+{
+public:
+    // Adds [begin, end); ranges that touch are merged
+    void insert(uint64_t begin, uint64_t end)
+    {
+        if (begin == end)
+            return;
+
+        // the first range that could touch [begin, end)
+        auto it = ranges.upper_bound(begin);
+        if (it != ranges.begin())
+        {
+            auto prev = it;
+            prev--;
+            if (prev->second >= begin)
+                it = prev;
+        }
+
+        while (it != ranges.end() && it->first <= end)
+        {
+            begin = std::min(begin, it->first);
+            end = std::max(end, it->second);
+            it = ranges.erase(it);
+        }
+
+        ranges.insert(std::make_pair(begin, end));
+    }
+
+    // Removes [begin, end) and returns the parts of it that were in the set
+    std::vector<std::pair<uint64_t, uint64_t>> erase(uint64_t begin, uint64_t end)
+    {
+        std::vector<std::pair<uint64_t, uint64_t>> cleared;
+        if (begin == end)
+            return cleared;
+
+        auto it = ranges.upper_bound(begin);
+        if (it != ranges.begin())
+        {
+            auto prev = it;
+            prev--;
+            if (prev->second > begin)
+                it = prev;
+        }
+
+        while (it != ranges.end() && it->first < end)
+        {
+            const uint64_t first = it->first;
+            const uint64_t last = it->second;
+            it = ranges.erase(it);
+
+            // keep whatever lies outside [begin, end)
+            if (first < begin)
+                ranges.insert(std::make_pair(first, begin));
+            if (last > end)
+                it = ranges.insert(std::make_pair(end, last)).first;
+
+            cleared.push_back(std::make_pair(std::max(first, begin), std::min(last, end)));
+        }
+
+        return cleared;
+    }
+
+    // Returns the parts of [begin, end) that are in the set
+    std::vector<std::pair<uint64_t, uint64_t>> find(uint64_t begin, uint64_t end) const
+    {
+        std::vector<std::pair<uint64_t, uint64_t>> found;
+
+        auto it = ranges.upper_bound(begin);
+        if (it != ranges.begin())
+        {
+            auto prev = it;
+            prev--;
+            if (prev->second > begin)
+                it = prev;
+        }
+
+        for (; it != ranges.end() && it->first < end; it++)
+        {
+            found.push_back(std::make_pair(std::max(it->first, begin), std::min(it->second, end)));
+        }
+
+        return found;
+    }
+
+    // Returns the parts of [begin, end) that are not in the set
+    std::vector<std::pair<uint64_t, uint64_t>> missing(uint64_t begin, uint64_t end) const
+    {
+        std::vector<std::pair<uint64_t, uint64_t>> gaps;
+
+        // skip the part covered by a range starting before begin
+        auto it = ranges.upper_bound(begin);
+        if (it != ranges.begin())
+        {
+            auto prev = it;
+            prev--;
+            begin = std::max(begin, prev->second);
+        }
+
+        while (begin < end)
+        {
+            const uint64_t next = (it == ranges.end()) ? end : std::min(it->first, end);
+            if (next > begin)
+                gaps.push_back(std::make_pair(begin, next));
+            if (it == ranges.end())
+                break;
+
+            begin = it->second;
+            it++;
+        }
+
+        return gaps;
+    }
+
+private:
+    std::map<uint64_t, uint64_t> ranges;
+};
+
+// Sum of the lengths of ranges
+static uint64_t total_length(const std::vector<std::pair<uint64_t, uint64_t>>& ranges)
+{
+    uint64_t length = 0;
+    for (auto it = ranges.begin(); it != ranges.end(); it++)
+    {
+        length += it->second - it->first;
+    }
+
+    return length;
+}
+
 //----------------------------------------------------------------------------
 // amp_buffer
 //
@@ -94,14 +390,39 @@ concurrency::concurrent_unordered_map<DWORD, std::unique_ptr<thread_context>> g_
 class amp_buffer
 {
 public:
-	amp_buffer(void *buffer_ptr, size_t byte_len)
+    // Ownership of mapping and allocation moves to the members as they are initialized, so 
+    // an exception from the constructor leaves each of them released exactly once.
+	amp_buffer(void *buffer_ptr, size_t byte_len, std::unique_ptr<file_mapping>&& mapping = std::unique_ptr<file_mapping>(), std::unique_ptr<host_allocation>&& allocation = std::unique_ptr<host_allocation>())
 		:mem_base(reinterpret_cast<int32_t*>(buffer_ptr)), 
 		 byte_length(byte_len),
-         // byte_len has been asserted to be multiple of int32_t size, and the byte_len/sizeof(int32_t)
-         // is no greater than INT_MAX. So we can safely cast the result to int. 
-		 storage(concurrency::extent<1>(static_cast<int>(static_cast<uint64_t>(byte_len)/sizeof(int32_t))), 
-                 reinterpret_cast<int32_t*>(buffer_ptr))
+         segment_bytes(static_cast<uint64_t>(t_segment_length) * sizeof(int32_t)),
+         mapping(std::move(mapping)),
+         allocation(std::move(allocation)),
+         implicit(false),
+         generation(0),
+         pins(0)
 	{
+        // byte_len has been asserted to be multiple of int32_t size
+        const uint64_t length = static_cast<uint64_t>(byte_len) / sizeof(int32_t);
+        const uint64_t segment_length = segment_bytes / sizeof(int32_t);
+        for (uint64_t offset = 0; offset < length; offset += segment_length)
+        {
+            const int count = static_cast<int>(std::min<uint64_t>(length - offset, segment_length));
+            segments.push_back(concurrency::array_view<int32_t>(concurrency::extent<1>(count), reinterpret_cast<int32_t*>(buffer_ptr) + offset));
+        }
+    }
+
+    // Binds an imported array_view to the reserved addresses [buffer_ptr, buffer_ptr+view size)
+    amp_buffer(void *buffer_ptr, const concurrency::array_view<int32_t>& view, std::unique_ptr<address_reservation>&& reservation)
+		:mem_base(reinterpret_cast<int32_t*>(buffer_ptr)), 
+		 byte_length(static_cast<size_t>(view.extent.size()) * sizeof(int32_t)),
+         segment_bytes(static_cast<uint64_t>(max_segment_length) * sizeof(int32_t)),
+         reservation(std::move(reservation)),
+         segments(1, view),
+         implicit(false),
+         generation(0),
+         pins(0)
+    {
     }
 
     // Check whether this bound buffer contains the region starting at buffer_ptr with length byte_len 
@@ -131,10 +452,121 @@ public:
     {
         return !exclusive_with(buffer_ptr, byte_len) && !contain(buffer_ptr, byte_len);
     }
-    
+
+    // Returns the view of the region [byte_offset, byte_offset+byte_len), which has to lie within one segment
+    concurrency::array_view<int32_t> section(uint64_t byte_offset, uint64_t byte_len) const
+    {
+        const uint64_t segment = byte_offset / segment_bytes;
+        const uint64_t elem_offset = (byte_offset - segment * segment_bytes) / sizeof(int32_t);
+        const uint64_t elem_len = byte_len / sizeof(int32_t);
+        if (segment >= segments.size() || elem_offset + elem_len > static_cast<uint64_t>(segments[static_cast<size_t>(segment)].extent[0]))
+        {
+            throw ampblas_exception("Buffer region spans a segment boundary", AMPBLAS_BAD_RESOURCE);
+        }
+
+        return segments[static_cast<size_t>(segment)].section(concurrency::index<1>(static_cast<int>(elem_offset)), concurrency::extent<1>(static_cast<int>(elem_len)));
+    }
+
+    // Records that [begin, end) may be written on an accelerator
+    void mark_dirty(uint64_t begin, uint64_t end)
+    {
+        concurrency::critical_section::scoped_lock scope_lock(ranges_cs);
+        dirty_ranges.insert(begin, end);
+    }
+
+    // Returns the parts of [begin, end) that are marked dirty
+    std::vector<std::pair<uint64_t, uint64_t>> get_dirty(uint64_t begin, uint64_t end)
+    {
+        concurrency::critical_section::scoped_lock scope_lock(ranges_cs);
+        return dirty_ranges.find(begin, end);
+    }
+
+    // Removes the dirty marks within [begin, end) and returns the parts of [begin, end) they covered
+    std::vector<std::pair<uint64_t, uint64_t>> clear_dirty(uint64_t begin, uint64_t end)
+    {
+        concurrency::critical_section::scoped_lock scope_lock(ranges_cs);
+        return dirty_ranges.erase(begin, end);
+    }
+
+    // Records that [begin, end) is current on accl_view and returns the parts of it that were 
+    // not, which are the parts the runtime has to copy there. Moving to another view copies
+    // the whole region; the ranges are kept, as the previous view may still hold copies.
+    std::vector<std::pair<uint64_t, uint64_t>> mark_resident(const concurrency::accelerator_view& accl_view, uint64_t begin, uint64_t end)
+    {
+        concurrency::critical_section::scoped_lock scope_lock(ranges_cs);
+
+        std::vector<std::pair<uint64_t, uint64_t>> missing;
+        if (!resident_view || *resident_view != accl_view)
+        {
+            resident_view.reset(new concurrency::accelerator_view(accl_view));
+            if (begin != end)
+                missing.push_back(std::make_pair(begin, end));
+        }
+        else
+        {
+            missing = resident_ranges.missing(begin, end);
+        }
+
+        resident_ranges.insert(begin, end);
+        return missing;
+    }
+
+    // Forgets the accelerator copies within [begin, end) and returns the parts that were resident
+    std::vector<std::pair<uint64_t, uint64_t>> clear_resident(uint64_t begin, uint64_t end)
+    {
+        concurrency::critical_section::scoped_lock scope_lock(ranges_cs);
+        return resident_ranges.erase(begin, end);
+    }
+
+    // The bytes of [begin, end) that are not current on accl_view, and those that are newer on
+    // an accelerator than in host memory
+    void get_cost(const concurrency::accelerator_view& accl_view, uint64_t begin, uint64_t end, uint64_t& to_accelerator, uint64_t& to_host)
+    {
+        concurrency::critical_section::scoped_lock scope_lock(ranges_cs);
+
+        to_accelerator = end - begin;
+        if (resident_view && *resident_view == accl_view)
+        {
+            to_accelerator = total_length(resident_ranges.missing(begin, end));
+        }
+
+        to_host = end - begin - total_length(dirty_ranges.missing(begin, end));
+    }
+
 	const int32_t *mem_base;
 	const size_t byte_length;
-	concurrency::array_view<int32_t> storage;
+
+    // the size of every segment but the last, fixed when the buffer is bound
+    const uint64_t segment_bytes;
+
+    // the file backing a bind_file buffer, the addresses of a bind_array_view buffer, or the
+    // memory of an allocate buffer; released after the segments
+    std::unique_ptr<file_mapping> mapping;
+    std::unique_ptr<address_reservation> reservation;
+    std::unique_ptr<host_allocation> allocation;
+
+	std::vector<concurrency::array_view<int32_t>> segments;
+
+    // Byte offsets of the regions that have been viewed for writing since they were last
+    // synchronized, refreshed or discarded. Everything else is current in host memory, so
+    // synchronize has nothing to copy back for it.
+    range_set dirty_ranges;
+
+    // Byte offsets of the regions that may have a copy on an accelerator, because they were
+    // viewed for a routine, prefetched or discarded since they were last refreshed; the copies
+    // on resident_view, the view last used, are current. Refresh has nothing to invalidate 
+    // outside them. Not tracked for bind_array_view buffers, which have no host copy.
+    range_set resident_ranges;
+    std::unique_ptr<concurrency::accelerator_view> resident_view;
+    concurrency::critical_section ranges_cs;
+
+    // State of implicit bindings: the host generation the accelerator copies were last 
+    // refreshed in, the position in g_implicit_lru, and the number of routine calls using 
+    // the buffer. Pinned buffers are never evicted. Guarded by g_implicit_cs.
+    bool implicit;
+    uint64_t generation;
+    std::list<amp_buffer*>::iterator lru_position;
+    int pins;
 private:
     amp_buffer& operator=(const amp_buffer& right);
 };
@@ -154,14 +586,18 @@ public:
 
 	ampblas_result last_error_code;
 	concurrency::accelerator_view curr_accl_view;
+
+    // implicit bindings pinned by the routine this thread is running
+    std::vector<amp_buffer*> implicit_pins;
 };
 
+thread_context* get_current_thread_context(const DWORD tid);
+
 //----------------------------------------------------------------------------
 // Data management facilities 
 //----------------------------------------------------------------------------
 #define ASSERT_BUFFER_LENGTH(buf_byte_len) \
-    assert(((buf_byte_len) % sizeof(int32_t) == 0) && "Buffer length must be multiple of int32_t size"); \
-    assert((static_cast<uint64_t>(buf_byte_len) <= static_cast<uint64_t>(INT_MAX)*sizeof(int32_t)) && "Buffer length overflow");
+    assert(((buf_byte_len) % sizeof(int32_t) == 0) && "Buffer length must be multiple of int32_t size");
 
 static inline void check_buffer_length(size_t byte_len)
 {
@@ -169,10 +605,6 @@ static inline void check_buffer_length(size_t byte_len)
     {
         throw ampblas_exception("Buffer length must be multiple of int32_t size", AMPBLAS_BAD_RESOURCE);
     }
-    else if (static_cast<uint64_t>(byte_len) > static_cast<uint64_t>(INT_MAX)*sizeof(int32_t))
-    {
-        throw ampblas_exception("Buffer length overflow", AMPBLAS_BAD_RESOURCE);
-    }
 }
 
 // Find the bound buffer which contains a region starting at buffer_ptr with length byte_len
@@ -195,6 +627,12 @@ static amp_buffer* find_amp_buffer(const void *buffer_ptr, size_t byte_len)
         return nullptr;
 	}
 
+    // a region within one binding cannot overlap any other
+    if (g_last_found != nullptr && g_last_found->contain(buffer_ptr, byte_len))
+    {
+        return g_last_found;
+    }
+
 	auto it = g_allocations.lower_bound(const_cast<void*>(buffer_ptr));
     if (it == g_allocations.begin())
     {
@@ -214,10 +652,12 @@ static amp_buffer* find_amp_buffer(const void *buffer_ptr, size_t byte_len)
 
     if (ampbuff->contain(buffer_ptr, byte_len)) 
 	{
+        g_last_found = ampbuff;
 		return ampbuff;
 	}
 	else if (ampbuff_prev != nullptr && ampbuff_prev->contain(buffer_ptr, byte_len)) 
 	{
+        g_last_found = ampbuff_prev;
 		return ampbuff_prev;
 	}
 	else if (ampbuff->overlap(buffer_ptr, byte_len) || 
@@ -226,53 +666,683 @@ static amp_buffer* find_amp_buffer(const void *buffer_ptr, size_t byte_len)
 		throw ampblas_exception("Buffer overlapped", AMPBLAS_BAD_RESOURCE);
 	}
 
-	return nullptr;
+	return nullptr;
+}
+
+// Applies op to the view of each piece of [first, last) that lies within one segment
+template <typename op_type>
+static void for_each_section(const amp_buffer& ampbuff, uint64_t first, uint64_t last, const op_type& op)
+{
+    while (first < last)
+    {
+        const uint64_t piece_end = std::min(last, (first / ampbuff.segment_bytes + 1) * ampbuff.segment_bytes);
+        op(ampbuff.section(first, piece_end - first));
+        first = piece_end;
+    }
+}
+
+// Adds the total length of ranges to a transfer counter and to the statistics of the calling
+// thread with count_stats
+static void count_transfer(volatile LONGLONG& counter, void (*count_stats)(size_t), const std::vector<std::pair<uint64_t, uint64_t>>& ranges)
+{
+    const LONGLONG bytes = static_cast<LONGLONG>(total_length(ranges));
+    if (bytes != 0)
+    {
+        InterlockedExchangeAdd64(&counter, bytes);
+        count_stats(static_cast<size_t>(bytes));
+    }
+}
+
+// Copies the dirty parts of [first, last) back to host memory. Each part stays marked until it
+// has been copied, so a failed copy is retried by the next synchronization.
+static void synchronize_dirty(amp_buffer& ampbuff, uint64_t first, uint64_t last)
+{
+    auto ranges = ampbuff.get_dirty(first, last);
+    for (auto it = ranges.begin(); it != ranges.end(); it++)
+    {
+        for_each_section(ampbuff, it->first, it->second, [] (const concurrency::array_view<int32_t>& view) { view.synchronize(); });
+        count_transfer(g_bytes_to_host, count_bytes_to_host, ampbuff.clear_dirty(it->first, it->second));
+    }
+}
+
+// Invalidates the accelerator copies of the resident parts of [first, last)
+static void refresh_resident(amp_buffer& ampbuff, uint64_t first, uint64_t last)
+{
+    auto ranges = ampbuff.clear_resident(first, last);
+    for (auto it = ranges.begin(); it != ranges.end(); it++)
+    {
+        for_each_section(ampbuff, it->first, it->second, [] (const concurrency::array_view<int32_t>& view) { view.refresh(); });
+    }
+}
+
+//----------------------------------------------------------------------------
+// Implicit binding
+//
+// The caller of these functions has to hold g_implicit_cs.
+//----------------------------------------------------------------------------
+
+// Returns the bound buffers overlapping [buffer_ptr, buffer_ptr+byte_len) in address order
+static std::vector<amp_buffer*> find_overlapping(const void *buffer_ptr, size_t byte_len)
+{
+    std::vector<amp_buffer*> found;
+
+	concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+
+    auto it = g_allocations.lower_bound(buffer_ptr);
+    if (it != g_allocations.begin())
+    {
+        it--;
+    }
+
+    for (; it != g_allocations.end() && PTR_U64(it->first) <= PTR_U64(buffer_ptr)+byte_len; it++)
+    {
+        if (!it->second->exclusive_with(buffer_ptr, byte_len))
+        {
+            found.push_back(it->second);
+        }
+    }
+
+    return found;
+}
+
+// Writes back and unbinds an implicit binding that no routine is using
+static void evict_implicit(amp_buffer *ampbuff)
+{
+    assert(ampbuff->implicit && ampbuff->pins == 0);
+
+    synchronize_dirty(*ampbuff, 0, ampbuff->byte_length);
+
+    {
+		concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+        g_allocations.erase(ampbuff->mem_base);
+        if (g_last_found == ampbuff)
+        {
+            g_last_found = nullptr;
+        }
+    }
+
+    g_implicit_lru.erase(ampbuff->lru_position);
+    g_implicit_bytes -= ampbuff->byte_length;
+    delete ampbuff;
+}
+
+// Evicts least recently used implicit bindings until byte_len more bytes fit the cache.
+// Pinned bindings are skipped, so the cache can run over capacity while they are in use.
+static void trim_implicit_cache(size_t byte_len)
+{
+    auto it = g_implicit_lru.end();
+    while (it != g_implicit_lru.begin() && g_implicit_bytes + byte_len > g_implicit_capacity)
+    {
+        it--;
+        amp_buffer *ampbuff = *it;
+        if (ampbuff->pins == 0)
+        {
+            it++;
+            evict_implicit(ampbuff);
+        }
+    }
+}
+
+// Pins an implicit binding for the routine the calling thread is running. Buffers whose
+// accelerator copies predate the current host generation are refreshed first.
+static void pin_implicit(amp_buffer *ampbuff)
+{
+    if (ampbuff->generation != g_host_generation)
+    {
+        for_each_section(*ampbuff, 0, ampbuff->byte_length, [] (const concurrency::array_view<int32_t>& view) { view.refresh(); });
+        ampbuff->clear_dirty(0, ampbuff->byte_length);
+        ampbuff->clear_resident(0, ampbuff->byte_length);
+        ampbuff->generation = g_host_generation;
+    }
+
+    g_implicit_lru.splice(g_implicit_lru.begin(), g_implicit_lru, ampbuff->lru_position);
+    ampbuff->pins++;
+    get_current_thread_context(GetCurrentThreadId())->implicit_pins.push_back(ampbuff);
+}
+
+// Returns the binding for [buffer_ptr, buffer_ptr+byte_len), binding it implicitly if no
+// binding contains it. Implicit bindings the region overlaps are replaced by one binding
+// covering all of them; overlapping an explicit binding or one in use is an error.
+static amp_buffer* get_implicit_buffer(const void *buffer_ptr, size_t byte_len)
+{
+	concurrency::critical_section::scoped_lock scope_lock(g_implicit_cs);
+
+    amp_buffer *ampbuff = nullptr;
+    try
+    {
+		concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+        ampbuff = find_amp_buffer(buffer_ptr, byte_len);
+    }
+    catch (ampblas_exception&)
+    {
+        // overlapped buffer; handled below
+    }
+
+    if (ampbuff != nullptr)
+    {
+        if (ampbuff->implicit)
+        {
+            pin_implicit(ampbuff);
+        }
+        return ampbuff;
+    }
+
+    auto overlapping = find_overlapping(buffer_ptr, byte_len);
+    const char *begin = static_cast<const char*>(buffer_ptr);
+    const char *end = begin + byte_len;
+    for (auto it = overlapping.begin(); it != overlapping.end(); it++)
+    {
+        if (!(*it)->implicit || (*it)->pins != 0)
+        {
+            throw ampblas_exception("Buffer overlapped", AMPBLAS_BAD_RESOURCE);
+        }
+
+        const char *base = reinterpret_cast<const char*>((*it)->mem_base);
+        begin = std::min(begin, base);
+        end = std::max(end, base + (*it)->byte_length);
+    }
+
+    // an empty region is only valid inside a binding
+    if (byte_len == 0 && overlapping.empty())
+    {
+        return nullptr;
+    }
+
+    check_buffer_length(static_cast<size_t>(end - begin));
+    std::for_each(overlapping.begin(), overlapping.end(), evict_implicit);
+
+    trim_implicit_cache(static_cast<size_t>(end - begin));
+
+    void *base = const_cast<char*>(begin);
+	std::unique_ptr<amp_buffer> buff(new amp_buffer(base, static_cast<size_t>(end - begin)));
+    buff->implicit = true;
+    buff->generation = g_host_generation;
+
+    {
+		concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+        auto it = g_allocations.insert(std::make_pair(base, buff.get()));
+	    assert(it.second == true);
+    }
+
+    g_implicit_lru.push_front(buff.get());
+    buff->lru_position = g_implicit_lru.begin();
+    g_implicit_bytes += buff->byte_length;
+
+    ampbuff = buff.release();
+    count_bytes_bound(ampbuff->byte_length);
+    pin_implicit(ampbuff);
+
+    return ampbuff;
+}
+
+void set_implicit_binding(size_t cache_bytes)
+{
+	concurrency::critical_section::scoped_lock scope_lock(g_implicit_cs);
+
+    g_implicit_capacity = cache_bytes;
+    trim_implicit_cache(0);
+}
+
+void invalidate_implicit(const void *buffer_ptr, size_t byte_len)
+{
+	concurrency::critical_section::scoped_lock scope_lock(g_implicit_cs);
+
+    if (buffer_ptr == nullptr)
+    {
+        g_host_generation++;
+        return;
+    }
+
+    auto overlapping = find_overlapping(buffer_ptr, byte_len);
+    for (auto it = overlapping.begin(); it != overlapping.end(); it++)
+    {
+        if ((*it)->implicit)
+        {
+            (*it)->generation = 0;
+        }
+    }
+}
+
+void release_implicit_bindings()
+{
+    if (g_implicit_capacity == 0 && g_implicit_bytes == 0)
+    {
+        return;
+    }
+
+    std::vector<amp_buffer*>& pins = get_current_thread_context(GetCurrentThreadId())->implicit_pins;
+    if (pins.empty())
+    {
+        return;
+    }
+
+	concurrency::critical_section::scoped_lock scope_lock(g_implicit_cs);
+
+    // Pins left by a routine that failed are released by the next call on this thread.
+    // Unpinning first keeps a failed write back from leaving them pinned; the lock keeps 
+    // them from being evicted meanwhile.
+    std::vector<amp_buffer*> released;
+    released.swap(pins);
+    for (auto it = released.begin(); it != released.end(); it++)
+    {
+        (*it)->pins--;
+    }
+
+    // results are expected in host memory when a routine returns
+    for (auto it = released.begin(); it != released.end(); it++)
+    {
+        synchronize_dirty(**it, 0, (*it)->byte_length);
+    }
+
+    trim_implicit_cache(0);
+}
+
+// Returns the bound buffer containing [buffer_ptr, buffer_ptr+byte_len) and the byte offset of
+// buffer_ptr within it; throws if the region is not bound. An implicit binding is pinned until 
+// the calling thread releases its bindings, so another thread cannot evict it while it is used.
+static amp_buffer* get_amp_buffer(const void *buffer_ptr, size_t byte_len, uint64_t& byte_offset)
+{
+    check_buffer_length(byte_len);
+
+    amp_buffer *ampbuff = nullptr;
+    if (g_implicit_capacity != 0)
+    {
+        ampbuff = get_implicit_buffer(buffer_ptr, byte_len);
+    }
+    else
+    {
+		concurrency::critical_section::scoped_lock implicit_lock(g_implicit_cs);
+        {
+		    concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+            ampbuff = find_amp_buffer(buffer_ptr, byte_len);
+        }
+
+        // left from before the cache was disabled, and still evictable
+        if (ampbuff != nullptr && ampbuff->implicit)
+        {
+            pin_implicit(ampbuff);
+        }
+    }
+
+    if (ampbuff == nullptr)
+    {
+        throw ampblas_exception("Unbound resource", AMPBLAS_UNBOUND_RESOURCE);
+    }
+
+    byte_offset = PTR_U64(buffer_ptr) - PTR_U64(ampbuff->mem_base);
+    if (byte_offset % sizeof(int32_t) != 0)
+    {
+        throw ampblas_exception("Invalid buffer argument", AMPBLAS_INVALID_ARG);
+    }
+
+    return ampbuff;
+}
+
+// An empty operand, such as A and B of a GEMM with K == 0, is never read or written. Outside
+// every binding it gets a view of no elements rather than an implicit binding of its own.
+static concurrency::array_view<int32_t> empty_view()
+{
+    static int32_t placeholder = 0;
+    return concurrency::array_view<int32_t>(1, &placeholder).section(0, 0);
+}
+
+concurrency::array_view<int32_t> get_array_view(const void *buffer_ptr, size_t byte_len, bool read_only)
+{
+    if (byte_len == 0 && g_implicit_capacity != 0 && !ifbound(const_cast<void*>(buffer_ptr), 0))
+    {
+        return empty_view();
+    }
+
+    uint64_t byte_offset;
+    amp_buffer *ampbuff = get_amp_buffer(buffer_ptr, byte_len, byte_offset);
+
+    // a view cannot span two segments
+    concurrency::array_view<int32_t> view = ampbuff->section(byte_offset, byte_len);
+
+    // mapped pages are about to be read by the runtime
+    if (ampbuff->mapping)
+    {
+        file_mapping::prefetch(buffer_ptr, byte_len);
+    }
+
+    // the parts that are not on the accelerator yet are copied there when the routine runs
+    if (!ampbuff->reservation)
+    {
+        count_transfer(g_bytes_to_accelerator, count_bytes_to_accelerator, ampbuff->mark_resident(get_current_accelerator_view(), byte_offset, byte_offset + byte_len));
+    }
+
+    if (!read_only)
+    {
+        ampbuff->mark_dirty(byte_offset, byte_offset + byte_len);
+    }
+
+	return view;
+}
+
+void get_segment(const void *buffer_ptr, const void *&begin, const void *&end)
+{
+    // the binding is read under the lock; an implicit one can be evicted once it is released
+	concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+
+    const amp_buffer *ampbuff = find_amp_buffer(buffer_ptr, sizeof(int32_t));
+    if (ampbuff == nullptr) 
+    {
+        throw ampblas_exception("Unbound resource", AMPBLAS_UNBOUND_RESOURCE);
+    }
+
+    const uint64_t byte_offset = PTR_U64(buffer_ptr) - PTR_U64(ampbuff->mem_base);
+    const uint64_t first = byte_offset - byte_offset % ampbuff->segment_bytes;
+    const uint64_t last = std::min<uint64_t>(first + ampbuff->segment_bytes, ampbuff->byte_length);
+
+    begin = reinterpret_cast<const char*>(ampbuff->mem_base) + first;
+    end = reinterpret_cast<const char*>(ampbuff->mem_base) + last;
+}
+
+void set_segment_length(int length)
+{
+    if (length < 0 || length % 4 != 0 || length > max_segment_length)
+    {
+        throw ampblas_exception("Invalid segment length", AMPBLAS_INVALID_ARG);
+    }
+
+    t_segment_length = (length == 0 ? max_segment_length : length);
+}
+
+// Registers [buffer_ptr, buffer_ptr+byte_len) as an explicit binding that owns allocation
+static void bind_host_memory(void *buffer_ptr, size_t byte_len, std::unique_ptr<host_allocation> allocation)
+{
+    // an explicit binding replaces the implicit bindings it overlaps
+	concurrency::critical_section::scoped_lock implicit_lock(g_implicit_cs);
+    auto overlapping = find_overlapping(buffer_ptr, byte_len);
+    for (auto it = overlapping.begin(); it != overlapping.end(); it++)
+    {
+        if ((*it)->implicit && (*it)->pins == 0)
+        {
+            evict_implicit(*it);
+        }
+    }
+
+	concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+
+    auto ampbuff = find_amp_buffer(buffer_ptr, byte_len);
+    if (ampbuff != nullptr)
+    {
+		throw ampblas_exception("Duplicate binding", AMPBLAS_BAD_RESOURCE);
+    }
+        
+	std::unique_ptr<amp_buffer> buff(new amp_buffer(buffer_ptr, byte_len, std::unique_ptr<file_mapping>(), std::move(allocation)));
+
+    auto it = g_allocations.insert(std::make_pair(buffer_ptr, buff.get()));
+	assert(it.second == true);
+
+    buff.release();
+    count_bytes_bound(byte_len);
+}
+
+void bind(void *buffer_ptr, size_t byte_len)
+{
+    check_buffer_length(byte_len);
+    bind_host_memory(buffer_ptr, byte_len, std::unique_ptr<host_allocation>());
+}
+
+// Large pages are only granted to processes holding the lock pages in memory privilege, and
+// it has to be enabled in the process token first. Returns the large page size, or 0 when 
+// large pages cannot be used.
+static size_t large_page_size()
+{
+    HANDLE token;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+    {
+        return 0;
+    }
+
+    TOKEN_PRIVILEGES privileges;
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+    // AdjustTokenPrivileges succeeds with ERROR_NOT_ALL_ASSIGNED if the privilege is not held
+    const bool enabled = LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+                         AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                         GetLastError() == ERROR_SUCCESS;
+    CloseHandle(token);
+
+    return enabled ? GetLargePageMinimum() : 0;
+}
+
+// The allocation is rounded up to whole cache lines, or whole large pages, and all of it is
+// bound, so the length of the buffer does not have to be a multiple of int32_t size. NUMA
+// placed memory comes from host_numa_alloc, which commits and touches every page on its node
+// before the buffer is bound, so host routines find the owner of each column block from the
+// first call on.
+void *allocate(size_t byte_len, unsigned int flags)
+{
+    // a NUMA placement cannot be combined with large pages or with the other placement
+    const unsigned int numa_flags = AmpblasAllocNumaBlocked | AmpblasAllocNumaInterleaved;
+    if (byte_len == 0 || byte_len > SIZE_MAX - allocation_alignment || (flags & ~(AmpblasAllocLargePages | numa_flags)) != 0 ||
+        ((flags & numa_flags) != 0 && (flags & ~numa_flags) != 0) || (flags & numa_flags) == numa_flags)
+    {
+        throw ampblas_exception("Invalid allocation argument", AMPBLAS_INVALID_ARG);
+    }
+
+    size_t alloc_len = (byte_len + allocation_alignment - 1) & ~(allocation_alignment - 1);
+    void *buffer_ptr = nullptr;
+    host_allocation::allocation_kind kind = host_allocation::aligned;
+
+    if (flags & numa_flags)
+    {
+        const enum class ampblas::_detail::host_placement placement = (flags & AmpblasAllocNumaBlocked) ? ampblas::_detail::host_placement::blocked : ampblas::_detail::host_placement::interleaved;
+        try
+        {
+            buffer_ptr = ampblas::_detail::host_numa_alloc(alloc_len, placement);
+        }
+        catch (std::bad_alloc&)
+        {
+            throw ampblas_exception("Unable to allocate host memory", AMPBLAS_OUT_OF_MEMORY);
+        }
+        kind = host_allocation::numa;
+    }
+
+    // without large pages the allocation falls back to ordinary pages
+    if (flags & AmpblasAllocLargePages)
+    {
+        static const size_t large_page = large_page_size();
+        if (large_page != 0 && alloc_len <= SIZE_MAX - large_page)
+        {
+            const size_t large_len = (alloc_len + large_page - 1) / large_page * large_page;
+            buffer_ptr = VirtualAlloc(nullptr, large_len, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (buffer_ptr != nullptr)
+            {
+                alloc_len = large_len;
+                kind = host_allocation::large_pages;
+            }
+        }
+    }
+
+    if (buffer_ptr == nullptr)
+    {
+        buffer_ptr = _aligned_malloc(alloc_len, allocation_alignment);
+        if (buffer_ptr == nullptr)
+        {
+            throw ampblas_exception("Unable to allocate host memory", AMPBLAS_OUT_OF_MEMORY);
+        }
+    }
+
+    bind_host_memory(buffer_ptr, alloc_len, std::unique_ptr<host_allocation>(new host_allocation(buffer_ptr, kind)));
+    return buffer_ptr;
+}
+
+// Opens a matrix file and reads its header; throws if it is not a matrix file
+static HANDLE open_matrix_file(const char *path, ampblas_file_header& header, bool& writable)
+{
+    writable = true;
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        writable = false;
+        file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    }
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw ampblas_exception("Unable to open matrix file", AMPBLAS_BAD_RESOURCE);
+    }
+
+    DWORD read = 0;
+    if (!ReadFile(file, &header, sizeof(header), &read, nullptr) || read != sizeof(header) ||
+        header.magic != AMPBLAS_FILE_MAGIC || header.version != AMPBLAS_FILE_VERSION)
+    {
+        CloseHandle(file);
+        throw ampblas_exception("Not a matrix file", AMPBLAS_BAD_RESOURCE);
+    }
+
+    return file;
+}
+
+void read_file_header(const char *path, struct ampblas_file_header *header)
+{
+    bool writable;
+    CloseHandle(open_matrix_file(path, *header, writable));
+}
+
+void create_file(const char *path, size_t element_size, size_t rows, size_t cols)
+{
+    if (element_size == 0 || element_size % sizeof(int32_t) != 0)
+    {
+        throw ampblas_exception("Invalid element size", AMPBLAS_INVALID_ARG);
+    }
+
+    ampblas_file_header header = {};
+    header.magic = AMPBLAS_FILE_MAGIC;
+    header.version = AMPBLAS_FILE_VERSION;
+    header.element_size = static_cast<unsigned int>(element_size);
+    header.rows = rows;
+    header.cols = cols;
+    header.ld = rows;
+
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw ampblas_exception("Unable to create matrix file", AMPBLAS_BAD_RESOURCE);
+    }
+
+    // extending the file leaves the elements zero filled
+    LARGE_INTEGER size;
+    size.QuadPart = static_cast<LONGLONG>(sizeof(header) + static_cast<uint64_t>(rows) * cols * element_size);
+
+    DWORD written = 0;
+    const bool ok = WriteFile(file, &header, sizeof(header), &written, nullptr) && written == sizeof(header) &&
+                    SetFilePointerEx(file, size, nullptr, FILE_BEGIN) && SetEndOfFile(file);
+    CloseHandle(file);
+
+    if (!ok)
+    {
+        throw ampblas_exception("Unable to create matrix file", AMPBLAS_BAD_RESOURCE);
+    }
 }
 
-concurrency::array_view<int32_t> get_array_view(const void *buffer_ptr, size_t byte_len)
+void *bind_file(const char *path, size_t offset, size_t byte_len)
 {
-    const amp_buffer *ampbuff = nullptr;
+    if (path == nullptr || offset % sizeof(int32_t) != 0)
     {
-		concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
-        ampbuff = find_amp_buffer(buffer_ptr, byte_len);
+        throw ampblas_exception("Invalid file argument", AMPBLAS_INVALID_ARG);
     }
 
-    if (ampbuff == nullptr) 
+    ampblas_file_header header;
+    bool writable;
+    HANDLE file = open_matrix_file(path, header, writable);
+
+    // everything past the header is element data
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(file, &file_size);
+    const uint64_t data_len = static_cast<uint64_t>(file_size.QuadPart) - sizeof(header);
+
+    if (byte_len == 0 && offset < data_len)
     {
-        throw ampblas_exception("Unbound resource", AMPBLAS_UNBOUND_RESOURCE);
+        byte_len = static_cast<size_t>(data_len - offset);
     }
 
-    check_buffer_length(byte_len);
-	int elem_len = static_cast<int>(byte_len / sizeof(int32_t));
+    if (byte_len == 0 || offset + static_cast<uint64_t>(byte_len) > data_len)
+    {
+        CloseHandle(file);
+        throw ampblas_exception("Invalid file range", AMPBLAS_INVALID_ARG);
+    }
 
-    uint64_t byte_offset = PTR_U64(buffer_ptr) - PTR_U64(ampbuff->mem_base);
-    if (byte_offset % sizeof(int32_t) != 0)
+    try
     {
-        throw ampblas_exception("Invalid buffer argument", AMPBLAS_INVALID_ARG);
+        check_buffer_length(byte_len);
+    }
+    catch (...)
+    {
+        CloseHandle(file);
+        throw;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        throw ampblas_exception("Unable to map matrix file", AMPBLAS_BAD_RESOURCE);
+    }
+
+    // views start on an allocation granularity boundary
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const uint64_t start = sizeof(header) + static_cast<uint64_t>(offset);
+    const uint64_t view_start = start - start % info.dwAllocationGranularity;
+    const size_t view_len = static_cast<size_t>(start - view_start) + byte_len;
+
+    void *view_base = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_COPY, static_cast<DWORD>(view_start >> 32), static_cast<DWORD>(view_start), view_len);
+    if (view_base == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw ampblas_exception("Unable to map matrix file", AMPBLAS_OUT_OF_MEMORY);
     }
 
-    uint64_t elem_offset = byte_offset / sizeof(int32_t);
-    assert(elem_offset <= INT_MAX);
+    std::unique_ptr<file_mapping> owner(new file_mapping(file, mapping, view_base));
+    void *buffer_ptr = static_cast<char*>(view_base) + (start - view_start);
+
+	concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+
+	std::unique_ptr<amp_buffer> buff(new amp_buffer(buffer_ptr, byte_len, std::move(owner)));
 
-	return ampbuff->storage.section(concurrency::index<1>(static_cast<int>(elem_offset)), concurrency::extent<1>(elem_len));
+    auto it = g_allocations.insert(std::make_pair(buffer_ptr, buff.get()));
+	assert(it.second == true);
+
+    buff.release();
+    count_bytes_bound(byte_len);
+    return buffer_ptr;
 }
 
-void bind(void *buffer_ptr, size_t byte_len)
+// The imported view is entered in the registry under addresses reserved for it. They are 
+// never committed, so the registration costs no memory and any host access through them
+// faults instead of reading stale data.
+void *bind_array_view(const concurrency::array_view<int32_t>& view)
 {
-    check_buffer_length(byte_len);
-	concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+    const size_t byte_len = static_cast<size_t>(view.extent.size()) * sizeof(int32_t);
+    if (byte_len == 0 || view.extent[0] > max_segment_length)
+    {
+        throw ampblas_exception("Invalid array_view argument", AMPBLAS_INVALID_ARG);
+    }
 
-    auto ampbuff = find_amp_buffer(buffer_ptr, byte_len);
-    if (ampbuff != nullptr)
+    void *buffer_ptr = VirtualAlloc(nullptr, byte_len, MEM_RESERVE, PAGE_NOACCESS);
+    if (buffer_ptr == nullptr)
     {
-		throw ampblas_exception("Duplicate binding", AMPBLAS_BAD_RESOURCE);
+        throw ampblas_exception("Unable to reserve address space", AMPBLAS_OUT_OF_MEMORY);
     }
-        
-	std::unique_ptr<amp_buffer> buff(new amp_buffer(buffer_ptr, byte_len));
+
+    std::unique_ptr<address_reservation> owner(new address_reservation(buffer_ptr));
+
+	concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+
+	std::unique_ptr<amp_buffer> buff(new amp_buffer(buffer_ptr, view, std::move(owner)));
+
     auto it = g_allocations.insert(std::make_pair(buffer_ptr, buff.get()));
 	assert(it.second == true);
 
     buff.release();
+    count_bytes_bound(byte_len);
+    return buffer_ptr;
 }
 
 bool unbind(void *buffer_ptr)
@@ -282,12 +1352,43 @@ bool unbind(void *buffer_ptr)
 		concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
 
         auto it = g_allocations.find(buffer_ptr);
-        if (it == g_allocations.end())
+        if (it == g_allocations.end() || it->second->implicit || it->second->allocation)
+        {
+            // unbound buffer, one that is managed by the implicit binding cache, or one that
+            // has to be released with deallocate
+            return false;
+        }
+
+        if (g_last_found == it->second)
+        {
+            g_last_found = nullptr;
+        }
+
+        ampbuff.reset(it->second);
+		g_allocations.erase(it);
+	}
+
+    return true;
+}
+
+// The views are released before the memory, so nothing is written back to freed memory
+bool deallocate(void *buffer_ptr)
+{
+	std::unique_ptr<amp_buffer> ampbuff;
+	{
+		concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+
+        auto it = g_allocations.find(buffer_ptr);
+        if (it == g_allocations.end() || !it->second->allocation)
         {
-            // unbound buffer
             return false;
         }
 
+        if (g_last_found == it->second)
+        {
+            g_last_found = nullptr;
+        }
+
         ampbuff.reset(it->second);
 		g_allocations.erase(it);
 	}
@@ -311,22 +1412,175 @@ bool ifbound(void *buffer_ptr, size_t byte_len)
     }
 }
 
+// Only the dirty parts of the region can be newer on an accelerator than in host memory, so
+// they are the only parts copied back.
 void synchronize(void *buffer_ptr, size_t byte_len)
 {
-    check_buffer_length(byte_len);
-	get_array_view(buffer_ptr, byte_len).synchronize();
+    uint64_t byte_offset;
+    amp_buffer *ampbuff = get_amp_buffer(buffer_ptr, byte_len, byte_offset);
+
+    synchronize_dirty(*ampbuff, byte_offset, byte_offset + byte_len);
 }
 
 void discard(void *buffer_ptr, size_t byte_len)
 {
-    check_buffer_length(byte_len);
-	get_array_view(buffer_ptr, byte_len).discard_data();
+    uint64_t byte_offset;
+    amp_buffer *ampbuff = get_amp_buffer(buffer_ptr, byte_len, byte_offset);
+
+    for_each_section(*ampbuff, byte_offset, byte_offset + byte_len, [] (const concurrency::array_view<int32_t>& view) { view.discard_data(); });
+    ampbuff->clear_dirty(byte_offset, byte_offset + byte_len);
+
+    // the next routine finds the region on the accelerator without a copy
+    if (!ampbuff->reservation)
+    {
+        ampbuff->mark_resident(get_current_accelerator_view(), byte_offset, byte_offset + byte_len);
+    }
 }
 
+// Host memory becomes the current copy of the region, so pending accelerator writes to it
+// are dropped along with their dirty marks. Only the parts that may have been copied to an
+// accelerator have anything to invalidate; refreshing the rest is skipped.
 void refresh(void *buffer_ptr, size_t byte_len)
+{
+    uint64_t byte_offset;
+    amp_buffer *ampbuff = get_amp_buffer(buffer_ptr, byte_len, byte_offset);
+
+    if (ampbuff->reservation)
+    {
+        for_each_section(*ampbuff, byte_offset, byte_offset + byte_len, [] (const concurrency::array_view<int32_t>& view) { view.refresh(); });
+    }
+    else
+    {
+        refresh_resident(*ampbuff, byte_offset, byte_offset + byte_len);
+    }
+
+    ampbuff->clear_dirty(byte_offset, byte_offset + byte_len);
+}
+
+// Starts copying the parts of the region that are not current on accl_view there by capturing
+// them in a kernel that does nothing. Nothing waits for the copy, so it overlaps whatever the
+// caller does until the first routine using the region.
+void prefetch(const void *buffer_ptr, size_t byte_len, const concurrency::accelerator_view& accl_view)
+{
+    uint64_t byte_offset;
+    amp_buffer *ampbuff = get_amp_buffer(buffer_ptr, byte_len, byte_offset);
+
+    // an imported view is on its accelerator already
+    if (ampbuff->reservation)
+    {
+        return;
+    }
+
+    auto ranges = ampbuff->mark_resident(accl_view, byte_offset, byte_offset + byte_len);
+    for (auto it = ranges.begin(); it != ranges.end(); it++)
+    {
+        for_each_section(*ampbuff, it->first, it->second, [&accl_view] (const concurrency::array_view<int32_t>& view)
+        {
+            concurrency::array_view<const int32_t> data(view);
+            concurrency::parallel_for_each(accl_view, concurrency::extent<1>(1), [=] (concurrency::index<1> idx) restrict(amp)
+            {
+                (void)data[idx];
+            });
+        });
+    }
+
+    count_transfer(g_bytes_to_accelerator, count_bytes_to_accelerator, ranges);
+}
+
+void get_transfer_stats(struct ampblas_transfer_stats *stats)
+{
+    stats->bytes_to_accelerator = static_cast<unsigned long long>(g_bytes_to_accelerator);
+    stats->bytes_to_host = static_cast<unsigned long long>(g_bytes_to_host);
+}
+
+void reset_transfer_stats()
+{
+    InterlockedExchange64(&g_bytes_to_accelerator, 0);
+    InterlockedExchange64(&g_bytes_to_host, 0);
+}
+
+//----------------------------------------------------------------------------
+// Host dispatch
+//
+// Routines that run on the host work on bound memory in place. Regions that are not bound
+// are left unbound, and g_implicit_cs is held so implicit bindings are not evicted while
+// they are inspected.
+//----------------------------------------------------------------------------
+
+// Returns the binding containing [buffer_ptr, buffer_ptr+byte_len) and the byte offset of
+// buffer_ptr within it, or nullptr if the region is not bound
+static amp_buffer* find_host_region(const void *buffer_ptr, size_t byte_len, uint64_t& byte_offset)
 {
     check_buffer_length(byte_len);
-    get_array_view(buffer_ptr, byte_len).refresh();
+	concurrency::critical_section::scoped_lock scope_lock(g_allocations_cs);
+
+    amp_buffer *ampbuff = find_amp_buffer(buffer_ptr, byte_len);
+    if (ampbuff != nullptr)
+    {
+        byte_offset = PTR_U64(buffer_ptr) - PTR_U64(ampbuff->mem_base);
+    }
+
+    return ampbuff;
+}
+
+bool get_region_cost(const void *buffer_ptr, size_t byte_len, const concurrency::accelerator_view& accl_view, region_cost& cost)
+{
+	concurrency::critical_section::scoped_lock scope_lock(g_implicit_cs);
+
+    uint64_t byte_offset;
+    amp_buffer *ampbuff = nullptr;
+    try
+    {
+        ampbuff = find_host_region(buffer_ptr, byte_len, byte_offset);
+    }
+    catch (ampblas_exception&)
+    {
+        // overlapped buffer or bad length; the accelerator path reports it
+        return false;
+    }
+
+    if (ampbuff == nullptr)
+    {
+        // an implicit binding would copy the whole region over and the results back
+        cost.to_accelerator = byte_len;
+        cost.to_host = 0;
+        cost.write_back = true;
+        return g_implicit_capacity != 0;
+    }
+
+    if (ampbuff->reservation)
+    {
+        return false;
+    }
+
+    ampbuff->get_cost(accl_view, byte_offset, byte_offset + byte_len, cost.to_accelerator, cost.to_host);
+    cost.write_back = ampbuff->implicit;
+    return true;
+}
+
+void begin_host_access(const void *buffer_ptr, size_t byte_len)
+{
+	concurrency::critical_section::scoped_lock scope_lock(g_implicit_cs);
+
+    uint64_t byte_offset;
+    amp_buffer *ampbuff = find_host_region(buffer_ptr, byte_len, byte_offset);
+    if (ampbuff != nullptr)
+    {
+        synchronize_dirty(*ampbuff, byte_offset, byte_offset + byte_len);
+    }
+}
+
+void end_host_write(const void *buffer_ptr, size_t byte_len)
+{
+	concurrency::critical_section::scoped_lock scope_lock(g_implicit_cs);
+
+    uint64_t byte_offset;
+    amp_buffer *ampbuff = find_host_region(buffer_ptr, byte_len, byte_offset);
+    if (ampbuff != nullptr)
+    {
+        refresh_resident(*ampbuff, byte_offset, byte_offset + byte_len);
+        ampbuff->clear_dirty(byte_offset, byte_offset + byte_len);
+    }
 }
 
 thread_context* get_current_thread_context(const DWORD tid)
@@ -359,6 +1613,29 @@ ampblas_result get_last_error()
     return curr_context->last_error_code;
 }
 
+void get_capabilities(struct ampblas_capabilities *caps)
+{
+    const ampblas::_detail::architecture_info info = ampblas::_detail::get_architecture_info(get_current_accelerator_view().accelerator);
+
+    switch (info.arch)
+    {
+    case ampblas::_detail::architecture::amd:
+        caps->architecture = AmpblasArchAMD;
+        break;
+    case ampblas::_detail::architecture::nvidia:
+    case ampblas::_detail::architecture::nvidia_xxx:
+        caps->architecture = AmpblasArchNVIDIA;
+        break;
+    default:
+        caps->architecture = AmpblasArchUnknown;
+        break;
+    }
+
+    caps->host_features = info.host_features;
+    caps->supports_double_precision = info.supports_double_precision ? 1 : 0;
+    caps->supports_limited_double_precision = info.supports_limited_double_precision ? 1 : 0;
+}
+
 } // namespace _details
 
 
@@ -392,6 +1669,7 @@ concurrency::accelerator_view get_current_accelerator_view()
         try \
         { \
             (expr);\
+            ampcblas::_details::release_implicit_bindings(); \
         } \
         catch (ampcblas::ampblas_exception &e) \
         { \
@@ -418,11 +1696,62 @@ extern "C" ampblas_result ampblas_bind(void *buffer_ptr, size_t byte_len)
     AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::bind(buffer_ptr, byte_len));
 }
 
+static ampblas_result bind_file_checked(const char *path, size_t offset, size_t length, void **buffer_ptr)
+{
+    AMPCBLAS_RUNTIME_CHECKED_CALL(*buffer_ptr = ampcblas::_details::bind_file(path, offset, length));
+}
+
+extern "C" void *ampblas_bind_file(const char *path, size_t offset, size_t length)
+{
+    void *buffer_ptr = nullptr;
+    bind_file_checked(path, offset, length, &buffer_ptr);
+    return buffer_ptr;
+}
+
+extern "C" ampblas_result ampblas_read_file_header(const char *path, struct ampblas_file_header *header)
+{
+    if (path == nullptr || header == nullptr)
+    {
+        ampblas_set_last_error(AMPBLAS_INVALID_ARG);
+        return AMPBLAS_INVALID_ARG;
+    }
+
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::read_file_header(path, header));
+}
+
+extern "C" ampblas_result ampblas_create_file(const char *path, size_t element_size, size_t rows, size_t cols)
+{
+    if (path == nullptr)
+    {
+        ampblas_set_last_error(AMPBLAS_INVALID_ARG);
+        return AMPBLAS_INVALID_ARG;
+    }
+
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::create_file(path, element_size, rows, cols));
+}
+
 extern "C" bool ampblas_unbind(void *buffer_ptr)
 {
     return ampcblas::_details::unbind(buffer_ptr);
 }
 
+static ampblas_result allocate_checked(size_t byte_len, unsigned int flags, void **buffer_ptr)
+{
+    AMPCBLAS_RUNTIME_CHECKED_CALL(*buffer_ptr = ampcblas::_details::allocate(byte_len, flags));
+}
+
+extern "C" void *ampblas_malloc(size_t byte_len, unsigned int flags)
+{
+    void *buffer_ptr = nullptr;
+    allocate_checked(byte_len, flags, &buffer_ptr);
+    return buffer_ptr;
+}
+
+extern "C" bool ampblas_free(void *buffer_ptr)
+{
+    return ampcblas::_details::deallocate(buffer_ptr);
+}
+
 extern "C" bool ampblas_ifbound(void *buffer_ptr, size_t byte_len)
 {
     return ampcblas::_details::ifbound(buffer_ptr, byte_len);
@@ -443,6 +1772,40 @@ extern "C" ampblas_result ampblas_refresh(void *buffer_ptr, size_t byte_len)
     AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::refresh(buffer_ptr, byte_len));
 }
 
+extern "C" ampblas_result ampblas_set_implicit_binding(size_t cache_bytes)
+{
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::set_implicit_binding(cache_bytes));
+}
+
+extern "C" ampblas_result ampblas_invalidate_implicit(const void *buffer_ptr, size_t byte_len)
+{
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::invalidate_implicit(buffer_ptr, byte_len));
+}
+
+extern "C" ampblas_result ampblas_set_dispatch_mode(enum AMPBLAS_DISPATCH_MODE mode)
+{
+    if (mode != AmpblasDispatchAccelerator && mode != AmpblasDispatchHost && mode != AmpblasDispatchAuto)
+        return AMPBLAS_INVALID_ARG;
+
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::set_dispatch_mode(mode));
+}
+
+extern "C" ampblas_result ampblas_get_dispatch_model(struct ampblas_dispatch_model *model)
+{
+    if (model == nullptr)
+        return AMPBLAS_INVALID_ARG;
+
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::get_dispatch_model(ampcblas::get_current_accelerator_view(), model));
+}
+
+extern "C" ampblas_result ampblas_set_dispatch_model(const struct ampblas_dispatch_model *model)
+{
+    if (model == nullptr)
+        return AMPBLAS_INVALID_ARG;
+
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::set_dispatch_model(ampcblas::get_current_accelerator_view(), model));
+}
+
 extern "C" ampblas_result ampblas_set_current_accelerator_view(void *accl_view)
 {
     if (accl_view == nullptr)
@@ -452,6 +1815,82 @@ extern "C" ampblas_result ampblas_set_current_accelerator_view(void *accl_view)
 	AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::set_current_accelerator_view(av));
 }
 
+extern "C" ampblas_result ampblas_prefetch(const void *buffer_ptr, size_t byte_len, void *accl_view)
+{
+    if (accl_view == nullptr)
+    {
+        AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::prefetch(buffer_ptr, byte_len, ampcblas::get_current_accelerator_view()));
+    }
+
+    const concurrency::accelerator_view& av = *reinterpret_cast<concurrency::accelerator_view*>(accl_view);
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::prefetch(buffer_ptr, byte_len, av));
+}
+
+extern "C" ampblas_result ampblas_get_transfer_stats(struct ampblas_transfer_stats *stats)
+{
+    if (stats == nullptr)
+        return AMPBLAS_INVALID_ARG;
+
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::get_transfer_stats(stats));
+}
+
+extern "C" ampblas_result ampblas_reset_transfer_stats()
+{
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::reset_transfer_stats());
+}
+
+extern "C" ampblas_result ampblas_get_stats(struct ampblas_stats *stats, struct ampblas_routine_stats *routines, int *count)
+{
+    if (stats == nullptr || (routines != nullptr && (count == nullptr || *count < 0)))
+        return AMPBLAS_INVALID_ARG;
+
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::get_stats(stats, routines, count));
+}
+
+extern "C" ampblas_result ampblas_reset_stats()
+{
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::reset_stats());
+}
+
+extern "C" ampblas_result ampblas_set_trace_file(const char *path)
+{
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::set_trace_file(path));
+}
+
+extern "C" ampblas_result ampblas_start_timeline(int wait_for_kernels)
+{
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampblas::start_timeline(wait_for_kernels != 0));
+}
+
+extern "C" ampblas_result ampblas_stop_timeline()
+{
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampblas::stop_timeline());
+}
+
+static void write_timeline_file(const char *path)
+{
+    if (!ampblas::write_timeline(path))
+    {
+        throw ampcblas::ampblas_exception("Unable to write timeline file", AMPBLAS_BAD_RESOURCE);
+    }
+}
+
+extern "C" ampblas_result ampblas_write_timeline(const char *path)
+{
+    if (path == nullptr)
+        return AMPBLAS_INVALID_ARG;
+
+    AMPCBLAS_RUNTIME_CHECKED_CALL(write_timeline_file(path));
+}
+
+extern "C" ampblas_result ampblas_get_capabilities(struct ampblas_capabilities *caps)
+{
+    if (caps == nullptr)
+        return AMPBLAS_INVALID_ARG;
+
+    AMPCBLAS_RUNTIME_CHECKED_CALL(ampcblas::_details::get_capabilities(caps));
+}
+
 extern "C" ampblas_result ampblas_get_last_error()
 {
     return ampcblas::_details::get_last_error();
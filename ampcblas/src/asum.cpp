@@ -42,6 +42,32 @@ typename ampblas::real_type<value_type>::type asum(const int n, const value_type
     return ampblas::asum(get_current_accelerator_view(), x_vec);
 }
 
+// ASUM with 64-bit sizes
+template <typename value_type>
+typename ampblas::real_type<value_type>::type asum_64(const ampblas_int64 n, const value_type* x, const ampblas_int64 incx)
+{
+    typedef typename ampblas::real_type<value_type>::type real_type;
+
+    // quick return
+	if (n <= 0 || incx <= 0)
+		return real_type();
+
+	// argument check
+	if (x == nullptr)
+		argument_error("asum", 2);
+
+    const strided_blocks<const value_type> x_blocks(n, x, int_arg("asum", 3, incx));
+
+    real_type ret = real_type();
+    for (ampblas_int64 i = 0, count = 0; i < n; i += count)
+    {
+        count = x_blocks.fit(i);
+        ret += asum(static_cast<int>(count), x_blocks.at(i, count), x_blocks.inc(count));
+    }
+
+    return ret;
+}
+
 } // ampcblas
 
 extern "C" {
@@ -49,6 +75,7 @@ extern "C" {
 float ampblas_sasum(const int N, const float *X, const int incX)
 {
     float ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_sasum, N, incX));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::asum(N, X, incX) );
     return ret;
 }
@@ -56,6 +83,7 @@ float ampblas_sasum(const int N, const float *X, const int incX)
 double ampblas_dasum(const int N, const double *X, const int incX)
 {
     double ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dasum, N, incX));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::asum(N, X, incX) );
     return ret;
 }
@@ -63,6 +91,7 @@ double ampblas_dasum(const int N, const double *X, const int incX)
 float ampblas_scasum(const int N, const ampblas_fcomplex *X, const int incX)
 {
     float ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_scasum, N, incX));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::asum(N, ampcblas::ampblas_cast(X), incX) );
     return ret;
 }
@@ -70,8 +99,41 @@ float ampblas_scasum(const int N, const ampblas_fcomplex *X, const int incX)
 double ampblas_dzasum(const int N, const ampblas_dcomplex *X, const int incX)
 {
     double ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dzasum, N, incX));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::asum(N, ampcblas::ampblas_cast(X), incX) );
     return ret;
 }
 
+float ampblas_sasum_64(const ampblas_int64 N, const float *X, const ampblas_int64 incX)
+{
+    float ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_sasum_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::asum_64(N, X, incX) );
+    return ret;
+}
+
+double ampblas_dasum_64(const ampblas_int64 N, const double *X, const ampblas_int64 incX)
+{
+    double ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dasum_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::asum_64(N, X, incX) );
+    return ret;
+}
+
+float ampblas_scasum_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX)
+{
+    float ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_scasum_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::asum_64(N, ampcblas::ampblas_cast(X), incX) );
+    return ret;
+}
+
+double ampblas_dzasum_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX)
+{
+    double ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dzasum_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::asum_64(N, ampcblas::ampblas_cast(X), incX) );
+    return ret;
+}
+
 } // extern "C" 
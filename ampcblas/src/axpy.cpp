@@ -21,9 +21,36 @@
 #include "ampcblas_config.h"
 
 #include "detail/axpy.h"
+#include "detail/host/kernels.h"
 
 namespace ampcblas {
 
+namespace {
+
+// runs the call on the host if that is predicted to be faster
+template <typename value_type>
+bool host_axpy(int n, value_type alpha, const value_type *x, int incx, value_type *y, int incy, std::true_type)
+{
+    if (incx != 1 || incy != 1)
+        return false;
+
+    const _details::dispatch_operand operands[] = { host_operand(x, n, false), host_operand(y, n, true) };
+    if (!dispatch_to_host<value_type>(2.0 * n, operands))
+        return false;
+
+    ampblas::_detail::host_axpy(n, alpha, x, y);
+    complete_on_host(operands);
+    return true;
+}
+
+template <typename value_type>
+bool host_axpy(int, value_type, const value_type*, int, value_type*, int, std::false_type)
+{
+    return false;
+}
+
+} // namespace
+
 // Generic AXPY algorithm for AMPBLAS arrays of type T
 template <typename value_type>
 void axpy(int n, value_type alpha, const value_type *x, int incx, value_type *y, int incy)
@@ -38,36 +65,93 @@ void axpy(int n, value_type alpha, const value_type *x, int incx, value_type *y,
     if (y == nullptr)
 		argument_error("axpy", 5);
 
+    if (host_axpy(n, alpha, x, incx, y, incy, has_host_kernels<value_type>()))
+        return;
+
     auto x_vec = make_vector_view(n, x, incx);
     auto y_vec = make_vector_view(n, y, incy);
 
     ampblas::axpy(get_current_accelerator_view(), alpha, x_vec, y_vec); 
 }
 
+// AXPY with 64-bit sizes
+template <typename value_type>
+void axpy_64(ampblas_int64 n, value_type alpha, const value_type *x, ampblas_int64 incx, value_type *y, ampblas_int64 incy)
+{
+	// quick return
+	if (n <= 0 || alpha == value_type())
+        return;
+
+    // check arguments
+    if (x == nullptr)
+		argument_error("axpy", 3);
+    if (y == nullptr)
+		argument_error("axpy", 5);
+
+    const strided_blocks<const value_type> x_blocks(n, x, int_arg("axpy", 4, incx));
+    const strided_blocks<value_type> y_blocks(n, y, int_arg("axpy", 6, incy));
+
+    for (ampblas_int64 i = 0, count = 0; i < n; i += count)
+    {
+        count = std::min(x_blocks.fit(i), y_blocks.fit(i));
+        axpy(static_cast<int>(count), alpha, x_blocks.at(i, count), x_blocks.inc(count), y_blocks.at(i, count), y_blocks.inc(count));
+    }
+}
+
 } // namespace ampcblas
 
 extern "C" {
 
 void ampblas_saxpy(const int N, const float alpha, const float *X, const int incX, float *Y, const int incY)
 {
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_saxpy, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::axpy(N, alpha, X, incX, Y, incY) );
 }
 
 void ampblas_daxpy(const int N, const double alpha, const double *X, const int incX, double *Y, const int incY)
 {
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_daxpy, N, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::axpy(N, alpha, X, incX, Y, incY) );
 }
 
 void ampblas_caxpy(const int N, const ampblas_fcomplex *alpha, const ampblas_fcomplex *X, const int incX, ampblas_fcomplex *Y, const int incY)
 {
     const ampcblas::fcomplex calpha = *ampcblas::ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_caxpy, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::axpy(N, calpha, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
 }
 
 void ampblas_zaxpy(const int N, const ampblas_dcomplex *alpha, const ampblas_dcomplex *X, const int incX, ampblas_dcomplex *Y, const int incY)
 {
     const ampcblas::dcomplex zalpha = *ampcblas::ampblas_cast(alpha);
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zaxpy, N, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::axpy(N, zalpha, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
 }
 
+void ampblas_saxpy_64(const ampblas_int64 N, const float alpha, const float *X, const ampblas_int64 incX, float *Y, const ampblas_int64 incY)
+{
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_saxpy_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ampcblas::axpy_64(N, alpha, X, incX, Y, incY) );
+}
+
+void ampblas_daxpy_64(const ampblas_int64 N, const double alpha, const double *X, const ampblas_int64 incX, double *Y, const ampblas_int64 incY)
+{
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_daxpy_64, N, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::axpy_64(N, alpha, X, incX, Y, incY) );
+}
+
+void ampblas_caxpy_64(const ampblas_int64 N, const ampblas_fcomplex *alpha, const ampblas_fcomplex *X, const ampblas_int64 incX, ampblas_fcomplex *Y, const ampblas_int64 incY)
+{
+    const ampcblas::fcomplex calpha = *ampcblas::ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_caxpy_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ampcblas::axpy_64(N, calpha, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
+}
+
+void ampblas_zaxpy_64(const ampblas_int64 N, const ampblas_dcomplex *alpha, const ampblas_dcomplex *X, const ampblas_int64 incX, ampblas_dcomplex *Y, const ampblas_int64 incY)
+{
+    const ampcblas::dcomplex zalpha = *ampcblas::ampblas_cast(alpha);
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zaxpy_64, N, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::axpy_64(N, zalpha, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
+}
+
 } // extern "C"
\ No newline at end of file
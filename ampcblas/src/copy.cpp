@@ -44,28 +44,80 @@ void copy(int n, const value_type *x, int incx, value_type *y, int incy)
 	ampblas::copy(get_current_accelerator_view(), x_vec, y_vec);
 }
 
+// COPY with 64-bit sizes
+template <typename value_type>
+void copy_64(ampblas_int64 n, const value_type *x, ampblas_int64 incx, value_type *y, ampblas_int64 incy)
+{
+	// quick return
+	if (n <= 0)
+		return;
+
+    // check arguments
+    if (x == nullptr)
+		argument_error("copy", 2);
+    if (y == nullptr)
+        argument_error("copy", 4);
+
+    const strided_blocks<const value_type> x_blocks(n, x, int_arg("copy", 3, incx));
+    const strided_blocks<value_type> y_blocks(n, y, int_arg("copy", 5, incy));
+
+    for (ampblas_int64 i = 0, count = 0; i < n; i += count)
+    {
+        count = std::min(x_blocks.fit(i), y_blocks.fit(i));
+        copy(static_cast<int>(count), x_blocks.at(i, count), x_blocks.inc(count), y_blocks.at(i, count), y_blocks.inc(count));
+    }
+}
+
 } // ampcblas
 
 extern "C" {
 
 void ampblas_scopy(const int N, const float *X, const int incX, float *Y, const int incY)
 {
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_scopy, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::copy(N, X, incX, Y, incY) );
 }
 
 void ampblas_dcopy(const int N, const double *X, const int incX, double *Y, const int incY)
 {
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dcopy, N, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::copy(N, X, incX, Y, incY) );
 }
 
 void ampblas_ccopy(const int N, const ampblas_fcomplex *X, const int incX, ampblas_fcomplex *Y, const int incY)
 {
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_ccopy, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::copy(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
 }
 
 void ampblas_zcopy(const int N, const ampblas_dcomplex *X, const int incX, ampblas_dcomplex *Y, const int incY)
 {
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zcopy, N, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::copy(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
 }
 
+void ampblas_scopy_64(const ampblas_int64 N, const float *X, const ampblas_int64 incX, float *Y, const ampblas_int64 incY)
+{
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_scopy_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ampcblas::copy_64(N, X, incX, Y, incY) );
+}
+
+void ampblas_dcopy_64(const ampblas_int64 N, const double *X, const ampblas_int64 incX, double *Y, const ampblas_int64 incY)
+{
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dcopy_64, N, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::copy_64(N, X, incX, Y, incY) );
+}
+
+void ampblas_ccopy_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX, ampblas_fcomplex *Y, const ampblas_int64 incY)
+{
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_ccopy_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ampcblas::copy_64(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
+}
+
+void ampblas_zcopy_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX, ampblas_dcomplex *Y, const ampblas_int64 incY)
+{
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zcopy_64, N, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::copy_64(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
+}
+
 } // extern "C"
\ No newline at end of file
@@ -0,0 +1,275 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * dispatch.cpp
+ *
+ * Host and accelerator dispatch of routine calls. Each accelerator gets a
+ * model of its own and the host's rates, measured by a short benchmark the
+ * first time a call is dispatched for it, from which the time of a call on
+ * either side is predicted.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <cfloat>
+#include <vector>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include "ampcblas_config.h"
+
+#include "detail/axpy.h"
+#include "detail/gemm.h"
+#include "detail/host/blas3.h"
+
+namespace ampcblas {
+namespace _details {
+
+namespace {
+
+// AmpblasDispatchAccelerator keeps the behaviour of earlier releases
+volatile long g_dispatch_mode = AmpblasDispatchAccelerator;
+
+// Dispatch models by accelerator, measured on first use or set by the caller
+concurrency::critical_section g_models_cs;
+std::vector<std::pair<concurrency::accelerator, ampblas_dispatch_model>> g_models;
+
+class stopwatch
+{
+public:
+    stopwatch()
+    {
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&start);
+    }
+
+    double us() const
+    {
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+        return 1e6 * double(now.QuadPart - start.QuadPart) / double(frequency.QuadPart);
+    }
+
+private:
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER start;
+};
+
+// Fastest of runs timed calls of op in microseconds. An untimed call comes first, so kernels
+// are compiled and memory is touched before the clock starts.
+template <typename op_type>
+double best_time(int runs, const op_type& op)
+{
+    op();
+
+    double best = DBL_MAX;
+    for (int i=0; i<runs; i++)
+    {
+        stopwatch timer;
+        op();
+        best = std::min(best, timer.us());
+    }
+
+    return std::max(best, 0.01);
+}
+
+// GFLOP/s of the host kernel of a GEMM small enough to stay in cache
+template <typename value_type>
+double host_gflops()
+{
+    const int n = 128;
+    std::vector<value_type> a(n*n, value_type(1)), b(n*n, value_type(1)), c(n*n);
+
+    const double us = best_time(3, [&] { ampblas::_detail::host_parallel_gemm(n, n, n, value_type(1), a.data(), n, b.data(), n, c.data(), n); });
+    return 2.0 * n * n * n / us / 1e3;
+}
+
+// GFLOP/s of a GEMM on accl_view, less the launch overhead
+template <typename value_type>
+double accelerator_gflops(const concurrency::accelerator_view& accl_view, double launch_us)
+{
+    const int n = 256;
+    concurrency::array<value_type,2> a(n, n, accl_view), b(n, n, accl_view), c(n, n, accl_view);
+    concurrency::array_view<value_type,2> a_mat(a), b_mat(b), c_mat(c);
+
+    const double us = best_time(3, [&]
+    {
+        ampblas::gemm(accl_view, ampblas::transpose::no_trans, ampblas::transpose::no_trans, value_type(1), a_mat, b_mat, value_type(0), c_mat);
+        accl_view.wait();
+    });
+    return 2.0 * n * n * n / std::max(us - launch_us, 0.01) / 1e3;
+}
+
+ampblas_dispatch_model measure_model(const concurrency::accelerator_view& accl_view)
+{
+    ampblas_dispatch_model model;
+
+    // host: a long AXPY streams from memory
+    {
+        const int n = 1 << 22;
+        std::vector<float> x(n, 1.0f), y(n, 1.0f);
+
+        const double us = best_time(3, [&] { ampblas::_detail::host_axpy(n, 1.0f, x.data(), y.data()); });
+        model.host_bandwidth = 3.0 * n * sizeof(float) / us / 1e3;
+        model.host_sgflops = host_gflops<float>();
+        model.host_dgflops = host_gflops<double>();
+    }
+
+    // accelerator: a routine on a single element is all overhead
+    {
+        concurrency::array<float,1> x(1, accl_view), y(1, accl_view);
+        concurrency::array_view<float,1> x_vec(x), y_vec(y);
+
+        model.launch_overhead_us = best_time(5, [&] { ampblas::axpy(accl_view, 1.0f, x_vec, y_vec); accl_view.wait(); });
+    }
+
+    {
+        const int n = 1 << 22;
+        concurrency::array<float,1> x(n, accl_view), y(n, accl_view);
+        concurrency::array_view<float,1> x_vec(x), y_vec(y);
+        std::vector<float> host(n, 1.0f);
+
+        const double us = best_time(3, [&] { ampblas::axpy(accl_view, 1.0f, x_vec, y_vec); accl_view.wait(); });
+        model.accelerator_bandwidth = 3.0 * n * sizeof(float) / std::max(us - model.launch_overhead_us, 0.01) / 1e3;
+
+        const double copy_us = best_time(3, [&] { concurrency::copy(host.begin(), host.end(), x); });
+        model.transfer_bandwidth = n * sizeof(float) / copy_us / 1e3;
+    }
+
+    model.accelerator_sgflops = accelerator_gflops<float>(accl_view, model.launch_overhead_us);
+    model.accelerator_dgflops = accl_view.accelerator.supports_limited_double_precision ? accelerator_gflops<double>(accl_view, model.launch_overhead_us) : 0.0;
+
+    return model;
+}
+
+// The model of the accelerator of accl_view. The benchmark runs under the lock, so threads
+// dispatching their first call at the same time measure it once.
+ampblas_dispatch_model find_model(const concurrency::accelerator_view& accl_view)
+{
+    concurrency::critical_section::scoped_lock scope_lock(g_models_cs);
+
+    for (auto it = g_models.begin(); it != g_models.end(); it++)
+    {
+        if (it->first == accl_view.accelerator)
+            return it->second;
+    }
+
+    const ampblas_dispatch_model model = measure_model(accl_view);
+    g_models.push_back(std::make_pair(accl_view.accelerator, model));
+    return model;
+}
+
+// Microseconds to do flops operations and move bytes at the given rates; the two overlap
+double run_time(double flops, double gflops, double bytes, double bandwidth)
+{
+    if (gflops <= 0.0)
+        return DBL_MAX;
+
+    return std::max(flops / gflops, bytes / bandwidth) / 1e3;
+}
+
+} // namespace
+
+bool dispatch_to_host(double flops, size_t element_size, const dispatch_operand *operands, int count)
+{
+    const enum AMPBLAS_DISPATCH_MODE mode = static_cast<enum AMPBLAS_DISPATCH_MODE>(g_dispatch_mode);
+    if (mode == AmpblasDispatchAccelerator)
+        return false;
+
+    const concurrency::accelerator_view accl_view = get_current_accelerator_view();
+
+    // memory traffic of the kernels, and the bytes either side has to copy first
+    double bytes = 0.0;
+    double accelerator_copies = 0.0;
+    double host_copies = 0.0;
+    for (int i=0; i<count; i++)
+    {
+        region_cost cost;
+        if (!get_region_cost(operands[i].ptr, operands[i].byte_len, accl_view, cost))
+            return false;
+
+        bytes += double(operands[i].byte_len) * (operands[i].written ? 2 : 1);
+        accelerator_copies += double(cost.to_accelerator);
+        host_copies += double(cost.to_host);
+        if (operands[i].written && cost.write_back)
+            accelerator_copies += double(operands[i].byte_len);
+    }
+
+    if (mode == AmpblasDispatchAuto)
+    {
+        const ampblas_dispatch_model model = find_model(accl_view);
+        const bool single = (element_size == sizeof(float));
+
+        const double host_us = run_time(flops, (single ? model.host_sgflops : model.host_dgflops), bytes, model.host_bandwidth)
+                             + host_copies / model.transfer_bandwidth / 1e3;
+        const double accelerator_us = model.launch_overhead_us
+                                    + run_time(flops, (single ? model.accelerator_sgflops : model.accelerator_dgflops), bytes, model.accelerator_bandwidth)
+                                    + accelerator_copies / model.transfer_bandwidth / 1e3;
+
+        if (host_us >= accelerator_us)
+            return false;
+    }
+
+    for (int i=0; i<count; i++)
+        begin_host_access(operands[i].ptr, operands[i].byte_len);
+
+    return true;
+}
+
+void complete_on_host(const dispatch_operand *operands, int count)
+{
+    for (int i=0; i<count; i++)
+    {
+        if (operands[i].written)
+            end_host_write(operands[i].ptr, operands[i].byte_len);
+    }
+}
+
+void set_dispatch_mode(enum AMPBLAS_DISPATCH_MODE mode)
+{
+    g_dispatch_mode = mode;
+}
+
+enum AMPBLAS_DISPATCH_MODE get_dispatch_mode()
+{
+    return static_cast<enum AMPBLAS_DISPATCH_MODE>(g_dispatch_mode);
+}
+
+void get_dispatch_model(const concurrency::accelerator_view& accl_view, struct ampblas_dispatch_model *model)
+{
+    *model = find_model(accl_view);
+}
+
+void set_dispatch_model(const concurrency::accelerator_view& accl_view, const struct ampblas_dispatch_model *model)
+{
+    concurrency::critical_section::scoped_lock scope_lock(g_models_cs);
+
+    for (auto it = g_models.begin(); it != g_models.end(); it++)
+    {
+        if (it->first == accl_view.accelerator)
+        {
+            it->second = *model;
+            return;
+        }
+    }
+
+    g_models.push_back(std::make_pair(accl_view.accelerator, *model));
+}
+
+} // namespace _details
+} // namespace ampcblas
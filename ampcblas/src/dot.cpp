@@ -21,15 +21,41 @@
 #include "ampcblas_config.h"
 
 #include "detail/dot.h"
+#include "detail/host/kernels.h"
 
 namespace ampcblas {
 
+namespace {
+
+// runs the call on the host if that is predicted to be faster; ret is only set then
+template <typename value_type>
+bool host_dot(int n, const value_type *x, int incx, const value_type *y, int incy, value_type& ret, std::true_type)
+{
+    if (incx != 1 || incy != 1)
+        return false;
+
+    const _details::dispatch_operand operands[] = { host_operand(x, n, false), host_operand(y, n, false) };
+    if (!dispatch_to_host<value_type>(2.0 * n, operands))
+        return false;
+
+    ret = ampblas::_detail::host_dot(n, x, y);
+    return true;
+}
+
+template <typename value_type, typename accumulation_type>
+bool host_dot(int, const value_type*, int, const value_type*, int, accumulation_type&, std::false_type)
+{
+    return false;
+}
+
+} // namespace
+
 // Generic NRM2 algorithm for AMPBLAS arrays of type T
 template <typename value_type, typename accumulation_type, typename trans_op>
 accumulation_type dot(int n, const value_type *x, int incx, const value_type *y, int incy)
 {
 	// quick return
-    if (x <= 0) 
+    if (n <= 0) 
         return accumulation_type();
  
     // argument check
@@ -38,12 +64,44 @@ accumulation_type dot(int n, const value_type *x, int incx, const value_type *y,
     if (y == nullptr)
         argument_error("dot", 4);
 
+    // the host kernel accumulates in the element type, and conjugation is a no-op on it
+    accumulation_type ret = accumulation_type();
+    if (host_dot(n, x, incx, y, incy, ret, std::integral_constant<bool, has_host_kernels<value_type>::value && std::is_same<value_type, accumulation_type>::value>()))
+        return ret;
+
     auto x_vec = make_vector_view(n, x, incx);
     auto y_vec = make_vector_view(n, y, incy);
 
     return ampblas::dot<accumulation_type,trans_op>(get_current_accelerator_view(), x_vec, y_vec);
 }
 
+// DOT with 64-bit sizes; the partial results of the chunks are summed on the host
+template <typename value_type, typename accumulation_type, typename trans_op>
+accumulation_type dot_64(ampblas_int64 n, const value_type *x, ampblas_int64 incx, const value_type *y, ampblas_int64 incy)
+{
+	// quick return
+    if (n <= 0) 
+        return accumulation_type();
+ 
+    // argument check
+    if (x == nullptr)
+		argument_error("dot", 2);
+    if (y == nullptr)
+        argument_error("dot", 4);
+
+    const strided_blocks<const value_type> x_blocks(n, x, int_arg("dot", 3, incx));
+    const strided_blocks<const value_type> y_blocks(n, y, int_arg("dot", 5, incy));
+
+    accumulation_type ret = accumulation_type();
+    for (ampblas_int64 i = 0, count = 0; i < n; i += count)
+    {
+        count = std::min(x_blocks.fit(i), y_blocks.fit(i));
+        ret += dot<value_type,accumulation_type,trans_op>(static_cast<int>(count), x_blocks.at(i, count), x_blocks.inc(count), y_blocks.at(i, count), y_blocks.inc(count));
+    }
+
+    return ret;
+}
+
 } // namespace ampcblas
 
 extern "C" {
@@ -55,6 +113,7 @@ extern "C" {
 double ampblas_dsdot(const int N, const float *X, const int incX, const float *Y, const int incY)
 {
     double ret = 0;
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dsdot, N, incX, incY));
 	AMPBLAS_CHECKED_CALL( ret = ampcblas::dot<float, double, ampblas::_detail::noop>(N,X,incX,Y,incY) );
     return ret;
 }
@@ -62,6 +121,7 @@ double ampblas_dsdot(const int N, const float *X, const int incX, const float *Y
 float ampblas_sdot(const int N, const float  *X, const int incX, const float  *Y, const int incY)
 {
     float ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_sdot, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::dot<float, float, ampblas::_detail::noop>(N,X,incX,Y,incY) );
     return ret;
 }
@@ -69,6 +129,7 @@ float ampblas_sdot(const int N, const float  *X, const int incX, const float  *Y
 double ampblas_ddot(const int N, const double *X, const int incX, const double *Y, const int incY)
 {   
     double ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_ddot, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::dot<double, double, ampblas::_detail::noop>(N,X,incX,Y,incY) );
     return ret;
 }
@@ -76,25 +137,81 @@ double ampblas_ddot(const int N, const double *X, const int incX, const double *
 void ampblas_cdotu_sub(const int N, const ampblas_fcomplex *X, const int incX, const ampblas_fcomplex *Y, const int incY, ampblas_fcomplex *dotu)
 {
     ampcblas::fcomplex& ret = *ampcblas::ampblas_cast(dotu);
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_cdotu_sub, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::dot<ampcblas::fcomplex, ampcblas::fcomplex, ampblas::_detail::noop>(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
 }
 
 void ampblas_cdotc_sub(const int N, const ampblas_fcomplex *X, const int incX, const ampblas_fcomplex *Y, const int incY, ampblas_fcomplex *dotc)
 {
     ampcblas::fcomplex& ret = *ampcblas::ampblas_cast(dotc);
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_cdotc_sub, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::dot<ampcblas::fcomplex, ampcblas::fcomplex, ampblas::_detail::conjugate>(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
 }
 
 void ampblas_zdotu_sub(const int N, const ampblas_dcomplex *X, const int incX, const ampblas_dcomplex *Y, const int incY, ampblas_dcomplex *dotu)
 {
     ampcblas::dcomplex& ret = *ampcblas::ampblas_cast(dotu);
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zdotu_sub, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::dot<ampcblas::dcomplex, ampcblas::dcomplex, ampblas::_detail::noop>(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
 }
 
 void ampblas_zdotc_sub(const int N, const ampblas_dcomplex *X, const int incX, const ampblas_dcomplex *Y, const int incY, ampblas_dcomplex *dotc)
 {
     ampcblas::dcomplex& ret = *ampcblas::ampblas_cast(dotc);
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zdotc_sub, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::dot<ampcblas::dcomplex, ampcblas::dcomplex, ampblas::_detail::conjugate>(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
 }
 
+double ampblas_dsdot_64(const ampblas_int64 N, const float *X, const ampblas_int64 incX, const float *Y, const ampblas_int64 incY)
+{
+    double ret = 0;
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dsdot_64, N, incX, incY));
+	AMPBLAS_CHECKED_CALL( ret = ampcblas::dot_64<float, double, ampblas::_detail::noop>(N,X,incX,Y,incY) );
+    return ret;
+}
+
+float ampblas_sdot_64(const ampblas_int64 N, const float  *X, const ampblas_int64 incX, const float  *Y, const ampblas_int64 incY)
+{
+    float ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_sdot_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::dot_64<float, float, ampblas::_detail::noop>(N,X,incX,Y,incY) );
+    return ret;
+}
+
+double ampblas_ddot_64(const ampblas_int64 N, const double *X, const ampblas_int64 incX, const double *Y, const ampblas_int64 incY)
+{   
+    double ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_ddot_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::dot_64<double, double, ampblas::_detail::noop>(N,X,incX,Y,incY) );
+    return ret;
+}
+
+void ampblas_cdotu_sub_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX, const ampblas_fcomplex *Y, const ampblas_int64 incY, ampblas_fcomplex *dotu)
+{
+    ampcblas::fcomplex& ret = *ampcblas::ampblas_cast(dotu);
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_cdotu_sub_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::dot_64<ampcblas::fcomplex, ampcblas::fcomplex, ampblas::_detail::noop>(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
+}
+
+void ampblas_cdotc_sub_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX, const ampblas_fcomplex *Y, const ampblas_int64 incY, ampblas_fcomplex *dotc)
+{
+    ampcblas::fcomplex& ret = *ampcblas::ampblas_cast(dotc);
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_cdotc_sub_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::dot_64<ampcblas::fcomplex, ampcblas::fcomplex, ampblas::_detail::conjugate>(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
+}
+
+void ampblas_zdotu_sub_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX, const ampblas_dcomplex *Y, const ampblas_int64 incY, ampblas_dcomplex *dotu)
+{
+    ampcblas::dcomplex& ret = *ampcblas::ampblas_cast(dotu);
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zdotu_sub_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::dot_64<ampcblas::dcomplex, ampcblas::dcomplex, ampblas::_detail::noop>(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
+}
+
+void ampblas_zdotc_sub_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX, const ampblas_dcomplex *Y, const ampblas_int64 incY, ampblas_dcomplex *dotc)
+{
+    ampcblas::dcomplex& ret = *ampcblas::ampblas_cast(dotc);
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zdotc_sub_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::dot_64<ampcblas::dcomplex, ampcblas::dcomplex, ampblas::_detail::conjugate>(N, ampcblas::ampblas_cast(X), incX, ampcblas::ampblas_cast(Y), incY) );
+}
+
 } // extern "C"
@@ -21,9 +21,49 @@
 #include "ampcblas_config.h"
 
 #include "detail/gemm.h"
+#include "detail/out_of_core.h"
 
 namespace ampcblas {
 
+namespace {
+
+// runs the call on the host if that is predicted to be faster; the host kernel covers A and
+// B without transposition
+template <typename value_type>
+bool host_gemm(enum AMPBLAS_TRANSPOSE transa, enum AMPBLAS_TRANSPOSE transb, int m, int n, int k, value_type alpha, const value_type *a, int lda, const value_type *b, int ldb, value_type beta, value_type *c, int ldc, std::true_type)
+{
+    if (transa != AmpblasNoTrans || transb != AmpblasNoTrans)
+        return false;
+
+    const _details::dispatch_operand operands[] = { host_operand(a, m, k, lda, false), host_operand(b, k, n, ldb, false), host_operand(c, m, n, ldc, true) };
+    if (!dispatch_to_host<value_type>(2.0 * m * n * k, operands))
+        return false;
+
+    // C = beta * C
+    for (int j = 0; j < n; j++)
+    {
+        value_type *column = c + size_t(j) * ldc;
+        if (beta == value_type())
+            std::fill(column, column + m, value_type());
+        else if (beta != value_type(1))
+            std::transform(column, column + m, column, [beta] (value_type v) { return beta * v; });
+    }
+
+    if (alpha != value_type() && k != 0)
+        ampblas::_detail::host_parallel_gemm(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+
+    complete_on_host(operands);
+    return true;
+}
+
+template <typename value_type>
+bool host_gemm(enum AMPBLAS_TRANSPOSE, enum AMPBLAS_TRANSPOSE, int, int, int, value_type, const value_type*, int, const value_type*, int, value_type, value_type*, int, std::false_type)
+{
+    return false;
+}
+
+} // namespace
+
 template <typename value_type>
 void gemm(enum AMPBLAS_ORDER order, enum AMPBLAS_TRANSPOSE transa, enum AMPBLAS_TRANSPOSE transb, int m, int n, int k, value_type alpha, const value_type *a, int lda, const value_type *b, int ldb, value_type beta, value_type *c, int ldc) 
 {
@@ -64,6 +104,9 @@ void gemm(enum AMPBLAS_ORDER order, enum AMPBLAS_TRANSPOSE transa, enum AMPBLAS_
 	if (ldc < m) 
 		argument_error("gemm", 14);
   
+    if (host_gemm(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, has_host_kernels<value_type>()))
+        return;
+
     // create views
 	auto a_mat = make_matrix_view(a_row, a_col, a, lda);
 	auto b_mat = make_matrix_view(b_row, b_col, b, ldb);
@@ -83,17 +126,105 @@ void gemm(enum AMPBLAS_ORDER order, enum AMPBLAS_TRANSPOSE transa, enum AMPBLAS_
     ampblas::gemm(get_current_accelerator_view(), cast(transa), cast(transb), alpha, a_mat, b_mat, beta, c_mat);
 }
 
+namespace {
+
+// bytes spanned by a rows x cols column major operand
+template <typename value_type>
+size_t operand_bytes(int rows, int cols, int ld)
+{
+    return cols == 0 ? 0 : (size_t(ld) * (cols-1) + rows) * sizeof(value_type);
+}
+
+// regions too large for any binding are never bound
+bool is_bound(const void *ptr, size_t byte_len)
+{
+    try
+    {
+        return byte_len != 0 && _details::ifbound(const_cast<void*>(ptr), byte_len);
+    }
+    catch (ampblas_exception&)
+    {
+        return false;
+    }
+}
+
+} // namespace
+
+template <typename value_type>
+void gemm_out_of_core(enum AMPBLAS_ORDER order, enum AMPBLAS_TRANSPOSE transa, enum AMPBLAS_TRANSPOSE transb, int m, int n, int k, value_type alpha, const value_type *a, int lda, const value_type *b, int ldb, value_type beta, value_type *c, int ldc, size_t budget) 
+{
+	// recursive order adjustment 
+	if (order == AmpblasRowMajor)
+    {
+        gemm_out_of_core(AmpblasColMajor, transb, transa, n, m, k, alpha, b, ldb, a, lda, beta, c, ldc, budget);
+        return;
+    }
+
+    // quick return
+    if ((m == 0 || n == 0 || alpha == value_type() || k == 0) && beta == value_type(1))
+        return;
+
+    // derived parameters
+    auto a_row = (transa == AmpblasNoTrans ? m : k);
+	auto a_col = (transa == AmpblasNoTrans ? k : m);   
+	auto b_row = (transb == AmpblasNoTrans ? k : n);
+	auto b_col = (transb == AmpblasNoTrans ? n : k);
+
+	// error check
+	if (m < 0)		       
+		argument_error("gemm_out_of_core", 4);
+	if (n < 0)        
+		argument_error("gemm_out_of_core", 5);
+	if (k < 0)        
+		argument_error("gemm_out_of_core", 6);
+	if (a == nullptr) 
+		argument_error("gemm_out_of_core", 8);
+	if (lda < a_row)
+		argument_error("gemm_out_of_core", 9);
+	if (b == nullptr) 
+		argument_error("gemm_out_of_core", 10);
+	if (ldb < b_row) 
+		argument_error("gemm_out_of_core", 11);
+	if (c == nullptr) 
+		argument_error("gemm_out_of_core", 13);
+	if (ldc < m) 
+		argument_error("gemm_out_of_core", 14);
+
+    const size_t a_bytes = operand_bytes<value_type>(a_row, a_col, lda);
+    const size_t b_bytes = operand_bytes<value_type>(b_row, b_col, ldb);
+    const size_t c_bytes = operand_bytes<value_type>(m, n, ldc);
+
+    // bound operands are read from host memory, so it must be current
+    if (is_bound(a, a_bytes))
+        _details::synchronize(const_cast<value_type*>(a), a_bytes);
+    if (is_bound(b, b_bytes))
+        _details::synchronize(const_cast<value_type*>(b), b_bytes);
+
+    const bool c_bound = is_bound(c, c_bytes);
+    if (c_bound)
+        _details::synchronize(c, c_bytes);
+
+    // forward to ampblas
+    ampblas::gemm_out_of_core(get_current_accelerator_view(), cast(transa), cast(transb), m, n, k, alpha, a, lda, b, ldb, beta, c, ldc, budget == 0 ? ampblas::out_of_core_budget : budget);
+
+    // C was written directly in host memory
+    if (c_bound)
+        _details::refresh(c, c_bytes);
+}
+
 } // namespace ampcblas
 
 extern "C" {
 
 void ampblas_sgemm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const float alpha, const float *A, const int lda, const float *B, const int ldb, const float beta, float *C, const int ldc)
 {
+    const ampcblas::call_trace trace(ampcblas::gemm_call(ampcblas::routine_sgemm, Order, TransA, TransB, M, N, K, lda, ldb, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::gemm(Order, TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc) );
 }
 
 void ampblas_dgemm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const double alpha, const double *A, const int lda, const double *B, const int ldb, const double beta, double *C, const int ldc)
 {
+    const ampcblas::call_trace trace(ampcblas::gemm_call(ampcblas::routine_dgemm, Order, TransA, TransB, M, N, K, lda, ldb, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::gemm(Order, TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc) );
 }
 
@@ -101,6 +232,7 @@ void ampblas_cgemm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE
 {
     const ampcblas::fcomplex calpha = *ampcblas::ampblas_cast(alpha);
     const ampcblas::fcomplex cbeta  = *ampcblas::ampblas_cast(beta);
+    const ampcblas::call_trace trace(ampcblas::gemm_call(ampcblas::routine_cgemm, Order, TransA, TransB, M, N, K, lda, ldb, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::gemm(Order, TransA, TransB, M, N, K, calpha, ampcblas::ampblas_cast(A), lda, ampcblas::ampblas_cast(B), ldb, cbeta, ampcblas::ampblas_cast(C), ldc) );
 }
 
@@ -108,7 +240,36 @@ void ampblas_zgemm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE
 {
     const ampcblas::dcomplex zalpha = *ampcblas::ampblas_cast(alpha);
     const ampcblas::dcomplex zbeta  = *ampcblas::ampblas_cast(beta);
+    const ampcblas::call_trace trace(ampcblas::gemm_call(ampcblas::routine_zgemm, Order, TransA, TransB, M, N, K, lda, ldb, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::gemm(Order, TransA, TransB, M, N, K, zalpha, ampcblas::ampblas_cast(A), lda, ampcblas::ampblas_cast(B), ldb, zbeta, ampcblas::ampblas_cast(C), ldc) );
 }
 
+void ampblas_sgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const float alpha, const float *A, const int lda, const float *B, const int ldb, const float beta, float *C, const int ldc, const size_t budget)
+{
+    const ampcblas::call_trace trace(ampcblas::gemm_call(ampcblas::routine_sgemm_out_of_core, Order, TransA, TransB, M, N, K, lda, ldb, ldc));
+    AMPBLAS_CHECKED_CALL( ampcblas::gemm_out_of_core(Order, TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, budget) );
+}
+
+void ampblas_dgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const double alpha, const double *A, const int lda, const double *B, const int ldb, const double beta, double *C, const int ldc, const size_t budget)
+{
+    const ampcblas::call_trace trace(ampcblas::gemm_call(ampcblas::routine_dgemm_out_of_core, Order, TransA, TransB, M, N, K, lda, ldb, ldc));
+    AMPBLAS_CHECKED_CALL( ampcblas::gemm_out_of_core(Order, TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, budget) );
+}
+
+void ampblas_cgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const ampblas_fcomplex *alpha, const ampblas_fcomplex *A, const int lda, const ampblas_fcomplex *B, const int ldb, const ampblas_fcomplex *beta, ampblas_fcomplex *C, const int ldc, const size_t budget)
+{
+    const ampcblas::fcomplex calpha = *ampcblas::ampblas_cast(alpha);
+    const ampcblas::fcomplex cbeta  = *ampcblas::ampblas_cast(beta);
+    const ampcblas::call_trace trace(ampcblas::gemm_call(ampcblas::routine_cgemm_out_of_core, Order, TransA, TransB, M, N, K, lda, ldb, ldc));
+    AMPBLAS_CHECKED_CALL( ampcblas::gemm_out_of_core(Order, TransA, TransB, M, N, K, calpha, ampcblas::ampblas_cast(A), lda, ampcblas::ampblas_cast(B), ldb, cbeta, ampcblas::ampblas_cast(C), ldc, budget) );
+}
+
+void ampblas_zgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const ampblas_dcomplex *alpha, const ampblas_dcomplex *A, const int lda, const ampblas_dcomplex *B, const int ldb, const ampblas_dcomplex *beta, ampblas_dcomplex *C, const int ldc, const size_t budget)
+{
+    const ampcblas::dcomplex zalpha = *ampcblas::ampblas_cast(alpha);
+    const ampcblas::dcomplex zbeta  = *ampcblas::ampblas_cast(beta);
+    const ampcblas::call_trace trace(ampcblas::gemm_call(ampcblas::routine_zgemm_out_of_core, Order, TransA, TransB, M, N, K, lda, ldb, ldc));
+    AMPBLAS_CHECKED_CALL( ampcblas::gemm_out_of_core(Order, TransA, TransB, M, N, K, zalpha, ampcblas::ampblas_cast(A), lda, ampcblas::ampblas_cast(B), ldb, zbeta, ampcblas::ampblas_cast(C), ldc, budget) );
+}
+
 } // extern "C" 
\ No newline at end of file
@@ -21,9 +21,50 @@
 #include "ampcblas_config.h"
 
 #include "detail/gemv.h"
+#include "detail/host/kernels.h"
 
 namespace ampcblas {
 
+namespace {
+
+// y = beta * y on the host
+template <typename value_type>
+void host_scale(int n, value_type beta, value_type *y)
+{
+    if (beta == value_type())
+        std::fill(y, y + n, value_type());
+    else if (beta != value_type(1))
+        std::transform(y, y + n, y, [beta] (value_type v) { return beta * v; });
+}
+
+// runs the call on the host if that is predicted to be faster; the host kernel covers A
+// without transposition
+template <typename value_type>
+bool host_gemv(enum AMPBLAS_TRANSPOSE transa, int m, int n, value_type alpha, const value_type *a, int lda, const value_type *x, int incx, value_type beta, value_type* y, int incy, std::true_type)
+{
+    if (transa != AmpblasNoTrans || incx != 1 || incy != 1)
+        return false;
+
+    const _details::dispatch_operand operands[] = { host_operand(a, m, n, lda, false), host_operand(x, n, false), host_operand(y, m, true) };
+    if (!dispatch_to_host<value_type>(2.0 * m * n, operands))
+        return false;
+
+    host_scale(m, beta, y);
+    if (alpha != value_type())
+        ampblas::_detail::host_gemv(m, n, alpha, a, lda, x, y);
+
+    complete_on_host(operands);
+    return true;
+}
+
+template <typename value_type>
+bool host_gemv(enum AMPBLAS_TRANSPOSE, int, int, value_type, const value_type*, int, const value_type*, int, value_type, value_type*, int, std::false_type)
+{
+    return false;
+}
+
+} // namespace
+
 template <typename value_type>
 void gemv(enum AMPBLAS_ORDER order, enum AMPBLAS_TRANSPOSE transa, int m, int n, value_type alpha, const value_type *a, int lda, const value_type *x, int incx, value_type beta, value_type* y, int incy)
 {
@@ -49,6 +90,9 @@ void gemv(enum AMPBLAS_ORDER order, enum AMPBLAS_TRANSPOSE transa, int m, int n,
 	if (y == nullptr)
 		argument_error("gemv", 11);
 
+    if (host_gemv(transa, m, n, alpha, a, lda, x, incx, beta, y, incy, has_host_kernels<value_type>()))
+        return;
+
 	auto x_vec = make_vector_view((transa == AmpblasNoTrans ? n : m), x, incx);
     auto y_vec = make_vector_view((transa == AmpblasNoTrans ? m : n), y, incy);
     auto a_mat = make_matrix_view(m, n, a, lda);
@@ -65,17 +109,87 @@ void gemv(enum AMPBLAS_ORDER order, enum AMPBLAS_TRANSPOSE transa, int m, int n,
 	ampblas::gemv(get_current_accelerator_view(), cast(transa), alpha, a_mat, x_vec, beta, y_vec); 
 }
 
+// GEMV with 64-bit sizes. The columns of A are split between calls together with x
+// (no transpose) or y (transpose), and a column that crosses a segment boundary is split
+// there. M and lda have to fit in an int, and the other vector in a single segment.
+template <typename value_type>
+void gemv_64(enum AMPBLAS_ORDER order, enum AMPBLAS_TRANSPOSE transa, ampblas_int64 m, ampblas_int64 n, value_type alpha, const value_type *a, ampblas_int64 lda, const value_type *x, ampblas_int64 incx, value_type beta, value_type* y, ampblas_int64 incy)
+{
+	// quick return
+	if (m == 0 || n == 0 || (alpha == value_type() && beta == value_type(1)))
+		return;
+
+	// error check
+	if (order != AmpblasColMajor)
+        feature_not_implemented();
+	if (m < 0)
+		argument_error("gemv", 3);
+	if (n < 0)
+		argument_error("gemv", 4);
+	if (a == nullptr)
+		argument_error("gemv", 6);
+	if (lda < m)
+		argument_error("gemv", 7);
+	if (x == nullptr)
+		argument_error("gemv", 8);
+	if (y == nullptr)
+		argument_error("gemv", 11);
+
+    const int m32 = int_arg("gemv", 3, m);
+    const int lda32 = int_arg("gemv", 7, lda);
+    const bool no_trans = (transa == AmpblasNoTrans);
+
+    // A is split by columns, as is the vector of length n
+    const strided_blocks<const value_type> a_blocks(n, a, lda32);
+    const strided_blocks<const value_type> x_blocks((no_trans ? n : m), x, int_arg("gemv", 9, incx));
+    const strided_blocks<value_type> y_blocks((no_trans ? m : n), y, int_arg("gemv", 12, incy));
+
+    for (ampblas_int64 j = 0, count = 0; j < n; j += count)
+    {
+        count = std::min(a_blocks.fit(j), (no_trans ? x_blocks.fit(j) : y_blocks.fit(j)));
+
+        if (count > 1 || a_blocks.head(j) >= lda32)
+        {
+            if (no_trans)
+            {
+                // y = alpha * A(:,J) * x(J) + beta * y, scaling y by beta once
+                gemv(order, transa, m32, static_cast<int>(count), alpha, a_blocks.at(j, count), lda32, x_blocks.at(j, count), x_blocks.inc(count), (j == 0 ? beta : value_type(1)), y, y_blocks.inc(m));
+            }
+            else
+            {
+                // y(J) = alpha * A(:,J)' * x + beta * y(J)
+                gemv(order, transa, m32, static_cast<int>(count), alpha, a_blocks.at(j, count), lda32, x, x_blocks.inc(m), beta, y_blocks.at(j, count), y_blocks.inc(count));
+            }
+            continue;
+        }
+
+        // column j crosses a segment boundary; each piece is a matrix of one column
+        for (ampblas_int64 row = 0, rows = 0; row < m; row += rows)
+        {
+            rows = (row == 0 ? std::min(m, a_blocks.head(j)) : m - row);
+            const value_type *a_piece = a_blocks.block(j) + row;
+
+            if (no_trans)
+                gemv(order, transa, static_cast<int>(rows), 1, alpha, a_piece, static_cast<int>(rows), x_blocks.block(j), 1, (j == 0 ? beta : value_type(1)), y_blocks.at(row, rows), y_blocks.inc(rows));
+            else
+                gemv(order, transa, static_cast<int>(rows), 1, alpha, a_piece, static_cast<int>(rows), x_blocks.at(row, rows), x_blocks.inc(rows), (row == 0 ? beta : value_type(1)), y_blocks.block(j), 1);
+        }
+    }
+}
+
 } // namespace ampcblas
 
 extern "C" {
 
 void ampblas_sgemv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE TransA, const int M, const int N, const float alpha, const float *A, const int lda, const float *X, const int incX, const float beta, float *Y, const int incY)
 {
+	const ampcblas::call_trace trace(ampcblas::gemv_call(ampcblas::routine_sgemv, order, TransA, M, N, lda, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::gemv(order, TransA, M, N, alpha, A, lda, X, incX, beta, Y, incY) );
 }
 
 void ampblas_dgemv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE TransA, const int M, const int N, const double alpha, const double *A, const int lda, const double *X, const int incX, const double beta, double *Y, const int incY)
 {
+	const ampcblas::call_trace trace(ampcblas::gemv_call(ampcblas::routine_dgemv, order, TransA, M, N, lda, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::gemv(order, TransA, M, N, alpha, A, lda, X, incX, beta, Y, incY) );
 }
 
@@ -86,6 +200,7 @@ void ampblas_cgemv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE
 
     const fcomplex calpha = *ampblas_cast(alpha);
     const fcomplex cbeta  = *ampblas_cast(beta);
+	const ampcblas::call_trace trace(ampcblas::gemv_call(ampcblas::routine_cgemv, order, TransA, M, N, lda, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::gemv(order, TransA, M, N, calpha, ampblas_cast(A), lda, ampblas_cast(X), incX, cbeta, ampblas_cast(Y), incY) );
 }
 
@@ -96,7 +211,42 @@ void ampblas_zgemv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE
 
     const dcomplex zalpha = *ampblas_cast(alpha);
     const dcomplex zbeta  = *ampblas_cast(beta);
+	const ampcblas::call_trace trace(ampcblas::gemv_call(ampcblas::routine_zgemv, order, TransA, M, N, lda, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::gemv(order, TransA, M, N, zalpha, ampblas_cast(A), lda, ampblas_cast(X), incX, zbeta, ampblas_cast(Y), incY) );
 }
 
+void ampblas_sgemv_64(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE TransA, const ampblas_int64 M, const ampblas_int64 N, const float alpha, const float *A, const ampblas_int64 lda, const float *X, const ampblas_int64 incX, const float beta, float *Y, const ampblas_int64 incY)
+{
+	const ampcblas::call_trace trace(ampcblas::gemv_call(ampcblas::routine_sgemv_64, order, TransA, M, N, lda, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::gemv_64(order, TransA, M, N, alpha, A, lda, X, incX, beta, Y, incY) );
+}
+
+void ampblas_dgemv_64(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE TransA, const ampblas_int64 M, const ampblas_int64 N, const double alpha, const double *A, const ampblas_int64 lda, const double *X, const ampblas_int64 incX, const double beta, double *Y, const ampblas_int64 incY)
+{
+	const ampcblas::call_trace trace(ampcblas::gemv_call(ampcblas::routine_dgemv_64, order, TransA, M, N, lda, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::gemv_64(order, TransA, M, N, alpha, A, lda, X, incX, beta, Y, incY) );
+}
+
+void ampblas_cgemv_64(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE TransA, const ampblas_int64 M, const ampblas_int64 N, const ampblas_fcomplex* alpha, const ampblas_fcomplex *A, const ampblas_int64 lda, const ampblas_fcomplex *X, const ampblas_int64 incX, const ampblas_fcomplex* beta, ampblas_fcomplex *Y, const ampblas_int64 incY)
+{
+    using ampcblas::fcomplex;
+    using ampcblas::ampblas_cast;
+
+    const fcomplex calpha = *ampblas_cast(alpha);
+    const fcomplex cbeta  = *ampblas_cast(beta);
+	const ampcblas::call_trace trace(ampcblas::gemv_call(ampcblas::routine_cgemv_64, order, TransA, M, N, lda, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::gemv_64(order, TransA, M, N, calpha, ampblas_cast(A), lda, ampblas_cast(X), incX, cbeta, ampblas_cast(Y), incY) );
+}
+
+void ampblas_zgemv_64(const enum AMPBLAS_ORDER order, const enum AMPBLAS_TRANSPOSE TransA, const ampblas_int64 M, const ampblas_int64 N, const ampblas_dcomplex* alpha, const ampblas_dcomplex *A, const ampblas_int64 lda, const ampblas_dcomplex *X, const ampblas_int64 incX, const ampblas_dcomplex* beta, ampblas_dcomplex *Y, const ampblas_int64 incY)
+{
+    using ampcblas::dcomplex;
+    using ampcblas::ampblas_cast;
+
+    const dcomplex zalpha = *ampblas_cast(alpha);
+    const dcomplex zbeta  = *ampblas_cast(beta);
+	const ampcblas::call_trace trace(ampcblas::gemv_call(ampcblas::routine_zgemv_64, order, TransA, M, N, lda, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::gemv_64(order, TransA, M, N, zalpha, ampblas_cast(A), lda, ampblas_cast(X), incX, zbeta, ampblas_cast(Y), incY) );
+}
+
 } // extern "C"
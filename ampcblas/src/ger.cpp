@@ -61,17 +61,77 @@ void ger(enum AMPBLAS_ORDER order, int m, int n, value_type alpha, const value_t
     ampblas::ger<trans_op>(get_current_accelerator_view(), alpha, x_vec, y_vec, a_mat);
 }
 
+// GER with 64-bit sizes. The columns of A are split between calls together with y, and 
+// a column that crosses a segment boundary is split there. M and lda have to fit in an 
+// int, and x in a single segment.
+template <typename value_type, typename trans_op>
+void ger_64(enum AMPBLAS_ORDER order, ampblas_int64 m, ampblas_int64 n, value_type alpha, const value_type *x, ampblas_int64 incx, const value_type *y, ampblas_int64 incy, value_type *a, ampblas_int64 lda)
+{
+    // recursive order adjustment
+    if (order == AmpblasRowMajor)
+    {
+        ger_64<value_type,trans_op>(AmpblasColMajor, n, m, alpha, y, incy, x, incx, a, lda);
+        return;
+    }
+
+    // quick return
+    if (m == 0 || n == 0 || alpha == value_type())
+        return;
+
+    // argument check
+    if (m < 0)
+        argument_error("ger", 2);
+    if (n < 0)
+        argument_error("ger", 3);
+    if (x == nullptr)
+        argument_error("ger", 5);
+    if (y == nullptr)
+        argument_error("ger", 7);
+    if (a == nullptr)
+        argument_error("ger", 9);
+    if (lda < m)
+        argument_error("ger", 10);
+
+    const int m32 = int_arg("ger", 2, m);
+    const int lda32 = int_arg("ger", 10, lda);
+
+    const strided_blocks<const value_type> x_blocks(m, x, int_arg("ger", 6, incx));
+    const strided_blocks<const value_type> y_blocks(n, y, int_arg("ger", 8, incy));
+    const strided_blocks<value_type> a_blocks(n, a, lda32);
+
+    for (ampblas_int64 j = 0, count = 0; j < n; j += count)
+    {
+        count = std::min(a_blocks.fit(j), y_blocks.fit(j));
+
+        if (count > 1 || a_blocks.head(j) >= lda32)
+        {
+            // A(:,J) += alpha * x * y(J)'
+            ger<value_type,trans_op>(AmpblasColMajor, m32, static_cast<int>(count), alpha, x, x_blocks.inc(m), y_blocks.at(j, count), y_blocks.inc(count), a_blocks.at(j, count), lda32);
+            continue;
+        }
+
+        // column j crosses a segment boundary; each piece is a matrix of one column
+        for (ampblas_int64 row = 0, rows = 0; row < m; row += rows)
+        {
+            rows = (row == 0 ? std::min(m, a_blocks.head(j)) : m - row);
+            ger<value_type,trans_op>(AmpblasColMajor, static_cast<int>(rows), 1, alpha, x_blocks.at(row, rows), x_blocks.inc(rows), y_blocks.block(j), 1, a_blocks.block(j) + row, static_cast<int>(rows));
+        }
+    }
+}
+
 } // namespace ampcblas
 
 extern "C" {
 
 void ampblas_sger(const enum AMPBLAS_ORDER order, const int M, const int N, const float alpha, const float *X, const int incX, const float *Y, const int incY, float *A, const int lda)
 {
+    const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_sger, order, M, N, incX, incY, lda));
     AMPBLAS_CHECKED_CALL( ampcblas::ger<float,ampblas::_detail::noop>(order, M, N, alpha, X, incX, Y, incY, A, lda) );
 }
 
 void ampblas_dger(const enum AMPBLAS_ORDER order, const int M, const int N, const double alpha, const double *X, const int incX, const double *Y, const int incY, double *A, const int lda)
 {
+	const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_dger, order, M, N, incX, incY, lda));
 	AMPBLAS_CHECKED_CALL( ampcblas::ger<double,ampblas::_detail::noop>(order, M, N, alpha, X, incX, Y, incY, A, lda) );
 }
 
@@ -81,6 +141,7 @@ void ampblas_cgeru(const enum AMPBLAS_ORDER order, const int M, const int N, con
     using ampcblas::ampblas_cast;
 
     const fcomplex calpha = *ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_cgeru, order, M, N, incX, incY, lda));
     AMPBLAS_CHECKED_CALL( ampcblas::ger<fcomplex,ampblas::_detail::noop>(order, M, N, calpha, ampblas_cast(X), incX, ampblas_cast(Y), incY, ampblas_cast(A), lda) );
 }
 
@@ -90,6 +151,7 @@ void ampblas_zgeru(const enum AMPBLAS_ORDER order, const int M, const int N, con
     using ampcblas::ampblas_cast;
 
     const dcomplex zalpha = *ampblas_cast(alpha);
+	const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_zgeru, order, M, N, incX, incY, lda));
 	AMPBLAS_CHECKED_CALL( ampcblas::ger<dcomplex,ampblas::_detail::noop>(order, M, N, zalpha, ampblas_cast(X), incX, ampblas_cast(Y), incY, ampblas_cast(A), lda) );
 }
 
@@ -99,6 +161,7 @@ void ampblas_cgerc(const enum AMPBLAS_ORDER order, const int M, const int N, con
     using ampcblas::ampblas_cast;
 
     const fcomplex calpha = *ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_cgerc, order, M, N, incX, incY, lda));
     AMPBLAS_CHECKED_CALL( ampcblas::ger<fcomplex,ampblas::_detail::conjugate>(order, M, N, calpha, ampblas_cast(X), incX, ampblas_cast(Y), incY, ampblas_cast(A), lda) );
 }
 
@@ -108,7 +171,60 @@ void ampblas_zgerc(const enum AMPBLAS_ORDER order, const int M, const int N, con
     using ampcblas::ampblas_cast;
 
     const dcomplex zalpha = *ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_zgerc, order, M, N, incX, incY, lda));
     AMPBLAS_CHECKED_CALL( ampcblas::ger<dcomplex,ampblas::_detail::conjugate>(order, M, N, zalpha, ampblas_cast(X), incX, ampblas_cast(Y), incY, ampblas_cast(A), lda) );
 }
 
+void ampblas_sger_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N, const float alpha, const float *X, const ampblas_int64 incX, const float *Y, const ampblas_int64 incY, float *A, const ampblas_int64 lda)
+{
+    const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_sger_64, order, M, N, incX, incY, lda));
+    AMPBLAS_CHECKED_CALL( ampcblas::ger_64<float,ampblas::_detail::noop>(order, M, N, alpha, X, incX, Y, incY, A, lda) );
+}
+
+void ampblas_dger_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N, const double alpha, const double *X, const ampblas_int64 incX, const double *Y, const ampblas_int64 incY, double *A, const ampblas_int64 lda)
+{
+	const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_dger_64, order, M, N, incX, incY, lda));
+	AMPBLAS_CHECKED_CALL( ampcblas::ger_64<double,ampblas::_detail::noop>(order, M, N, alpha, X, incX, Y, incY, A, lda) );
+}
+
+void ampblas_cgeru_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N, const ampblas_fcomplex* alpha, const ampblas_fcomplex *X, const ampblas_int64 incX, const ampblas_fcomplex *Y, const ampblas_int64 incY, ampblas_fcomplex *A, const ampblas_int64 lda)
+{
+    using ampcblas::fcomplex;
+    using ampcblas::ampblas_cast;
+
+    const fcomplex calpha = *ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_cgeru_64, order, M, N, incX, incY, lda));
+    AMPBLAS_CHECKED_CALL( ampcblas::ger_64<fcomplex,ampblas::_detail::noop>(order, M, N, calpha, ampblas_cast(X), incX, ampblas_cast(Y), incY, ampblas_cast(A), lda) );
+}
+
+void ampblas_zgeru_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N, const ampblas_dcomplex* alpha, const ampblas_dcomplex *X, const ampblas_int64 incX, const ampblas_dcomplex *Y, const ampblas_int64 incY, ampblas_dcomplex *A, const ampblas_int64 lda)
+{
+    using ampcblas::dcomplex;
+    using ampcblas::ampblas_cast;
+
+    const dcomplex zalpha = *ampblas_cast(alpha);
+	const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_zgeru_64, order, M, N, incX, incY, lda));
+	AMPBLAS_CHECKED_CALL( ampcblas::ger_64<dcomplex,ampblas::_detail::noop>(order, M, N, zalpha, ampblas_cast(X), incX, ampblas_cast(Y), incY, ampblas_cast(A), lda) );
+}
+
+void ampblas_cgerc_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N, const ampblas_fcomplex* alpha, const ampblas_fcomplex *X, const ampblas_int64 incX, const ampblas_fcomplex *Y, const ampblas_int64 incY, ampblas_fcomplex *A, const ampblas_int64 lda)
+{
+    using ampcblas::fcomplex;
+    using ampcblas::ampblas_cast;
+
+    const fcomplex calpha = *ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_cgerc_64, order, M, N, incX, incY, lda));
+    AMPBLAS_CHECKED_CALL( ampcblas::ger_64<fcomplex,ampblas::_detail::conjugate>(order, M, N, calpha, ampblas_cast(X), incX, ampblas_cast(Y), incY, ampblas_cast(A), lda) );
+}
+
+void ampblas_zgerc_64(const enum AMPBLAS_ORDER order, const ampblas_int64 M, const ampblas_int64 N, const ampblas_dcomplex* alpha, const ampblas_dcomplex *X, const ampblas_int64 incX, const ampblas_dcomplex *Y, const ampblas_int64 incY, ampblas_dcomplex *A, const ampblas_int64 lda)
+{
+    using ampcblas::dcomplex;
+    using ampcblas::ampblas_cast;
+
+    const dcomplex zalpha = *ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::ger_call(ampcblas::routine_zgerc_64, order, M, N, incX, incY, lda));
+    AMPBLAS_CHECKED_CALL( ampcblas::ger_64<dcomplex,ampblas::_detail::conjugate>(order, M, N, zalpha, ampblas_cast(X), incX, ampblas_cast(Y), incY, ampblas_cast(A), lda) );
+}
+
 } // extern "C"
@@ -18,6 +18,8 @@
  *
  *---------------------------------------------------------------------------*/
 
+#include <cmath>
+
 #include "ampcblas_config.h"
 
 #include "detail/nrm2.h"
@@ -40,6 +42,36 @@ value_type nrm2(int n, const value_type *x, int incx)
 	return ampblas::nrm2(get_current_accelerator_view(), x_vec);
 }
 
+// NRM2 with 64-bit sizes; the norms of the chunks are combined without overflow
+template <typename value_type>
+value_type nrm2_64(ampblas_int64 n, const value_type *x, ampblas_int64 incx)
+{
+	// quick return
+	if (n <= 0) 
+        return value_type();
+
+    // check arguments
+    if (x == nullptr)
+		argument_error("nrm2", 2);
+
+    const strided_blocks<const value_type> x_blocks(n, x, int_arg("nrm2", 3, incx));
+
+    value_type ret = value_type();
+    for (ampblas_int64 i = 0, count = 0; i < n; i += count)
+    {
+        count = x_blocks.fit(i);
+        const value_type part = nrm2(static_cast<int>(count), x_blocks.at(i, count), x_blocks.inc(count));
+
+        // sqrt(ret^2 + part^2)
+        const value_type big = std::max(ret, part);
+        const value_type small = std::min(ret, part);
+        if (big != value_type())
+            ret = big * std::sqrt(value_type(1) + (small / big) * (small / big));
+    }
+
+    return ret;
+}
+
 } // namespace ampcblas
 
 extern "C" {
@@ -47,6 +79,7 @@ extern "C" {
 float ampblas_snrm2(const int N, const float* X, int incX )
 {
     float ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_snrm2, N, incX));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::nrm2(N, X, incX) );
     return ret;
 }
@@ -54,8 +87,25 @@ float ampblas_snrm2(const int N, const float* X, int incX )
 double ampblas_dnrm2(const int N, const double* X, int incX )
 {
     double ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dnrm2, N, incX));
     AMPBLAS_CHECKED_CALL( ret = ampcblas::nrm2(N, X, incX) );
     return ret;
 }
 
+float ampblas_snrm2_64(const ampblas_int64 N, const float* X, const ampblas_int64 incX)
+{
+    float ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_snrm2_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::nrm2_64(N, X, incX) );
+    return ret;
+}
+
+double ampblas_dnrm2_64(const ampblas_int64 N, const double* X, const ampblas_int64 incX)
+{
+    double ret = 0;
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dnrm2_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ret = ampcblas::nrm2_64(N, X, incX) );
+    return ret;
+}
+
 } // extern "C"
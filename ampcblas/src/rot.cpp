@@ -43,18 +43,56 @@ void rot(int n, value_type* x, int incx, value_type* y, int incy, value_type c,
     ampblas::rot(get_current_accelerator_view(), x_vec, y_vec, c, s); 
 }
 
+// ROT with 64-bit sizes
+template <typename value_type>
+void rot_64(ampblas_int64 n, value_type* x, ampblas_int64 incx, value_type* y, ampblas_int64 incy, value_type c, value_type s)
+{
+	// quick return
+	if (n <= 0)
+		return;
+
+	// error check
+	if (x == nullptr)
+		argument_error("rot", 2);
+	if (y == nullptr)
+		argument_error("rot", 4);
+
+    const strided_blocks<value_type> x_blocks(n, x, int_arg("rot", 3, incx));
+    const strided_blocks<value_type> y_blocks(n, y, int_arg("rot", 5, incy));
+
+    for (ampblas_int64 i = 0, count = 0; i < n; i += count)
+    {
+        count = std::min(x_blocks.fit(i), y_blocks.fit(i));
+        rot(static_cast<int>(count), x_blocks.at(i, count), x_blocks.inc(count), y_blocks.at(i, count), y_blocks.inc(count), c, s);
+    }
+}
+
 } // namespace ampcblas
 
 extern "C" {
 
 void ampblas_srot(const int N, float *X, const int incX, float *Y, const int incY, const float c, const float s)
 {
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_srot, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::rot(N, X, incX, Y, incY, c, s) );
 }
 
 void ampblas_drot(const int N, double *X, const int incX, double *Y, const int incY, const double c, const double s)
 {    
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_drot, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::rot(N, X, incX, Y, incY, c, s) );
 }
 
+void ampblas_srot_64(const ampblas_int64 N, float *X, const ampblas_int64 incX, float *Y, const ampblas_int64 incY, const float c, const float s)
+{
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_srot_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ampcblas::rot_64(N, X, incX, Y, incY, c, s) );
+}
+
+void ampblas_drot_64(const ampblas_int64 N, double *X, const ampblas_int64 incX, double *Y, const ampblas_int64 incY, const double c, const double s)
+{    
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_drot_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ampcblas::rot_64(N, X, incX, Y, incY, c, s) );
+}
+
 } // extern "C"
@@ -41,17 +41,40 @@ void scal(int n, scalar_type alpha, value_type *x, int incx)
     ampblas::scal(get_current_accelerator_view(), alpha, x_vec);
 }
 
+// SCAL with 64-bit sizes
+template <typename value_type, typename scalar_type>
+void scal_64(ampblas_int64 n, scalar_type alpha, value_type *x, ampblas_int64 incx)
+{
+	// quick return
+	if (n <= 0) 
+        return;
+
+    // check arguments
+    if (x == nullptr)
+		argument_error("scal", 3);
+
+    const strided_blocks<value_type> x_blocks(n, x, int_arg("scal", 4, incx));
+
+    for (ampblas_int64 i = 0, count = 0; i < n; i += count)
+    {
+        count = x_blocks.fit(i);
+        scal(static_cast<int>(count), alpha, x_blocks.at(i, count), x_blocks.inc(count));
+    }
+}
+
 } // namespace ampcblas
 
 extern "C" {
 
 void ampblas_sscal(const int N, const float alpha, float *X, const int incX)
 {
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_sscal, N, incX));
     AMPBLAS_CHECKED_CALL( ampcblas::scal(N, alpha, X, incX) );
 }
 
 void ampblas_dscal(const int N, const double alpha, double *X, const int incX)
 {
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dscal, N, incX));
 	AMPBLAS_CHECKED_CALL( ampcblas::scal(N, alpha, X, incX) );
 }
 
@@ -61,6 +84,7 @@ void ampblas_cscal(const int N, const ampblas_fcomplex *alpha, ampblas_fcomplex
     using ampcblas::ampblas_cast;
 
 	const fcomplex calpha = *ampblas_cast(alpha);
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_cscal, N, incX));
 	AMPBLAS_CHECKED_CALL( ampcblas::scal(N, calpha, ampblas_cast(X), incX) );
 }
 
@@ -70,6 +94,7 @@ void ampblas_zscal(const int N, const ampblas_dcomplex *alpha, ampblas_dcomplex
     using ampcblas::ampblas_cast;
 
     const dcomplex zalpha = *ampblas_cast(alpha);
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zscal, N, incX));
 	AMPBLAS_CHECKED_CALL( ampcblas::scal(N, zalpha, ampblas_cast(X), incX) );
 }
 
@@ -77,6 +102,7 @@ void ampblas_csscal(const int N, const float alpha, ampblas_fcomplex *X, const i
 {
     using ampcblas::ampblas_cast;
 
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_csscal, N, incX));
     AMPBLAS_CHECKED_CALL( ampcblas::scal(N, alpha, ampblas_cast(X), incX) );
 }
 
@@ -84,7 +110,56 @@ void ampblas_zdscal(const int N, const double alpha, ampblas_dcomplex *X, const
 {
     using ampcblas::ampblas_cast;
 
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zdscal, N, incX));
 	AMPBLAS_CHECKED_CALL( ampcblas::scal(N, alpha, ampblas_cast(X), incX) );
 }
 
+void ampblas_sscal_64(const ampblas_int64 N, const float alpha, float *X, const ampblas_int64 incX)
+{
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_sscal_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ampcblas::scal_64(N, alpha, X, incX) );
+}
+
+void ampblas_dscal_64(const ampblas_int64 N, const double alpha, double *X, const ampblas_int64 incX)
+{
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dscal_64, N, incX));
+	AMPBLAS_CHECKED_CALL( ampcblas::scal_64(N, alpha, X, incX) );
+}
+
+void ampblas_cscal_64(const ampblas_int64 N, const ampblas_fcomplex *alpha, ampblas_fcomplex *X, const ampblas_int64 incX)
+{
+    using ampcblas::fcomplex;
+    using ampcblas::ampblas_cast;
+
+	const fcomplex calpha = *ampblas_cast(alpha);
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_cscal_64, N, incX));
+	AMPBLAS_CHECKED_CALL( ampcblas::scal_64(N, calpha, ampblas_cast(X), incX) );
+}
+
+void ampblas_zscal_64(const ampblas_int64 N, const ampblas_dcomplex *alpha, ampblas_dcomplex *X, const ampblas_int64 incX)
+{
+    using ampcblas::dcomplex;
+    using ampcblas::ampblas_cast;
+
+    const dcomplex zalpha = *ampblas_cast(alpha);
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zscal_64, N, incX));
+	AMPBLAS_CHECKED_CALL( ampcblas::scal_64(N, zalpha, ampblas_cast(X), incX) );
+}
+
+void ampblas_csscal_64(const ampblas_int64 N, const float alpha, ampblas_fcomplex *X, const ampblas_int64 incX)
+{
+    using ampcblas::ampblas_cast;
+
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_csscal_64, N, incX));
+    AMPBLAS_CHECKED_CALL( ampcblas::scal_64(N, alpha, ampblas_cast(X), incX) );
+}
+
+void ampblas_zdscal_64(const ampblas_int64 N, const double alpha, ampblas_dcomplex *X, const ampblas_int64 incX)
+{
+    using ampcblas::ampblas_cast;
+
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zdscal_64, N, incX));
+	AMPBLAS_CHECKED_CALL( ampcblas::scal_64(N, alpha, ampblas_cast(X), incX) );
+}
+
 } // extern "C"
\ No newline at end of file
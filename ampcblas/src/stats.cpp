@@ -0,0 +1,433 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * stats.cpp
+ *
+ * Statistics of the calls of the C entry points. Every thread counts its
+ * calls in a shard of its own, which no other thread writes, so counting
+ * takes neither a lock nor an interlocked instruction; readers sum the
+ * shards under a lock. Calls are timed with the time stamp counter, which
+ * is converted to microseconds against the performance counter when the
+ * statistics are read.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <intrin.h>
+#include <malloc.h>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include "ampcblas_config.h"
+#include "detail/gemm.h"
+
+namespace ampcblas {
+namespace _details {
+
+namespace {
+
+// Routine families by the floating point operations of a call
+enum flop_count { flops_none, flops_n, flops_2n, flops_6n, flops_2mn, flops_nn, flops_2nn, flops_2mnk, flops_nnk, flops_2nnk, flops_triangular };
+
+struct family
+{
+    const char *name;
+    flop_count flops;
+};
+
+// A routine belongs to the first family whose name is part of its own, so families whose
+// names contain others come first
+const family g_families[] =
+{
+    { "syr2k", flops_2nnk }, { "her2k", flops_2nnk }, { "syrk", flops_nnk }, { "herk", flops_nnk },
+    { "symv", flops_2nn }, { "hemv", flops_2nn }, { "syr", flops_nn }, { "her", flops_nn },
+    { "trmv", flops_nn }, { "trsv", flops_nn }, { "trmm", flops_triangular }, { "trsm", flops_triangular },
+    { "gemv", flops_2mn }, { "gemm", flops_2mnk }, { "ger", flops_2mn },
+    { "amax", flops_n }, { "asum", flops_n }, { "scal", flops_n },
+    { "axpy", flops_2n }, { "dot", flops_2n }, { "nrm2", flops_2n }, { "rot", flops_6n },
+    { "copy", flops_none }, { "swap", flops_none },
+};
+
+struct routine_counters
+{
+    unsigned long long calls;
+    unsigned long long ticks;
+    unsigned long long max_ticks;
+    unsigned long long flops;
+    unsigned long long bytes_bound;
+    unsigned long long bytes_to_accelerator;
+    unsigned long long bytes_to_host;
+    unsigned long long gemm_guarded_launches;
+    unsigned long long gemm_unguarded_launches;
+};
+
+// The counters of one thread. Bytes moved while the thread runs no routine are counted in
+// routines[routine_count]. A shard whose epoch is not g_epoch was last written before the
+// statistics were reset; its thread zeroes it when it next counts, and readers skip it.
+struct stats_shard
+{
+    volatile long epoch;
+    routine_id current;
+    routine_counters routines[routine_count + 1];
+};
+
+const size_t shard_alignment = 64;
+
+// g_shards holds the shard of every thread that has counted; shards outlive their threads,
+// so the calls of threads that have exited are not lost
+concurrency::critical_section g_shards_cs;
+std::vector<stats_shard*> g_shards;
+volatile long g_epoch = 1;
+__declspec(thread) stats_shard *t_shard = nullptr;
+
+// counts of the performance counter and of the time stamp counter when the library was loaded
+long long g_qpc_origin;
+unsigned long long g_tsc_origin;
+
+// the family of every routine, and 4 for the complex routines or 1 for the real ones
+flop_count g_routine_flops[routine_count];
+unsigned int g_routine_scales[routine_count];
+
+// Allocates and registers the calling thread's shard; nullptr if it cannot, in which case
+// the thread does not count until it can
+stats_shard *new_shard()
+{
+    stats_shard *shard = static_cast<stats_shard*>(_aligned_malloc(sizeof(stats_shard), shard_alignment));
+    if (shard == nullptr)
+        return nullptr;
+
+    memset(shard, 0, sizeof(stats_shard));
+    shard->epoch = g_epoch;
+    shard->current = routine_count;
+
+    try
+    {
+        concurrency::critical_section::scoped_lock lock(g_shards_cs);
+        g_shards.push_back(shard);
+    }
+    catch (...)
+    {
+        _aligned_free(shard);
+        return nullptr;
+    }
+
+    t_shard = shard;
+    return shard;
+}
+
+stats_shard *get_shard()
+{
+    stats_shard *shard = t_shard;
+    if (shard == nullptr)
+    {
+        shard = new_shard();
+        if (shard == nullptr)
+            return nullptr;
+    }
+
+    const long epoch = g_epoch;
+    if (shard->epoch != epoch)
+    {
+        // zeroed before the new epoch is published, so readers never see the old counts
+        memset(shard->routines, 0, sizeof(shard->routines));
+        shard->epoch = epoch;
+    }
+    return shard;
+}
+
+unsigned long long count_flops(const call_shape& shape)
+{
+    const unsigned long long m = static_cast<unsigned long long>(shape.m);
+    const unsigned long long n = static_cast<unsigned long long>(shape.n);
+    const unsigned long long k = static_cast<unsigned long long>(shape.k);
+
+    unsigned long long flops = 0;
+    switch (g_routine_flops[shape.routine])
+    {
+    case flops_n:           flops = n; break;
+    case flops_2n:          flops = 2 * n; break;
+    case flops_6n:          flops = 6 * n; break;
+    case flops_2mn:         flops = 2 * m * n; break;
+    case flops_nn:          flops = n * n; break;
+    case flops_2nn:         flops = 2 * n * n; break;
+    case flops_2mnk:        flops = 2 * m * n * k; break;
+    case flops_nnk:         flops = n * n * k; break;
+    case flops_2nnk:        flops = 2 * n * n * k; break;
+    case flops_triangular:  flops = shape.side == 'L' ? m * m * n : m * n * n; break;
+    default:                break;
+    }
+
+    return g_routine_scales[shape.routine] * flops;
+}
+
+// microseconds per tick of the time stamp counter, measured over the time since the library
+// was loaded; the counter runs at a constant rate on the processors C++ AMP supports
+double microseconds_per_tick()
+{
+    LARGE_INTEGER frequency, count;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&count);
+
+    const unsigned long long ticks = __rdtsc() - g_tsc_origin;
+    if (ticks == 0)
+        return 0.0;
+
+    return 1e6 * double(count.QuadPart - g_qpc_origin) / double(frequency.QuadPart) / double(ticks);
+}
+
+void add(routine_counters& sum, const routine_counters& counters)
+{
+    sum.calls += counters.calls;
+    sum.ticks += counters.ticks;
+    if (counters.max_ticks > sum.max_ticks)
+        sum.max_ticks = counters.max_ticks;
+    sum.flops += counters.flops;
+    sum.bytes_bound += counters.bytes_bound;
+    sum.bytes_to_accelerator += counters.bytes_to_accelerator;
+    sum.bytes_to_host += counters.bytes_to_host;
+    sum.gemm_guarded_launches += counters.gemm_guarded_launches;
+    sum.gemm_unguarded_launches += counters.gemm_unguarded_launches;
+}
+
+// the GEMM launch hook; launches are counted against the routine that made them
+void count_gemm_launch(bool guarded)
+{
+    stats_shard *shard = get_shard();
+    if (shard == nullptr)
+        return;
+
+    routine_counters& counters = shard->routines[shard->current];
+    if (guarded)
+        counters.gemm_guarded_launches++;
+    else
+        counters.gemm_unguarded_launches++;
+}
+
+void write_json(FILE *file)
+{
+    struct ampblas_stats totals;
+    std::vector<ampblas_routine_stats> routines(routine_count);
+    int count = routine_count;
+    get_stats(&totals, routines.data(), &count);
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"calls\": %llu,\n  \"total_us\": %.3f,\n  \"flops\": %llu,\n", totals.calls, totals.total_us, totals.flops);
+    fprintf(file, "  \"bytes_bound\": %llu,\n  \"bytes_to_accelerator\": %llu,\n  \"bytes_to_host\": %llu,\n",
+            totals.bytes_bound, totals.bytes_to_accelerator, totals.bytes_to_host);
+    fprintf(file, "  \"gemm_guarded_launches\": %llu,\n  \"gemm_unguarded_launches\": %llu,\n",
+            totals.gemm_guarded_launches, totals.gemm_unguarded_launches);
+    fprintf(file, "  \"routines\": [");
+
+    for (int i = 0; i < count; i++)
+    {
+        const ampblas_routine_stats& r = routines[i];
+        fprintf(file, "%s\n    {\"routine\": \"%s\", \"calls\": %llu, \"total_us\": %.3f, \"max_us\": %.3f, \"flops\": %llu, "
+                "\"bytes_bound\": %llu, \"bytes_to_accelerator\": %llu, \"bytes_to_host\": %llu}",
+                i == 0 ? "" : ",", r.routine, r.calls, r.total_us, r.max_us, r.flops, r.bytes_bound, r.bytes_to_accelerator, r.bytes_to_host);
+    }
+
+    fprintf(file, "%s]\n}\n", count == 0 ? "" : "\n  ");
+}
+
+// Classifies the routines and starts the clocks when the library is loaded, and writes the
+// statistics to the file named by AMPBLAS_STATS when it is unloaded
+class stats_environment
+{
+public:
+    stats_environment()
+    {
+        for (int i = 0; i < routine_count; i++)
+        {
+            const char type = routine_type(static_cast<routine_id>(i));
+            g_routine_scales[i] = type == 'c' || type == 'z' ? 4 : 1;
+
+            g_routine_flops[i] = flops_none;
+            for (size_t f = 0; f < sizeof(g_families) / sizeof(g_families[0]); f++)
+            {
+                if (strstr(routine_name(static_cast<routine_id>(i)), g_families[f].name) != nullptr)
+                {
+                    g_routine_flops[i] = g_families[f].flops;
+                    break;
+                }
+            }
+        }
+
+        LARGE_INTEGER count;
+        QueryPerformanceCounter(&count);
+        g_qpc_origin = count.QuadPart;
+        g_tsc_origin = __rdtsc();
+
+        ampblas::_detail::gemm_launch_hook<>::count = count_gemm_launch;
+    }
+
+    ~stats_environment()
+    {
+        char path[MAX_PATH];
+        const DWORD len = GetEnvironmentVariableA("AMPBLAS_STATS", path, sizeof(path));
+        if (len == 0 || len >= sizeof(path))
+            return;
+
+        FILE *file = nullptr;
+        if (fopen_s(&file, path, "w") != 0 || file == nullptr)
+            return;
+
+        try
+        {
+            write_json(file);
+        }
+        catch (...)
+        {
+            // the statistics are lost, not the program
+        }
+        fclose(file);
+    }
+
+private:
+    stats_environment(const stats_environment&);
+    stats_environment& operator=(const stats_environment&);
+};
+
+stats_environment g_stats_environment;
+
+} // namespace
+
+unsigned long long enter_routine(routine_id routine, routine_id& outer)
+{
+    stats_shard *shard = get_shard();
+    if (shard == nullptr)
+    {
+        outer = routine_count;
+        return 0;
+    }
+
+    outer = shard->current;
+    shard->current = routine;
+    return __rdtsc();
+}
+
+void leave_routine(const call_shape& shape, routine_id outer, unsigned long long ticks)
+{
+    // the thread had no shard when the call began
+    if (ticks == 0)
+        return;
+
+    ticks = __rdtsc() - ticks;
+    stats_shard *shard = t_shard;
+
+    shard->current = outer;
+
+    // a reset during the call leaves the shard to be zeroed by the next call
+    if (shard->epoch != g_epoch)
+        return;
+
+    routine_counters& counters = shard->routines[shape.routine];
+    counters.calls++;
+    counters.ticks += ticks;
+    if (ticks > counters.max_ticks)
+        counters.max_ticks = ticks;
+    counters.flops += count_flops(shape);
+}
+
+void count_bytes_bound(size_t byte_len)
+{
+    stats_shard *shard = get_shard();
+    if (shard != nullptr)
+        shard->routines[shard->current].bytes_bound += byte_len;
+}
+
+void count_bytes_to_accelerator(size_t byte_len)
+{
+    stats_shard *shard = get_shard();
+    if (shard != nullptr)
+        shard->routines[shard->current].bytes_to_accelerator += byte_len;
+}
+
+void count_bytes_to_host(size_t byte_len)
+{
+    stats_shard *shard = get_shard();
+    if (shard != nullptr)
+        shard->routines[shard->current].bytes_to_host += byte_len;
+}
+
+void get_stats(struct ampblas_stats *stats, struct ampblas_routine_stats *routines, int *count)
+{
+    std::vector<routine_counters> sums(routine_count + 1);
+
+    {
+        concurrency::critical_section::scoped_lock lock(g_shards_cs);
+        const long epoch = g_epoch;
+        for (auto it = g_shards.begin(); it != g_shards.end(); it++)
+        {
+            if ((*it)->epoch != epoch)
+                continue;
+
+            for (int i = 0; i <= routine_count; i++)
+                add(sums[i], (*it)->routines[i]);
+        }
+    }
+
+    const double us_per_tick = microseconds_per_tick();
+    const int capacity = routines != nullptr ? *count : 0;
+
+    memset(stats, 0, sizeof(*stats));
+    int called = 0;
+    for (int i = 0; i <= routine_count; i++)
+    {
+        const routine_counters& sum = sums[i];
+        stats->calls += sum.calls;
+        stats->total_us += us_per_tick * double(sum.ticks);
+        stats->flops += sum.flops;
+        stats->bytes_bound += sum.bytes_bound;
+        stats->bytes_to_accelerator += sum.bytes_to_accelerator;
+        stats->bytes_to_host += sum.bytes_to_host;
+        stats->gemm_guarded_launches += sum.gemm_guarded_launches;
+        stats->gemm_unguarded_launches += sum.gemm_unguarded_launches;
+
+        if (sum.calls == 0)
+            continue;
+
+        if (called < capacity)
+        {
+            ampblas_routine_stats& r = routines[called];
+            strcpy_s(r.routine, sizeof(r.routine), routine_name(static_cast<routine_id>(i)));
+            r.calls = sum.calls;
+            r.total_us = us_per_tick * double(sum.ticks);
+            r.max_us = us_per_tick * double(sum.max_ticks);
+            r.flops = sum.flops;
+            r.bytes_bound = sum.bytes_bound;
+            r.bytes_to_accelerator = sum.bytes_to_accelerator;
+            r.bytes_to_host = sum.bytes_to_host;
+        }
+        called++;
+    }
+
+    if (count != nullptr)
+        *count = called;
+}
+
+void reset_stats()
+{
+    concurrency::critical_section::scoped_lock lock(g_shards_cs);
+    InterlockedIncrement(&g_epoch);
+}
+
+} // namespace _details
+} // namespace ampcblas
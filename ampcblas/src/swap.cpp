@@ -42,17 +42,43 @@ void swap(int n, value_type *x, int incx, value_type *y, int incy)
     ampblas::swap(get_current_accelerator_view(), x_vec, y_vec);
 }
 
+// SWAP with 64-bit sizes
+template <typename value_type>
+void swap_64(ampblas_int64 n, value_type *x, ampblas_int64 incx, value_type *y, ampblas_int64 incy)
+{
+	// quick return
+	if (n <= 0 || x == y) 
+		return;
+ 
+    // check arguments
+    if (x == nullptr)
+		argument_error("swap", 2);
+	if (y == nullptr)
+		argument_error("swap", 3);
+
+    const strided_blocks<value_type> x_blocks(n, x, int_arg("swap", 3, incx));
+    const strided_blocks<value_type> y_blocks(n, y, int_arg("swap", 5, incy));
+
+    for (ampblas_int64 i = 0, count = 0; i < n; i += count)
+    {
+        count = std::min(x_blocks.fit(i), y_blocks.fit(i));
+        swap(static_cast<int>(count), x_blocks.at(i, count), x_blocks.inc(count), y_blocks.at(i, count), y_blocks.inc(count));
+    }
+}
+
 } // namespace ampcblas
 
 extern "C" {
 
 void ampblas_sswap(const int N, float *X, const int incX, float *Y, const int incY)
 {
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_sswap, N, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::swap(N, X, incX, Y, incY) );
 }
 
 void ampblas_dswap(const int N, double *X, const int incX, double *Y, const int incY)
 {
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dswap, N, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::swap(N, X, incX, Y, incY) );
 }
 
@@ -60,6 +86,7 @@ void ampblas_cswap(const int N, ampblas_fcomplex *X, const int incX, ampblas_fco
 {
     using ampcblas::ampblas_cast;
 
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_cswap, N, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::swap(N, ampblas_cast(X), incX, ampblas_cast(Y), incY) );
 }
 
@@ -67,7 +94,36 @@ void ampblas_zswap(const int N, ampblas_dcomplex *X, const int incX, ampblas_dco
 {
     using ampcblas::ampblas_cast;
 
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zswap, N, incX, incY));
 	AMPBLAS_CHECKED_CALL( ampcblas::swap(N, ampblas_cast(X), incX, ampblas_cast(Y), incY) );
 }
 
+void ampblas_sswap_64(const ampblas_int64 N, float *X, const ampblas_int64 incX, float *Y, const ampblas_int64 incY)
+{
+    const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_sswap_64, N, incX, incY));
+    AMPBLAS_CHECKED_CALL( ampcblas::swap_64(N, X, incX, Y, incY) );
+}
+
+void ampblas_dswap_64(const ampblas_int64 N, double *X, const ampblas_int64 incX, double *Y, const ampblas_int64 incY)
+{
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_dswap_64, N, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::swap_64(N, X, incX, Y, incY) );
+}
+
+void ampblas_cswap_64(const ampblas_int64 N, ampblas_fcomplex *X, const ampblas_int64 incX, ampblas_fcomplex *Y, const ampblas_int64 incY)
+{
+    using ampcblas::ampblas_cast;
+
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_cswap_64, N, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::swap_64(N, ampblas_cast(X), incX, ampblas_cast(Y), incY) );
+}
+
+void ampblas_zswap_64(const ampblas_int64 N, ampblas_dcomplex *X, const ampblas_int64 incX, ampblas_dcomplex *Y, const ampblas_int64 incY)
+{
+    using ampcblas::ampblas_cast;
+
+	const ampcblas::call_trace trace(ampcblas::vector_call(ampcblas::routine_zswap_64, N, incX, incY));
+	AMPBLAS_CHECKED_CALL( ampcblas::swap_64(N, ampblas_cast(X), incX, ampblas_cast(Y), incY) );
+}
+
 } // extern "C"
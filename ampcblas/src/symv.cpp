@@ -65,11 +65,13 @@ extern "C" {
 
 void ampblas_ssymv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo, const int N, const float alpha, const float *A, const int lda, const float *X, const int incX, const float beta, float *Y, const int incY)
 {
+    const ampcblas::call_trace trace(ampcblas::symv_call(ampcblas::routine_ssymv, order, Uplo, N, lda, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::symv<ampblas::_detail::noop>(order, Uplo, N, alpha, A, lda, X, incX, beta, Y, incY) );
 }
 
 void ampblas_dsymv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo, const int N, const double alpha, const double *A, const int lda, const double *X, const int incX, const double beta, double *Y, const int incY)
 {
+    const ampcblas::call_trace trace(ampcblas::symv_call(ampcblas::routine_dsymv, order, Uplo, N, lda, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::symv<ampblas::_detail::noop>(order, Uplo, N, alpha, A, lda, X, incX, beta, Y, incY) );
 }
 
@@ -80,6 +82,7 @@ void ampblas_chemv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo,
 
     const fcomplex calpha = *ampblas_cast(alpha);
     const fcomplex cbeta  = *ampblas_cast(beta);
+    const ampcblas::call_trace trace(ampcblas::symv_call(ampcblas::routine_chemv, order, Uplo, N, lda, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::symv<ampblas::_detail::conjugate>(order, Uplo, N, calpha, ampblas_cast(A), lda, ampblas_cast(X), incX, cbeta, ampblas_cast(Y), incY) )
 }
 
@@ -90,6 +93,7 @@ void ampblas_zhemv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo,
 
     const dcomplex zalpha = *ampblas_cast(alpha);
     const dcomplex zbeta  = *ampblas_cast(beta);
+    const ampcblas::call_trace trace(ampcblas::symv_call(ampcblas::routine_zhemv, order, Uplo, N, lda, incX, incY));
     AMPBLAS_CHECKED_CALL( ampcblas::symv<ampblas::_detail::conjugate>(order, Uplo, N, zalpha, ampblas_cast(A), lda, ampblas_cast(X), incX, zbeta, ampblas_cast(Y), incY) )
 }
 
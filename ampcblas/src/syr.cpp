@@ -66,11 +66,13 @@ extern "C" {
 
 void ampblas_ssyr(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO uplo, const int N, const float alpha, const float *X, const int incX, float *A, const int lda)
 {
+    const ampcblas::call_trace trace(ampcblas::symv_call(ampcblas::routine_ssyr, order, uplo, N, lda, incX, 0));
     AMPBLAS_CHECKED_CALL( ampcblas::syr<ampblas::_detail::noop>(order, uplo, N, alpha, X, incX, A, lda) );
 }
 
 void ampblas_dsyr(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO uplo, const int N, const double alpha, const double *X, const int incX, double *A, const int lda)
 {
+	const ampcblas::call_trace trace(ampcblas::symv_call(ampcblas::routine_dsyr, order, uplo, N, lda, incX, 0));
 	AMPBLAS_CHECKED_CALL( ampcblas::syr<ampblas::_detail::noop>(order, uplo, N, alpha, X, incX, A, lda) );
 }
 
@@ -79,6 +81,7 @@ void ampblas_cher(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO uplo,
     using ampcblas::fcomplex;
     using ampcblas::ampblas_cast;
 
+    const ampcblas::call_trace trace(ampcblas::symv_call(ampcblas::routine_cher, order, uplo, N, lda, incX, 0));
     AMPBLAS_CHECKED_CALL( ampcblas::syr<ampblas::_detail::conjugate>(order, uplo, N, alpha, ampblas_cast(X), incX, ampblas_cast(A), lda) );
 }
  
@@ -87,6 +90,7 @@ void ampblas_zher(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO uplo,
     using ampcblas::dcomplex;
     using ampcblas::ampblas_cast;
 
+    const ampcblas::call_trace trace(ampcblas::symv_call(ampcblas::routine_zher, order, uplo, N, lda, incX, 0));
     AMPBLAS_CHECKED_CALL( ampcblas::syr<ampblas::_detail::conjugate>(order, uplo, N, alpha, ampblas_cast(X), incX, ampblas_cast(A), lda) );
 }
 
@@ -84,11 +84,13 @@ extern "C" {
 
 void ampblas_ssyr2k(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE Trans, const int N, const int K, const float alpha, const float *A, const int lda, const float *B, const int ldb, const float beta, float *C, const int ldc)
 {
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_ssyr2k, Order, Uplo, Trans, N, K, lda, ldb, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syr2k<ampblas::_detail::noop>(Order, Uplo, Trans, N, K, alpha, A, lda, B, ldb, beta, C, ldc) );
 }
 
 void ampblas_dsyr2k(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE Trans, const int N, const int K, const double alpha, const double *A, const int lda, const double *B, const int ldb, const double beta, double *C, const int ldc)
 {
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_dsyr2k, Order, Uplo, Trans, N, K, lda, ldb, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syr2k<ampblas::_detail::noop>(Order, Uplo, Trans, N, K, alpha, A, lda, B, ldb, beta, C, ldc) );
 }
 
@@ -99,6 +101,7 @@ void ampblas_csyr2k(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo
 
     const fcomplex calpha = *ampblas_cast(alpha);
     const fcomplex cbeta  = *ampblas_cast(beta);
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_csyr2k, Order, Uplo, Trans, N, K, lda, ldb, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syr2k<ampblas::_detail::noop>(Order, Uplo, Trans, N, K, calpha, ampblas_cast(A), lda, ampblas_cast(B), ldb, cbeta, ampblas_cast(C), ldc) );
 }
 
@@ -109,6 +112,7 @@ void ampblas_zsyr2k(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo
 
     const dcomplex zalpha = *ampblas_cast(alpha);
     const dcomplex zbeta  = *ampblas_cast(beta);
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_zsyr2k, Order, Uplo, Trans, N, K, lda, ldb, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syr2k<ampblas::_detail::noop>(Order, Uplo, Trans, N, K, zalpha, ampblas_cast(A), lda, ampblas_cast(B), ldb, zbeta, ampblas_cast(C), ldc) );
 }
 
@@ -118,6 +122,7 @@ void ampblas_cher2k(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo
     using ampcblas::ampblas_cast;
 
     const fcomplex calpha = *ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_cher2k, Order, Uplo, Trans, N, K, lda, ldb, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syr2k<ampblas::_detail::conjugate>(Order, Uplo, Trans, N, K, calpha, ampblas_cast(A), lda, ampblas_cast(B), ldb, beta, ampblas_cast(C), ldc) );
 }
 
@@ -127,6 +132,7 @@ void ampblas_zher2k(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo
     using ampcblas::ampblas_cast;
 
     const dcomplex zalpha = *ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_zher2k, Order, Uplo, Trans, N, K, lda, ldb, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syr2k<ampblas::_detail::conjugate>(Order, Uplo, Trans, N, K, zalpha, ampblas_cast(A), lda, ampblas_cast(B), ldb, beta, ampblas_cast(C), ldc) );
 }
 
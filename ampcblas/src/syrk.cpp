@@ -77,11 +77,13 @@ extern "C" {
 
 void ampblas_ssyrk(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE Trans, const int N, const int K, const float alpha, const float *A, const int lda, const float beta, float *C, const int ldc)
 {
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_ssyrk, Order, Uplo, Trans, N, K, lda, 0, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syrk<ampblas::_detail::noop>(Order, Uplo, Trans, N, K, alpha, A, lda, beta, C, ldc) );
 }
 
 void ampblas_dsyrk(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE Trans, const int N, const int K, const double alpha, const double *A, const int lda, const double beta, double *C, const int ldc)
 {
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_dsyrk, Order, Uplo, Trans, N, K, lda, 0, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syrk<ampblas::_detail::noop>(Order, Uplo, Trans, N, K, alpha, A, lda, beta, C, ldc) );
 }
 
@@ -92,6 +94,7 @@ void ampblas_csyrk(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo,
 
     const fcomplex calpha = *ampblas_cast(alpha);
     const fcomplex cbeta  = *ampblas_cast(beta);
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_csyrk, Order, Uplo, Trans, N, K, lda, 0, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syrk<ampblas::_detail::noop>(Order, Uplo, Trans, N, K, calpha, ampblas_cast(A), lda, cbeta, ampblas_cast(C), ldc) );
 }
 
@@ -102,6 +105,7 @@ void ampblas_zsyrk(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo,
 
     const dcomplex zalpha = *ampblas_cast(alpha);
     const dcomplex zbeta  = *ampblas_cast(beta);
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_zsyrk, Order, Uplo, Trans, N, K, lda, 0, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syrk<ampblas::_detail::noop>(Order, Uplo, Trans, N, K, zalpha, ampblas_cast(A), lda, zbeta, ampblas_cast(C), ldc) );
 }
 
@@ -110,6 +114,7 @@ void ampblas_cherk(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo,
     using ampcblas::fcomplex;
     using ampcblas::ampblas_cast;
 
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_cherk, Order, Uplo, Trans, N, K, lda, 0, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syrk<ampblas::_detail::conjugate>(Order, Uplo, Trans, N, K, alpha, ampblas_cast(A), lda, beta, ampblas_cast(C), ldc) )
 }
 
@@ -118,6 +123,7 @@ void ampblas_zherk(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_UPLO Uplo,
     using ampcblas::dcomplex;
     using ampcblas::ampblas_cast;
 
+    const ampcblas::call_trace trace(ampcblas::syrk_call(ampcblas::routine_zherk, Order, Uplo, Trans, N, K, lda, 0, ldc));
     AMPBLAS_CHECKED_CALL( ampcblas::syrk<ampblas::_detail::conjugate>(Order, Uplo, Trans, N, K, alpha, ampblas_cast(A), lda, beta, ampblas_cast(C), ldc) )
 }
 
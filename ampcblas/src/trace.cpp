@@ -0,0 +1,213 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * trace.cpp
+ *
+ * Call trace of the C entry points. The trace is a CSV file with a header
+ * line and a line per call, written through a buffered stream under a lock;
+ * calls are only timed while a trace is being recorded. The kernel timeline
+ * of the ampblas layer is recorded here too when the environment asks for
+ * it.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <cstdio>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include "ampcblas_config.h"
+#include "detail/timeline.h"
+
+namespace ampcblas {
+namespace _details {
+
+namespace {
+
+#define AMPCBLAS_ROUTINE_NAME(name, type) #name,
+#define AMPCBLAS_ROUTINE_TYPE(name, type) #type[0],
+
+const char *const g_routine_names[] = { AMPCBLAS_TRACED_ROUTINES(AMPCBLAS_ROUTINE_NAME) };
+const char g_routine_types[] = { AMPCBLAS_TRACED_ROUTINES(AMPCBLAS_ROUTINE_TYPE) };
+
+#undef AMPCBLAS_ROUTINE_NAME
+#undef AMPCBLAS_ROUTINE_TYPE
+
+static_assert(sizeof(g_routine_names) / sizeof(g_routine_names[0]) == routine_count, "a routine name is missing");
+
+const size_t trace_buffer_bytes = 1 << 16;
+
+// g_trace_file is the file being recorded, if any; g_tracing is set while there is one, so a
+// call can test it without the lock
+concurrency::critical_section g_trace_cs;
+FILE *g_trace_file = nullptr;
+volatile long g_tracing = 0;
+LARGE_INTEGER g_frequency;
+
+long long now()
+{
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    return count.QuadPart;
+}
+
+// to be called with g_trace_cs held
+void close_trace()
+{
+    InterlockedExchange(&g_tracing, 0);
+    if (g_trace_file != nullptr)
+    {
+        fclose(g_trace_file);
+        g_trace_file = nullptr;
+    }
+}
+
+void write_call(const call_shape& shape, double us)
+{
+    concurrency::critical_section::scoped_lock lock(g_trace_cs);
+    if (g_trace_file == nullptr)
+        return;
+
+    fprintf(g_trace_file, "%s,%c,%c,%c,%c,%c,%c,%c,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%.3f\n",
+            g_routine_names[shape.routine], g_routine_types[shape.routine], 
+            shape.order, shape.trans_a, shape.trans_b, shape.uplo, shape.side, shape.diag,
+            shape.m, shape.n, shape.k, shape.lda, shape.ldb, shape.ldc, shape.incx, shape.incy, us);
+}
+
+// Starts the trace named by AMPBLAS_TRACE and the kernel timeline named by AMPBLAS_TIMELINE
+// when the library is loaded, and flushes the trace and writes the timeline when it is 
+// unloaded
+class trace_environment
+{
+public:
+    trace_environment()
+    {
+        timeline_path[0] = '\0';
+        const DWORD timeline_len = GetEnvironmentVariableA("AMPBLAS_TIMELINE", timeline_path, sizeof(timeline_path));
+        if (timeline_len == 0 || timeline_len >= sizeof(timeline_path))
+            timeline_path[0] = '\0';
+        else
+            ampblas::start_timeline();
+
+        char path[MAX_PATH];
+        const DWORD len = GetEnvironmentVariableA("AMPBLAS_TRACE", path, sizeof(path));
+        if (len == 0 || len >= sizeof(path))
+            return;
+
+        try
+        {
+            set_trace_file(path);
+        }
+        catch (...)
+        {
+            // the library works without its trace
+        }
+    }
+
+    ~trace_environment()
+    {
+        concurrency::critical_section::scoped_lock lock(g_trace_cs);
+        close_trace();
+
+        if (timeline_path[0] != '\0')
+        {
+            ampblas::stop_timeline();
+            try
+            {
+                ampblas::write_timeline(timeline_path);
+            }
+            catch (...)
+            {
+                // the timeline is lost, not the program
+            }
+        }
+    }
+
+private:
+    trace_environment(const trace_environment&);
+    trace_environment& operator=(const trace_environment&);
+
+    char timeline_path[MAX_PATH];
+};
+
+trace_environment g_trace_environment;
+
+} // namespace
+
+const char *routine_name(routine_id routine)
+{
+    return g_routine_names[routine];
+}
+
+char routine_type(routine_id routine)
+{
+    return g_routine_types[routine];
+}
+
+void set_trace_file(const char *path)
+{
+    concurrency::critical_section::scoped_lock lock(g_trace_cs);
+    close_trace();
+
+    if (path == nullptr)
+        return;
+
+    FILE *file = nullptr;
+    if (fopen_s(&file, path, "w") != 0 || file == nullptr)
+    {
+        throw ampblas_exception("Unable to create trace file", AMPBLAS_BAD_RESOURCE);
+    }
+
+    setvbuf(file, nullptr, _IOFBF, trace_buffer_bytes);
+    fputs("routine,type,order,trans_a,trans_b,uplo,side,diag,m,n,k,lda,ldb,ldc,incx,incy,time_us\n", file);
+
+    QueryPerformanceFrequency(&g_frequency);
+    g_trace_file = file;
+    InterlockedExchange(&g_tracing, 1);
+}
+
+} // namespace _details
+
+call_trace::call_trace(const call_shape& shape)
+    : shape(shape), start(_details::g_tracing ? _details::now() : 0)
+{
+    ticks = _details::enter_routine(shape.routine, outer);
+}
+
+call_trace::~call_trace()
+{
+    _details::leave_routine(shape, outer, ticks);
+
+    if (start == 0)
+        return;
+
+    try
+    {
+        // the time of a call includes its kernels
+        get_current_accelerator_view().wait();
+
+        const double us = 1e6 * double(_details::now() - start) / double(_details::g_frequency.QuadPart);
+        _details::write_call(shape, us);
+    }
+    catch (...)
+    {
+        // a failure to trace is not a failure of the call
+    }
+}
+
+} // namespace ampcblas
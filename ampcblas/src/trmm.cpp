@@ -68,8 +68,8 @@ void trmm(enum AMPBLAS_ORDER order, enum AMPBLAS_SIDE side, enum AMPBLAS_UPLO up
     }
 
     // workspace
-    concurrency::array<value_type,2> c(n,m); 
-    concurrency::array_view<value_type,2> c_mat(c);
+    ampblas::_detail::workspace_lease workspace = ampblas::_detail::acquire_workspace(get_current_accelerator_view(), size_t(n) * m * sizeof(value_type));
+    concurrency::array_view<value_type,2> c_mat = workspace->template view<value_type>(n, m);
     c_mat.discard_data();
 
     // forward to tuning routine
@@ -85,10 +85,12 @@ extern "C" {
 
 void ampblas_strmm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int M, const int N, const float alpha, const float *A, const int lda, float *B, const int ldb)
 {
+    const ampcblas::call_trace trace(ampcblas::trmm_call(ampcblas::routine_strmm, Order, Side, Uplo, TransA, Diag, M, N, lda, ldb));
     AMPBLAS_CHECKED_CALL( ampcblas::trmm(Order, Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B, ldb) );
 }
 void ampblas_dtrmm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int M, const int N, const double alpha, const double *A, const int lda, double *B, const int ldb)
 {
+    const ampcblas::call_trace trace(ampcblas::trmm_call(ampcblas::routine_dtrmm, Order, Side, Uplo, TransA, Diag, M, N, lda, ldb));
     AMPBLAS_CHECKED_CALL( ampcblas::trmm(Order, Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B, ldb) );
 }
 
@@ -98,6 +100,7 @@ void ampblas_ctrmm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side,
     using ampcblas::ampblas_cast;
 
     const fcomplex calpha = *ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::trmm_call(ampcblas::routine_ctrmm, Order, Side, Uplo, TransA, Diag, M, N, lda, ldb));
     AMPBLAS_CHECKED_CALL( ampcblas::trmm(Order, Side, Uplo, TransA, Diag, M, N, calpha, ampblas_cast(A), lda, ampblas_cast(B), ldb) );
 }
 void ampblas_ztrmm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int M, const int N, const ampblas_dcomplex *alpha, const ampblas_dcomplex *A, const int lda, ampblas_dcomplex *B, const int ldb)
@@ -106,6 +109,7 @@ void ampblas_ztrmm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side,
     using ampcblas::ampblas_cast;
 
     const dcomplex zalpha = *ampblas_cast(alpha);
+    const ampcblas::call_trace trace(ampcblas::trmm_call(ampcblas::routine_ztrmm, Order, Side, Uplo, TransA, Diag, M, N, lda, ldb));
     AMPBLAS_CHECKED_CALL( ampcblas::trmm(Order, Side, Uplo, TransA, Diag, M, N, zalpha, ampblas_cast(A), lda, ampblas_cast(B), ldb) );
 }
 
@@ -49,15 +49,16 @@ void trmv(enum AMPBLAS_ORDER order, enum AMPBLAS_UPLO uplo, enum AMPBLAS_TRANSPO
         argument_error("trmv", 7);
 
     // workspace to enable some more parallelism
-    concurrency::array<value_type,1> workspace(n);
+    const concurrency::accelerator_view& av = get_current_accelerator_view();
+    ampblas::_detail::workspace_lease workspace = ampblas::_detail::acquire_workspace(av, n * sizeof(value_type));
     
 	// create views
 	auto x_vec = make_vector_view(n, x, incx);
     auto a_mat = make_matrix_view(n, n, a, lda);
-    concurrency::array_view<value_type,1> y_vec(workspace);
+    concurrency::array_view<value_type,1> y_vec = workspace->template view<value_type>(n);
 
     // call generic implementation
-	ampblas::trmv(get_current_accelerator_view(), cast(uplo), cast(transa), cast(diag), a_mat, x_vec, y_vec);
+	ampblas::trmv(av, cast(uplo), cast(transa), cast(diag), a_mat, x_vec, y_vec);
    
     // copy workspace back to x
     auto x_2d = x_vec.get_base_view().view_as(concurrency::extent<2>(n,std::abs(incx))).section(concurrency::extent<2>(n,1));
@@ -72,11 +73,13 @@ extern "C" {
 
 void ampblas_strmv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int N, const float *A, const int lda, float *X, const int incX)
 {
+    const ampcblas::call_trace trace(ampcblas::trmv_call(ampcblas::routine_strmv, order, Uplo, TransA, Diag, N, lda, incX));
     AMPBLAS_CHECKED_CALL( ampcblas::trmv(order, Uplo, TransA, Diag, N, A, lda, X, incX) );
 }
 
 void ampblas_dtrmv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int N, const double *A, const int lda, double *X, const int incX)
 {
+    const ampcblas::call_trace trace(ampcblas::trmv_call(ampcblas::routine_dtrmv, order, Uplo, TransA, Diag, N, lda, incX));
     AMPBLAS_CHECKED_CALL( ampcblas::trmv(order, Uplo, TransA, Diag, N, A, lda, X, incX) );
 }
 
@@ -85,6 +88,7 @@ void ampblas_ctrmv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo,
     using ampcblas::fcomplex;
     using ampcblas::ampblas_cast;
 
+    const ampcblas::call_trace trace(ampcblas::trmv_call(ampcblas::routine_ctrmv, order, Uplo, TransA, Diag, N, lda, incX));
     AMPBLAS_CHECKED_CALL( ampcblas::trmv(order, Uplo, TransA, Diag, N, ampblas_cast(A), lda, ampblas_cast(X), incX) );
 }
 
@@ -93,6 +97,7 @@ void ampblas_ztrmv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo,
     using ampcblas::dcomplex;
     using ampcblas::ampblas_cast;
 
+    const ampcblas::call_trace trace(ampcblas::trmv_call(ampcblas::routine_ztrmv, order, Uplo, TransA, Diag, N, lda, incX));
     AMPBLAS_CHECKED_CALL( ampcblas::trmv(order, Uplo, TransA, Diag, N, ampblas_cast(A), lda, ampblas_cast(X), incX) );
 }
 
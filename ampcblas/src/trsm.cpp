@@ -76,11 +76,13 @@ extern "C" {
 
 void ampblas_strsm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int M, const int N, const float alpha, const float *A, const int lda, float *B, const int ldb)
 {
+	const ampcblas::call_trace trace(ampcblas::trmm_call(ampcblas::routine_strsm, Order, Side, Uplo, TransA, Diag, M, N, lda, ldb));
 	AMPBLAS_CHECKED_CALL( ampcblas::trsm(Order, Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B, ldb) );
 }
 
 void ampblas_dtrsm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int M, const int N, const double alpha, const double *A, const int lda, double *B, const int ldb)
 {
+	const ampcblas::call_trace trace(ampcblas::trmm_call(ampcblas::routine_dtrsm, Order, Side, Uplo, TransA, Diag, M, N, lda, ldb));
 	AMPBLAS_CHECKED_CALL( ampcblas::trsm(Order, Side, Uplo, TransA, Diag, M, N, alpha, A, lda, B, ldb) );
 }
 
@@ -90,6 +92,7 @@ void ampblas_ctrsm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side,
     using ampcblas::ampblas_cast;
 
     const fcomplex calpha = *ampblas_cast(alpha);
+	const ampcblas::call_trace trace(ampcblas::trmm_call(ampcblas::routine_ctrsm, Order, Side, Uplo, TransA, Diag, M, N, lda, ldb));
 	AMPBLAS_CHECKED_CALL( ampcblas::trsm(Order, Side, Uplo, TransA, Diag, M, N, calpha, ampblas_cast(A), lda, ampblas_cast(B), ldb) );
 }
 
@@ -99,6 +102,7 @@ void ampblas_ztrsm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side,
     using ampcblas::ampblas_cast;
 
     const dcomplex zalpha = *ampblas_cast(alpha);
+	const ampcblas::call_trace trace(ampcblas::trmm_call(ampcblas::routine_ztrsm, Order, Side, Uplo, TransA, Diag, M, N, lda, ldb));
 	AMPBLAS_CHECKED_CALL( ampcblas::trsm(Order, Side, Uplo, TransA, Diag, M, N, zalpha, ampblas_cast(A), lda, ampblas_cast(B), ldb) );
 }
 
@@ -62,11 +62,13 @@ extern "C" {
 
 void ampblas_strsv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int N, const float *A, const int lda, float *X, const int incX)
 {
+    const ampcblas::call_trace trace(ampcblas::trmv_call(ampcblas::routine_strsv, order, Uplo, TransA, Diag, N, lda, incX));
     AMPBLAS_CHECKED_CALL( ampcblas::trsv(order, Uplo, TransA, Diag, N, A, lda, X, incX) );
 }
 
 void ampblas_dtrsv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int N, const double *A, const int lda, double *X, const int incX)
 {
+    const ampcblas::call_trace trace(ampcblas::trmv_call(ampcblas::routine_dtrsv, order, Uplo, TransA, Diag, N, lda, incX));
     AMPBLAS_CHECKED_CALL( ampcblas::trsv(order, Uplo, TransA, Diag, N, A, lda, X, incX) );
 }
 
@@ -75,6 +77,7 @@ void ampblas_ctrsv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo,
     using ampcblas::fcomplex;
     using ampcblas::ampblas_cast;
 
+    const ampcblas::call_trace trace(ampcblas::trmv_call(ampcblas::routine_ctrsv, order, Uplo, TransA, Diag, N, lda, incX));
     AMPBLAS_CHECKED_CALL( ampcblas::trsv(order, Uplo, TransA, Diag, N, ampblas_cast(A), lda, ampblas_cast(X), incX) );
 }
 
@@ -83,6 +86,7 @@ void ampblas_ztrsv(const enum AMPBLAS_ORDER order, const enum AMPBLAS_UPLO Uplo,
     using ampcblas::dcomplex;
     using ampcblas::ampblas_cast;
 
+    const ampcblas::call_trace trace(ampcblas::trmv_call(ampcblas::routine_ztrsv, order, Uplo, TransA, Diag, N, lda, incX));
     AMPBLAS_CHECKED_CALL( ampcblas::trsv(order, Uplo, TransA, Diag, N, ampblas_cast(A), lda, ampblas_cast(X), incX) );
 }
 
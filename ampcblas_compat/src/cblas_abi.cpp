@@ -0,0 +1,661 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * cblas_abi.cpp
+ *
+ * cblas_* entry points with the signatures of the reference CBLAS header,
+ * forwarded to the ampblas_* routines of the same name. Routines AMPBLAS
+ * does not implement are not exported, so a program needing them fails to
+ * load rather than computing a wrong result.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include "compat.h"
+
+using namespace compat;
+
+typedef size_t CBLAS_INDEX;
+
+//-----------------------------------------------------------------------------
+// Level 1
+//-----------------------------------------------------------------------------
+
+COMPAT_EXPORT float cblas_sdsdot(const int N, const float alpha, const float *X, const int incX, const float *Y, const int incY)
+{
+    enter();
+    return ampblas_sdsdot(N, alpha, X, incX, Y, incY);
+}
+
+COMPAT_EXPORT double cblas_dsdot(const int N, const float *X, const int incX, const float *Y, const int incY)
+{
+    enter();
+    return ampblas_dsdot(N, X, incX, Y, incY);
+}
+
+COMPAT_EXPORT float cblas_sdot(const int N, const float *X, const int incX, const float *Y, const int incY)
+{
+    enter();
+    return ampblas_sdot(N, X, incX, Y, incY);
+}
+
+COMPAT_EXPORT double cblas_ddot(const int N, const double *X, const int incX, const double *Y, const int incY)
+{
+    enter();
+    return ampblas_ddot(N, X, incX, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_cdotu_sub(const int N, const void *X, const int incX, const void *Y, const int incY, void *dotu)
+{
+    enter();
+    ampblas_cdotu_sub(N, fcomplex(X), incX, fcomplex(Y), incY, fcomplex(dotu));
+}
+
+COMPAT_EXPORT void cblas_cdotc_sub(const int N, const void *X, const int incX, const void *Y, const int incY, void *dotc)
+{
+    enter();
+    ampblas_cdotc_sub(N, fcomplex(X), incX, fcomplex(Y), incY, fcomplex(dotc));
+}
+
+COMPAT_EXPORT void cblas_zdotu_sub(const int N, const void *X, const int incX, const void *Y, const int incY, void *dotu)
+{
+    enter();
+    ampblas_zdotu_sub(N, dcomplex(X), incX, dcomplex(Y), incY, dcomplex(dotu));
+}
+
+COMPAT_EXPORT void cblas_zdotc_sub(const int N, const void *X, const int incX, const void *Y, const int incY, void *dotc)
+{
+    enter();
+    ampblas_zdotc_sub(N, dcomplex(X), incX, dcomplex(Y), incY, dcomplex(dotc));
+}
+
+COMPAT_EXPORT float cblas_snrm2(const int N, const float *X, const int incX)
+{
+    enter();
+    return ampblas_snrm2(N, X, incX);
+}
+
+COMPAT_EXPORT double cblas_dnrm2(const int N, const double *X, const int incX)
+{
+    enter();
+    return ampblas_dnrm2(N, X, incX);
+}
+
+COMPAT_EXPORT float cblas_sasum(const int N, const float *X, const int incX)
+{
+    enter();
+    return ampblas_sasum(N, X, incX);
+}
+
+COMPAT_EXPORT double cblas_dasum(const int N, const double *X, const int incX)
+{
+    enter();
+    return ampblas_dasum(N, X, incX);
+}
+
+COMPAT_EXPORT float cblas_scasum(const int N, const void *X, const int incX)
+{
+    enter();
+    return ampblas_scasum(N, fcomplex(X), incX);
+}
+
+COMPAT_EXPORT double cblas_dzasum(const int N, const void *X, const int incX)
+{
+    enter();
+    return ampblas_dzasum(N, dcomplex(X), incX);
+}
+
+// the ampblas_i?amax routines return Fortran indices; CBLAS counts from 0
+COMPAT_EXPORT CBLAS_INDEX cblas_isamax(const int N, const float *X, const int incX)
+{
+    if (N < 1 || incX <= 0)
+        return 0;
+
+    enter();
+    return CBLAS_INDEX(ampblas_isamax(N, X, incX) - 1);
+}
+
+COMPAT_EXPORT CBLAS_INDEX cblas_idamax(const int N, const double *X, const int incX)
+{
+    if (N < 1 || incX <= 0)
+        return 0;
+
+    enter();
+    return CBLAS_INDEX(ampblas_idamax(N, X, incX) - 1);
+}
+
+COMPAT_EXPORT CBLAS_INDEX cblas_icamax(const int N, const void *X, const int incX)
+{
+    if (N < 1 || incX <= 0)
+        return 0;
+
+    enter();
+    return CBLAS_INDEX(ampblas_icamax(N, fcomplex(X), incX) - 1);
+}
+
+COMPAT_EXPORT CBLAS_INDEX cblas_izamax(const int N, const void *X, const int incX)
+{
+    if (N < 1 || incX <= 0)
+        return 0;
+
+    enter();
+    return CBLAS_INDEX(ampblas_izamax(N, dcomplex(X), incX) - 1);
+}
+
+COMPAT_EXPORT void cblas_sswap(const int N, float *X, const int incX, float *Y, const int incY)
+{
+    enter();
+    ampblas_sswap(N, X, incX, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_dswap(const int N, double *X, const int incX, double *Y, const int incY)
+{
+    enter();
+    ampblas_dswap(N, X, incX, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_cswap(const int N, void *X, const int incX, void *Y, const int incY)
+{
+    enter();
+    ampblas_cswap(N, fcomplex(X), incX, fcomplex(Y), incY);
+}
+
+COMPAT_EXPORT void cblas_zswap(const int N, void *X, const int incX, void *Y, const int incY)
+{
+    enter();
+    ampblas_zswap(N, dcomplex(X), incX, dcomplex(Y), incY);
+}
+
+COMPAT_EXPORT void cblas_scopy(const int N, const float *X, const int incX, float *Y, const int incY)
+{
+    enter();
+    ampblas_scopy(N, X, incX, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_dcopy(const int N, const double *X, const int incX, double *Y, const int incY)
+{
+    enter();
+    ampblas_dcopy(N, X, incX, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_ccopy(const int N, const void *X, const int incX, void *Y, const int incY)
+{
+    enter();
+    ampblas_ccopy(N, fcomplex(X), incX, fcomplex(Y), incY);
+}
+
+COMPAT_EXPORT void cblas_zcopy(const int N, const void *X, const int incX, void *Y, const int incY)
+{
+    enter();
+    ampblas_zcopy(N, dcomplex(X), incX, dcomplex(Y), incY);
+}
+
+COMPAT_EXPORT void cblas_saxpy(const int N, const float alpha, const float *X, const int incX, float *Y, const int incY)
+{
+    enter();
+    ampblas_saxpy(N, alpha, X, incX, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_daxpy(const int N, const double alpha, const double *X, const int incX, double *Y, const int incY)
+{
+    enter();
+    ampblas_daxpy(N, alpha, X, incX, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_caxpy(const int N, const void *alpha, const void *X, const int incX, void *Y, const int incY)
+{
+    enter();
+    ampblas_caxpy(N, fcomplex(alpha), fcomplex(X), incX, fcomplex(Y), incY);
+}
+
+COMPAT_EXPORT void cblas_zaxpy(const int N, const void *alpha, const void *X, const int incX, void *Y, const int incY)
+{
+    enter();
+    ampblas_zaxpy(N, dcomplex(alpha), dcomplex(X), incX, dcomplex(Y), incY);
+}
+
+COMPAT_EXPORT void cblas_srot(const int N, float *X, const int incX, float *Y, const int incY, const float c, const float s)
+{
+    enter();
+    ampblas_srot(N, X, incX, Y, incY, c, s);
+}
+
+COMPAT_EXPORT void cblas_drot(const int N, double *X, const int incX, double *Y, const int incY, const double c, const double s)
+{
+    enter();
+    ampblas_drot(N, X, incX, Y, incY, c, s);
+}
+
+COMPAT_EXPORT void cblas_sscal(const int N, const float alpha, float *X, const int incX)
+{
+    enter();
+    ampblas_sscal(N, alpha, X, incX);
+}
+
+COMPAT_EXPORT void cblas_dscal(const int N, const double alpha, double *X, const int incX)
+{
+    enter();
+    ampblas_dscal(N, alpha, X, incX);
+}
+
+COMPAT_EXPORT void cblas_cscal(const int N, const void *alpha, void *X, const int incX)
+{
+    enter();
+    ampblas_cscal(N, fcomplex(alpha), fcomplex(X), incX);
+}
+
+COMPAT_EXPORT void cblas_zscal(const int N, const void *alpha, void *X, const int incX)
+{
+    enter();
+    ampblas_zscal(N, dcomplex(alpha), dcomplex(X), incX);
+}
+
+COMPAT_EXPORT void cblas_csscal(const int N, const float alpha, void *X, const int incX)
+{
+    enter();
+    ampblas_csscal(N, alpha, fcomplex(X), incX);
+}
+
+COMPAT_EXPORT void cblas_zdscal(const int N, const double alpha, void *X, const int incX)
+{
+    enter();
+    ampblas_zdscal(N, alpha, dcomplex(X), incX);
+}
+
+//-----------------------------------------------------------------------------
+// Level 2
+//-----------------------------------------------------------------------------
+
+COMPAT_EXPORT void cblas_sgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE TransA, const int M, const int N,
+                               const float alpha, const float *A, const int lda, const float *X, const int incX,
+                               const float beta, float *Y, const int incY)
+{
+    enter();
+    ampblas_sgemv(compat::order(order), trans(TransA), M, N, alpha, A, lda, X, incX, beta, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_dgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE TransA, const int M, const int N,
+                               const double alpha, const double *A, const int lda, const double *X, const int incX,
+                               const double beta, double *Y, const int incY)
+{
+    enter();
+    ampblas_dgemv(compat::order(order), trans(TransA), M, N, alpha, A, lda, X, incX, beta, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_cgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE TransA, const int M, const int N,
+                               const void *alpha, const void *A, const int lda, const void *X, const int incX,
+                               const void *beta, void *Y, const int incY)
+{
+    enter();
+    ampblas_cgemv(compat::order(order), trans(TransA), M, N, fcomplex(alpha), fcomplex(A), lda, fcomplex(X), incX, fcomplex(beta), fcomplex(Y), incY);
+}
+
+COMPAT_EXPORT void cblas_zgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE TransA, const int M, const int N,
+                               const void *alpha, const void *A, const int lda, const void *X, const int incX,
+                               const void *beta, void *Y, const int incY)
+{
+    enter();
+    ampblas_zgemv(compat::order(order), trans(TransA), M, N, dcomplex(alpha), dcomplex(A), lda, dcomplex(X), incX, dcomplex(beta), dcomplex(Y), incY);
+}
+
+COMPAT_EXPORT void cblas_strmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+                               const enum CBLAS_DIAG Diag, const int N, const float *A, const int lda, float *X, const int incX)
+{
+    enter();
+    ampblas_strmv(compat::order(order), uplo(Uplo), trans(TransA), diag(Diag), N, A, lda, X, incX);
+}
+
+COMPAT_EXPORT void cblas_dtrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+                               const enum CBLAS_DIAG Diag, const int N, const double *A, const int lda, double *X, const int incX)
+{
+    enter();
+    ampblas_dtrmv(compat::order(order), uplo(Uplo), trans(TransA), diag(Diag), N, A, lda, X, incX);
+}
+
+COMPAT_EXPORT void cblas_ctrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+                               const enum CBLAS_DIAG Diag, const int N, const void *A, const int lda, void *X, const int incX)
+{
+    enter();
+    ampblas_ctrmv(compat::order(order), uplo(Uplo), trans(TransA), diag(Diag), N, fcomplex(A), lda, fcomplex(X), incX);
+}
+
+COMPAT_EXPORT void cblas_ztrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+                               const enum CBLAS_DIAG Diag, const int N, const void *A, const int lda, void *X, const int incX)
+{
+    enter();
+    ampblas_ztrmv(compat::order(order), uplo(Uplo), trans(TransA), diag(Diag), N, dcomplex(A), lda, dcomplex(X), incX);
+}
+
+COMPAT_EXPORT void cblas_strsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+                               const enum CBLAS_DIAG Diag, const int N, const float *A, const int lda, float *X, const int incX)
+{
+    enter();
+    ampblas_strsv(compat::order(order), uplo(Uplo), trans(TransA), diag(Diag), N, A, lda, X, incX);
+}
+
+COMPAT_EXPORT void cblas_dtrsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+                               const enum CBLAS_DIAG Diag, const int N, const double *A, const int lda, double *X, const int incX)
+{
+    enter();
+    ampblas_dtrsv(compat::order(order), uplo(Uplo), trans(TransA), diag(Diag), N, A, lda, X, incX);
+}
+
+COMPAT_EXPORT void cblas_ctrsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+                               const enum CBLAS_DIAG Diag, const int N, const void *A, const int lda, void *X, const int incX)
+{
+    enter();
+    ampblas_ctrsv(compat::order(order), uplo(Uplo), trans(TransA), diag(Diag), N, fcomplex(A), lda, fcomplex(X), incX);
+}
+
+COMPAT_EXPORT void cblas_ztrsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE TransA,
+                               const enum CBLAS_DIAG Diag, const int N, const void *A, const int lda, void *X, const int incX)
+{
+    enter();
+    ampblas_ztrsv(compat::order(order), uplo(Uplo), trans(TransA), diag(Diag), N, dcomplex(A), lda, dcomplex(X), incX);
+}
+
+COMPAT_EXPORT void cblas_ssymv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const int N, const float alpha,
+                               const float *A, const int lda, const float *X, const int incX, const float beta, float *Y, const int incY)
+{
+    enter();
+    ampblas_ssymv(compat::order(order), uplo(Uplo), N, alpha, A, lda, X, incX, beta, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_dsymv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const int N, const double alpha,
+                               const double *A, const int lda, const double *X, const int incX, const double beta, double *Y, const int incY)
+{
+    enter();
+    ampblas_dsymv(compat::order(order), uplo(Uplo), N, alpha, A, lda, X, incX, beta, Y, incY);
+}
+
+COMPAT_EXPORT void cblas_chemv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const int N, const void *alpha,
+                               const void *A, const int lda, const void *X, const int incX, const void *beta, void *Y, const int incY)
+{
+    enter();
+    ampblas_chemv(compat::order(order), uplo(Uplo), N, fcomplex(alpha), fcomplex(A), lda, fcomplex(X), incX, fcomplex(beta), fcomplex(Y), incY);
+}
+
+COMPAT_EXPORT void cblas_zhemv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const int N, const void *alpha,
+                               const void *A, const int lda, const void *X, const int incX, const void *beta, void *Y, const int incY)
+{
+    enter();
+    ampblas_zhemv(compat::order(order), uplo(Uplo), N, dcomplex(alpha), dcomplex(A), lda, dcomplex(X), incX, dcomplex(beta), dcomplex(Y), incY);
+}
+
+COMPAT_EXPORT void cblas_sger(const enum CBLAS_ORDER order, const int M, const int N, const float alpha,
+                              const float *X, const int incX, const float *Y, const int incY, float *A, const int lda)
+{
+    enter();
+    ampblas_sger(compat::order(order), M, N, alpha, X, incX, Y, incY, A, lda);
+}
+
+COMPAT_EXPORT void cblas_dger(const enum CBLAS_ORDER order, const int M, const int N, const double alpha,
+                              const double *X, const int incX, const double *Y, const int incY, double *A, const int lda)
+{
+    enter();
+    ampblas_dger(compat::order(order), M, N, alpha, X, incX, Y, incY, A, lda);
+}
+
+COMPAT_EXPORT void cblas_cgeru(const enum CBLAS_ORDER order, const int M, const int N, const void *alpha,
+                               const void *X, const int incX, const void *Y, const int incY, void *A, const int lda)
+{
+    enter();
+    ampblas_cgeru(compat::order(order), M, N, fcomplex(alpha), fcomplex(X), incX, fcomplex(Y), incY, fcomplex(A), lda);
+}
+
+COMPAT_EXPORT void cblas_cgerc(const enum CBLAS_ORDER order, const int M, const int N, const void *alpha,
+                               const void *X, const int incX, const void *Y, const int incY, void *A, const int lda)
+{
+    enter();
+    ampblas_cgerc(compat::order(order), M, N, fcomplex(alpha), fcomplex(X), incX, fcomplex(Y), incY, fcomplex(A), lda);
+}
+
+COMPAT_EXPORT void cblas_zgeru(const enum CBLAS_ORDER order, const int M, const int N, const void *alpha,
+                               const void *X, const int incX, const void *Y, const int incY, void *A, const int lda)
+{
+    enter();
+    ampblas_zgeru(compat::order(order), M, N, dcomplex(alpha), dcomplex(X), incX, dcomplex(Y), incY, dcomplex(A), lda);
+}
+
+COMPAT_EXPORT void cblas_zgerc(const enum CBLAS_ORDER order, const int M, const int N, const void *alpha,
+                               const void *X, const int incX, const void *Y, const int incY, void *A, const int lda)
+{
+    enter();
+    ampblas_zgerc(compat::order(order), M, N, dcomplex(alpha), dcomplex(X), incX, dcomplex(Y), incY, dcomplex(A), lda);
+}
+
+COMPAT_EXPORT void cblas_ssyr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const int N, const float alpha,
+                              const float *X, const int incX, float *A, const int lda)
+{
+    enter();
+    ampblas_ssyr(compat::order(order), uplo(Uplo), N, alpha, X, incX, A, lda);
+}
+
+COMPAT_EXPORT void cblas_dsyr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const int N, const double alpha,
+                              const double *X, const int incX, double *A, const int lda)
+{
+    enter();
+    ampblas_dsyr(compat::order(order), uplo(Uplo), N, alpha, X, incX, A, lda);
+}
+
+COMPAT_EXPORT void cblas_cher(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const int N, const float alpha,
+                              const void *X, const int incX, void *A, const int lda)
+{
+    enter();
+    ampblas_cher(compat::order(order), uplo(Uplo), N, alpha, fcomplex(X), incX, fcomplex(A), lda);
+}
+
+COMPAT_EXPORT void cblas_zher(const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo, const int N, const double alpha,
+                              const void *X, const int incX, void *A, const int lda)
+{
+    enter();
+    ampblas_zher(compat::order(order), uplo(Uplo), N, alpha, dcomplex(X), incX, dcomplex(A), lda);
+}
+
+//-----------------------------------------------------------------------------
+// Level 3
+//-----------------------------------------------------------------------------
+
+COMPAT_EXPORT void cblas_sgemm(const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_TRANSPOSE TransB,
+                               const int M, const int N, const int K, const float alpha, const float *A, const int lda,
+                               const float *B, const int ldb, const float beta, float *C, const int ldc)
+{
+    enter();
+    ampblas_sgemm(order(Order), trans(TransA), trans(TransB), M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+COMPAT_EXPORT void cblas_dgemm(const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_TRANSPOSE TransB,
+                               const int M, const int N, const int K, const double alpha, const double *A, const int lda,
+                               const double *B, const int ldb, const double beta, double *C, const int ldc)
+{
+    enter();
+    ampblas_dgemm(order(Order), trans(TransA), trans(TransB), M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+COMPAT_EXPORT void cblas_cgemm(const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_TRANSPOSE TransB,
+                               const int M, const int N, const int K, const void *alpha, const void *A, const int lda,
+                               const void *B, const int ldb, const void *beta, void *C, const int ldc)
+{
+    enter();
+    ampblas_cgemm(order(Order), trans(TransA), trans(TransB), M, N, K, fcomplex(alpha), fcomplex(A), lda, fcomplex(B), ldb, fcomplex(beta), fcomplex(C), ldc);
+}
+
+COMPAT_EXPORT void cblas_zgemm(const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_TRANSPOSE TransB,
+                               const int M, const int N, const int K, const void *alpha, const void *A, const int lda,
+                               const void *B, const int ldb, const void *beta, void *C, const int ldc)
+{
+    enter();
+    ampblas_zgemm(order(Order), trans(TransA), trans(TransB), M, N, K, dcomplex(alpha), dcomplex(A), lda, dcomplex(B), ldb, dcomplex(beta), dcomplex(C), ldc);
+}
+
+COMPAT_EXPORT void cblas_ssyrk(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                               const int N, const int K, const float alpha, const float *A, const int lda,
+                               const float beta, float *C, const int ldc)
+{
+    enter();
+    ampblas_ssyrk(order(Order), uplo(Uplo), trans(Trans), N, K, alpha, A, lda, beta, C, ldc);
+}
+
+COMPAT_EXPORT void cblas_dsyrk(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                               const int N, const int K, const double alpha, const double *A, const int lda,
+                               const double beta, double *C, const int ldc)
+{
+    enter();
+    ampblas_dsyrk(order(Order), uplo(Uplo), trans(Trans), N, K, alpha, A, lda, beta, C, ldc);
+}
+
+COMPAT_EXPORT void cblas_csyrk(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                               const int N, const int K, const void *alpha, const void *A, const int lda,
+                               const void *beta, void *C, const int ldc)
+{
+    enter();
+    ampblas_csyrk(order(Order), uplo(Uplo), trans(Trans), N, K, fcomplex(alpha), fcomplex(A), lda, fcomplex(beta), fcomplex(C), ldc);
+}
+
+COMPAT_EXPORT void cblas_zsyrk(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                               const int N, const int K, const void *alpha, const void *A, const int lda,
+                               const void *beta, void *C, const int ldc)
+{
+    enter();
+    ampblas_zsyrk(order(Order), uplo(Uplo), trans(Trans), N, K, dcomplex(alpha), dcomplex(A), lda, dcomplex(beta), dcomplex(C), ldc);
+}
+
+COMPAT_EXPORT void cblas_cherk(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                               const int N, const int K, const float alpha, const void *A, const int lda,
+                               const float beta, void *C, const int ldc)
+{
+    enter();
+    ampblas_cherk(order(Order), uplo(Uplo), trans(Trans), N, K, alpha, fcomplex(A), lda, beta, fcomplex(C), ldc);
+}
+
+COMPAT_EXPORT void cblas_zherk(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                               const int N, const int K, const double alpha, const void *A, const int lda,
+                               const double beta, void *C, const int ldc)
+{
+    enter();
+    ampblas_zherk(order(Order), uplo(Uplo), trans(Trans), N, K, alpha, dcomplex(A), lda, beta, dcomplex(C), ldc);
+}
+
+COMPAT_EXPORT void cblas_ssyr2k(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                                const int N, const int K, const float alpha, const float *A, const int lda,
+                                const float *B, const int ldb, const float beta, float *C, const int ldc)
+{
+    enter();
+    ampblas_ssyr2k(order(Order), uplo(Uplo), trans(Trans), N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+COMPAT_EXPORT void cblas_dsyr2k(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                                const int N, const int K, const double alpha, const double *A, const int lda,
+                                const double *B, const int ldb, const double beta, double *C, const int ldc)
+{
+    enter();
+    ampblas_dsyr2k(order(Order), uplo(Uplo), trans(Trans), N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+COMPAT_EXPORT void cblas_csyr2k(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                                const int N, const int K, const void *alpha, const void *A, const int lda,
+                                const void *B, const int ldb, const void *beta, void *C, const int ldc)
+{
+    enter();
+    ampblas_csyr2k(order(Order), uplo(Uplo), trans(Trans), N, K, fcomplex(alpha), fcomplex(A), lda, fcomplex(B), ldb, fcomplex(beta), fcomplex(C), ldc);
+}
+
+COMPAT_EXPORT void cblas_zsyr2k(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                                const int N, const int K, const void *alpha, const void *A, const int lda,
+                                const void *B, const int ldb, const void *beta, void *C, const int ldc)
+{
+    enter();
+    ampblas_zsyr2k(order(Order), uplo(Uplo), trans(Trans), N, K, dcomplex(alpha), dcomplex(A), lda, dcomplex(B), ldb, dcomplex(beta), dcomplex(C), ldc);
+}
+
+COMPAT_EXPORT void cblas_cher2k(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                                const int N, const int K, const void *alpha, const void *A, const int lda,
+                                const void *B, const int ldb, const float beta, void *C, const int ldc)
+{
+    enter();
+    ampblas_cher2k(order(Order), uplo(Uplo), trans(Trans), N, K, fcomplex(alpha), fcomplex(A), lda, fcomplex(B), ldb, beta, fcomplex(C), ldc);
+}
+
+COMPAT_EXPORT void cblas_zher2k(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo, const enum CBLAS_TRANSPOSE Trans,
+                                const int N, const int K, const void *alpha, const void *A, const int lda,
+                                const void *B, const int ldb, const double beta, void *C, const int ldc)
+{
+    enter();
+    ampblas_zher2k(order(Order), uplo(Uplo), trans(Trans), N, K, dcomplex(alpha), dcomplex(A), lda, dcomplex(B), ldb, beta, dcomplex(C), ldc);
+}
+
+COMPAT_EXPORT void cblas_strmm(const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+                               const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag, const int M, const int N,
+                               const float alpha, const float *A, const int lda, float *B, const int ldb)
+{
+    enter();
+    ampblas_strmm(order(Order), side(Side), uplo(Uplo), trans(TransA), diag(Diag), M, N, alpha, A, lda, B, ldb);
+}
+
+COMPAT_EXPORT void cblas_dtrmm(const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+                               const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag, const int M, const int N,
+                               const double alpha, const double *A, const int lda, double *B, const int ldb)
+{
+    enter();
+    ampblas_dtrmm(order(Order), side(Side), uplo(Uplo), trans(TransA), diag(Diag), M, N, alpha, A, lda, B, ldb);
+}
+
+COMPAT_EXPORT void cblas_ctrmm(const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+                               const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag, const int M, const int N,
+                               const void *alpha, const void *A, const int lda, void *B, const int ldb)
+{
+    enter();
+    ampblas_ctrmm(order(Order), side(Side), uplo(Uplo), trans(TransA), diag(Diag), M, N, fcomplex(alpha), fcomplex(A), lda, fcomplex(B), ldb);
+}
+
+COMPAT_EXPORT void cblas_ztrmm(const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+                               const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag, const int M, const int N,
+                               const void *alpha, const void *A, const int lda, void *B, const int ldb)
+{
+    enter();
+    ampblas_ztrmm(order(Order), side(Side), uplo(Uplo), trans(TransA), diag(Diag), M, N, dcomplex(alpha), dcomplex(A), lda, dcomplex(B), ldb);
+}
+
+COMPAT_EXPORT void cblas_strsm(const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+                               const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag, const int M, const int N,
+                               const float alpha, const float *A, const int lda, float *B, const int ldb)
+{
+    enter();
+    ampblas_strsm(order(Order), side(Side), uplo(Uplo), trans(TransA), diag(Diag), M, N, alpha, A, lda, B, ldb);
+}
+
+COMPAT_EXPORT void cblas_dtrsm(const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+                               const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag, const int M, const int N,
+                               const double alpha, const double *A, const int lda, double *B, const int ldb)
+{
+    enter();
+    ampblas_dtrsm(order(Order), side(Side), uplo(Uplo), trans(TransA), diag(Diag), M, N, alpha, A, lda, B, ldb);
+}
+
+COMPAT_EXPORT void cblas_ctrsm(const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+                               const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag, const int M, const int N,
+                               const void *alpha, const void *A, const int lda, void *B, const int ldb)
+{
+    enter();
+    ampblas_ctrsm(order(Order), side(Side), uplo(Uplo), trans(TransA), diag(Diag), M, N, fcomplex(alpha), fcomplex(A), lda, fcomplex(B), ldb);
+}
+
+COMPAT_EXPORT void cblas_ztrsm(const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side, const enum CBLAS_UPLO Uplo,
+                               const enum CBLAS_TRANSPOSE TransA, const enum CBLAS_DIAG Diag, const int M, const int N,
+                               const void *alpha, const void *A, const int lda, void *B, const int ldb)
+{
+    enter();
+    ampblas_ztrsm(order(Order), side(Side), uplo(Uplo), trans(TransA), diag(Diag), M, N, dcomplex(alpha), dcomplex(A), lda, dcomplex(B), ldb);
+}
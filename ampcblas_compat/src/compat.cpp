@@ -0,0 +1,111 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * compat.cpp
+ *
+ * Runtime configuration of the compatibility library and the XERBLA entry
+ * points. Errors are reported through ampblas_xerbla, which prints the
+ * message and returns; unlike the reference XERBLA it does not stop the
+ * program.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include "compat.h"
+
+namespace compat {
+
+namespace {
+
+const size_t default_cache_mb = 256;
+
+INIT_ONCE g_init = INIT_ONCE_STATIC_INIT;
+bool g_assume_unmodified = false;
+
+// reads an environment variable; false if it is not set or does not fit in size characters
+bool read_environment(const char *name, char *value, DWORD size)
+{
+    const DWORD len = GetEnvironmentVariableA(name, value, size);
+    if (len == 0 || len >= size)
+    {
+        value[0] = '\0';
+        return false;
+    }
+    return true;
+}
+
+BOOL CALLBACK configure(PINIT_ONCE, PVOID, PVOID *)
+{
+    char value[64];
+
+    size_t cache_mb = default_cache_mb;
+    if (read_environment("AMPBLAS_IMPLICIT_CACHE_MB", value, sizeof(value)))
+        cache_mb = static_cast<size_t>(strtoul(value, nullptr, 10));
+    ampblas_set_implicit_binding(cache_mb << 20);
+
+    enum AMPBLAS_DISPATCH_MODE mode = AmpblasDispatchAuto;
+    if (read_environment("AMPBLAS_DISPATCH", value, sizeof(value)))
+    {
+        if (_stricmp(value, "accelerator") == 0)
+            mode = AmpblasDispatchAccelerator;
+        else if (_stricmp(value, "host") == 0)
+            mode = AmpblasDispatchHost;
+    }
+    ampblas_set_dispatch_mode(mode);
+
+    g_assume_unmodified = read_environment("AMPBLAS_ASSUME_UNMODIFIED", value, sizeof(value)) && strcmp(value, "1") == 0;
+
+    return TRUE;
+}
+
+} // namespace
+
+void enter()
+{
+    InitOnceExecuteOnce(&g_init, configure, nullptr, nullptr);
+
+    if (!g_assume_unmodified)
+        ampblas_invalidate_implicit(nullptr, 0);
+}
+
+} // namespace compat
+
+// XERBLA as called from Fortran; the routine name is blank padded to srname_len characters
+COMPAT_EXPORT void xerbla_(const char *srname, const int *info, int srname_len)
+{
+    char name[32];
+    const size_t len = srname_len > 0 ? std::min(size_t(srname_len), sizeof(name) - 1) : 0;
+    memcpy(name, srname, len);
+    name[len] = '\0';
+
+    int index = *info;
+    ampblas_xerbla(name, &index);
+}
+
+// p is the position of the bad argument in the CBLAS signature of rout; the format is ignored
+COMPAT_EXPORT void cblas_xerbla(int p, const char *rout, const char *form, ...)
+{
+    (void)form;
+    ampblas_xerbla(rout, &p);
+}
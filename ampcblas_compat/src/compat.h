@@ -0,0 +1,67 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * compat.h
+ *
+ * Shared by the CBLAS and Fortran BLAS entry points of the compatibility
+ * library, which export the standard BLAS symbol names and forward them to
+ * the AMPBLAS C API with implicit binding enabled.
+ *
+ *---------------------------------------------------------------------------*/
+
+#ifndef AMPCBLAS_COMPAT_H
+#define AMPCBLAS_COMPAT_H
+
+#include "ampcblas.h"
+#include "ampcblas_runtime.h"
+
+#define COMPAT_EXPORT extern "C" __declspec(dllexport)
+
+// enumerations of the CBLAS interface; their values are those of the AMPBLAS enumerations
+enum CBLAS_ORDER {CblasRowMajor=101, CblasColMajor=102};
+enum CBLAS_TRANSPOSE {CblasNoTrans=111, CblasTrans=112, CblasConjTrans=113};
+enum CBLAS_UPLO {CblasUpper=121, CblasLower=122};
+enum CBLAS_DIAG {CblasNonUnit=131, CblasUnit=132};
+enum CBLAS_SIDE {CblasLeft=141, CblasRight=142};
+
+namespace compat {
+
+// Called by every entry point before it forwards. The first call configures the runtime
+// from the environment:
+//
+//   AMPBLAS_IMPLICIT_CACHE_MB   accelerator memory kept by implicit binding (256 by default)
+//   AMPBLAS_DISPATCH            accelerator, host or auto (the default)
+//   AMPBLAS_ASSUME_UNMODIFIED   1 if the caller never writes operands between calls
+//
+// A BLAS caller is free to change its arrays between calls, so unless told otherwise every
+// call starts a new host generation and cached bindings are refreshed before they are used.
+void enter();
+
+inline enum AMPBLAS_ORDER order(enum CBLAS_ORDER o) { return static_cast<enum AMPBLAS_ORDER>(o); }
+inline enum AMPBLAS_TRANSPOSE trans(enum CBLAS_TRANSPOSE t) { return static_cast<enum AMPBLAS_TRANSPOSE>(t); }
+inline enum AMPBLAS_UPLO uplo(enum CBLAS_UPLO u) { return static_cast<enum AMPBLAS_UPLO>(u); }
+inline enum AMPBLAS_DIAG diag(enum CBLAS_DIAG d) { return static_cast<enum AMPBLAS_DIAG>(d); }
+inline enum AMPBLAS_SIDE side(enum CBLAS_SIDE s) { return static_cast<enum AMPBLAS_SIDE>(s); }
+
+// complex arguments are untyped in the CBLAS interface
+inline const ampblas_fcomplex* fcomplex(const void *p) { return static_cast<const ampblas_fcomplex*>(p); }
+inline ampblas_fcomplex* fcomplex(void *p) { return static_cast<ampblas_fcomplex*>(p); }
+inline const ampblas_dcomplex* dcomplex(const void *p) { return static_cast<const ampblas_dcomplex*>(p); }
+inline ampblas_dcomplex* dcomplex(void *p) { return static_cast<ampblas_dcomplex*>(p); }
+
+} // namespace compat
+
+#endif // AMPCBLAS_COMPAT_H
@@ -0,0 +1,941 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * fortran_abi.cpp
+ *
+ * Fortran 77 BLAS entry points: lower case names with a trailing underscore,
+ * every argument by reference, column major matrices and 32-bit INTEGERs.
+ * The hidden lengths compilers append for character arguments come last and
+ * are not needed, so they are not declared.
+ *
+ * Arguments are checked in the order of the reference implementation and the
+ * first bad one is reported to ampblas_xerbla with its Fortran position.
+ * REAL functions return float, as gfortran and the Intel compiler do; code
+ * translated by f2c, which returns double, must use the CBLAS entry points.
+ * The COMPLEX functions CDOTU, CDOTC, ZDOTU and ZDOTC are not exported, as
+ * compilers disagree on how a complex result is returned.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cctype>
+
+#include "compat.h"
+
+namespace {
+
+// character options are case insensitive
+inline bool lsame(const char *c, char option)
+{
+    return std::toupper(static_cast<unsigned char>(*c)) == option;
+}
+
+inline bool is_trans(const char *c) { return lsame(c, 'N') || lsame(c, 'T') || lsame(c, 'C'); }
+inline bool is_uplo(const char *c) { return lsame(c, 'U') || lsame(c, 'L'); }
+inline bool is_diag(const char *c) { return lsame(c, 'U') || lsame(c, 'N'); }
+inline bool is_side(const char *c) { return lsame(c, 'L') || lsame(c, 'R'); }
+
+// real routines take 'C' to mean 'T'
+inline enum AMPBLAS_TRANSPOSE real_trans(const char *c) { return lsame(c, 'N') ? AmpblasNoTrans : AmpblasTrans; }
+inline enum AMPBLAS_TRANSPOSE complex_trans(const char *c) { return lsame(c, 'N') ? AmpblasNoTrans : (lsame(c, 'T') ? AmpblasTrans : AmpblasConjTrans); }
+inline enum AMPBLAS_UPLO to_uplo(const char *c) { return lsame(c, 'U') ? AmpblasUpper : AmpblasLower; }
+inline enum AMPBLAS_DIAG to_diag(const char *c) { return lsame(c, 'U') ? AmpblasUnit : AmpblasNonUnit; }
+inline enum AMPBLAS_SIDE to_side(const char *c) { return lsame(c, 'L') ? AmpblasLeft : AmpblasRight; }
+
+//
+// arg_check
+//   Collects the position of the first argument failing its check and reports it like the
+//   reference XERBLA call would.
+//
+class arg_check
+{
+public:
+    explicit arg_check(const char *name)
+        : name(name), info(0)
+    {
+    }
+
+    void require(bool valid, int position)
+    {
+        if (info == 0 && !valid)
+            info = position;
+    }
+
+    bool failed()
+    {
+        if (info != 0)
+            ampblas_xerbla(name, &info);
+        return info != 0;
+    }
+
+private:
+    const char *name;
+    int info;
+};
+
+// the checks shared by routines of the same shape
+bool gemv_failed(const char *name, const char *trans, int m, int n, int lda, int incx, int incy)
+{
+    arg_check check(name);
+    check.require(is_trans(trans), 1);
+    check.require(m >= 0, 2);
+    check.require(n >= 0, 3);
+    check.require(lda >= std::max(1, m), 6);
+    check.require(incx != 0, 8);
+    check.require(incy != 0, 11);
+    return check.failed();
+}
+
+bool ger_failed(const char *name, int m, int n, int incx, int incy, int lda)
+{
+    arg_check check(name);
+    check.require(m >= 0, 1);
+    check.require(n >= 0, 2);
+    check.require(incx != 0, 5);
+    check.require(incy != 0, 7);
+    check.require(lda >= std::max(1, m), 9);
+    return check.failed();
+}
+
+bool symv_failed(const char *name, const char *uplo, int n, int lda, int incx, int incy)
+{
+    arg_check check(name);
+    check.require(is_uplo(uplo), 1);
+    check.require(n >= 0, 2);
+    check.require(lda >= std::max(1, n), 5);
+    check.require(incx != 0, 7);
+    check.require(incy != 0, 10);
+    return check.failed();
+}
+
+bool syr_failed(const char *name, const char *uplo, int n, int incx, int lda)
+{
+    arg_check check(name);
+    check.require(is_uplo(uplo), 1);
+    check.require(n >= 0, 2);
+    check.require(incx != 0, 5);
+    check.require(lda >= std::max(1, n), 7);
+    return check.failed();
+}
+
+bool trmv_failed(const char *name, const char *uplo, const char *trans, const char *diag, int n, int lda, int incx)
+{
+    arg_check check(name);
+    check.require(is_uplo(uplo), 1);
+    check.require(is_trans(trans), 2);
+    check.require(is_diag(diag), 3);
+    check.require(n >= 0, 4);
+    check.require(lda >= std::max(1, n), 6);
+    check.require(incx != 0, 8);
+    return check.failed();
+}
+
+bool gemm_failed(const char *name, const char *transa, const char *transb, int m, int n, int k, int lda, int ldb, int ldc)
+{
+    const int nrowa = lsame(transa, 'N') ? m : k;
+    const int nrowb = lsame(transb, 'N') ? k : n;
+
+    arg_check check(name);
+    check.require(is_trans(transa), 1);
+    check.require(is_trans(transb), 2);
+    check.require(m >= 0, 3);
+    check.require(n >= 0, 4);
+    check.require(k >= 0, 5);
+    check.require(lda >= std::max(1, nrowa), 8);
+    check.require(ldb >= std::max(1, nrowb), 10);
+    check.require(ldc >= std::max(1, m), 13);
+    return check.failed();
+}
+
+// trans_ok tells which transpose options the routine accepts
+bool syrk_failed(const char *name, const char *uplo, const char *trans, bool trans_ok, int n, int k, int lda, int ldc)
+{
+    const int nrowa = lsame(trans, 'N') ? n : k;
+
+    arg_check check(name);
+    check.require(is_uplo(uplo), 1);
+    check.require(trans_ok, 2);
+    check.require(n >= 0, 3);
+    check.require(k >= 0, 4);
+    check.require(lda >= std::max(1, nrowa), 7);
+    check.require(ldc >= std::max(1, n), 10);
+    return check.failed();
+}
+
+bool syr2k_failed(const char *name, const char *uplo, const char *trans, bool trans_ok, int n, int k, int lda, int ldb, int ldc)
+{
+    const int nrowa = lsame(trans, 'N') ? n : k;
+
+    arg_check check(name);
+    check.require(is_uplo(uplo), 1);
+    check.require(trans_ok, 2);
+    check.require(n >= 0, 3);
+    check.require(k >= 0, 4);
+    check.require(lda >= std::max(1, nrowa), 7);
+    check.require(ldb >= std::max(1, nrowa), 9);
+    check.require(ldc >= std::max(1, n), 12);
+    return check.failed();
+}
+
+bool trmm_failed(const char *name, const char *side, const char *uplo, const char *transa, const char *diag, int m, int n, int lda, int ldb)
+{
+    const int nrowa = lsame(side, 'L') ? m : n;
+
+    arg_check check(name);
+    check.require(is_side(side), 1);
+    check.require(is_uplo(uplo), 2);
+    check.require(is_trans(transa), 3);
+    check.require(is_diag(diag), 4);
+    check.require(m >= 0, 5);
+    check.require(n >= 0, 6);
+    check.require(lda >= std::max(1, nrowa), 9);
+    check.require(ldb >= std::max(1, m), 11);
+    return check.failed();
+}
+
+// transpose options of the symmetric and Hermitian rank-k updates
+inline bool real_syrk_trans(const char *c) { return is_trans(c); }
+inline bool complex_syrk_trans(const char *c) { return lsame(c, 'N') || lsame(c, 'T'); }
+inline bool herk_trans(const char *c) { return lsame(c, 'N') || lsame(c, 'C'); }
+
+} // namespace
+
+using compat::enter;
+
+//-----------------------------------------------------------------------------
+// Level 1
+//-----------------------------------------------------------------------------
+
+COMPAT_EXPORT float sdsdot_(const int *n, const float *sb, const float *sx, const int *incx, const float *sy, const int *incy)
+{
+    enter();
+    return ampblas_sdsdot(*n, *sb, sx, *incx, sy, *incy);
+}
+
+COMPAT_EXPORT double dsdot_(const int *n, const float *sx, const int *incx, const float *sy, const int *incy)
+{
+    enter();
+    return ampblas_dsdot(*n, sx, *incx, sy, *incy);
+}
+
+COMPAT_EXPORT float sdot_(const int *n, const float *sx, const int *incx, const float *sy, const int *incy)
+{
+    enter();
+    return ampblas_sdot(*n, sx, *incx, sy, *incy);
+}
+
+COMPAT_EXPORT double ddot_(const int *n, const double *dx, const int *incx, const double *dy, const int *incy)
+{
+    enter();
+    return ampblas_ddot(*n, dx, *incx, dy, *incy);
+}
+
+COMPAT_EXPORT float snrm2_(const int *n, const float *x, const int *incx)
+{
+    enter();
+    return ampblas_snrm2(*n, x, *incx);
+}
+
+COMPAT_EXPORT double dnrm2_(const int *n, const double *x, const int *incx)
+{
+    enter();
+    return ampblas_dnrm2(*n, x, *incx);
+}
+
+COMPAT_EXPORT float sasum_(const int *n, const float *sx, const int *incx)
+{
+    enter();
+    return ampblas_sasum(*n, sx, *incx);
+}
+
+COMPAT_EXPORT double dasum_(const int *n, const double *dx, const int *incx)
+{
+    enter();
+    return ampblas_dasum(*n, dx, *incx);
+}
+
+COMPAT_EXPORT float scasum_(const int *n, const ampblas_fcomplex *cx, const int *incx)
+{
+    enter();
+    return ampblas_scasum(*n, cx, *incx);
+}
+
+COMPAT_EXPORT double dzasum_(const int *n, const ampblas_dcomplex *zx, const int *incx)
+{
+    enter();
+    return ampblas_dzasum(*n, zx, *incx);
+}
+
+// the reference I?AMAX return 0 where ampblas_i?amax return 1
+COMPAT_EXPORT int isamax_(const int *n, const float *sx, const int *incx)
+{
+    if (*n < 1 || *incx <= 0)
+        return 0;
+
+    enter();
+    return ampblas_isamax(*n, sx, *incx);
+}
+
+COMPAT_EXPORT int idamax_(const int *n, const double *dx, const int *incx)
+{
+    if (*n < 1 || *incx <= 0)
+        return 0;
+
+    enter();
+    return ampblas_idamax(*n, dx, *incx);
+}
+
+COMPAT_EXPORT int icamax_(const int *n, const ampblas_fcomplex *cx, const int *incx)
+{
+    if (*n < 1 || *incx <= 0)
+        return 0;
+
+    enter();
+    return ampblas_icamax(*n, cx, *incx);
+}
+
+COMPAT_EXPORT int izamax_(const int *n, const ampblas_dcomplex *zx, const int *incx)
+{
+    if (*n < 1 || *incx <= 0)
+        return 0;
+
+    enter();
+    return ampblas_izamax(*n, zx, *incx);
+}
+
+COMPAT_EXPORT void sswap_(const int *n, float *sx, const int *incx, float *sy, const int *incy)
+{
+    enter();
+    ampblas_sswap(*n, sx, *incx, sy, *incy);
+}
+
+COMPAT_EXPORT void dswap_(const int *n, double *dx, const int *incx, double *dy, const int *incy)
+{
+    enter();
+    ampblas_dswap(*n, dx, *incx, dy, *incy);
+}
+
+COMPAT_EXPORT void cswap_(const int *n, ampblas_fcomplex *cx, const int *incx, ampblas_fcomplex *cy, const int *incy)
+{
+    enter();
+    ampblas_cswap(*n, cx, *incx, cy, *incy);
+}
+
+COMPAT_EXPORT void zswap_(const int *n, ampblas_dcomplex *zx, const int *incx, ampblas_dcomplex *zy, const int *incy)
+{
+    enter();
+    ampblas_zswap(*n, zx, *incx, zy, *incy);
+}
+
+COMPAT_EXPORT void scopy_(const int *n, const float *sx, const int *incx, float *sy, const int *incy)
+{
+    enter();
+    ampblas_scopy(*n, sx, *incx, sy, *incy);
+}
+
+COMPAT_EXPORT void dcopy_(const int *n, const double *dx, const int *incx, double *dy, const int *incy)
+{
+    enter();
+    ampblas_dcopy(*n, dx, *incx, dy, *incy);
+}
+
+COMPAT_EXPORT void ccopy_(const int *n, const ampblas_fcomplex *cx, const int *incx, ampblas_fcomplex *cy, const int *incy)
+{
+    enter();
+    ampblas_ccopy(*n, cx, *incx, cy, *incy);
+}
+
+COMPAT_EXPORT void zcopy_(const int *n, const ampblas_dcomplex *zx, const int *incx, ampblas_dcomplex *zy, const int *incy)
+{
+    enter();
+    ampblas_zcopy(*n, zx, *incx, zy, *incy);
+}
+
+COMPAT_EXPORT void saxpy_(const int *n, const float *sa, const float *sx, const int *incx, float *sy, const int *incy)
+{
+    enter();
+    ampblas_saxpy(*n, *sa, sx, *incx, sy, *incy);
+}
+
+COMPAT_EXPORT void daxpy_(const int *n, const double *da, const double *dx, const int *incx, double *dy, const int *incy)
+{
+    enter();
+    ampblas_daxpy(*n, *da, dx, *incx, dy, *incy);
+}
+
+COMPAT_EXPORT void caxpy_(const int *n, const ampblas_fcomplex *ca, const ampblas_fcomplex *cx, const int *incx, ampblas_fcomplex *cy, const int *incy)
+{
+    enter();
+    ampblas_caxpy(*n, ca, cx, *incx, cy, *incy);
+}
+
+COMPAT_EXPORT void zaxpy_(const int *n, const ampblas_dcomplex *za, const ampblas_dcomplex *zx, const int *incx, ampblas_dcomplex *zy, const int *incy)
+{
+    enter();
+    ampblas_zaxpy(*n, za, zx, *incx, zy, *incy);
+}
+
+COMPAT_EXPORT void srot_(const int *n, float *sx, const int *incx, float *sy, const int *incy, const float *c, const float *s)
+{
+    enter();
+    ampblas_srot(*n, sx, *incx, sy, *incy, *c, *s);
+}
+
+COMPAT_EXPORT void drot_(const int *n, double *dx, const int *incx, double *dy, const int *incy, const double *c, const double *s)
+{
+    enter();
+    ampblas_drot(*n, dx, *incx, dy, *incy, *c, *s);
+}
+
+COMPAT_EXPORT void sscal_(const int *n, const float *sa, float *sx, const int *incx)
+{
+    enter();
+    ampblas_sscal(*n, *sa, sx, *incx);
+}
+
+COMPAT_EXPORT void dscal_(const int *n, const double *da, double *dx, const int *incx)
+{
+    enter();
+    ampblas_dscal(*n, *da, dx, *incx);
+}
+
+COMPAT_EXPORT void cscal_(const int *n, const ampblas_fcomplex *ca, ampblas_fcomplex *cx, const int *incx)
+{
+    enter();
+    ampblas_cscal(*n, ca, cx, *incx);
+}
+
+COMPAT_EXPORT void zscal_(const int *n, const ampblas_dcomplex *za, ampblas_dcomplex *zx, const int *incx)
+{
+    enter();
+    ampblas_zscal(*n, za, zx, *incx);
+}
+
+COMPAT_EXPORT void csscal_(const int *n, const float *sa, ampblas_fcomplex *cx, const int *incx)
+{
+    enter();
+    ampblas_csscal(*n, *sa, cx, *incx);
+}
+
+COMPAT_EXPORT void zdscal_(const int *n, const double *da, ampblas_dcomplex *zx, const int *incx)
+{
+    enter();
+    ampblas_zdscal(*n, *da, zx, *incx);
+}
+
+//-----------------------------------------------------------------------------
+// Level 2
+//-----------------------------------------------------------------------------
+
+COMPAT_EXPORT void sgemv_(const char *trans, const int *m, const int *n, const float *alpha, const float *a, const int *lda,
+                          const float *x, const int *incx, const float *beta, float *y, const int *incy)
+{
+    if (gemv_failed("SGEMV ", trans, *m, *n, *lda, *incx, *incy))
+        return;
+
+    enter();
+    ampblas_sgemv(AmpblasColMajor, real_trans(trans), *m, *n, *alpha, a, *lda, x, *incx, *beta, y, *incy);
+}
+
+COMPAT_EXPORT void dgemv_(const char *trans, const int *m, const int *n, const double *alpha, const double *a, const int *lda,
+                          const double *x, const int *incx, const double *beta, double *y, const int *incy)
+{
+    if (gemv_failed("DGEMV ", trans, *m, *n, *lda, *incx, *incy))
+        return;
+
+    enter();
+    ampblas_dgemv(AmpblasColMajor, real_trans(trans), *m, *n, *alpha, a, *lda, x, *incx, *beta, y, *incy);
+}
+
+COMPAT_EXPORT void cgemv_(const char *trans, const int *m, const int *n, const ampblas_fcomplex *alpha, const ampblas_fcomplex *a, const int *lda,
+                          const ampblas_fcomplex *x, const int *incx, const ampblas_fcomplex *beta, ampblas_fcomplex *y, const int *incy)
+{
+    if (gemv_failed("CGEMV ", trans, *m, *n, *lda, *incx, *incy))
+        return;
+
+    enter();
+    ampblas_cgemv(AmpblasColMajor, complex_trans(trans), *m, *n, alpha, a, *lda, x, *incx, beta, y, *incy);
+}
+
+COMPAT_EXPORT void zgemv_(const char *trans, const int *m, const int *n, const ampblas_dcomplex *alpha, const ampblas_dcomplex *a, const int *lda,
+                          const ampblas_dcomplex *x, const int *incx, const ampblas_dcomplex *beta, ampblas_dcomplex *y, const int *incy)
+{
+    if (gemv_failed("ZGEMV ", trans, *m, *n, *lda, *incx, *incy))
+        return;
+
+    enter();
+    ampblas_zgemv(AmpblasColMajor, complex_trans(trans), *m, *n, alpha, a, *lda, x, *incx, beta, y, *incy);
+}
+
+COMPAT_EXPORT void sger_(const int *m, const int *n, const float *alpha, const float *x, const int *incx,
+                         const float *y, const int *incy, float *a, const int *lda)
+{
+    if (ger_failed("SGER  ", *m, *n, *incx, *incy, *lda))
+        return;
+
+    enter();
+    ampblas_sger(AmpblasColMajor, *m, *n, *alpha, x, *incx, y, *incy, a, *lda);
+}
+
+COMPAT_EXPORT void dger_(const int *m, const int *n, const double *alpha, const double *x, const int *incx,
+                         const double *y, const int *incy, double *a, const int *lda)
+{
+    if (ger_failed("DGER  ", *m, *n, *incx, *incy, *lda))
+        return;
+
+    enter();
+    ampblas_dger(AmpblasColMajor, *m, *n, *alpha, x, *incx, y, *incy, a, *lda);
+}
+
+COMPAT_EXPORT void cgeru_(const int *m, const int *n, const ampblas_fcomplex *alpha, const ampblas_fcomplex *x, const int *incx,
+                          const ampblas_fcomplex *y, const int *incy, ampblas_fcomplex *a, const int *lda)
+{
+    if (ger_failed("CGERU ", *m, *n, *incx, *incy, *lda))
+        return;
+
+    enter();
+    ampblas_cgeru(AmpblasColMajor, *m, *n, alpha, x, *incx, y, *incy, a, *lda);
+}
+
+COMPAT_EXPORT void cgerc_(const int *m, const int *n, const ampblas_fcomplex *alpha, const ampblas_fcomplex *x, const int *incx,
+                          const ampblas_fcomplex *y, const int *incy, ampblas_fcomplex *a, const int *lda)
+{
+    if (ger_failed("CGERC ", *m, *n, *incx, *incy, *lda))
+        return;
+
+    enter();
+    ampblas_cgerc(AmpblasColMajor, *m, *n, alpha, x, *incx, y, *incy, a, *lda);
+}
+
+COMPAT_EXPORT void zgeru_(const int *m, const int *n, const ampblas_dcomplex *alpha, const ampblas_dcomplex *x, const int *incx,
+                          const ampblas_dcomplex *y, const int *incy, ampblas_dcomplex *a, const int *lda)
+{
+    if (ger_failed("ZGERU ", *m, *n, *incx, *incy, *lda))
+        return;
+
+    enter();
+    ampblas_zgeru(AmpblasColMajor, *m, *n, alpha, x, *incx, y, *incy, a, *lda);
+}
+
+COMPAT_EXPORT void zgerc_(const int *m, const int *n, const ampblas_dcomplex *alpha, const ampblas_dcomplex *x, const int *incx,
+                          const ampblas_dcomplex *y, const int *incy, ampblas_dcomplex *a, const int *lda)
+{
+    if (ger_failed("ZGERC ", *m, *n, *incx, *incy, *lda))
+        return;
+
+    enter();
+    ampblas_zgerc(AmpblasColMajor, *m, *n, alpha, x, *incx, y, *incy, a, *lda);
+}
+
+COMPAT_EXPORT void ssymv_(const char *uplo, const int *n, const float *alpha, const float *a, const int *lda,
+                          const float *x, const int *incx, const float *beta, float *y, const int *incy)
+{
+    if (symv_failed("SSYMV ", uplo, *n, *lda, *incx, *incy))
+        return;
+
+    enter();
+    ampblas_ssymv(AmpblasColMajor, to_uplo(uplo), *n, *alpha, a, *lda, x, *incx, *beta, y, *incy);
+}
+
+COMPAT_EXPORT void dsymv_(const char *uplo, const int *n, const double *alpha, const double *a, const int *lda,
+                          const double *x, const int *incx, const double *beta, double *y, const int *incy)
+{
+    if (symv_failed("DSYMV ", uplo, *n, *lda, *incx, *incy))
+        return;
+
+    enter();
+    ampblas_dsymv(AmpblasColMajor, to_uplo(uplo), *n, *alpha, a, *lda, x, *incx, *beta, y, *incy);
+}
+
+COMPAT_EXPORT void chemv_(const char *uplo, const int *n, const ampblas_fcomplex *alpha, const ampblas_fcomplex *a, const int *lda,
+                          const ampblas_fcomplex *x, const int *incx, const ampblas_fcomplex *beta, ampblas_fcomplex *y, const int *incy)
+{
+    if (symv_failed("CHEMV ", uplo, *n, *lda, *incx, *incy))
+        return;
+
+    enter();
+    ampblas_chemv(AmpblasColMajor, to_uplo(uplo), *n, alpha, a, *lda, x, *incx, beta, y, *incy);
+}
+
+COMPAT_EXPORT void zhemv_(const char *uplo, const int *n, const ampblas_dcomplex *alpha, const ampblas_dcomplex *a, const int *lda,
+                          const ampblas_dcomplex *x, const int *incx, const ampblas_dcomplex *beta, ampblas_dcomplex *y, const int *incy)
+{
+    if (symv_failed("ZHEMV ", uplo, *n, *lda, *incx, *incy))
+        return;
+
+    enter();
+    ampblas_zhemv(AmpblasColMajor, to_uplo(uplo), *n, alpha, a, *lda, x, *incx, beta, y, *incy);
+}
+
+COMPAT_EXPORT void ssyr_(const char *uplo, const int *n, const float *alpha, const float *x, const int *incx, float *a, const int *lda)
+{
+    if (syr_failed("SSYR  ", uplo, *n, *incx, *lda))
+        return;
+
+    enter();
+    ampblas_ssyr(AmpblasColMajor, to_uplo(uplo), *n, *alpha, x, *incx, a, *lda);
+}
+
+COMPAT_EXPORT void dsyr_(const char *uplo, const int *n, const double *alpha, const double *x, const int *incx, double *a, const int *lda)
+{
+    if (syr_failed("DSYR  ", uplo, *n, *incx, *lda))
+        return;
+
+    enter();
+    ampblas_dsyr(AmpblasColMajor, to_uplo(uplo), *n, *alpha, x, *incx, a, *lda);
+}
+
+COMPAT_EXPORT void cher_(const char *uplo, const int *n, const float *alpha, const ampblas_fcomplex *x, const int *incx, ampblas_fcomplex *a, const int *lda)
+{
+    if (syr_failed("CHER  ", uplo, *n, *incx, *lda))
+        return;
+
+    enter();
+    ampblas_cher(AmpblasColMajor, to_uplo(uplo), *n, *alpha, x, *incx, a, *lda);
+}
+
+COMPAT_EXPORT void zher_(const char *uplo, const int *n, const double *alpha, const ampblas_dcomplex *x, const int *incx, ampblas_dcomplex *a, const int *lda)
+{
+    if (syr_failed("ZHER  ", uplo, *n, *incx, *lda))
+        return;
+
+    enter();
+    ampblas_zher(AmpblasColMajor, to_uplo(uplo), *n, *alpha, x, *incx, a, *lda);
+}
+
+COMPAT_EXPORT void strmv_(const char *uplo, const char *trans, const char *diag, const int *n, const float *a, const int *lda, float *x, const int *incx)
+{
+    if (trmv_failed("STRMV ", uplo, trans, diag, *n, *lda, *incx))
+        return;
+
+    enter();
+    ampblas_strmv(AmpblasColMajor, to_uplo(uplo), real_trans(trans), to_diag(diag), *n, a, *lda, x, *incx);
+}
+
+COMPAT_EXPORT void dtrmv_(const char *uplo, const char *trans, const char *diag, const int *n, const double *a, const int *lda, double *x, const int *incx)
+{
+    if (trmv_failed("DTRMV ", uplo, trans, diag, *n, *lda, *incx))
+        return;
+
+    enter();
+    ampblas_dtrmv(AmpblasColMajor, to_uplo(uplo), real_trans(trans), to_diag(diag), *n, a, *lda, x, *incx);
+}
+
+COMPAT_EXPORT void ctrmv_(const char *uplo, const char *trans, const char *diag, const int *n, const ampblas_fcomplex *a, const int *lda, ampblas_fcomplex *x, const int *incx)
+{
+    if (trmv_failed("CTRMV ", uplo, trans, diag, *n, *lda, *incx))
+        return;
+
+    enter();
+    ampblas_ctrmv(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), to_diag(diag), *n, a, *lda, x, *incx);
+}
+
+COMPAT_EXPORT void ztrmv_(const char *uplo, const char *trans, const char *diag, const int *n, const ampblas_dcomplex *a, const int *lda, ampblas_dcomplex *x, const int *incx)
+{
+    if (trmv_failed("ZTRMV ", uplo, trans, diag, *n, *lda, *incx))
+        return;
+
+    enter();
+    ampblas_ztrmv(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), to_diag(diag), *n, a, *lda, x, *incx);
+}
+
+COMPAT_EXPORT void strsv_(const char *uplo, const char *trans, const char *diag, const int *n, const float *a, const int *lda, float *x, const int *incx)
+{
+    if (trmv_failed("STRSV ", uplo, trans, diag, *n, *lda, *incx))
+        return;
+
+    enter();
+    ampblas_strsv(AmpblasColMajor, to_uplo(uplo), real_trans(trans), to_diag(diag), *n, a, *lda, x, *incx);
+}
+
+COMPAT_EXPORT void dtrsv_(const char *uplo, const char *trans, const char *diag, const int *n, const double *a, const int *lda, double *x, const int *incx)
+{
+    if (trmv_failed("DTRSV ", uplo, trans, diag, *n, *lda, *incx))
+        return;
+
+    enter();
+    ampblas_dtrsv(AmpblasColMajor, to_uplo(uplo), real_trans(trans), to_diag(diag), *n, a, *lda, x, *incx);
+}
+
+COMPAT_EXPORT void ctrsv_(const char *uplo, const char *trans, const char *diag, const int *n, const ampblas_fcomplex *a, const int *lda, ampblas_fcomplex *x, const int *incx)
+{
+    if (trmv_failed("CTRSV ", uplo, trans, diag, *n, *lda, *incx))
+        return;
+
+    enter();
+    ampblas_ctrsv(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), to_diag(diag), *n, a, *lda, x, *incx);
+}
+
+COMPAT_EXPORT void ztrsv_(const char *uplo, const char *trans, const char *diag, const int *n, const ampblas_dcomplex *a, const int *lda, ampblas_dcomplex *x, const int *incx)
+{
+    if (trmv_failed("ZTRSV ", uplo, trans, diag, *n, *lda, *incx))
+        return;
+
+    enter();
+    ampblas_ztrsv(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), to_diag(diag), *n, a, *lda, x, *incx);
+}
+
+//-----------------------------------------------------------------------------
+// Level 3
+//-----------------------------------------------------------------------------
+
+COMPAT_EXPORT void sgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k,
+                          const float *alpha, const float *a, const int *lda, const float *b, const int *ldb,
+                          const float *beta, float *c, const int *ldc)
+{
+    if (gemm_failed("SGEMM ", transa, transb, *m, *n, *k, *lda, *ldb, *ldc))
+        return;
+
+    enter();
+    ampblas_sgemm(AmpblasColMajor, real_trans(transa), real_trans(transb), *m, *n, *k, *alpha, a, *lda, b, *ldb, *beta, c, *ldc);
+}
+
+COMPAT_EXPORT void dgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k,
+                          const double *alpha, const double *a, const int *lda, const double *b, const int *ldb,
+                          const double *beta, double *c, const int *ldc)
+{
+    if (gemm_failed("DGEMM ", transa, transb, *m, *n, *k, *lda, *ldb, *ldc))
+        return;
+
+    enter();
+    ampblas_dgemm(AmpblasColMajor, real_trans(transa), real_trans(transb), *m, *n, *k, *alpha, a, *lda, b, *ldb, *beta, c, *ldc);
+}
+
+COMPAT_EXPORT void cgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k,
+                          const ampblas_fcomplex *alpha, const ampblas_fcomplex *a, const int *lda, const ampblas_fcomplex *b, const int *ldb,
+                          const ampblas_fcomplex *beta, ampblas_fcomplex *c, const int *ldc)
+{
+    if (gemm_failed("CGEMM ", transa, transb, *m, *n, *k, *lda, *ldb, *ldc))
+        return;
+
+    enter();
+    ampblas_cgemm(AmpblasColMajor, complex_trans(transa), complex_trans(transb), *m, *n, *k, alpha, a, *lda, b, *ldb, beta, c, *ldc);
+}
+
+COMPAT_EXPORT void zgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k,
+                          const ampblas_dcomplex *alpha, const ampblas_dcomplex *a, const int *lda, const ampblas_dcomplex *b, const int *ldb,
+                          const ampblas_dcomplex *beta, ampblas_dcomplex *c, const int *ldc)
+{
+    if (gemm_failed("ZGEMM ", transa, transb, *m, *n, *k, *lda, *ldb, *ldc))
+        return;
+
+    enter();
+    ampblas_zgemm(AmpblasColMajor, complex_trans(transa), complex_trans(transb), *m, *n, *k, alpha, a, *lda, b, *ldb, beta, c, *ldc);
+}
+
+COMPAT_EXPORT void ssyrk_(const char *uplo, const char *trans, const int *n, const int *k, const float *alpha,
+                          const float *a, const int *lda, const float *beta, float *c, const int *ldc)
+{
+    if (syrk_failed("SSYRK ", uplo, trans, real_syrk_trans(trans), *n, *k, *lda, *ldc))
+        return;
+
+    enter();
+    ampblas_ssyrk(AmpblasColMajor, to_uplo(uplo), real_trans(trans), *n, *k, *alpha, a, *lda, *beta, c, *ldc);
+}
+
+COMPAT_EXPORT void dsyrk_(const char *uplo, const char *trans, const int *n, const int *k, const double *alpha,
+                          const double *a, const int *lda, const double *beta, double *c, const int *ldc)
+{
+    if (syrk_failed("DSYRK ", uplo, trans, real_syrk_trans(trans), *n, *k, *lda, *ldc))
+        return;
+
+    enter();
+    ampblas_dsyrk(AmpblasColMajor, to_uplo(uplo), real_trans(trans), *n, *k, *alpha, a, *lda, *beta, c, *ldc);
+}
+
+COMPAT_EXPORT void csyrk_(const char *uplo, const char *trans, const int *n, const int *k, const ampblas_fcomplex *alpha,
+                          const ampblas_fcomplex *a, const int *lda, const ampblas_fcomplex *beta, ampblas_fcomplex *c, const int *ldc)
+{
+    if (syrk_failed("CSYRK ", uplo, trans, complex_syrk_trans(trans), *n, *k, *lda, *ldc))
+        return;
+
+    enter();
+    ampblas_csyrk(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), *n, *k, alpha, a, *lda, beta, c, *ldc);
+}
+
+COMPAT_EXPORT void zsyrk_(const char *uplo, const char *trans, const int *n, const int *k, const ampblas_dcomplex *alpha,
+                          const ampblas_dcomplex *a, const int *lda, const ampblas_dcomplex *beta, ampblas_dcomplex *c, const int *ldc)
+{
+    if (syrk_failed("ZSYRK ", uplo, trans, complex_syrk_trans(trans), *n, *k, *lda, *ldc))
+        return;
+
+    enter();
+    ampblas_zsyrk(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), *n, *k, alpha, a, *lda, beta, c, *ldc);
+}
+
+COMPAT_EXPORT void cherk_(const char *uplo, const char *trans, const int *n, const int *k, const float *alpha,
+                          const ampblas_fcomplex *a, const int *lda, const float *beta, ampblas_fcomplex *c, const int *ldc)
+{
+    if (syrk_failed("CHERK ", uplo, trans, herk_trans(trans), *n, *k, *lda, *ldc))
+        return;
+
+    enter();
+    ampblas_cherk(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), *n, *k, *alpha, a, *lda, *beta, c, *ldc);
+}
+
+COMPAT_EXPORT void zherk_(const char *uplo, const char *trans, const int *n, const int *k, const double *alpha,
+                          const ampblas_dcomplex *a, const int *lda, const double *beta, ampblas_dcomplex *c, const int *ldc)
+{
+    if (syrk_failed("ZHERK ", uplo, trans, herk_trans(trans), *n, *k, *lda, *ldc))
+        return;
+
+    enter();
+    ampblas_zherk(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), *n, *k, *alpha, a, *lda, *beta, c, *ldc);
+}
+
+COMPAT_EXPORT void ssyr2k_(const char *uplo, const char *trans, const int *n, const int *k, const float *alpha,
+                           const float *a, const int *lda, const float *b, const int *ldb, const float *beta, float *c, const int *ldc)
+{
+    if (syr2k_failed("SSYR2K", uplo, trans, real_syrk_trans(trans), *n, *k, *lda, *ldb, *ldc))
+        return;
+
+    enter();
+    ampblas_ssyr2k(AmpblasColMajor, to_uplo(uplo), real_trans(trans), *n, *k, *alpha, a, *lda, b, *ldb, *beta, c, *ldc);
+}
+
+COMPAT_EXPORT void dsyr2k_(const char *uplo, const char *trans, const int *n, const int *k, const double *alpha,
+                           const double *a, const int *lda, const double *b, const int *ldb, const double *beta, double *c, const int *ldc)
+{
+    if (syr2k_failed("DSYR2K", uplo, trans, real_syrk_trans(trans), *n, *k, *lda, *ldb, *ldc))
+        return;
+
+    enter();
+    ampblas_dsyr2k(AmpblasColMajor, to_uplo(uplo), real_trans(trans), *n, *k, *alpha, a, *lda, b, *ldb, *beta, c, *ldc);
+}
+
+COMPAT_EXPORT void csyr2k_(const char *uplo, const char *trans, const int *n, const int *k, const ampblas_fcomplex *alpha,
+                           const ampblas_fcomplex *a, const int *lda, const ampblas_fcomplex *b, const int *ldb,
+                           const ampblas_fcomplex *beta, ampblas_fcomplex *c, const int *ldc)
+{
+    if (syr2k_failed("CSYR2K", uplo, trans, complex_syrk_trans(trans), *n, *k, *lda, *ldb, *ldc))
+        return;
+
+    enter();
+    ampblas_csyr2k(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), *n, *k, alpha, a, *lda, b, *ldb, beta, c, *ldc);
+}
+
+COMPAT_EXPORT void zsyr2k_(const char *uplo, const char *trans, const int *n, const int *k, const ampblas_dcomplex *alpha,
+                           const ampblas_dcomplex *a, const int *lda, const ampblas_dcomplex *b, const int *ldb,
+                           const ampblas_dcomplex *beta, ampblas_dcomplex *c, const int *ldc)
+{
+    if (syr2k_failed("ZSYR2K", uplo, trans, complex_syrk_trans(trans), *n, *k, *lda, *ldb, *ldc))
+        return;
+
+    enter();
+    ampblas_zsyr2k(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), *n, *k, alpha, a, *lda, b, *ldb, beta, c, *ldc);
+}
+
+COMPAT_EXPORT void cher2k_(const char *uplo, const char *trans, const int *n, const int *k, const ampblas_fcomplex *alpha,
+                           const ampblas_fcomplex *a, const int *lda, const ampblas_fcomplex *b, const int *ldb,
+                           const float *beta, ampblas_fcomplex *c, const int *ldc)
+{
+    if (syr2k_failed("CHER2K", uplo, trans, herk_trans(trans), *n, *k, *lda, *ldb, *ldc))
+        return;
+
+    enter();
+    ampblas_cher2k(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), *n, *k, alpha, a, *lda, b, *ldb, *beta, c, *ldc);
+}
+
+COMPAT_EXPORT void zher2k_(const char *uplo, const char *trans, const int *n, const int *k, const ampblas_dcomplex *alpha,
+                           const ampblas_dcomplex *a, const int *lda, const ampblas_dcomplex *b, const int *ldb,
+                           const double *beta, ampblas_dcomplex *c, const int *ldc)
+{
+    if (syr2k_failed("ZHER2K", uplo, trans, herk_trans(trans), *n, *k, *lda, *ldb, *ldc))
+        return;
+
+    enter();
+    ampblas_zher2k(AmpblasColMajor, to_uplo(uplo), complex_trans(trans), *n, *k, alpha, a, *lda, b, *ldb, *beta, c, *ldc);
+}
+
+COMPAT_EXPORT void strmm_(const char *side, const char *uplo, const char *transa, const char *diag, const int *m, const int *n,
+                          const float *alpha, const float *a, const int *lda, float *b, const int *ldb)
+{
+    if (trmm_failed("STRMM ", side, uplo, transa, diag, *m, *n, *lda, *ldb))
+        return;
+
+    enter();
+    ampblas_strmm(AmpblasColMajor, to_side(side), to_uplo(uplo), real_trans(transa), to_diag(diag), *m, *n, *alpha, a, *lda, b, *ldb);
+}
+
+COMPAT_EXPORT void dtrmm_(const char *side, const char *uplo, const char *transa, const char *diag, const int *m, const int *n,
+                          const double *alpha, const double *a, const int *lda, double *b, const int *ldb)
+{
+    if (trmm_failed("DTRMM ", side, uplo, transa, diag, *m, *n, *lda, *ldb))
+        return;
+
+    enter();
+    ampblas_dtrmm(AmpblasColMajor, to_side(side), to_uplo(uplo), real_trans(transa), to_diag(diag), *m, *n, *alpha, a, *lda, b, *ldb);
+}
+
+COMPAT_EXPORT void ctrmm_(const char *side, const char *uplo, const char *transa, const char *diag, const int *m, const int *n,
+                          const ampblas_fcomplex *alpha, const ampblas_fcomplex *a, const int *lda, ampblas_fcomplex *b, const int *ldb)
+{
+    if (trmm_failed("CTRMM ", side, uplo, transa, diag, *m, *n, *lda, *ldb))
+        return;
+
+    enter();
+    ampblas_ctrmm(AmpblasColMajor, to_side(side), to_uplo(uplo), complex_trans(transa), to_diag(diag), *m, *n, alpha, a, *lda, b, *ldb);
+}
+
+COMPAT_EXPORT void ztrmm_(const char *side, const char *uplo, const char *transa, const char *diag, const int *m, const int *n,
+                          const ampblas_dcomplex *alpha, const ampblas_dcomplex *a, const int *lda, ampblas_dcomplex *b, const int *ldb)
+{
+    if (trmm_failed("ZTRMM ", side, uplo, transa, diag, *m, *n, *lda, *ldb))
+        return;
+
+    enter();
+    ampblas_ztrmm(AmpblasColMajor, to_side(side), to_uplo(uplo), complex_trans(transa), to_diag(diag), *m, *n, alpha, a, *lda, b, *ldb);
+}
+
+COMPAT_EXPORT void strsm_(const char *side, const char *uplo, const char *transa, const char *diag, const int *m, const int *n,
+                          const float *alpha, const float *a, const int *lda, float *b, const int *ldb)
+{
+    if (trmm_failed("STRSM ", side, uplo, transa, diag, *m, *n, *lda, *ldb))
+        return;
+
+    enter();
+    ampblas_strsm(AmpblasColMajor, to_side(side), to_uplo(uplo), real_trans(transa), to_diag(diag), *m, *n, *alpha, a, *lda, b, *ldb);
+}
+
+COMPAT_EXPORT void dtrsm_(const char *side, const char *uplo, const char *transa, const char *diag, const int *m, const int *n,
+                          const double *alpha, const double *a, const int *lda, double *b, const int *ldb)
+{
+    if (trmm_failed("DTRSM ", side, uplo, transa, diag, *m, *n, *lda, *ldb))
+        return;
+
+    enter();
+    ampblas_dtrsm(AmpblasColMajor, to_side(side), to_uplo(uplo), real_trans(transa), to_diag(diag), *m, *n, *alpha, a, *lda, b, *ldb);
+}
+
+COMPAT_EXPORT void ctrsm_(const char *side, const char *uplo, const char *transa, const char *diag, const int *m, const int *n,
+                          const ampblas_fcomplex *alpha, const ampblas_fcomplex *a, const int *lda, ampblas_fcomplex *b, const int *ldb)
+{
+    if (trmm_failed("CTRSM ", side, uplo, transa, diag, *m, *n, *lda, *ldb))
+        return;
+
+    enter();
+    ampblas_ctrsm(AmpblasColMajor, to_side(side), to_uplo(uplo), complex_trans(transa), to_diag(diag), *m, *n, alpha, a, *lda, b, *ldb);
+}
+
+COMPAT_EXPORT void ztrsm_(const char *side, const char *uplo, const char *transa, const char *diag, const int *m, const int *n,
+                          const ampblas_dcomplex *alpha, const ampblas_dcomplex *a, const int *lda, ampblas_dcomplex *b, const int *ldb)
+{
+    if (trmm_failed("ZTRSM ", side, uplo, transa, diag, *m, *n, *lda, *ldb))
+        return;
+
+    enter();
+    ampblas_ztrsm(AmpblasColMajor, to_side(side), to_uplo(uplo), complex_trans(transa), to_diag(diag), *m, *n, alpha, a, *lda, b, *ldb);
+}
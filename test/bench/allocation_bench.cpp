@@ -0,0 +1,120 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * allocation_bench.cpp
+ *
+ * Matrices obtained from malloc and bound, against ampblas_malloc with
+ * ordinary and with large pages: the cost of allocating, binding and
+ * first touching the memory, and a host GEMV sweeping it, where the large
+ * pages cut TLB misses.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "ampcblas.h"
+#include "ampcblas_runtime.h"
+#include "detail/host/kernels.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class allocation_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "S bound matrix allocation and host sweep";
+    }
+
+    void run()
+    {
+        using namespace ampblas::_detail;
+
+        const host_kernel_table<float> table = get_host_kernel_table<float>(select_host_isa(detect_host_features()));
+
+        const int sizes[] = { 1024, 4096, 8192 };
+        for (int m : sizes)
+        {
+            const size_t byte_len = size_t(m) * m * sizeof(float);
+            std::vector<float> x(m, 1.0f), y(m);
+
+            std::stringstream label;
+            label << "m = " << m;
+
+            const char* names[] = { " malloc + bind", " ampblas_malloc", " ampblas_malloc large pages" };
+            for (int kind = 0; kind < 3; kind++)
+            {
+                std::vector<double> setup_samples, gemv_samples, release_samples;
+                for (int s = 0; s < samples; s++)
+                {
+                    timer.restart();
+                    float *a = nullptr;
+                    if (kind == 0)
+                    {
+                        a = static_cast<float*>(std::malloc(byte_len));
+                        ampblas_bind(a, byte_len);
+                    }
+                    else
+                    {
+                        a = static_cast<float*>(ampblas_malloc(byte_len, kind == 2 ? AmpblasAllocLargePages : AmpblasAllocDefault));
+                    }
+
+                    if (a == nullptr)
+                    {
+                        std::cout << "  allocation failed" << std::endl;
+                        return;
+                    }
+
+                    std::fill(a, a + size_t(m) * m, 1.0f / m);
+                    setup_samples.push_back(timer.us());
+
+                    timer.restart();
+                    table.gemv(m, m, 1.0f, a, m, x.data(), y.data());
+                    gemv_samples.push_back(timer.us());
+
+                    timer.restart();
+                    if (kind == 0)
+                    {
+                        ampblas_unbind(a);
+                        std::free(a);
+                    }
+                    else
+                    {
+                        ampblas_free(a);
+                    }
+                    release_samples.push_back(timer.us());
+                }
+
+                report_samples(label.str() + names[kind] + " setup", setup_samples);
+                report_samples(label.str() + names[kind] + " gemv", gemv_samples);
+                report_samples(label.str() + names[kind] + " release", release_samples);
+            }
+        }
+    }
+
+private:
+    static const int samples = 10;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(allocation_bench);
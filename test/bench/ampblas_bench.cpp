@@ -0,0 +1,32 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ * 
+ * main benchmark driver
+ *
+ *---------------------------------------------------------------------------*/
+
+#include "ampblas_bench_list.h"
+
+int main(int argc, char* argv[])
+{
+    // any arguments are treated as name filters
+    std::vector<std::string> filters(argv + 1, argv + argc);
+
+    // run all benchmarks that have been registered by the benchmarking framework 
+    execute_benchmarks(filters);
+    
+    return 0;
+}
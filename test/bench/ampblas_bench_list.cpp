@@ -0,0 +1,64 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <numeric>
+#include <iostream>
+#include <iomanip>
+
+#include "ampblas_bench_list.h"
+
+bench_list& get_bench_list()
+{
+    static bench_list benches;
+    return benches; 
+}
+
+void execute_benchmarks(const std::vector<std::string>& filters)
+{
+    for (const std::shared_ptr<bench_list_item>& bench : get_bench_list())
+    {
+        const std::string name = bench->name();
+
+        bool selected = filters.empty();
+        for (const std::string& filter : filters)
+            selected |= (name.find(filter) != std::string::npos);
+
+        if (!selected)
+            continue;
+
+        std::cout << name << std::endl;
+        bench->run();
+        std::cout << std::endl;
+    }
+}
+
+void report_samples(const std::string& label, std::vector<double> samples)
+{
+    if (samples.empty())
+        return;
+
+    std::sort(samples.begin(), samples.end());
+
+    const double min = samples.front();
+    const double median = samples[samples.size() / 2];
+    const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+
+    std::cout << "  " << std::left << std::setw(32) << label << std::right << std::fixed << std::setprecision(2)
+              << " min " << std::setw(10) << min << " us"
+              << "  median " << std::setw(10) << median << " us"
+              << "  mean " << std::setw(10) << mean << " us" << std::endl;
+}
@@ -0,0 +1,67 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ * 
+ * ampblas_bench_list.h
+ *
+ * Benchmarking framework component used to register benchmarks and report
+ * timing statistics.
+ *
+ *---------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <string>
+
+//
+// bench list
+//
+
+class bench_list_item
+{
+public:
+    virtual ~bench_list_item() {}
+    virtual std::string name() const = 0;
+    virtual void run() = 0;
+};
+
+template <typename bench_type>
+class bench_register_helper
+{
+public:
+	bench_register_helper()
+	{
+		get_bench_list().push_back( std::make_shared<bench_type>() );
+	}
+};
+
+// helper macro to create an "anonymous" variable to add to the global bench list
+#define REGISTER_BENCH(bench_name) bench_register_helper<bench_name> BENCH_##bench_name;
+
+typedef std::vector<std::shared_ptr<bench_list_item>> bench_list;
+
+bench_list& get_bench_list();
+
+// runs every registered benchmark whose name contains one of the filters (all if empty)
+void execute_benchmarks(const std::vector<std::string>& filters);
+
+//
+// reporting
+//
+
+// prints min, median and mean of a set of samples given in microseconds
+void report_samples(const std::string& label, std::vector<double> samples);
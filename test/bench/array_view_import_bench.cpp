@@ -0,0 +1,102 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * array_view_import_bench.cpp
+ *
+ * SSCAL through the C interface on data that already lives in an accelerator
+ * array: copied out to host memory and bound, against importing the array's
+ * view with bind_array_view.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <sstream>
+
+#include "ampcblas.h"
+#include "ampcblas_runtime.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class array_view_import_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "SSCAL on accelerator arrays through the C interface";
+    }
+
+    void run()
+    {
+        const concurrency::accelerator_view av = ampcblas::get_current_accelerator_view();
+
+        const int sizes[] = { 1 << 12, 1 << 18, 1 << 24 };
+        for (int n : sizes)
+        {
+            concurrency::array<float,1> data(n, av);
+            concurrency::array_view<float,1> view(data);
+            std::vector<float> host(n);
+
+            std::stringstream label;
+            label << "n = " << n;
+
+            // round trip through host memory
+            {
+                std::vector<double> samples_us;
+                for (int i=0; i<warmup+samples; i++)
+                {
+                    timer.restart();
+                    concurrency::copy(data, host.begin());
+                    ampblas_bind(host.data(), host.size() * sizeof(float));
+                    ampblas_sscal(n, 1.0f, host.data(), 1);
+                    ampblas_synchronize(host.data(), host.size() * sizeof(float));
+                    ampblas_unbind(host.data());
+                    concurrency::copy(host.begin(), host.end(), data);
+                    if (i >= warmup)
+                        samples_us.push_back(timer.us());
+                }
+                report_samples(label.str() + " copy and bind", samples_us);
+            }
+
+            // imported view
+            {
+                float *x = static_cast<float*>(ampcblas::bind_array_view(view));
+
+                std::vector<double> samples_us;
+                for (int i=0; i<warmup+samples; i++)
+                {
+                    timer.restart();
+                    ampblas_sscal(n, 1.0f, x, 1);
+                    av.wait();
+                    if (i >= warmup)
+                        samples_us.push_back(timer.us());
+                }
+                report_samples(label.str() + " bind_array_view", samples_us);
+
+                ampblas_unbind(x);
+            }
+        }
+    }
+
+private:
+    static const int warmup = 3;
+    static const int samples = 50;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(array_view_import_bench);
@@ -0,0 +1,102 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * dirty_range_bench.cpp
+ *
+ * Small updates to a large bound buffer followed by a synchronize of the
+ * whole buffer, the pattern of callers that do not keep track of what a
+ * routine wrote. Synchronizing just the updated sections is timed alongside
+ * as the lower bound.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <sstream>
+
+#include "ampcblas.h"
+#include "ampcblas_runtime.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class dirty_range_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "S bound buffer synchronize after small updates";
+    }
+
+    void run()
+    {
+        std::vector<float> x(n, 1.0f);
+        ampblas_bind(x.data(), x.size() * sizeof(float));
+
+        // warm up kernel compilation and move the buffer to the accelerator
+        ampblas_sscal(n, 1.0f, x.data(), 1);
+        ampblas_synchronize(x.data(), x.size() * sizeof(float));
+
+        const int updates[] = { 1, 4, 16 };
+        for (int count : updates)
+        {
+            std::vector<double> whole_samples, section_samples;
+            for (int s=0; s<samples; s++)
+            {
+                // spread the updated sections over the buffer
+                update(x.data(), count, s);
+                timer.restart();
+                ampblas_synchronize(x.data(), x.size() * sizeof(float));
+                whole_samples.push_back(timer.us());
+
+                update(x.data(), count, s);
+                timer.restart();
+                for (int i=0; i<count; i++)
+                    ampblas_synchronize(x.data() + offset(i, count, s), section * sizeof(float));
+                section_samples.push_back(timer.us());
+            }
+
+            std::stringstream label;
+            label << count << " x " << section << " of " << n;
+            report_samples(label.str() + " whole buffer", whole_samples);
+            report_samples(label.str() + " sections only", section_samples);
+        }
+
+        ampblas_unbind(x.data());
+    }
+
+private:
+
+    static void update(float *x, int count, int sample)
+    {
+        for (int i=0; i<count; i++)
+            ampblas_sscal(section, 1.0f, x + offset(i, count, sample), 1);
+        ampcblas::get_current_accelerator_view().wait();
+    }
+
+    static int offset(int i, int count, int sample)
+    {
+        return ((i * (n / count)) + sample * section) % (n - section);
+    }
+
+    static const int n = 1 << 26;
+    static const int section = 4096;
+    static const int samples = 20;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(dirty_range_bench);
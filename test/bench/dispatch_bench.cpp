@@ -0,0 +1,116 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * dispatch_bench.cpp
+ *
+ * A trace of AXPY, DOT, GEMV and GEMM calls of mixed sizes through the C
+ * interface, as an application alternating small and large steps issues
+ * them, run with every call on the accelerator, every call on the host, and
+ * the dispatch model choosing per call.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <iostream>
+#include <vector>
+
+#include "ampcblas.h"
+#include "ampcblas_runtime.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class dispatch_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "S mixed-size call trace with host/accelerator dispatch";
+    }
+
+    void run()
+    {
+        std::vector<float> a(max_n * max_n, 1.0f / max_n), b(max_n * max_n, 1.0f / max_n), c(max_n * max_n);
+        std::vector<float> x(max_n * max_n, 1.0f), y(max_n * max_n);
+
+        ampblas_bind(a.data(), a.size() * sizeof(float));
+        ampblas_bind(b.data(), b.size() * sizeof(float));
+        ampblas_bind(c.data(), c.size() * sizeof(float));
+        ampblas_bind(x.data(), x.size() * sizeof(float));
+        ampblas_bind(y.data(), y.size() * sizeof(float));
+
+        // measure the model before any timing
+        ampblas_dispatch_model model;
+        ampblas_get_dispatch_model(&model);
+
+        std::cout << "  model: host " << model.host_sgflops << " GFLOP/s " << model.host_bandwidth << " GB/s, accelerator "
+                  << model.accelerator_sgflops << " GFLOP/s " << model.accelerator_bandwidth << " GB/s, transfers "
+                  << model.transfer_bandwidth << " GB/s, launch " << model.launch_overhead_us << " us" << std::endl;
+
+        const enum AMPBLAS_DISPATCH_MODE modes[] = { AmpblasDispatchAccelerator, AmpblasDispatchHost, AmpblasDispatchAuto };
+        const char *labels[] = { "accelerator", "host", "auto" };
+        for (int m=0; m<3; m++)
+        {
+            ampblas_set_dispatch_mode(modes[m]);
+
+            std::vector<double> samples_us;
+            for (int i=0; i<warmup+samples; i++)
+            {
+                timer.restart();
+                trace(a.data(), b.data(), c.data(), x.data(), y.data());
+                if (i >= warmup)
+                    samples_us.push_back(timer.us());
+            }
+            report_samples(labels[m], samples_us);
+        }
+
+        ampblas_set_dispatch_mode(AmpblasDispatchAccelerator);
+
+        ampblas_unbind(a.data());
+        ampblas_unbind(b.data());
+        ampblas_unbind(c.data());
+        ampblas_unbind(x.data());
+        ampblas_unbind(y.data());
+    }
+
+private:
+
+    // every size runs a step of level 1, 2 and 3 calls; the caller reads the results of each
+    static void trace(const float *a, const float *b, float *c, float *x, float *y)
+    {
+        const int sizes[] = { 8, 16, 32, 64, 128, 256, 512, max_n };
+        for (int n : sizes)
+        {
+            ampblas_saxpy(n * n, 0.5f, x, 1, y, 1);
+            volatile float d = ampblas_sdot(n * n, x, 1, y, 1);
+            (void)d;
+
+            ampblas_sgemv(AmpblasColMajor, AmpblasNoTrans, n, n, 1.0f, a, n, x, 1, 0.0f, y, 1);
+            ampblas_sgemm(AmpblasColMajor, AmpblasNoTrans, AmpblasNoTrans, n, n, n, 1.0f, a, n, b, n, 0.0f, c, n);
+
+            ampblas_synchronize(y, n * n * sizeof(float));
+            ampblas_synchronize(c, n * n * sizeof(float));
+        }
+    }
+
+    static const int max_n = 1024;
+    static const int warmup = 3;
+    static const int samples = 20;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(dispatch_bench);
@@ -0,0 +1,179 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * expression_bench.cpp
+ *
+ * Times expressions on ampblas::vector and ampblas::matrix against the
+ * sequence of templated BLAS calls a caller would otherwise write by hand.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+
+#include "ampblas_matrix.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class expression_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "S expression templates versus hand written calls";
+    }
+
+    void run()
+    {
+        const concurrency::accelerator_view av = concurrency::accelerator().default_view;
+
+        run_elementwise(av);
+        run_gemv(av);
+        run_gemm(av);
+    }
+
+private:
+
+    // z = x + 2 * y - w
+    void run_elementwise(const concurrency::accelerator_view& av)
+    {
+        const int n = 1 << 22;
+
+        std::vector<float> data(n, 1.0f);
+        concurrency::array_view<float,1> xv(n, data), yv(n, data), wv(n, data), zv(n);
+        ampblas::vector<float> x(xv, av), y(yv, av), w(wv, av), z(zv, av);
+
+        std::vector<double> hand_samples, expression_samples;
+
+        for (int s = 0; s <= samples; s++)
+        {
+            // copy, scaled update and update: three passes over z
+            timer.restart();
+            ampblas::copy(av, xv, zv);
+            ampblas::axpy(av, 2.0f, yv, zv);
+            ampblas::axpy(av, -1.0f, wv, zv);
+            av.wait();
+            const double hand = timer.us();
+
+            // one fused kernel
+            timer.restart();
+            z = x + 2.0f * y - w;
+            av.wait();
+            const double expression = timer.us();
+
+            // the first iteration compiles the kernels
+            if (s > 0)
+            {
+                hand_samples.push_back(hand);
+                expression_samples.push_back(expression);
+            }
+        }
+
+        report_samples("z = x + 2y - w  copy + axpy + axpy", hand_samples);
+        report_samples("z = x + 2y - w  expression", expression_samples);
+    }
+
+    // y = alpha * A * x + beta * y
+    void run_gemv(const concurrency::accelerator_view& av)
+    {
+        const int n = 2048;
+
+        std::vector<float> a_data(n*n, 1.0f), x_data(n, 1.0f), y_data(n, 1.0f);
+        concurrency::array_view<float,2> av_a(concurrency::extent<2>(n, n), a_data);
+        concurrency::array_view<float,1> av_x(n, x_data), av_y(n, y_data);
+
+        ampblas::matrix<float> a(av_a, av);
+        ampblas::vector<float> x(av_x, av), y(av_y, av);
+
+        std::vector<double> hand_samples, expression_samples;
+
+        for (int s = 0; s <= samples; s++)
+        {
+            timer.restart();
+            ampblas::gemv(av, ampblas::transpose::no_trans, 2.0f, concurrency::array_view<const float,2>(av_a), av_x, 0.5f, av_y);
+            av.wait();
+            const double hand = timer.us();
+
+            timer.restart();
+            y = 2.0f * a * x + 0.5f * y;
+            av.wait();
+            const double expression = timer.us();
+
+            if (s > 0)
+            {
+                hand_samples.push_back(hand);
+                expression_samples.push_back(expression);
+            }
+        }
+
+        report_samples("y = aAx + by  gemv", hand_samples);
+        report_samples("y = aAx + by  expression", expression_samples);
+    }
+
+    // C = A * B + bias
+    void run_gemm(const concurrency::accelerator_view& av)
+    {
+        const int n = 1024;
+
+        std::vector<float> a_data(n*n, 1.0f), b_data(n*n, 1.0f), c_data(n*n), bias_data(n*n, 1.0f);
+        concurrency::array_view<float,2> av_a(concurrency::extent<2>(n, n), a_data);
+        concurrency::array_view<float,2> av_b(concurrency::extent<2>(n, n), b_data);
+        concurrency::array_view<float,2> av_c(concurrency::extent<2>(n, n), c_data);
+        concurrency::array_view<float,2> av_bias(concurrency::extent<2>(n, n), bias_data);
+
+        // flat views for the hand written bias pass
+        concurrency::array_view<float,1> c_flat = av_c.view_as(concurrency::extent<1>(n*n));
+        concurrency::array_view<float,1> bias_flat = av_bias.view_as(concurrency::extent<1>(n*n));
+
+        ampblas::matrix<float> a(av_a, av), b(av_b, av), c(av_c, av), bias(av_bias, av);
+
+        std::vector<double> hand_samples, expression_samples;
+
+        for (int s = 0; s <= samples; s++)
+        {
+            // product into C followed by a separate bias pass
+            timer.restart();
+            ampblas::gemm(av, ampblas::transpose::no_trans, ampblas::transpose::no_trans, 1.0f, concurrency::array_view<const float,2>(av_a), concurrency::array_view<const float,2>(av_b), 0.0f, av_c);
+            ampblas::axpy(av, 1.0f, bias_flat, c_flat);
+            av.wait();
+            const double hand = timer.us();
+
+            // bias is written first and accumulated into by the product
+            timer.restart();
+            c = a * b + bias;
+            av.wait();
+            const double expression = timer.us();
+
+            if (s > 0)
+            {
+                hand_samples.push_back(hand);
+                expression_samples.push_back(expression);
+            }
+        }
+
+        report_samples("C = AB + bias  gemm + axpy", hand_samples);
+        report_samples("C = AB + bias  expression", expression_samples);
+    }
+
+    static const int samples = 20;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(expression_bench);
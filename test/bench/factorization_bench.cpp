@@ -0,0 +1,163 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * factorization_bench.cpp
+ *
+ * Flop rates of the blocked Cholesky, LU and QR factorizations on the
+ * accelerator and on the host.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+
+#include "ampblas.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+template <typename T>
+class factorization_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return std::string(sizeof(T) == sizeof(float) ? "S" : "D") + " POTRF/GETRF/GEQRF";
+    }
+
+    void run()
+    {
+        const concurrency::accelerator_view av = concurrency::accelerator().default_view;
+
+        if (sizeof(T) == sizeof(double) && !av.accelerator.supports_double_precision)
+        {
+            std::cout << "  skipped (no double support)" << std::endl;
+            return;
+        }
+
+        const int sizes[] = { 1024, 4096, 8192, 16384 };
+        for (int n : sizes)
+        {
+            std::stringstream label;
+            label << "n = " << n << " ";
+
+            try
+            {
+                run_accelerator(label.str(), n, av);
+            }
+            catch (const concurrency::out_of_memory&)
+            {
+                std::cout << "  " << label.str() << "skipped (out of memory)" << std::endl;
+            }
+
+            // the host path is only timed at the smaller sizes
+            if (n <= 4096)
+                run_host(label.str(), n);
+        }
+    }
+
+private:
+
+    // diagonally dominant, so every factorization runs to completion
+    static std::vector<T> make_matrix(int n)
+    {
+        std::vector<T> a(size_t(n)*n);
+        for (int j=0; j<n; j++)
+            for (int i=0; i<n; i++)
+                a[i + size_t(j)*n] = (i == j ? T(n) : T((i*7 + j*13) % 17) / T(17));
+        return a;
+    }
+
+    static void report(const std::string& label, double flops, double us)
+    {
+        std::cout << "  " << label << ": " << us / 1e3 << " ms, " << flops / (us * 1e3) << " GFLOP/s" << std::endl;
+    }
+
+    void run_accelerator(const std::string& label, int n, const concurrency::accelerator_view& av)
+    {
+        const double n3 = double(n) * n * n;
+        const std::vector<T> source = make_matrix(n);
+
+        concurrency::array<T,2> a_data(n, n, av);
+        concurrency::array_view<T,2> a(a_data);
+
+        std::vector<int> ipiv;
+        std::vector<T> tau;
+
+        // warm up kernel compilation
+        {
+            concurrency::array<T,2> w_data(256, 256, source.begin(), av);
+            concurrency::array_view<T,2> w(w_data);
+            ampblas::potrf(av, ampblas::uplo::lower, w);
+            ampblas::getrf(av, w, ipiv);
+            ampblas::geqrf(av, w, tau);
+            av.wait();
+        }
+
+        concurrency::copy(source.begin(), a_data);
+        av.wait();
+        timer.restart();
+        ampblas::potrf(av, ampblas::uplo::lower, a);
+        av.wait();
+        report(label + "accelerator potrf", n3 / 3, timer.us());
+
+        concurrency::copy(source.begin(), a_data);
+        av.wait();
+        timer.restart();
+        ampblas::getrf(av, a, ipiv);
+        av.wait();
+        report(label + "accelerator getrf", 2 * n3 / 3, timer.us());
+
+        concurrency::copy(source.begin(), a_data);
+        av.wait();
+        timer.restart();
+        ampblas::geqrf(av, a, tau);
+        av.wait();
+        report(label + "accelerator geqrf", 4 * n3 / 3, timer.us());
+    }
+
+    void run_host(const std::string& label, int n)
+    {
+        const double n3 = double(n) * n * n;
+        std::vector<int> ipiv(n);
+        std::vector<T> tau(n);
+
+        std::vector<T> a = make_matrix(n);
+        timer.restart();
+        ampblas::host::potrf(ampblas::uplo::lower, n, a.data(), n);
+        report(label + "host potrf", n3 / 3, timer.us());
+
+        a = make_matrix(n);
+        timer.restart();
+        ampblas::host::getrf(n, n, a.data(), n, ipiv.data());
+        report(label + "host getrf", 2 * n3 / 3, timer.us());
+
+        a = make_matrix(n);
+        timer.restart();
+        ampblas::host::geqrf(n, n, a.data(), n, tau.data());
+        report(label + "host geqrf", 4 * n3 / 3, timer.us());
+    }
+
+    high_resolution_timer timer;
+};
+
+typedef factorization_bench<float> sfactorization_bench;
+typedef factorization_bench<double> dfactorization_bench;
+
+REGISTER_BENCH(sfactorization_bench);
+REGISTER_BENCH(dfactorization_bench);
@@ -0,0 +1,203 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * fused_krylov_bench.cpp
+ *
+ * Compares the vector updates of a conjugate gradient iteration written as
+ * separate BLAS 1 calls against the fused routines, on the accelerator and
+ * on the host.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+
+#include "ampblas.h"
+#include "detail/host/kernels.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+template <typename T>
+class fused_krylov_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return std::string(sizeof(T) == sizeof(float) ? "S" : "D") + " fused Krylov vector updates";
+    }
+
+    void run()
+    {
+        const concurrency::accelerator_view av = concurrency::accelerator().default_view;
+
+        if (sizeof(T) == sizeof(double) && !av.accelerator.supports_limited_double_precision)
+        {
+            std::cout << "  skipped (no double support)" << std::endl;
+            return;
+        }
+
+        run_accelerator(av);
+        run_host();
+    }
+
+    fused_krylov_bench()
+        : x(n), y(n), z(n)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            x[i] = T(i % 17) / T(17);
+            y[i] = T(i % 13) / T(13);
+            z[i] = T(i % 11) / T(11);
+        }
+    }
+
+private:
+
+    void run_accelerator(const concurrency::accelerator_view& av)
+    {
+        concurrency::array<T,1> x_data(n, x.begin(), av);
+        concurrency::array<T,1> y_data(n, y.begin(), av);
+        concurrency::array<T,1> z_data(n, z.begin(), av);
+
+        concurrency::array_view<T,1> xv(x_data);
+        concurrency::array_view<T,1> yv(y_data);
+        concurrency::array_view<T,1> zv(z_data);
+
+        std::vector<double> axpy_dot_samples, axpy_dot_fused_samples;
+        std::vector<double> dot_pair_samples, dot_pair_fused_samples;
+        std::vector<double> axpby_samples, axpby_fused_samples;
+
+        // warm up kernel compilation
+        ampblas::axpy(av, T(0), xv, yv);
+        ampblas::dot<T>(av, xv, yv);
+        ampblas::axpy_dot<T>(av, T(0), xv, yv, zv);
+        ampblas::dot2<T>(av, xv, yv);
+        ampblas::scal(av, T(1), yv);
+        ampblas::axpby(av, T(0), xv, T(1), yv);
+        av.wait();
+
+        for (int s = 0; s < samples; s++)
+        {
+            // r = r - alpha * q; rho = dot(r, r)
+            timer.restart();
+            ampblas::axpy(av, T(1e-3), xv, yv);
+            volatile T result = ampblas::dot<T>(av, yv, zv);
+            axpy_dot_samples.push_back(timer.us());
+
+            timer.restart();
+            result = ampblas::axpy_dot<T>(av, T(-1e-3), xv, yv, zv);
+            axpy_dot_fused_samples.push_back(timer.us());
+
+            // dot(x, y) and dot(x, x)
+            timer.restart();
+            result = ampblas::dot<T>(av, xv, yv);
+            result = ampblas::dot<T>(av, xv, xv);
+            dot_pair_samples.push_back(timer.us());
+
+            timer.restart();
+            result = ampblas::dot2<T>(av, xv, yv).first;
+            dot_pair_fused_samples.push_back(timer.us());
+            (void)result;
+
+            // p = r + beta * p
+            timer.restart();
+            ampblas::scal(av, T(1), yv);
+            ampblas::axpy(av, T(0), xv, yv);
+            av.wait();
+            axpby_samples.push_back(timer.us());
+
+            timer.restart();
+            ampblas::axpby(av, T(0), xv, T(1), yv);
+            av.wait();
+            axpby_fused_samples.push_back(timer.us());
+        }
+
+        report_samples("accelerator axpy + dot", axpy_dot_samples);
+        report_samples("accelerator axpy_dot", axpy_dot_fused_samples);
+        report_samples("accelerator dot + dot", dot_pair_samples);
+        report_samples("accelerator dot2", dot_pair_fused_samples);
+        report_samples("accelerator scal + axpy", axpby_samples);
+        report_samples("accelerator axpby", axpby_fused_samples);
+    }
+
+    void run_host()
+    {
+        using namespace ampblas::_detail;
+
+        std::vector<T> w(n);
+
+        std::vector<double> axpy_dot_samples, axpy_dot_fused_samples;
+        std::vector<double> dot_pair_samples, dot_pair_fused_samples;
+        std::vector<double> waxpby_samples, waxpby_fused_samples;
+
+        for (int s = 0; s < samples; s++)
+        {
+            timer.restart();
+            host_axpy(n, T(1e-3), x.data(), y.data());
+            volatile T result = host_dot(n, y.data(), z.data());
+            axpy_dot_samples.push_back(timer.us());
+
+            timer.restart();
+            result = host_axpy_dot(n, T(-1e-3), x.data(), y.data(), z.data());
+            axpy_dot_fused_samples.push_back(timer.us());
+
+            timer.restart();
+            result = host_dot(n, x.data(), y.data());
+            result = host_dot(n, x.data(), x.data());
+            dot_pair_samples.push_back(timer.us());
+
+            T xy, xx;
+            timer.restart();
+            host_dot2(n, x.data(), y.data(), x.data(), &xy, &xx);
+            dot_pair_fused_samples.push_back(timer.us());
+            (void)result;
+
+            // w = x + 0.5 * y as a copy, a scale and an update
+            timer.restart();
+            std::copy(y.begin(), y.end(), w.begin());
+            for (int i = 0; i < n; i++)
+                w[i] *= T(0.5);
+            host_axpy(n, T(1), x.data(), w.data());
+            waxpby_samples.push_back(timer.us());
+
+            timer.restart();
+            host_waxpby(n, T(1), x.data(), T(0.5), y.data(), w.data());
+            waxpby_fused_samples.push_back(timer.us());
+        }
+
+        report_samples("host axpy + dot", axpy_dot_samples);
+        report_samples("host axpy_dot", axpy_dot_fused_samples);
+        report_samples("host dot + dot", dot_pair_samples);
+        report_samples("host dot2", dot_pair_fused_samples);
+        report_samples("host copy + scal + axpy", waxpby_samples);
+        report_samples("host waxpby", waxpby_fused_samples);
+    }
+
+    static const int n = 1 << 20;
+    static const int samples = 50;
+
+    high_resolution_timer timer;
+    std::vector<T> x, y, z;
+};
+
+typedef fused_krylov_bench<float> sfused_krylov_bench;
+typedef fused_krylov_bench<double> dfused_krylov_bench;
+
+REGISTER_BENCH(sfused_krylov_bench);
+REGISTER_BENCH(dfused_krylov_bench);
@@ -0,0 +1,110 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ * 
+ * gemm_latency_bench.cpp
+ *
+ * Measures the host side cost of dispatching small GEMM calls, where the
+ * per-call overhead dominates the kernel itself. Architecture lookup is
+ * timed separately against the uncached description parser.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <sstream>
+
+#include "ampcblas.h"
+#include "ampcblas_runtime.h"
+#include "detail/tuning/tune.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class gemm_latency_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "SGEMM small matrix dispatch latency";
+    }
+
+    void run()
+    {
+        const concurrency::accelerator_view av = ampcblas::get_current_accelerator_view();
+        high_resolution_timer timer;
+
+        // architecture detection: uncached parse versus cached lookup
+        {
+            std::vector<double> parse_samples, cached_samples;
+
+            for (int i=0; i<samples; i++)
+            {
+                timer.restart();
+                std::wstring desc = av.accelerator.get_description();
+                volatile enum class ampblas::_detail::architecture arch = ampblas::_detail::get_architecture(desc);
+                parse_samples.push_back(timer.us());
+
+                timer.restart();
+                arch = ampblas::_detail::get_architecture(av.accelerator);
+                cached_samples.push_back(timer.us());
+            }
+
+            report_samples("description parse", parse_samples);
+            report_samples("cached lookup", cached_samples);
+        }
+
+        // end to end dispatch of small problems
+        const int sizes[] = { 1, 4, 16, 32, 64 };
+        for (int n : sizes)
+        {
+            std::vector<float> a(n*n, 1.0f), b(n*n, 1.0f), c(n*n, 0.0f);
+
+            ampblas_bind(a.data(), a.size() * sizeof(float));
+            ampblas_bind(b.data(), b.size() * sizeof(float));
+            ampblas_bind(c.data(), c.size() * sizeof(float));
+
+            // warm up kernel compilation and data transfers
+            for (int i=0; i<warmup; i++)
+                ampblas_sgemm(AmpblasColMajor, AmpblasNoTrans, AmpblasNoTrans, n, n, n, 1.0f, a.data(), n, b.data(), n, 0.0f, c.data(), n);
+            av.wait();
+
+            std::vector<double> submit_samples, round_trip_samples;
+            for (int i=0; i<samples; i++)
+            {
+                timer.restart();
+                ampblas_sgemm(AmpblasColMajor, AmpblasNoTrans, AmpblasNoTrans, n, n, n, 1.0f, a.data(), n, b.data(), n, 0.0f, c.data(), n);
+                submit_samples.push_back(timer.us());
+                av.wait();
+                round_trip_samples.push_back(timer.us());
+            }
+
+            std::stringstream label;
+            label << "n = " << n;
+            report_samples(label.str() + " submit", submit_samples);
+            report_samples(label.str() + " round trip", round_trip_samples);
+
+            ampblas_unbind(a.data());
+            ampblas_unbind(b.data());
+            ampblas_unbind(c.data());
+        }
+    }
+
+private:
+    static const int warmup = 10;
+    static const int samples = 1000;
+};
+
+REGISTER_BENCH(gemm_latency_bench);
@@ -0,0 +1,122 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * gemm_shard_bench.cpp
+ *
+ * Square GEMM on host memory split across the first 1, 2, ... of the
+ * available accelerators. Transfers are part of every sample, as they are
+ * for a caller whose operands live on the host.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+#include "ampblas.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class gemm_shard_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "S GEMM sharded across accelerators";
+    }
+
+    void run()
+    {
+        const std::vector<concurrency::accelerator_view> all_views = ampblas::get_shard_views();
+
+        if (all_views.empty())
+        {
+            std::cout << "  skipped (no hardware accelerators)" << std::endl;
+            return;
+        }
+
+        const int sizes[] = { 2048, 4096, 8192 };
+        for (int n : sizes)
+        {
+            for (size_t count = 1; count <= all_views.size(); count++)
+            {
+                std::stringstream label;
+                label << "n = " << n << ", " << count << " accelerator(s)";
+
+                const std::vector<concurrency::accelerator_view> views(all_views.begin(), all_views.begin() + count);
+
+                try
+                {
+                    run_gemm(label.str(), n, views);
+                }
+                catch (const concurrency::out_of_memory&)
+                {
+                    std::cout << "  " << label.str() << " skipped (out of memory)" << std::endl;
+                }
+            }
+        }
+    }
+
+private:
+
+    void run_gemm(const std::string& label, int n, const std::vector<concurrency::accelerator_view>& views)
+    {
+        using namespace ampblas;
+
+        std::vector<float> a_host(n*n, 1.0f / n);
+        std::vector<float> b_host(n*n, 1.0f);
+        std::vector<float> c_host(n*n, 0.0f);
+
+        concurrency::array_view<const float,2> a(n, n, a_host);
+        concurrency::array_view<const float,2> b(n, n, b_host);
+        concurrency::array_view<float,2> c(n, n, c_host);
+
+        const double flops = 2.0 * n * n * n;
+        std::vector<double> samples_us;
+
+        // warm up kernel compilation on every view
+        ampblas::gemm(views, transpose::no_trans, transpose::no_trans, 1.0f, a, b, 0.0f, c);
+        c.synchronize();
+
+        for (int s=0; s<samples; s++)
+        {
+            // the operands start on the host every time
+            a.refresh();
+            b.refresh();
+            c.refresh();
+
+            timer.restart();
+            ampblas::gemm(views, transpose::no_trans, transpose::no_trans, 1.0f, a, b, 0.0f, c);
+            c.synchronize();
+            samples_us.push_back(timer.us());
+        }
+
+        report_samples(label, samples_us);
+
+        std::vector<double> sorted(samples_us);
+        std::sort(sorted.begin(), sorted.end());
+        std::cout << "    " << flops / (sorted[sorted.size()/2] * 1e3) << " GFLOP/s" << std::endl;
+    }
+
+    static const int samples = 3;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(gemm_shard_bench);
@@ -0,0 +1,133 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ * 
+ * host_kernel_bench.cpp
+ *
+ * Times every host kernel variant the running machine supports and checks
+ * each one against the portable implementation.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+#include "detail/host/kernels.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+template <typename T>
+class host_kernel_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return std::string(sizeof(T) == sizeof(float) ? "S" : "D") + " host kernel dispatch";
+    }
+
+    void run()
+    {
+        using namespace ampblas::_detail;
+
+        const enum class host_isa selected = select_host_isa(detect_host_features());
+        std::cout << "  selected isa: " << isa_name(selected) << std::endl;
+
+        const ampblas::_detail::host_kernel_table<T> reference = get_host_kernel_table<T>(host_isa::generic);
+
+        for (int i = 0; i <= int(selected); i++)
+        {
+            const enum class host_isa isa = static_cast<enum class host_isa>(i);
+            const ampblas::_detail::host_kernel_table<T> table = get_host_kernel_table<T>(isa);
+
+            std::vector<double> axpy_samples, dot_samples, gemv_samples, gemm_samples;
+
+            for (int s = 0; s < samples; s++)
+            {
+                std::vector<T> y(y0);
+                timer.restart();
+                table.axpy(n, T(0.5), x.data(), y.data());
+                axpy_samples.push_back(timer.us());
+
+                timer.restart();
+                volatile T result = table.dot(n, x.data(), y0.data());
+                dot_samples.push_back(timer.us());
+                (void)result;
+
+                std::vector<T> v(y0.begin(), y0.begin() + m);
+                timer.restart();
+                table.gemv(m, m, T(1), a.data(), m, x.data(), v.data());
+                gemv_samples.push_back(timer.us());
+
+                std::vector<T> c(a);
+                timer.restart();
+                table.gemm(m, m, m, T(1), a.data(), m, b.data(), m, c.data(), m);
+                gemm_samples.push_back(timer.us());
+            }
+
+            const std::string prefix = std::string(isa_name(isa)) + " ";
+            report_samples(prefix + "axpy", axpy_samples);
+            report_samples(prefix + "dot", dot_samples);
+            report_samples(prefix + "gemv", gemv_samples);
+            report_samples(prefix + "gemm", gemm_samples);
+
+            // compare against the portable kernels
+            const T expected = reference.dot(n, x.data(), y0.data());
+            const T actual = table.dot(n, x.data(), y0.data());
+            if (std::abs(expected - actual) > T(1e-3) * std::abs(expected))
+                std::cout << "  " << isa_name(isa) << " dot mismatch: " << actual << " != " << expected << std::endl;
+        }
+    }
+
+    host_kernel_bench()
+        : x(n), y0(n), a(m*m), b(m*m)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            x[i] = T(i % 17) / T(17);
+            y0[i] = T(i % 13) / T(13);
+        }
+
+        for (int i = 0; i < m*m; i++)
+        {
+            a[i] = T(i % 7) / T(7);
+            b[i] = T(i % 5) / T(5);
+        }
+    }
+
+private:
+
+    static const char* isa_name(enum class ampblas::_detail::host_isa isa)
+    {
+        static const char* names[] = { "generic", "sse42", "avx2", "avx512" };
+        return names[int(isa)];
+    }
+
+    static const int n = 1 << 16;
+    static const int m = 128;
+    static const int samples = 50;
+
+    high_resolution_timer timer;
+    std::vector<T> x, y0, a, b;
+};
+
+typedef host_kernel_bench<float> shost_kernel_bench;
+typedef host_kernel_bench<double> dhost_kernel_bench;
+
+REGISTER_BENCH(shost_kernel_bench);
+REGISTER_BENCH(dhost_kernel_bench);
@@ -0,0 +1,102 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * ilp64_bench.cpp
+ *
+ * Submit cost of the ILP64 entry points against their int counterparts on
+ * operands that fit a single segment, where the 64-bit routines should add
+ * no more than the block bookkeeping.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <sstream>
+
+#include "ampcblas.h"
+#include "ampcblas_runtime.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class ilp64_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "S ILP64 entry point overhead";
+    }
+
+    void run()
+    {
+        const concurrency::accelerator_view av = ampcblas::get_current_accelerator_view();
+
+        const int sizes[] = { 16, 256, 4096 };
+        for (int n : sizes)
+        {
+            std::vector<float> a(n*n, 1.0f), x(n, 1.0f), y(n, 0.0f);
+
+            ampblas_bind(a.data(), a.size() * sizeof(float));
+            ampblas_bind(x.data(), x.size() * sizeof(float));
+            ampblas_bind(y.data(), y.size() * sizeof(float));
+
+            // warm up kernel compilation and data transfers
+            ampblas_saxpy(n, 1.0f, x.data(), 1, y.data(), 1);
+            ampblas_sgemv(AmpblasColMajor, AmpblasNoTrans, n, n, 1.0f, a.data(), n, x.data(), 1, 0.0f, y.data(), 1);
+            av.wait();
+
+            std::vector<double> axpy_samples, axpy_64_samples;
+            std::vector<double> gemv_samples, gemv_64_samples;
+            for (int i=0; i<samples; i++)
+            {
+                timer.restart();
+                ampblas_saxpy(n, 1.0f, x.data(), 1, y.data(), 1);
+                axpy_samples.push_back(timer.us());
+
+                timer.restart();
+                ampblas_saxpy_64(n, 1.0f, x.data(), 1, y.data(), 1);
+                axpy_64_samples.push_back(timer.us());
+
+                timer.restart();
+                ampblas_sgemv(AmpblasColMajor, AmpblasNoTrans, n, n, 1.0f, a.data(), n, x.data(), 1, 0.0f, y.data(), 1);
+                gemv_samples.push_back(timer.us());
+
+                timer.restart();
+                ampblas_sgemv_64(AmpblasColMajor, AmpblasNoTrans, n, n, 1.0f, a.data(), n, x.data(), 1, 0.0f, y.data(), 1);
+                gemv_64_samples.push_back(timer.us());
+            }
+            av.wait();
+
+            std::stringstream label;
+            label << "n = " << n;
+            report_samples(label.str() + " saxpy", axpy_samples);
+            report_samples(label.str() + " saxpy_64", axpy_64_samples);
+            report_samples(label.str() + " sgemv", gemv_samples);
+            report_samples(label.str() + " sgemv_64", gemv_64_samples);
+
+            ampblas_unbind(a.data());
+            ampblas_unbind(x.data());
+            ampblas_unbind(y.data());
+        }
+    }
+
+private:
+    static const int samples = 200;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(ilp64_bench);
@@ -0,0 +1,117 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * implicit_binding_bench.cpp
+ *
+ * Repeated SGEMV calls on the same matrix, written as an unmodified CBLAS
+ * caller would with implicit binding enabled. Explicitly bound operands give
+ * the reference, and invalidating the cache before every call shows the cost
+ * without data reuse.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <sstream>
+
+#include "ampcblas.h"
+#include "ampcblas_runtime.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class implicit_binding_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "SGEMV repeated calls with implicit binding";
+    }
+
+    void run()
+    {
+        const int sizes[] = { 256, 1024, 4096 };
+        for (int n : sizes)
+        {
+            std::vector<float> a(n*n, 1.0f / n), x(n, 1.0f), y(n, 0.0f);
+
+            std::stringstream label;
+            label << "n = " << n;
+
+            // explicit binding; y is written back after every call as a BLAS caller expects
+            {
+                ampblas_bind(a.data(), a.size() * sizeof(float));
+                ampblas_bind(x.data(), x.size() * sizeof(float));
+                ampblas_bind(y.data(), y.size() * sizeof(float));
+
+                std::vector<double> samples_us;
+                for (int i=0; i<warmup+samples; i++)
+                {
+                    timer.restart();
+                    ampblas_sgemv(AmpblasColMajor, AmpblasNoTrans, n, n, 1.0f, a.data(), n, x.data(), 1, 0.0f, y.data(), 1);
+                    ampblas_synchronize(y.data(), y.size() * sizeof(float));
+                    if (i >= warmup)
+                        samples_us.push_back(timer.us());
+                }
+                report_samples(label.str() + " explicit", samples_us);
+
+                ampblas_unbind(a.data());
+                ampblas_unbind(x.data());
+                ampblas_unbind(y.data());
+            }
+
+            ampblas_set_implicit_binding(cache_bytes);
+
+            // implicit binding; A and x stay on the accelerator between calls
+            {
+                std::vector<double> samples_us;
+                for (int i=0; i<warmup+samples; i++)
+                {
+                    timer.restart();
+                    ampblas_sgemv(AmpblasColMajor, AmpblasNoTrans, n, n, 1.0f, a.data(), n, x.data(), 1, 0.0f, y.data(), 1);
+                    if (i >= warmup)
+                        samples_us.push_back(timer.us());
+                }
+                report_samples(label.str() + " implicit", samples_us);
+            }
+
+            // implicit binding with the operands invalidated before every call
+            {
+                std::vector<double> samples_us;
+                for (int i=0; i<warmup+samples; i++)
+                {
+                    timer.restart();
+                    ampblas_invalidate_implicit(nullptr, 0);
+                    ampblas_sgemv(AmpblasColMajor, AmpblasNoTrans, n, n, 1.0f, a.data(), n, x.data(), 1, 0.0f, y.data(), 1);
+                    if (i >= warmup)
+                        samples_us.push_back(timer.us());
+                }
+                report_samples(label.str() + " implicit, invalidated", samples_us);
+            }
+
+            ampblas_set_implicit_binding(0);
+        }
+    }
+
+private:
+    static const size_t cache_bytes = size_t(256) << 20;
+    static const int warmup = 3;
+    static const int samples = 50;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(implicit_binding_bench);
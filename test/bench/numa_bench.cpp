@@ -0,0 +1,145 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * numa_bench.cpp
+ *
+ * Runs the parallel host GEMM, SYRK and TRMM on operands allocated with each
+ * page placement: all on the allocating node, interleaved across the nodes,
+ * and split into one range per node so every column block is local to the
+ * node it runs on.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+#include "ampblas_defs.h"
+#include "detail/host/blas3.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+template <typename T>
+class numa_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return std::string(sizeof(T) == sizeof(float) ? "S" : "D") + " host BLAS 3 page placement";
+    }
+
+    void run()
+    {
+        using namespace ampblas::_detail;
+
+        std::cout << "  numa nodes: " << host_numa_node_count() << std::endl;
+
+        const int sizes[] = { 1024, 2048, 4096 };
+        for (int n : sizes)
+        {
+            std::vector<T> reference;
+            run_placement(n, host_placement::local, "local", reference);
+            run_placement(n, host_placement::interleaved, "interleaved", reference);
+            run_placement(n, host_placement::blocked, "numa blocked", reference);
+        }
+    }
+
+private:
+
+    typedef ampblas::_detail::host_numa_buffer<T> buffer_type;
+
+    static void fill(const buffer_type& buffer, int n)
+    {
+        T* p = buffer.data();
+        for (int j = 0; j < n; j++)
+            for (int i = 0; i < n; i++)
+                p[i + j*n] = (i == j ? T(1) : T((i + 3*j) % 7) / T(7 * n));
+    }
+
+    static void report(const std::string& label, double flops, const std::vector<double>& samples)
+    {
+        report_samples(label, samples);
+
+        std::vector<double> sorted(samples);
+        std::sort(sorted.begin(), sorted.end());
+        std::cout << "    " << flops / (sorted[sorted.size()/2] * 1e3) << " GFLOP/s" << std::endl;
+    }
+
+    void run_placement(int n, enum class ampblas::_detail::host_placement placement, const std::string& placement_name, std::vector<T>& reference)
+    {
+        using namespace ampblas;
+        using namespace ampblas::_detail;
+
+        std::stringstream label;
+        label << "n = " << n << ", " << placement_name << " ";
+
+        const size_t count = size_t(n) * n;
+        buffer_type a(count, placement), b(count, placement), c(count, placement);
+
+        fill(a, n);
+        fill(b, n);
+
+        std::vector<double> gemm_samples, syrk_samples, trmm_samples;
+
+        for (int s = 0; s < samples; s++)
+        {
+            timer.restart();
+            host_parallel_gemm(n, n, n, T(1), a.data(), n, b.data(), n, c.data(), n);
+            gemm_samples.push_back(timer.us());
+
+            timer.restart();
+            host_parallel_syrk(uplo::lower, n, n, T(1), a.data(), n, c.data(), n);
+            syrk_samples.push_back(timer.us());
+
+            timer.restart();
+            host_parallel_trmm(uplo::upper, diag::non_unit, n, n, T(1), a.data(), n, b.data(), n);
+            trmm_samples.push_back(timer.us());
+        }
+
+        report(label.str() + "gemm", 2.0 * n * n * n, gemm_samples);
+        report(label.str() + "syrk", double(n) * (n+1) * n, syrk_samples);
+        report(label.str() + "trmm", double(n) * n * n, trmm_samples);
+
+        // placement must not change the results
+        if (reference.empty())
+        {
+            reference.assign(c.data(), c.data() + count);
+        }
+        else
+        {
+            T max_error = T(0);
+            for (size_t i = 0; i < count; i++)
+                max_error = std::max(max_error, std::abs(reference[i] - c.data()[i]));
+
+            if (max_error != T(0))
+                std::cout << "    mismatch against local placement: " << max_error << std::endl;
+        }
+    }
+
+    static const int samples = 3;
+
+    high_resolution_timer timer;
+};
+
+typedef numa_bench<float> snuma_bench;
+typedef numa_bench<double> dnuma_bench;
+
+REGISTER_BENCH(snuma_bench);
+REGISTER_BENCH(dnuma_bench);
@@ -0,0 +1,140 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * out_of_core_bench.cpp
+ *
+ * Streams square GEMMs whose operands are several times larger than a
+ * fixed accelerator memory budget, next to the in-core product on host
+ * memory where it fits. Transfers are part of every sample.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+#include "ampblas.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class out_of_core_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "S out-of-core GEMM";
+    }
+
+    void run()
+    {
+        const concurrency::accelerator_view av = concurrency::accelerator().default_view;
+
+        std::cout << "  budget: " << (budget >> 20) << " MB" << std::endl;
+
+        const int sizes[] = { 4096, 8192 };
+        for (int n : sizes)
+        {
+            std::stringstream label;
+            label << "n = " << n << " (" << (3.0 * n * n * sizeof(float) / budget) << "x budget) ";
+
+            try
+            {
+                run_gemm(label.str(), n, av);
+            }
+            catch (const std::bad_alloc&)
+            {
+                std::cout << "  " << label.str() << "skipped (out of host memory)" << std::endl;
+            }
+        }
+    }
+
+private:
+
+    static void report(const std::string& label, double flops, const std::vector<double>& samples)
+    {
+        report_samples(label, samples);
+
+        std::vector<double> sorted(samples);
+        std::sort(sorted.begin(), sorted.end());
+        std::cout << "    " << flops / (sorted[sorted.size()/2] * 1e3) << " GFLOP/s" << std::endl;
+    }
+
+    void run_gemm(const std::string& label, int n, const concurrency::accelerator_view& av)
+    {
+        using namespace ampblas;
+
+        std::vector<float> a(size_t(n) * n, 1.0f / n);
+        std::vector<float> b(size_t(n) * n, 1.0f);
+        std::vector<float> c(size_t(n) * n, 0.0f);
+
+        const double flops = 2.0 * n * n * n;
+        std::vector<double> streamed, in_core, host_streamed;
+
+        // warm up kernel compilation
+        gemm_out_of_core(av, transpose::no_trans, transpose::no_trans, 64, 64, 64, 1.0f, a.data(), n, b.data(), n, 0.0f, c.data(), n, budget);
+
+        for (int s = 0; s < samples; s++)
+        {
+            timer.restart();
+            gemm_out_of_core(av, transpose::no_trans, transpose::no_trans, n, n, n, 1.0f, a.data(), n, b.data(), n, 0.0f, c.data(), n, budget);
+            streamed.push_back(timer.us());
+        }
+        report(label + "streamed", flops, streamed);
+
+        // the whole problem on the accelerator, when it fits
+        try
+        {
+            for (int s = 0; s < samples; s++)
+            {
+                concurrency::array_view<const float,2> av_a(n, n, a);
+                concurrency::array_view<const float,2> av_b(n, n, b);
+                concurrency::array_view<float,2> av_c(n, n, c);
+
+                timer.restart();
+                gemm(av, transpose::no_trans, transpose::no_trans, 1.0f, av_a, av_b, 0.0f, av_c);
+                av_c.synchronize();
+                in_core.push_back(timer.us());
+            }
+            report(label + "in core", flops, in_core);
+        }
+        catch (const concurrency::out_of_memory&)
+        {
+            std::cout << "  " << label << "in core skipped (out of accelerator memory)" << std::endl;
+        }
+
+        // the host schedule is only timed where it finishes in reasonable time
+        if (n <= 4096)
+        {
+            for (int s = 0; s < samples; s++)
+            {
+                timer.restart();
+                host::gemm_out_of_core(transpose::no_trans, transpose::no_trans, n, n, n, 1.0f, a.data(), n, b.data(), n, 0.0f, c.data(), n);
+                host_streamed.push_back(timer.us());
+            }
+            report(label + "host streamed", flops, host_streamed);
+        }
+    }
+
+    static const int samples = 3;
+    static const size_t budget = size_t(64) << 20;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(out_of_core_bench);
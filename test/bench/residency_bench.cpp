@@ -0,0 +1,146 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * residency_bench.cpp
+ *
+ * A GEMM, TRSM, GEMV chain on the same bound buffers, run the way a
+ * defensive caller writes it, with every operand synchronized and refreshed
+ * between the calls, and relying on the runtime's residency tracking with
+ * the operands prefetched up front. Bytes moved are reported with the times.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+
+#include "ampcblas.h"
+#include "ampcblas_runtime.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class residency_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "S call chain bytes moved with residency tracking";
+    }
+
+    void run()
+    {
+        const int sizes[] = { 256, 1024, 2048 };
+        for (int n : sizes)
+        {
+            // a is kept well conditioned for the triangular solve
+            std::vector<float> a(n*n, 0.0f), b(n*n, 1.0f / n), c(n*n, 0.0f), x(n, 1.0f), y(n, 0.0f);
+            for (int i = 0; i < n; i++)
+                a[i*n + i] = 2.0f;
+
+            bind(a);
+            bind(b);
+            bind(c);
+            bind(x);
+            bind(y);
+
+            // warm up kernel compilation
+            chain(n, a, b, c, x, y, false);
+            ampcblas::get_current_accelerator_view().wait();
+
+            std::stringstream label;
+            label << "n = " << n;
+
+            for (int defensive = 1; defensive >= 0; defensive--)
+            {
+                std::vector<double> samples_us;
+                ampblas_transfer_stats stats = {};
+                for (int s = 0; s < samples; s++)
+                {
+                    refresh(a);
+                    refresh(b);
+                    ampblas_reset_transfer_stats();
+
+                    timer.restart();
+                    if (!defensive)
+                    {
+                        ampblas_prefetch(a.data(), a.size() * sizeof(float), nullptr);
+                        ampblas_prefetch(b.data(), b.size() * sizeof(float), nullptr);
+                    }
+                    chain(n, a, b, c, x, y, defensive != 0);
+                    ampblas_synchronize(y.data(), y.size() * sizeof(float));
+                    samples_us.push_back(timer.us());
+
+                    ampblas_get_transfer_stats(&stats);
+                }
+
+                const std::string variant = defensive ? " synchronize and refresh between calls" : " prefetch, tracked";
+                report_samples(label.str() + variant, samples_us);
+                std::cout << "    " << stats.bytes_to_accelerator << " bytes to the accelerator, " 
+                          << stats.bytes_to_host << " bytes to the host" << std::endl;
+            }
+
+            ampblas_unbind(a.data());
+            ampblas_unbind(b.data());
+            ampblas_unbind(c.data());
+            ampblas_unbind(x.data());
+            ampblas_unbind(y.data());
+        }
+    }
+
+private:
+
+    // C = A * B; C = inv(A) * C; y = C * x
+    static void chain(int n, std::vector<float>& a, std::vector<float>& b, std::vector<float>& c, std::vector<float>& x, std::vector<float>& y, bool defensive)
+    {
+        ampblas_sgemm(AmpblasColMajor, AmpblasNoTrans, AmpblasNoTrans, n, n, n, 1.0f, a.data(), n, b.data(), n, 0.0f, c.data(), n);
+        if (defensive)
+            round_trip(a, b, c, x, y);
+
+        ampblas_strsm(AmpblasColMajor, AmpblasLeft, AmpblasLower, AmpblasNoTrans, AmpblasNonUnit, n, n, 1.0f, a.data(), n, c.data(), n);
+        if (defensive)
+            round_trip(a, b, c, x, y);
+
+        ampblas_sgemv(AmpblasColMajor, AmpblasNoTrans, n, n, 1.0f, c.data(), n, x.data(), 1, 0.0f, y.data(), 1);
+    }
+
+    static void round_trip(std::vector<float>& a, std::vector<float>& b, std::vector<float>& c, std::vector<float>& x, std::vector<float>& y)
+    {
+        std::vector<float>* operands[] = { &a, &b, &c, &x, &y };
+        for (auto v : operands)
+        {
+            ampblas_synchronize(v->data(), v->size() * sizeof(float));
+            refresh(*v);
+        }
+    }
+
+    static void bind(std::vector<float>& v)
+    {
+        ampblas_bind(v.data(), v.size() * sizeof(float));
+    }
+
+    static void refresh(std::vector<float>& v)
+    {
+        ampblas_refresh(v.data(), v.size() * sizeof(float));
+    }
+
+    static const int samples = 10;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(residency_bench);
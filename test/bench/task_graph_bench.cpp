@@ -0,0 +1,183 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * task_graph_bench.cpp
+ *
+ * Runs the recursive TRSM and SYRK decompositions step by step and through a
+ * task graph on one and two queues, reporting time and flop rate.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+#include "ampblas.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class task_graph_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "S recursive TRSM/SYRK through a task graph";
+    }
+
+    void run()
+    {
+        const concurrency::accelerator_view av = concurrency::accelerator().default_view;
+
+        std::vector<concurrency::accelerator_view> queues;
+        queues.push_back(av);
+        queues.push_back(av.accelerator.create_view(av.queuing_mode));
+
+        const int sizes[] = { 4096, 8192, 16384 };
+        for (int n : sizes)
+        {
+            std::stringstream label;
+            label << "n = " << n << " ";
+
+            try
+            {
+                run_trsm(label.str(), n, av, queues);
+                run_syrk(label.str(), n, av, queues);
+            }
+            catch (const concurrency::out_of_memory&)
+            {
+                std::cout << "  " << label.str() << "skipped (out of memory)" << std::endl;
+            }
+        }
+    }
+
+private:
+
+    typedef concurrency::array_view<float,2> view_type;
+
+    static void report(const std::string& label, double flops, const std::vector<double>& samples)
+    {
+        report_samples(label, samples);
+
+        std::vector<double> sorted(samples);
+        std::sort(sorted.begin(), sorted.end());
+        std::cout << "    " << flops / (sorted[sorted.size()/2] * 1e3) << " GFLOP/s" << std::endl;
+    }
+
+    void run_trsm(const std::string& label, int n, const concurrency::accelerator_view& av, const std::vector<concurrency::accelerator_view>& queues)
+    {
+        using namespace ampblas;
+
+        // diagonally dominant lower triangle keeps repeated solves bounded
+        std::vector<float> a_host(n*n, 1.0f / n);
+        for (int i=0; i<n; i++)
+            a_host[i*n+i] = 2.0f;
+        std::vector<float> b_host(n*n, 1.0f);
+
+        concurrency::array<float,2> a_data(n, n, a_host.begin(), av);
+        concurrency::array<float,2> b_data(n, n, b_host.begin(), av);
+        view_type a(a_data), b(b_data);
+
+        const double flops = double(n) * n * n;
+        std::vector<double> sequential, graph_one, graph_two;
+
+        // warm up kernel compilation
+        ampblas::trsm(av, side::left, uplo::lower, transpose::no_trans, diag::non_unit, 1.0f, a, b);
+        av.wait();
+
+        for (int s=0; s<samples; s++)
+        {
+            timer.restart();
+            ampblas::trsm(av, side::left, uplo::lower, transpose::no_trans, diag::non_unit, 1.0f, a, b);
+            av.wait();
+            sequential.push_back(timer.us());
+
+            timer.restart();
+            {
+                task_graph graph(av);
+                ampblas::trsm(graph, side::left, uplo::lower, transpose::no_trans, diag::non_unit, 1.0f, graph.track(a), graph.track(b));
+                graph.wait();
+            }
+            graph_one.push_back(timer.us());
+
+            timer.restart();
+            {
+                task_graph graph(queues);
+                ampblas::trsm(graph, side::left, uplo::lower, transpose::no_trans, diag::non_unit, 1.0f, graph.track(a), graph.track(b));
+                graph.wait();
+            }
+            graph_two.push_back(timer.us());
+        }
+
+        report(label + "trsm sequential", flops, sequential);
+        report(label + "trsm graph, 1 queue", flops, graph_one);
+        report(label + "trsm graph, 2 queues", flops, graph_two);
+    }
+
+    void run_syrk(const std::string& label, int n, const concurrency::accelerator_view& av, const std::vector<concurrency::accelerator_view>& queues)
+    {
+        using namespace ampblas;
+
+        std::vector<float> a_host(n*n, 1.0f / n);
+        std::vector<float> c_host(n*n, 0.0f);
+
+        concurrency::array<float,2> a_data(n, n, a_host.begin(), av);
+        concurrency::array<float,2> c_data(n, n, c_host.begin(), av);
+        view_type a(a_data), c(c_data);
+
+        const double flops = double(n) * (n+1) * n;
+        std::vector<double> sequential, graph_one, graph_two;
+
+        ampblas::syrk(av, uplo::lower, transpose::no_trans, 1.0f, a, 0.0f, c);
+        av.wait();
+
+        for (int s=0; s<samples; s++)
+        {
+            timer.restart();
+            ampblas::syrk(av, uplo::lower, transpose::no_trans, 1.0f, a, 0.0f, c);
+            av.wait();
+            sequential.push_back(timer.us());
+
+            timer.restart();
+            {
+                task_graph graph(av);
+                ampblas::syrk(graph, uplo::lower, transpose::no_trans, 1.0f, graph.track(a), 0.0f, graph.track(c));
+                graph.wait();
+            }
+            graph_one.push_back(timer.us());
+
+            timer.restart();
+            {
+                task_graph graph(queues);
+                ampblas::syrk(graph, uplo::lower, transpose::no_trans, 1.0f, graph.track(a), 0.0f, graph.track(c));
+                graph.wait();
+            }
+            graph_two.push_back(timer.us());
+        }
+
+        report(label + "syrk sequential", flops, sequential);
+        report(label + "syrk graph, 1 queue", flops, graph_one);
+        report(label + "syrk graph, 2 queues", flops, graph_two);
+    }
+
+    static const int samples = 3;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(task_graph_bench);
@@ -0,0 +1,107 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * workspace_bench.cpp
+ *
+ * Small-n reductions issued back to back, the pattern of iterative solvers
+ * where per-call overhead dominates. The pooled workspace is timed against
+ * a zero workspace limit, which frees every scratch block on return and so
+ * allocates on each call.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+
+#include "ampblas.h"
+
+#include "ampblas_bench_list.h"
+#include "ampblas_test_timer.h"
+
+class workspace_bench : public bench_list_item
+{
+public:
+
+    std::string name() const
+    {
+        return "S small reductions with pooled workspace";
+    }
+
+    void run()
+    {
+        const concurrency::accelerator_view av = concurrency::accelerator().default_view;
+
+        const int sizes[] = { 64, 1024, 16384 };
+        for (int n : sizes)
+        {
+            std::vector<float> x(n, 1.0f), y(n, 0.5f);
+            concurrency::array<float,1> x_data(n, x.begin(), av);
+            concurrency::array<float,1> y_data(n, y.begin(), av);
+            concurrency::array_view<float,1> xv(x_data);
+            concurrency::array_view<float,1> yv(y_data);
+
+            // warm up kernel compilation
+            ampblas::dot<float>(av, xv, yv);
+            ampblas::nrm2(av, xv);
+            ampblas::asum(av, xv);
+
+            std::stringstream label;
+            label << "n = " << n;
+
+            time_reductions(av, xv, yv, label.str() + " pooled");
+
+            ampblas::set_workspace_limit(0);
+            time_reductions(av, xv, yv, label.str() + " allocate per call");
+            ampblas::set_workspace_limit(limit);
+        }
+    }
+
+private:
+
+    void time_reductions(const concurrency::accelerator_view& av, const concurrency::array_view<float,1>& xv, const concurrency::array_view<float,1>& yv, const std::string& label)
+    {
+        const ampblas::workspace_stats before = ampblas::get_workspace_stats(av);
+
+        std::vector<double> samples_us;
+        for (int s = 0; s < samples; s++)
+        {
+            timer.restart();
+            for (int i = 0; i < calls; i++)
+            {
+                volatile float result = ampblas::dot<float>(av, xv, yv);
+                result = ampblas::nrm2(av, xv);
+                result = ampblas::asum(av, xv);
+                (void)result;
+            }
+            samples_us.push_back(timer.us() / (3 * calls));
+        }
+
+        const ampblas::workspace_stats after = ampblas::get_workspace_stats(av);
+
+        report_samples(label, samples_us);
+        std::cout << "    " << (after.allocations - before.allocations) << " allocations for "
+                  << (after.requests - before.requests) << " requests, peak " << after.peak_bytes << " bytes" << std::endl;
+    }
+
+    static const size_t limit = size_t(64) << 20;
+    static const int calls = 100;
+    static const int samples = 20;
+
+    high_resolution_timer timer;
+};
+
+REGISTER_BENCH(workspace_bench);
@@ -23,6 +23,9 @@
 #include <vector>
 #include <amp.h>
 #include <assert.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
 using namespace concurrency;
 
 //------------------------------------------------------------------------------------
@@ -216,3 +219,701 @@ bool test_runtime_3()
     return (re == AMPBLAS_OK);
 }
 
+//------------------------------------------------------------------------------------
+// Testing ampblas_bind_file: scales a matrix file in place through its mapping 
+// and reads the result back through a second mapping.
+//------------------------------------------------------------------------------------
+template<typename T>
+bool test_runtime_4()
+{
+    const char* path = "ampblas_rt_test.amat";
+    const int rows = 64;
+    const int cols = 32;
+    const int n = rows * cols;
+    T alpha = 3;
+
+    ampblas_result re = ampblas_create_file(path, sizeof(T), rows, cols);
+
+    ampblas_file_header header;
+    EXECUTE_IF_OK(re, ampblas_read_file_header(path, &header));
+    if (re == AMPBLAS_OK && (header.element_size != sizeof(T) || header.rows != rows || header.cols != cols || header.ld != rows))
+    {
+        return false;
+    }
+
+    // fill and scale the whole file
+    if (re == AMPBLAS_OK)
+    {
+        T* a = static_cast<T*>(ampblas_bind_file(path, 0, 0));
+        re = ampblas_get_last_error();
+        if (re == AMPBLAS_OK)
+        {
+            for (int i=0; i<n; i++)
+            {
+                a[i] = (T)i;
+            }
+
+            EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(n, alpha, a, 1));
+            EXECUTE_IF_OK(re, ampblas_synchronize(a, n * sizeof(T)));
+            ampblas_unbind(a);
+        }
+    }
+
+    // map the second half of the columns only
+    if (re == AMPBLAS_OK)
+    {
+        const int offset = n / 2;
+        T* b = static_cast<T*>(ampblas_bind_file(path, offset * sizeof(T), (n - offset) * sizeof(T)));
+        re = ampblas_get_last_error();
+        if (re == AMPBLAS_OK)
+        {
+            for (int i=0; i<n-offset; i++)
+            {
+                if (b[i] != static_cast<T>((offset + i) * alpha))
+                {
+                    re = AMPBLAS_INTERNAL_ERROR;
+                    break;
+                }
+            }
+            ampblas_unbind(b);
+        }
+    }
+
+    std::remove(path);
+
+    return (re == AMPBLAS_OK);
+}
+
+//------------------------------------------------------------------------------------
+// Testing dirty range tracking: sections of a bound buffer are updated on the 
+// accelerator and the whole buffer is synchronized, while host writes to the rest 
+// of the buffer must survive the synchronization.
+//------------------------------------------------------------------------------------
+template<typename T>
+bool test_runtime_5()
+{
+    const int n = 4096;
+    const int section = 64;
+    T alpha = 2;
+    std::vector<T> x(n);
+    for (int i=0; i<n; i++)
+    {
+        x[i] = (T)i;
+    }
+
+	ampblas_result re = AMPBLAS_OK;
+    EXECUTE_IF_OK(re, ampblas_bind(x.data(), n * sizeof(T)));
+
+    // scale two separate sections; the whole buffer is synchronized once
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(section, alpha, x.data() + 128, 1));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(section, alpha, x.data() + 1024, 1));
+    EXECUTE_IF_OK(re, ampblas_synchronize(x.data(), n * sizeof(T)));
+
+    // the host copy is current everywhere else, so a host write there is kept
+    x[n-1] = (T)-1;
+    EXECUTE_IF_OK(re, ampblas_synchronize(x.data(), n * sizeof(T)));
+
+    ampblas_unbind(x.data());
+
+    // verify result
+    if (re == AMPBLAS_OK)
+    {
+	    for (int i=0; i<n; i++)
+	    {
+            T expected = (T)i;
+            if ((i >= 128 && i < 128 + section) || (i >= 1024 && i < 1024 + section))
+                expected *= alpha;
+            if (i == n-1)
+                expected = (T)-1;
+
+		    if (x[i] != expected)
+            {
+                return false;
+            }
+	    }
+    }
+
+    return (re == AMPBLAS_OK);
+}
+
+//------------------------------------------------------------------------------------
+// Testing implicit binding: routines run on unbound buffers, results are in host 
+// memory when they return, and host writes are picked up after invalidation.
+//------------------------------------------------------------------------------------
+template<typename T>
+bool test_runtime_6()
+{
+    const int n = 256;
+    T alpha = 2;
+    std::vector<T> x(n), y(n);
+    for (int i=0; i<n; i++)
+    {
+        x[i] = (T)i;
+        y[i] = (T)1;
+    }
+
+	ampblas_result re = ampblas_set_implicit_binding(4 * n * sizeof(T));
+
+    // y = 1 + 2 * alpha * x, with x reused from the cache by the second call
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xaxpy(n, alpha, x.data(), 1, y.data(), 1));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xaxpy(n, alpha, x.data(), 1, y.data(), 1));
+    for (int i=0; re == AMPBLAS_OK && i<n; i++)
+    {
+        if (y[i] != (T)1 + 2 * alpha * (T)i)
+            re = AMPBLAS_INTERNAL_ERROR;
+    }
+
+    // implicit bindings are not unbound by the caller
+    if (re == AMPBLAS_OK && ampblas_unbind(x.data()))
+        re = AMPBLAS_INTERNAL_ERROR;
+
+    // a host write is seen once the cached copy is invalidated
+    for (int i=0; i<n; i++)
+    {
+        x[i] = (T)1;
+    }
+    EXECUTE_IF_OK(re, ampblas_invalidate_implicit(x.data(), n * sizeof(T)));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(n, alpha, x.data(), 1));
+    for (int i=0; re == AMPBLAS_OK && i<n; i++)
+    {
+        if (x[i] != alpha)
+            re = AMPBLAS_INTERNAL_ERROR;
+    }
+
+    // with K == 0 the product is empty, so A is never bound and C = beta * C
+    const int m = 16;
+    std::vector<T> a(1), b(m), c(m * m, (T)1);
+    T beta = 3;
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xgemm(AmpblasColMajor, AmpblasNoTrans, AmpblasNoTrans, m, m, 0, alpha, a.data(), m, b.data(), 1, beta, c.data(), m));
+    for (int i=0; re == AMPBLAS_OK && i<m*m; i++)
+    {
+        if (c[i] != beta)
+            re = AMPBLAS_INTERNAL_ERROR;
+    }
+
+    // disabling releases the cache, so the buffers are unbound again
+    EXECUTE_IF_OK(re, ampblas_set_implicit_binding(0));
+    if (re == AMPBLAS_OK && (ampblas_ifbound(x.data(), n * sizeof(T)) || ampblas_ifbound(y.data(), n * sizeof(T))))
+        re = AMPBLAS_INTERNAL_ERROR;
+
+    ampblas_set_implicit_binding(0);
+
+    return (re == AMPBLAS_OK);
+}
+
+//------------------------------------------------------------------------------------
+// Testing bind_array_view: a routine scales data that lives in an accelerator array,
+// addressed through the pointer the array's view was bound to.
+//------------------------------------------------------------------------------------
+template<typename T>
+bool test_runtime_7()
+{
+    const int n = 1024;
+    T alpha = 3;
+    std::vector<T> host(n);
+    for (int i=0; i<n; i++)
+    {
+        host[i] = (T)i;
+    }
+
+    array<T,1> x_data(n, host.begin());
+    array_view<T,1> x_view(x_data);
+
+    T* x = nullptr;
+    try
+    {
+        x = static_cast<T*>(ampcblas::bind_array_view(x_view));
+    }
+    catch (ampcblas::ampblas_exception&)
+    {
+        return false;
+    }
+
+    // scale everything, then the second half once more
+	ampblas_result re = AMPBLAS_OK;
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(n, alpha, x, 1));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(n/2, alpha, x + n/2, 1));
+
+    if (!ampblas_unbind(x))
+    {
+        return false;
+    }
+
+    // verify result
+    if (re == AMPBLAS_OK)
+    {
+        copy(x_data, host.begin());
+	    for (int i=0; i<n; i++)
+	    {
+            T expected = (T)i * alpha;
+            if (i >= n/2)
+                expected *= alpha;
+
+		    if (host[i] != expected)
+            {
+                return false;
+            }
+	    }
+    }
+
+    return (re == AMPBLAS_OK);
+}
+
+//------------------------------------------------------------------------------------
+// Testing ampblas_malloc: memory comes back aligned and bound, is released with 
+// ampblas_free only, and the large page request falls back when it cannot be met.
+//------------------------------------------------------------------------------------
+template<typename T>
+bool test_runtime_8()
+{
+    const int n = 1000;
+    T alpha = 2;
+    const unsigned int flags[] = { AmpblasAllocDefault, AmpblasAllocLargePages };
+
+    for (unsigned int f : flags)
+    {
+        T* x = static_cast<T*>(ampblas_malloc(n * sizeof(T), f));
+        if (x == nullptr || reinterpret_cast<uintptr_t>(x) % 64 != 0 || !ampblas_ifbound(x, n * sizeof(T)))
+        {
+            return false;
+        }
+
+        for (int i=0; i<n; i++)
+        {
+            x[i] = (T)i;
+        }
+
+	    ampblas_result re = AMPBLAS_OK;
+        EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(n, alpha, x, 1));
+        EXECUTE_IF_OK(re, ampblas_synchronize(x, n * sizeof(T)));
+
+        // verify result
+        if (re == AMPBLAS_OK)
+        {
+	        for (int i=0; i<n; i++)
+	        {
+		        if (x[i] != (T)i * alpha)
+                {
+                    re = AMPBLAS_FAIL;
+                }
+	        }
+        }
+
+        // the binding belongs to the allocation
+        if (ampblas_unbind(x) || !ampblas_free(x) || ampblas_free(x) || re != AMPBLAS_OK)
+        {
+            return false;
+        }
+    }
+
+    // zero bytes and unknown flags are rejected
+    if (ampblas_malloc(0, AmpblasAllocDefault) != nullptr || ampblas_get_last_error() != AMPBLAS_INVALID_ARG ||
+        ampblas_malloc(n, 0x80) != nullptr || ampblas_get_last_error() != AMPBLAS_INVALID_ARG)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------
+// Testing residency tracking: data already on the accelerator is not copied again, 
+// synchronize and refresh move only what changed, and a prefetch replaces the copy the
+// next routine would make.
+//------------------------------------------------------------------------------------
+template<typename T>
+bool test_runtime_9()
+{
+    const int n = 1024;
+    const unsigned long long bytes = n * sizeof(T);
+    T alpha = 2;
+    std::vector<T> x(n);
+    for (int i=0; i<n; i++)
+    {
+        x[i] = (T)i;
+    }
+
+    ampblas_transfer_stats stats;
+	ampblas_result re = AMPBLAS_OK;
+    EXECUTE_IF_OK(re, ampblas_bind(x.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_reset_transfer_stats());
+
+    // one copy to the accelerator for two routines, one copy back for two synchronizes
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(n, alpha, x.data(), 1));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(n, alpha, x.data(), 1));
+    EXECUTE_IF_OK(re, ampblas_synchronize(x.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_synchronize(x.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_get_transfer_stats(&stats));
+    if (re == AMPBLAS_OK && (stats.bytes_to_accelerator != bytes || stats.bytes_to_host != bytes))
+    {
+        re = AMPBLAS_FAIL;
+    }
+
+    // a host write; the prefetch makes the copy the routine would have made
+    x[0] = (T)-1;
+    EXECUTE_IF_OK(re, ampblas_refresh(x.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_prefetch(x.data(), bytes, nullptr));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(n, alpha, x.data(), 1));
+    EXECUTE_IF_OK(re, ampblas_synchronize(x.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_get_transfer_stats(&stats));
+    if (re == AMPBLAS_OK && (stats.bytes_to_accelerator != 2 * bytes || stats.bytes_to_host != 2 * bytes))
+    {
+        re = AMPBLAS_FAIL;
+    }
+
+    ampblas_unbind(x.data());
+
+    // verify result
+    if (re == AMPBLAS_OK)
+    {
+	    for (int i=0; i<n; i++)
+	    {
+            T expected = (i == 0) ? (T)-1 * alpha : (T)i * alpha * alpha * alpha;
+		    if (x[i] != expected)
+            {
+                return false;
+            }
+	    }
+    }
+
+    return (re == AMPBLAS_OK);
+}
+
+// test dispatch of AXPY to the host: forced, and chosen by the model in auto mode
+template<typename T>
+bool test_runtime_10()
+{
+    const int n = 1024;
+    const unsigned long long bytes = n * sizeof(T);
+    T alpha = 2;
+    std::vector<T> x(n), y(n);
+    for (int i=0; i<n; i++)
+    {
+        x[i] = (T)i;
+        y[i] = (T)(n - i);
+    }
+
+    ampblas_transfer_stats stats;
+	ampblas_result re = AMPBLAS_OK;
+    EXECUTE_IF_OK(re, ampblas_bind(x.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_bind(y.data(), bytes));
+
+    // the host call reads the result of the accelerator call and writes y in place
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xscal(n, alpha, y.data(), 1));
+    EXECUTE_IF_OK(re, ampblas_reset_transfer_stats());
+    EXECUTE_IF_OK(re, ampblas_set_dispatch_mode(AmpblasDispatchHost));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xaxpy(n, alpha, x.data(), 1, y.data(), 1));
+    EXECUTE_IF_OK(re, ampblas_get_transfer_stats(&stats));
+    if (re == AMPBLAS_OK && (stats.bytes_to_accelerator != 0 || stats.bytes_to_host != bytes))
+    {
+        re = AMPBLAS_FAIL;
+    }
+
+    // an accelerator that is infinitely slow to start leaves every call to the host
+    ampblas_dispatch_model model;
+    EXECUTE_IF_OK(re, ampblas_get_dispatch_model(&model));
+    model.launch_overhead_us = 1e30;
+    EXECUTE_IF_OK(re, ampblas_set_dispatch_model(&model));
+    EXECUTE_IF_OK(re, ampblas_set_dispatch_mode(AmpblasDispatchAuto));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xaxpy(n, alpha, x.data(), 1, y.data(), 1));
+    EXECUTE_IF_OK(re, ampblas_get_transfer_stats(&stats));
+    if (re == AMPBLAS_OK && stats.bytes_to_accelerator != 0)
+    {
+        re = AMPBLAS_FAIL;
+    }
+
+    // and one that costs nothing takes them all; the accelerator sees the host results
+    model.launch_overhead_us = 0;
+    model.host_sgflops = model.host_dgflops = model.host_bandwidth = 1e-30;
+    model.accelerator_sgflops = model.accelerator_dgflops = model.accelerator_bandwidth = model.transfer_bandwidth = 1e30;
+    EXECUTE_IF_OK(re, ampblas_set_dispatch_model(&model));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xaxpy(n, alpha, x.data(), 1, y.data(), 1));
+    EXECUTE_IF_OK(re, ampblas_synchronize(y.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_get_transfer_stats(&stats));
+    if (re == AMPBLAS_OK && stats.bytes_to_accelerator != 2 * bytes)
+    {
+        re = AMPBLAS_FAIL;
+    }
+
+    ampblas_set_dispatch_mode(AmpblasDispatchAccelerator);
+    ampblas_unbind(x.data());
+    ampblas_unbind(y.data());
+
+    // verify result
+    if (re == AMPBLAS_OK)
+    {
+	    for (int i=0; i<n; i++)
+	    {
+            T expected = (T)(n - i) * alpha + 3 * alpha * (T)i;
+		    if (x[i] != (T)i || y[i] != expected)
+            {
+                return false;
+            }
+	    }
+    }
+
+    return (re == AMPBLAS_OK);
+}
+
+//------------------------------------------------------------------------------------
+// Testing the call trace: a call made while a trace is recorded appears in it with
+// its shape, and calls after the trace has ended do not.
+//------------------------------------------------------------------------------------
+template<typename T>
+bool test_runtime_11()
+{
+    const char* path = "ampblas_rt_test.csv";
+    const int n = 1024;
+    const size_t bytes = n * sizeof(T);
+    T alpha = 2;
+    std::vector<T> x(n, (T)1), y(n, (T)1);
+
+    // a trace that cannot be created is reported
+    if (ampblas_set_trace_file("no_such_directory/ampblas_rt_test.csv") != AMPBLAS_BAD_RESOURCE)
+    {
+        return false;
+    }
+
+	ampblas_result re = AMPBLAS_OK;
+    EXECUTE_IF_OK(re, ampblas_bind(x.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_bind(y.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_set_trace_file(path));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xaxpy(n, alpha, x.data(), 1, y.data(), 1));
+    EXECUTE_IF_OK(re, ampblas_set_trace_file(nullptr));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xaxpy(n, alpha, x.data(), 1, y.data(), 1));
+
+    ampblas_unbind(x.data());
+    ampblas_unbind(y.data());
+
+    // the header and the first call
+    std::vector<std::string> lines;
+    FILE* file = nullptr;
+    if (re == AMPBLAS_OK && fopen_s(&file, path, "r") == 0)
+    {
+        char line[256];
+        while (fgets(line, sizeof(line), file) != nullptr)
+        {
+            lines.push_back(line);
+        }
+        fclose(file);
+    }
+    std::remove(path);
+
+    const std::string expected = sizeof(T) == sizeof(float) ? "saxpy,s,-,-,-,-,-,-,0,1024,0,0,0,0,1,1," 
+                                                            : "daxpy,d,-,-,-,-,-,-,0,1024,0,0,0,0,1,1,";
+    if (lines.size() != 2 || lines[1].compare(0, expected.size(), expected) != 0)
+    {
+        return false;
+    }
+
+    return (re == AMPBLAS_OK);
+}
+
+//------------------------------------------------------------------------------------
+// Testing the routine statistics: calls are counted per routine with their flops and
+// the bytes they copied, bindings outside the calls count in the totals only, and a
+// reset clears everything.
+//------------------------------------------------------------------------------------
+template<typename T>
+bool test_runtime_12()
+{
+    const int n = 1024;
+    const size_t bytes = n * sizeof(T);
+    T alpha = 2;
+    std::vector<T> x(n, (T)1), y(n, (T)1);
+
+    ampblas_stats stats;
+    ampblas_routine_stats routines[4];
+    int count = -1;
+    if (ampblas_get_stats(nullptr, nullptr, nullptr) != AMPBLAS_INVALID_ARG ||
+        ampblas_get_stats(&stats, routines, nullptr) != AMPBLAS_INVALID_ARG ||
+        ampblas_get_stats(&stats, routines, &count) != AMPBLAS_INVALID_ARG)
+    {
+        return false;
+    }
+
+	ampblas_result re = AMPBLAS_OK;
+    EXECUTE_IF_OK(re, ampblas_reset_stats());
+    EXECUTE_IF_OK(re, ampblas_bind(x.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_bind(y.data(), bytes));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xaxpy(n, alpha, x.data(), 1, y.data(), 1));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xaxpy(n, alpha, x.data(), 1, y.data(), 1));
+
+    count = 4;
+    EXECUTE_IF_OK(re, ampblas_get_stats(&stats, routines, &count));
+    ampblas_unbind(x.data());
+    ampblas_unbind(y.data());
+
+    const char *expected = sizeof(T) == sizeof(float) ? "saxpy" : "daxpy";
+    if (re != AMPBLAS_OK || count != 1 || strcmp(routines[0].routine, expected) != 0 || routines[0].calls != 2 || 
+        routines[0].flops != 4 * n || routines[0].bytes_bound != 0 || routines[0].bytes_to_accelerator != 2 * bytes ||
+        routines[0].total_us < routines[0].max_us || stats.calls != 2 || stats.bytes_bound != 2 * bytes)
+    {
+        return false;
+    }
+
+    // only the totals are wanted
+    EXECUTE_IF_OK(re, ampblas_reset_stats());
+    EXECUTE_IF_OK(re, ampblas_get_stats(&stats, nullptr, nullptr));
+    if (re == AMPBLAS_OK && (stats.calls != 0 || stats.flops != 0 || stats.bytes_bound != 0))
+    {
+        return false;
+    }
+
+    return (re == AMPBLAS_OK);
+}
+
+//------------------------------------------------------------------------------------
+// Testing the kernel timeline: a GEMM made while the timeline is recorded appears in
+// the export as a begin and an end event of its kernel stage, one made after it has
+// stopped does not.
+//------------------------------------------------------------------------------------
+template<typename T>
+bool test_runtime_13()
+{
+    const char* path = "ampblas_rt_test.json";
+    const int n = 64;
+    const size_t bytes = n * n * sizeof(T);
+    T alpha = 1, beta = 0;
+    std::vector<T> a(n * n, (T)1), b(n * n, (T)1), c(n * n, (T)0);
+
+    // a timeline that cannot be written is reported
+    if (ampblas_write_timeline(nullptr) != AMPBLAS_INVALID_ARG ||
+        ampblas_write_timeline("no_such_directory/ampblas_rt_test.json") != AMPBLAS_BAD_RESOURCE)
+    {
+        return false;
+    }
+
+	ampblas_result re = AMPBLAS_OK;
+    EXECUTE_IF_OK(re, ampblas_set_dispatch_mode(AmpblasDispatchAccelerator));
+    EXECUTE_IF_OK(re, ampblas_bind(a.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_bind(b.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_bind(c.data(), bytes));
+    EXECUTE_IF_OK(re, ampblas_start_timeline(1));
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xgemm(AmpblasColMajor, AmpblasNoTrans, AmpblasNoTrans, n, n, n, alpha, a.data(), n, b.data(), n, beta, c.data(), n));
+    EXECUTE_IF_OK(re, ampblas_stop_timeline());
+    EXECUTE_KERNEL_IF_OK(re, ampblas_xgemm(AmpblasColMajor, AmpblasNoTrans, AmpblasNoTrans, n, n, n, alpha, a.data(), n, b.data(), n, beta, c.data(), n));
+    EXECUTE_IF_OK(re, ampblas_write_timeline(path));
+
+    ampblas_unbind(a.data());
+    ampblas_unbind(b.data());
+    ampblas_unbind(c.data());
+
+    std::string json;
+    FILE* file = nullptr;
+    if (re == AMPBLAS_OK && fopen_s(&file, path, "r") == 0)
+    {
+        char line[512];
+        while (fgets(line, sizeof(line), file) != nullptr)
+        {
+            json += line;
+        }
+        fclose(file);
+    }
+    std::remove(path);
+
+    // one begin and one end event of the stage
+    int stages = 0;
+    for (size_t pos = json.find("\"name\":\"gemm_stage_4\""); pos != std::string::npos; pos = json.find("\"name\":\"gemm_stage_4\"", pos + 1))
+    {
+        stages++;
+    }
+
+    if (json.compare(0, 1, "{") != 0 || stages != 2 || json.find("\"ph\":\"B\"") == std::string::npos ||
+        json.find("\"ph\":\"E\"") == std::string::npos || json.find("\"grid_m\":") == std::string::npos)
+    {
+        return false;
+    }
+
+    return (re == AMPBLAS_OK);
+}
+
+//------------------------------------------------------------------------------------
+// Testing NUMA placed allocations: the memory comes back page aligned, zeroed and 
+// bound, and a GEMM on it gives the same result on the accelerator and on the host.
+//------------------------------------------------------------------------------------
+template<typename T>
+bool test_runtime_14()
+{
+    const int n = 96;
+    const size_t bytes = n * n * sizeof(T);
+    T alpha = 1, beta = 0;
+    const unsigned int flags[] = { AmpblasAllocNumaBlocked, AmpblasAllocNumaInterleaved };
+
+    for (unsigned int f : flags)
+    {
+        T* a = static_cast<T*>(ampblas_malloc(bytes, f));
+        T* b = static_cast<T*>(ampblas_malloc(bytes, f));
+        T* c = static_cast<T*>(ampblas_malloc(bytes, f));
+        if (a == nullptr || b == nullptr || c == nullptr || reinterpret_cast<uintptr_t>(c) % 4096 != 0 || !ampblas_ifbound(c, bytes))
+        {
+            ampblas_free(a);
+            ampblas_free(b);
+            ampblas_free(c);
+            return false;
+        }
+
+        bool zeroed = true;
+        for (int i=0; i<n*n; i++)
+        {
+            zeroed &= (c[i] == (T)0);
+            a[i] = (T)(i % 3);
+            b[i] = (T)(i % 5);
+        }
+
+	    ampblas_result re = zeroed ? AMPBLAS_OK : AMPBLAS_FAIL;
+        EXECUTE_IF_OK(re, ampblas_set_dispatch_mode(AmpblasDispatchAccelerator));
+        EXECUTE_KERNEL_IF_OK(re, ampblas_xgemm(AmpblasColMajor, AmpblasNoTrans, AmpblasNoTrans, n, n, n, alpha, a, n, b, n, beta, c, n));
+        EXECUTE_IF_OK(re, ampblas_synchronize(c, bytes));
+
+        // the small integers keep every product exact
+        for (int j=0; j<n && re == AMPBLAS_OK; j++)
+        {
+            for (int i=0; i<n; i++)
+            {
+                T expected = 0;
+                for (int l=0; l<n; l++)
+                {
+                    expected += a[i + l*n] * b[l + j*n];
+                }
+
+                if (c[i + j*n] != expected)
+                {
+                    re = AMPBLAS_FAIL;
+                }
+            }
+        }
+
+        // the host routines run the column blocks on the nodes holding them, in place
+        alpha = -1;
+        beta = 1;
+        EXECUTE_IF_OK(re, ampblas_set_dispatch_mode(AmpblasDispatchHost));
+        EXECUTE_KERNEL_IF_OK(re, ampblas_xgemm(AmpblasColMajor, AmpblasNoTrans, AmpblasNoTrans, n, n, n, alpha, a, n, b, n, beta, c, n));
+        EXECUTE_IF_OK(re, ampblas_synchronize(c, bytes));
+        ampblas_set_dispatch_mode(AmpblasDispatchAccelerator);
+        alpha = 1;
+        beta = 0;
+
+        for (int i=0; i<n*n && re == AMPBLAS_OK; i++)
+        {
+            if (c[i] != (T)0)
+            {
+                re = AMPBLAS_FAIL;
+            }
+        }
+
+        if (!ampblas_free(a) || !ampblas_free(b) || !ampblas_free(c) || re != AMPBLAS_OK)
+        {
+            return false;
+        }
+    }
+
+    // the placements exclude each other and large pages
+    if (ampblas_malloc(bytes, AmpblasAllocNumaBlocked | AmpblasAllocNumaInterleaved) != nullptr || ampblas_get_last_error() != AMPBLAS_INVALID_ARG ||
+        ampblas_malloc(bytes, AmpblasAllocNumaBlocked | AmpblasAllocLargePages) != nullptr || ampblas_get_last_error() != AMPBLAS_INVALID_ARG)
+    {
+        return false;
+    }
+
+    return true;
+}
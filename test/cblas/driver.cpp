@@ -46,6 +46,28 @@ int main()
     passed &= run_test(test_runtime_2<double>(), "test_runtime_2<double>");
     passed &= run_test(test_runtime_3<float>(), "test_runtime_3<float>");
     passed &= run_test(test_runtime_3<double>(), "test_runtime_3<double>");
+    passed &= run_test(test_runtime_4<float>(), "test_runtime_4<float>");
+    passed &= run_test(test_runtime_4<double>(), "test_runtime_4<double>");
+    passed &= run_test(test_runtime_5<float>(), "test_runtime_5<float>");
+    passed &= run_test(test_runtime_5<double>(), "test_runtime_5<double>");
+    passed &= run_test(test_runtime_6<float>(), "test_runtime_6<float>");
+    passed &= run_test(test_runtime_6<double>(), "test_runtime_6<double>");
+    passed &= run_test(test_runtime_7<float>(), "test_runtime_7<float>");
+    passed &= run_test(test_runtime_7<double>(), "test_runtime_7<double>");
+    passed &= run_test(test_runtime_8<float>(), "test_runtime_8<float>");
+    passed &= run_test(test_runtime_8<double>(), "test_runtime_8<double>");
+    passed &= run_test(test_runtime_9<float>(), "test_runtime_9<float>");
+    passed &= run_test(test_runtime_9<double>(), "test_runtime_9<double>");
+    passed &= run_test(test_runtime_10<float>(), "test_runtime_10<float>");
+    passed &= run_test(test_runtime_10<double>(), "test_runtime_10<double>");
+    passed &= run_test(test_runtime_11<float>(), "test_runtime_11<float>");
+    passed &= run_test(test_runtime_11<double>(), "test_runtime_11<double>");
+    passed &= run_test(test_runtime_12<float>(), "test_runtime_12<float>");
+    passed &= run_test(test_runtime_12<double>(), "test_runtime_12<double>");
+    passed &= run_test(test_runtime_13<float>(), "test_runtime_13<float>");
+    passed &= run_test(test_runtime_13<double>(), "test_runtime_13<double>");
+    passed &= run_test(test_runtime_14<float>(), "test_runtime_14<float>");
+    passed &= run_test(test_runtime_14<double>(), "test_runtime_14<double>");
 
     // Testing axpy
     passed &= run_test(test_axpy_1<float>(), "test_axpy_1<float>");
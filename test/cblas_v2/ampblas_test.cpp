@@ -20,10 +20,10 @@
 
 #include "ampblas_test_list.h"
 
-int main()
+int main(int argc, char* argv[])
 {
-    // run all tests that have been registered by the testing framework 
-    execute_all_tests();
+    // run all tests that have been registered by the testing framework, in parallel unless --serial is given
+    execute_tests(parse_test_options(argc, argv));
     
     return 0;
 }
@@ -25,8 +25,11 @@
 
 #include <vector>
 #include <string>
+#include <sstream>
 #include <functional>
 
+#include <ppl.h>
+
 #include "ampxblas.h"
 #include "cblas_wrapper.h"
 
@@ -99,51 +102,92 @@ public:
         throw ampblas_test_accuracy_exception(residual,threshold);
     }
 
-    // main execution loop
-    void run_all_tests() 
-    { 
-        std::cout << "Running " << parameter_list.size() << " " << blas_prefix<value_type>() << name() << " tests... ";
+    // test_list_item interface
+    std::string routine_name() const
+    {
+        return name();
+    }
+
+    char type_prefix() const
+    {
+        return blas_prefix<value_type>();
+    }
+
+    size_t test_count() const
+    {
+        return parameter_list.size();
+    }
 
-        // see if test is runable on this accelerator
+    // see if test is runable on this accelerator; an empty string means it is
+    std::string skip_reason() const
+    {
 		if (is_double())
         {
             // see if we at least have limited doubles
             if(!ampcblas::get_current_accelerator_view().accelerator.supports_limited_double_precision)
-		    {
-			    std::cout << "SKIPPED (no double support)" << std::endl;
-			    return;
-		    }
+			    return "no double support";
 
             // some routines require full double support
             if (requires_full_double() && !ampcblas::get_current_accelerator_view().accelerator.supports_double_precision)
-		    {
-			    std::cout << "SKIPPED (needs full double support)" << std::endl;
-			    return;
-		    }
+			    return "needs full double support";
+        }
+
+        return std::string();
+    }
+
+    // runs a single parameter set; safe to call concurrently for different parameter sets
+    test_result run_test(size_t i)
+    {
+        const typed_parameters& p = parameter_list[i];
+
+        test_result result;
+        std::stringstream out;
+
+        try
+        {
+            run_cblas_test(p);
+        }
+        catch (const ampblas_test_runtime_exception& e)
+        {
+            result.passed = false;
+			out << "Runtime error with " << p.name() << "where " << e.get();
+        }
+        catch (const ampblas_test_accuracy_exception& e)
+        {
+            result.passed = false;
+			out << "Accuracy error with " << p.name() << "where " << e.residual() << " > " << e.threshold();
+        }
+		catch (...)
+		{
+			result.passed = false;
+			out << "Unknown error with " << p.name();
+		}
+
+        result.message = out.str();
+        return result;
+    }
+
+    // main execution loop
+    void run_all_tests() 
+    { 
+        std::cout << "Running " << parameter_list.size() << " " << blas_prefix<value_type>() << name() << " tests... ";
+
+        std::string reason = skip_reason();
+        if (!reason.empty())
+        {
+            std::cout << "SKIPPED (" << reason << ")" << std::endl;
+            return;
         }
 
         bool failed = false;
-        for (const typed_parameters& p : parameter_list)
+        for (size_t i=0; i<parameter_list.size(); i++)
         {
-            try
-            {
-                run_cblas_test(p);
-            }
-            catch (const ampblas_test_runtime_exception& e)
-            {
-                failed = true;
-				std::cout << "\n  Runtime error with " << p.name() << "where " << e.get();
-            }
-            catch (const ampblas_test_accuracy_exception& e)
+            test_result result = run_test(i);
+            if (!result.passed)
             {
                 failed = true;
-				std::cout << "\n  Accuracy error with " << p.name() << "where " << e.residual() << " > " << e.threshold();
+                std::cout << "\n  " << result.message;
             }
-			catch (...)
-			{
-				failed = true;
-				std::cout << "\n  Unknown error with " << p.name();
-			}
         }
 
 		if (!failed)
@@ -154,10 +198,18 @@ public:
 
 private:
 
-	high_resolution_timer timer;
+    // timing state is kept per thread so parameter sets can run concurrently
+    struct test_timing
+    {
+        test_timing() : ref_time(0), amp_time(0) {}
+
+        high_resolution_timer timer;
+        double ref_time;
+        double amp_time;
+    };
+
+    concurrency::combinable<test_timing> timing;
     typed_parameter_container parameter_list;
-    double ref_time;
-    double amp_time;
 
     virtual std::string name() const = 0;
     virtual void run_cblas_test( const typed_parameters& p ) = 0;
@@ -244,22 +296,22 @@ protected:
 
     void start_reference_test() 
     {
-        timer.restart();
+        timing.local().timer.restart();
     }
 
     void stop_reference_test()
     { 
-        ref_time = timer.elapsed(); 
+        timing.local().ref_time = timing.local().timer.elapsed(); 
     }
 
-    double reference_time() const
+    double reference_time()
     {
-        return ref_time;
+        return timing.local().ref_time;
     }
 
     void start_ampblas_test() 
     {
-        timer.restart();
+        timing.local().timer.restart();
     }
 
     void stop_ampblas_test() 
@@ -271,12 +323,12 @@ protected:
         // synchronize
         ampcblas::get_current_accelerator_view().wait();
 
-        amp_time = timer.elapsed();
+        timing.local().amp_time = timing.local().timer.elapsed();
     }
 
-    double ampblas_time() const
+    double ampblas_time()
     {
-        return amp_time;
+        return timing.local().amp_time;
     }
 
     // single value error check
@@ -323,7 +375,8 @@ protected:
 		for (int i=0; i<ref.n(); i++)
 			norm += abs(ref[i] - amp[i]);	
 				
-		if (norm > threshold)
+		// written so a NaN fails
+		if (!(norm <= threshold))
             ampblas_test_accuracy_error(norm, threshold);
 	}
 
@@ -341,10 +394,11 @@ protected:
 			real_type sum = 0;
 			for (int i=0; i<ref.m(); i++)
 				sum += abs(ref(i,j) - amp(i,j));
-			norm = std::max(norm,sum);
+			norm = (sum > norm || sum != sum) ? sum : norm;
 		}
         		
-		if (norm > threshold)
+		// written so a NaN fails
+		if (!(norm <= threshold))
             ampblas_test_accuracy_error(norm, threshold); 
     }
 };
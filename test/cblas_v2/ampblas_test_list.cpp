@@ -16,8 +16,13 @@
 
 #include <algorithm>
 #include <functional>
+#include <iostream>
+#include <cctype>
+
+#include <ppl.h>
 
 #include "ampblas_test_list.h"
+#include "ampcblas_runtime.h"
 
 test_list& get_test_list()
 {
@@ -29,3 +34,122 @@ void execute_all_tests()
 {
     std::for_each( get_test_list().begin(), get_test_list().end(), std::mem_fn( &test_list_item::run_all_tests ) );
 }
+
+//
+// filtering
+//
+
+namespace {
+
+std::string to_upper(std::string str)
+{
+    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+    return str;
+}
+
+} // anonymous namespace
+
+bool test_options::matches(const test_list_item& item) const
+{
+    if (!routines.empty() && std::find(routines.begin(), routines.end(), to_upper(item.routine_name())) == routines.end())
+        return false;
+
+    if (!types.empty() && std::find(types.begin(), types.end(), std::string(1, item.type_prefix())) == types.end())
+        return false;
+
+    return true;
+}
+
+test_options parse_test_options(int argc, char* argv[])
+{
+    test_options options;
+
+    for (int i=1; i<argc; i++)
+    {
+        std::string arg(argv[i]);
+
+        if (arg == "--serial")
+            options.parallel = false;
+        else if (arg == "--routine" && i+1 < argc)
+            options.routines.push_back(to_upper(argv[++i]));
+        else if (arg == "--type" && i+1 < argc)
+            options.types.push_back(to_upper(argv[++i]));
+        else
+            std::cout << "Ignoring unknown option " << arg << std::endl;
+    }
+
+    return options;
+}
+
+//
+// execution
+//
+
+void execute_tests(const test_options& options)
+{
+    // apply filters
+    std::vector<std::shared_ptr<test_list_item>> tests;
+    std::copy_if(get_test_list().begin(), get_test_list().end(), std::back_inserter(tests), [&](const std::shared_ptr<test_list_item>& item) { return options.matches(*item); });
+
+    if (!options.parallel)
+    {
+        std::for_each( tests.begin(), tests.end(), std::mem_fn( &test_list_item::run_all_tests ) );
+        return;
+    }
+
+    // flatten into (test, parameter) pairs so the scheduler can balance long and short tests
+    std::vector<std::string> skipped(tests.size());
+    std::vector<std::vector<test_result>> results(tests.size());
+    std::vector<std::pair<size_t,size_t>> work;
+
+    for (size_t t=0; t<tests.size(); t++)
+    {
+        skipped[t] = tests[t]->skip_reason();
+        if (!skipped[t].empty())
+            continue;
+
+        results[t].resize(tests[t]->test_count());
+        for (size_t i=0; i<results[t].size(); i++)
+            work.push_back(std::make_pair(t,i));
+    }
+
+    // each worker thread gets its own accelerator_view on the calling thread's accelerator so that
+    // queue waits and error state are isolated from the other workers
+    const concurrency::accelerator accl = ampcblas::get_current_accelerator_view().accelerator;
+    concurrency::combinable<concurrency::accelerator_view> views([&]() { return accl.create_view(); });
+
+    concurrency::parallel_for_each(work.begin(), work.end(), [&](const std::pair<size_t,size_t>& item)
+    {
+        ampcblas::set_current_accelerator_view(views.local());
+        ampblas_set_last_error(AMPBLAS_OK);
+
+        results[item.first][item.second] = tests[item.first]->run_test(item.second);
+    });
+
+    // report in registration order
+    for (size_t t=0; t<tests.size(); t++)
+    {
+        std::cout << "Running " << tests[t]->test_count() << " " << tests[t]->type_prefix() << tests[t]->routine_name() << " tests... ";
+
+        if (!skipped[t].empty())
+        {
+            std::cout << "SKIPPED (" << skipped[t] << ")" << std::endl;
+            continue;
+        }
+
+        bool failed = false;
+        for (const test_result& result : results[t])
+        {
+            if (!result.passed)
+            {
+                failed = true;
+                std::cout << "\n  " << result.message;
+            }
+        }
+
+        if (!failed)
+            std::cout << "PASSED";
+
+        std::cout << std::endl;
+    }
+}
@@ -24,6 +24,19 @@
 
 #include <vector>
 #include <memory>
+#include <string>
+
+//
+// test results
+//
+
+struct test_result
+{
+    test_result() : passed(true) {}
+
+    bool passed;
+    std::string message;
+};
 
 //
 // test list
@@ -32,8 +45,15 @@
 class test_list_item
 {
 public:
-    ~test_list_item() {}
+    virtual ~test_list_item() {}
     virtual void run_all_tests() = 0;
+
+    // used by the parallel runner to schedule individual parameter sets
+    virtual std::string routine_name() const = 0;
+    virtual char type_prefix() const = 0;
+    virtual size_t test_count() const = 0;
+    virtual std::string skip_reason() const = 0;
+    virtual test_result run_test(size_t i) = 0;
 };
 
 template <typename test_type>
@@ -53,3 +73,26 @@ typedef std::vector<std::shared_ptr<test_list_item>> test_list;
 
 test_list& get_test_list();
 void execute_all_tests();
+
+//
+// test execution options
+//
+
+struct test_options
+{
+    test_options() : parallel(true) {}
+
+    // run (test, parameter) pairs concurrently on the host thread pool
+    bool parallel;
+
+    // case insensitive routine (e.g. "gemm") and type prefix (e.g. "d") filters; empty matches all
+    std::vector<std::string> routines;
+    std::vector<std::string> types;
+
+    bool matches(const test_list_item& item) const;
+};
+
+// parses --serial, --routine <name> and --type <prefix> from the command line
+test_options parse_test_options(int argc, char* argv[]);
+
+void execute_tests(const test_options& options);
@@ -156,6 +156,13 @@ template <>             inline void ampblas_xgemm(const enum AMPBLAS_ORDER Order
 template <>             inline void ampblas_xgemm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const ampblas_fcomplex alpha, const ampblas_fcomplex *A, const int lda, const ampblas_fcomplex *B, const int ldb, const ampblas_fcomplex beta, ampblas_fcomplex *C, const int ldc) { ampblas_cgemm(Order, TransA, TransB, M, N, K, &alpha, A, lda, B, ldb, &beta, C, ldc); }
 template <>             inline void ampblas_xgemm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const ampblas_dcomplex alpha, const ampblas_dcomplex *A, const int lda, const ampblas_dcomplex *B, const int ldb, const ampblas_dcomplex beta, ampblas_dcomplex *C, const int ldc) { ampblas_zgemm(Order, TransA, TransB, M, N, K, &alpha, A, lda, B, ldb, &beta, C, ldc); }
 
+// ampblas_xgemm_out_of_core
+template <typename value_type> void ampblas_xgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const value_type       alpha, const value_type       *A, const int lda, const value_type       *B, const int ldb, const value_type       beta, value_type       *C, const int ldc, const size_t budget);
+template <>             inline void ampblas_xgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const float            alpha, const float            *A, const int lda, const float            *B, const int ldb, const float            beta, float            *C, const int ldc, const size_t budget) { ampblas_sgemm_out_of_core(Order, TransA, TransB, M, N, K,  alpha, A, lda, B, ldb,  beta, C, ldc, budget); }
+template <>             inline void ampblas_xgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const double           alpha, const double           *A, const int lda, const double           *B, const int ldb, const double           beta, double           *C, const int ldc, const size_t budget) { ampblas_dgemm_out_of_core(Order, TransA, TransB, M, N, K,  alpha, A, lda, B, ldb,  beta, C, ldc, budget); }
+template <>             inline void ampblas_xgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const ampblas_fcomplex alpha, const ampblas_fcomplex *A, const int lda, const ampblas_fcomplex *B, const int ldb, const ampblas_fcomplex beta, ampblas_fcomplex *C, const int ldc, const size_t budget) { ampblas_cgemm_out_of_core(Order, TransA, TransB, M, N, K, &alpha, A, lda, B, ldb, &beta, C, ldc, budget); }
+template <>             inline void ampblas_xgemm_out_of_core(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_TRANSPOSE TransB, const int M, const int N, const int K, const ampblas_dcomplex alpha, const ampblas_dcomplex *A, const int lda, const ampblas_dcomplex *B, const int ldb, const ampblas_dcomplex beta, ampblas_dcomplex *C, const int ldc, const size_t budget) { ampblas_zgemm_out_of_core(Order, TransA, TransB, M, N, K, &alpha, A, lda, B, ldb, &beta, C, ldc, budget); }
+
 // ampblas_xsymm
 template <typename value_type> void ampblas_xsymm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side, const enum AMPBLAS_UPLO Uplo, const int M, const int N, const value_type       alpha, const value_type       *A, const int lda, const value_type       *B, const int ldb, const value_type       beta, value_type       *C, const int ldc);
 template <>             inline void ampblas_xsymm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side, const enum AMPBLAS_UPLO Uplo, const int M, const int N, const float            alpha, const float            *A, const int lda, const float            *B, const int ldb, const float            beta, float            *C, const int ldc) { ampblas_ssymm(Order, Side, Uplo, M, N,  alpha, A, lda, B, ldb,  beta, C, ldc); }
@@ -191,4 +198,29 @@ template <>             inline void ampblas_xtrmm(const enum AMPBLAS_ORDER Order
 template <>             inline void ampblas_xtrmm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int M, const int N, const ampblas_fcomplex alpha, const ampblas_fcomplex *A, const int lda, ampblas_fcomplex *B, const int ldb) { ampblas_ctrmm(Order, Side, Uplo, TransA, Diag, M, N, &alpha, A, lda, B, ldb); }
 template <>             inline void ampblas_xtrmm(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_SIDE Side, const enum AMPBLAS_UPLO Uplo, const enum AMPBLAS_TRANSPOSE TransA, const enum AMPBLAS_DIAG Diag, const int M, const int N, const ampblas_dcomplex alpha, const ampblas_dcomplex *A, const int lda, ampblas_dcomplex *B, const int ldb) { ampblas_ztrmm(Order, Side, Uplo, TransA, Diag, M, N, &alpha, A, lda, B, ldb); }
 
+//----------------------------------------------------------------------------
+// Overloaded ILP64 Routines
+//----------------------------------------------------------------------------
+
+// ampblas_xaxpy_64
+template <typename value_type> void ampblas_xaxpy_64(const ampblas_int64 N, const value_type       alpha, const value_type       *X, const ampblas_int64 incX, value_type       *Y, const ampblas_int64 incY);
+template <>             inline void ampblas_xaxpy_64(const ampblas_int64 N, const float            alpha, const float            *X, const ampblas_int64 incX, float            *Y, const ampblas_int64 incY) { ampblas_saxpy_64(N,  alpha, X, incX, Y, incY); }
+template <>             inline void ampblas_xaxpy_64(const ampblas_int64 N, const double           alpha, const double           *X, const ampblas_int64 incX, double           *Y, const ampblas_int64 incY) { ampblas_daxpy_64(N,  alpha, X, incX, Y, incY); }
+template <>             inline void ampblas_xaxpy_64(const ampblas_int64 N, const ampblas_fcomplex alpha, const ampblas_fcomplex *X, const ampblas_int64 incX, ampblas_fcomplex *Y, const ampblas_int64 incY) { ampblas_caxpy_64(N, &alpha, X, incX, Y, incY); }
+template <>             inline void ampblas_xaxpy_64(const ampblas_int64 N, const ampblas_dcomplex alpha, const ampblas_dcomplex *X, const ampblas_int64 incX, ampblas_dcomplex *Y, const ampblas_int64 incY) { ampblas_zaxpy_64(N, &alpha, X, incX, Y, incY); }
+
+// ampblas_xdot_64
+template <typename value_type>           value_type ampblas_xdot_64(const ampblas_int64 N, const value_type       *X, const ampblas_int64 incX, const value_type       *Y, const ampblas_int64 incY);
+template <>                 inline            float ampblas_xdot_64(const ampblas_int64 N, const float            *X, const ampblas_int64 incX, const float            *Y, const ampblas_int64 incY) { return ampblas_sdot_64(N, X, incX, Y, incY); }
+template <>                 inline           double ampblas_xdot_64(const ampblas_int64 N, const double           *X, const ampblas_int64 incX, const double           *Y, const ampblas_int64 incY) { return ampblas_ddot_64(N, X, incX, Y, incY); }
+template <>                 inline ampblas_fcomplex ampblas_xdot_64(const ampblas_int64 N, const ampblas_fcomplex *X, const ampblas_int64 incX, const ampblas_fcomplex *Y, const ampblas_int64 incY) { ampblas_fcomplex ret; ampblas_cdotc_sub_64(N, X, incX, Y, incY, &ret); return ret; }
+template <>                 inline ampblas_dcomplex ampblas_xdot_64(const ampblas_int64 N, const ampblas_dcomplex *X, const ampblas_int64 incX, const ampblas_dcomplex *Y, const ampblas_int64 incY) { ampblas_dcomplex ret; ampblas_zdotc_sub_64(N, X, incX, Y, incY, &ret); return ret; }
+
+// ampblas_xgemv_64
+template <typename value_type> void ampblas_xgemv_64(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const ampblas_int64 M, const ampblas_int64 N, const value_type       alpha, const value_type       *A, const ampblas_int64 lda, const value_type       *X, const ampblas_int64 incX, const value_type       beta, value_type       *Y, const ampblas_int64 incY);
+template <>             inline void ampblas_xgemv_64(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const ampblas_int64 M, const ampblas_int64 N, const float            alpha, const float            *A, const ampblas_int64 lda, const float            *X, const ampblas_int64 incX, const float            beta, float            *Y, const ampblas_int64 incY) { ampblas_sgemv_64(Order, TransA, M, N,  alpha, A, lda, X, incX,  beta, Y, incY); }
+template <>             inline void ampblas_xgemv_64(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const ampblas_int64 M, const ampblas_int64 N, const double           alpha, const double           *A, const ampblas_int64 lda, const double           *X, const ampblas_int64 incX, const double           beta, double           *Y, const ampblas_int64 incY) { ampblas_dgemv_64(Order, TransA, M, N,  alpha, A, lda, X, incX,  beta, Y, incY); }
+template <>             inline void ampblas_xgemv_64(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const ampblas_int64 M, const ampblas_int64 N, const ampblas_fcomplex alpha, const ampblas_fcomplex *A, const ampblas_int64 lda, const ampblas_fcomplex *X, const ampblas_int64 incX, const ampblas_fcomplex beta, ampblas_fcomplex *Y, const ampblas_int64 incY) { ampblas_cgemv_64(Order, TransA, M, N, &alpha, A, lda, X, incX, &beta, Y, incY); }
+template <>             inline void ampblas_xgemv_64(const enum AMPBLAS_ORDER Order, const enum AMPBLAS_TRANSPOSE TransA, const ampblas_int64 M, const ampblas_int64 N, const ampblas_dcomplex alpha, const ampblas_dcomplex *A, const ampblas_int64 lda, const ampblas_dcomplex *X, const ampblas_int64 incX, const ampblas_dcomplex beta, ampblas_dcomplex *Y, const ampblas_int64 incY) { ampblas_zgemv_64(Order, TransA, M, N, &alpha, A, lda, X, incX, &beta, Y, incY); }
+
 #endif //AMPXBLAS_H
@@ -0,0 +1,251 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * async_test.cpp
+ *
+ * Chains asynchronous accelerator and host routines through their tasks and
+ * compares the delivered results against the synchronous reference. The chain
+ * test also checks the order its continuations run in, and that an error
+ * raised inside a chain reaches the caller through the returned task.
+ *
+ *---------------------------------------------------------------------------*/
+
+// c++ interfaces
+#include "ampblas.h"
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+#include <atomic>
+
+// unique paramaters for async
+template <typename value_type>
+struct async_parameters
+{
+    async_parameters(int n, value_type alpha)
+      : n(n), alpha(alpha)
+    {}
+
+    int n;
+    value_type alpha;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(alpha);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class async_test : public test_case<value_type,async_parameters>
+{
+public:
+
+    std::string name() const
+    {
+        return "ASYNC";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // reference data
+        ampblas_test_vector<value_type> x(p.n);
+        test_vector<value_type> y(p.n);
+
+        // generate data
+        randomize(x);
+        randomize(y);
+
+        // ampblas and host data
+        ampblas_test_vector<value_type> y_amp(y);
+        test_vector<value_type> y_host(y);
+
+        // test references
+        start_reference_test();
+        cblas::xAXPY( p.n, cblas_cast(p.alpha), cblas_cast(x.data()), x.inc(), cblas_cast(y.data()), y.inc() );
+        value_type cblas = cblas::xDOT<value_type,value_type>( p.n, cblas_cast(y.data()), y.inc(), cblas_cast(x.data()), x.inc() );
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        const concurrency::accelerator_view& av = ampcblas::get_current_accelerator_view();
+        auto x_view = ampcblas::get_array_view(x.data(), p.n);
+        auto y_view = ampcblas::get_array_view(y_amp.data(), p.n);
+
+        // the dot product is enqueued from a continuation of the update
+        concurrency::task<value_type> amp_task = ampblas::async::axpy(av, p.alpha, x_view, y_view).then([=] {
+            return ampblas::async::dot<value_type>(av, y_view, x_view);
+        });
+
+        // the host pipeline runs alongside
+        const value_type* x_ptr = x.data();
+        value_type* y_ptr = y_host.data();
+        const int n = p.n;
+        concurrency::task<value_type> host_task = ampblas::async::host::axpy(n, p.alpha, x_ptr, y_ptr).then([=] {
+            return ampblas::async::host::dot(n, y_ptr, x_ptr);
+        });
+
+        value_type amp = amp_task.get();
+        value_type host = host_task.get();
+        stop_ampblas_test();
+
+        // synchronize outputs
+        y_amp.synchronize();
+
+        // calculate error
+        check_error(y, y_amp);
+        check_error(y, y_host);
+        check_error(p.n, cblas, amp);
+        check_error(p.n, cblas, host);
+    }
+
+    async_test()
+    {
+        // bulk test example
+        std::vector<int> n;
+        n.push_back(16);
+        n.push_back(64);
+        n.push_back(256);
+        n.push_back(2048);
+
+        std::vector<value_type> alpha;
+        alpha.push_back( value_type(1) );
+        alpha.push_back( value_type(-1) );
+        alpha.push_back( value_type(0) );
+
+        paramter_exploder(n, alpha);
+    }
+};
+
+// C = alpha * A * B + C, then the norm of C, enqueued from a continuation of the product
+template <typename value_type>
+class async_chain_test : public test_case<value_type,async_parameters>
+{
+public:
+
+    std::string name() const
+    {
+        return "ASYNC_CHAIN";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        const int n = p.n;
+
+        // reference data
+        ampblas_test_matrix<value_type> A(n, n);
+        ampblas_test_matrix<value_type> B(n, n);
+        test_matrix<value_type> C(n, n);
+
+        // generate data
+        randomize(A);
+        randomize(B);
+        randomize(C);
+
+        // ampblas data
+        ampblas_test_matrix<value_type> C_amp(C);
+
+        // test references
+        start_reference_test();
+        cblas::xGEMM(cblas::transpose::no_trans, cblas::transpose::no_trans, n, n, n, cblas_cast(p.alpha), cblas_cast(A.data()), A.ld(), cblas_cast(B.data()), B.ld(), cblas_cast(value_type(1)), cblas_cast(C.data()), C.ld());
+        value_type cblas = cblas::xNRM2(n*n, cblas_cast(C.data()), 1);
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        const concurrency::accelerator_view& av = ampcblas::get_current_accelerator_view();
+        auto a_view = ampcblas::make_matrix_view(n, n, A.data(), A.ld());
+        auto b_view = ampcblas::make_matrix_view(n, n, B.data(), B.ld());
+        auto c_view = ampcblas::make_matrix_view(n, n, C_amp.data(), C_amp.ld());
+        auto c_vec = ampcblas::get_array_view(C_amp.data(), n*n);
+
+        // each continuation records when it ran; the norm is only right if it read the product
+        std::atomic<int> step(0);
+        int gemm_step = 0;
+        int nrm2_step = 0;
+
+        concurrency::task<value_type> amp_task = ampblas::async::gemm(av, ampblas::transpose::no_trans, ampblas::transpose::no_trans, p.alpha, a_view, b_view, value_type(1), c_view).then([=, &step, &gemm_step] {
+            gemm_step = ++step;
+            return ampblas::async::nrm2(av, c_vec);
+        }).then([&step, &nrm2_step] (value_type norm) {
+            nrm2_step = ++step;
+            return norm;
+        });
+
+        value_type amp = amp_task.get();
+        stop_ampblas_test();
+
+        if (gemm_step != 1 || nrm2_step != 2)
+            ampblas_test_runtime_error(AMPBLAS_INTERNAL_ERROR);
+
+        // an argument error raised in a continuation skips the ones after it and is rethrown by get
+        bool skipped = true;
+        bool caught = false;
+        try
+        {
+            ampblas::async::scal(av, value_type(1), c_vec).then([=] {
+                ampblas::potrf(av, ampblas::uplo::lower, c_view.section(concurrency::extent<2>(1, n)));
+            }).then([&skipped] {
+                skipped = false;
+            }).get();
+        }
+        catch (const ampblas::argument_error_exception&)
+        {
+            caught = true;
+        }
+
+        if (!caught || !skipped)
+            ampblas_test_runtime_error(AMPBLAS_INTERNAL_ERROR);
+
+        // synchronize outputs
+        C_amp.synchronize();
+
+        // calculate error
+        check_error(C, C_amp);
+        check_error(n*n, cblas, amp);
+    }
+
+    async_chain_test()
+    {
+        std::vector<int> n;
+        n.push_back(20);
+        n.push_back(128);
+
+        std::vector<value_type> alpha;
+        alpha.push_back( value_type(1) );
+        alpha.push_back( value_type(-1) );
+        alpha.push_back( value_type(0) );
+
+        paramter_exploder(n, alpha);
+    }
+};
+
+REGISTER_TEST(async_test, float);
+REGISTER_TEST(async_test, double);
+
+REGISTER_TEST(async_chain_test, float);
+REGISTER_TEST(async_chain_test, double);
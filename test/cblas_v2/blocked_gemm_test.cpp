@@ -0,0 +1,146 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * blocked_gemm_test.cpp
+ *
+ * Large GEMM tests are verified by the blocked reference kernels, so these
+ * check the blocked kernels themselves against the F2C reference. The sizes
+ * are small enough for the automatic backend to pick F2C for xGEMM, and are
+ * not multiples of the blocking factors, so every block shape is packed.
+ *
+ *---------------------------------------------------------------------------*/
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+#include "cblas_blocked.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+
+// unique paramaters for the blocked reference
+template <typename value_type>
+struct blocked_gemm_parameters
+{
+    blocked_gemm_parameters(enum AMPBLAS_TRANSPOSE transa, enum AMPBLAS_TRANSPOSE transb, int m, int n, int k)
+      : transa(transa), transb(transb), m(m), n(n), k(k)
+    {}
+
+    enum AMPBLAS_TRANSPOSE transa;
+    enum AMPBLAS_TRANSPOSE transb;
+    int m;
+    int n;
+    int k;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(transa)
+            << AMPBLAS_NAMED_TYPE(transb)
+            << AMPBLAS_NAMED_TYPE(m)
+            << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(k);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class blocked_gemm_test : public test_case<value_type,blocked_gemm_parameters>
+{
+public:
+
+    std::string name() const
+    {
+        return "BLOCKED_GEMM";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // derived parameters
+        const int row_a = (p.transa == AmpblasNoTrans ? p.m : p.k);
+        const int col_a = (p.transa == AmpblasNoTrans ? p.k : p.m);
+        const int row_b = (p.transb == AmpblasNoTrans ? p.k : p.n);
+        const int col_b = (p.transb == AmpblasNoTrans ? p.n : p.k);
+
+        // padded leading dimensions
+        test_matrix<value_type> A(row_a, col_a, row_a + 3);
+        test_matrix<value_type> B(row_b, col_b, row_b + 5);
+        test_matrix<value_type> C(p.m, p.n, p.m + 1);
+
+        // generate data
+        randomize(A);
+        randomize(B);
+        randomize(C);
+
+        // blocked data
+        test_matrix<value_type> C_blocked(C);
+
+        const value_type alpha = value_type(-1);
+        const value_type beta = value_type(2);
+
+        // test references
+        start_reference_test();
+        cblas::xGEMM(cblas_cast(p.transa), cblas_cast(p.transb), p.m, p.n, p.k, cblas_cast(alpha), cblas_cast(A.data()), A.ld(), cblas_cast(B.data()), B.ld(), cblas_cast(beta), cblas_cast(C.data()), C.ld());
+        stop_reference_test();
+
+        // test blocked kernels
+        start_ampblas_test();
+        cblas::blocked::gemm(cblas_cast(p.transa), cblas_cast(p.transb), p.m, p.n, p.k, cblas_cast(alpha), cblas_cast(A.data()), A.ld(), cblas_cast(B.data()), B.ld(), cblas_cast(beta), cblas_cast(C_blocked.data()), C_blocked.ld());
+        stop_ampblas_test();
+
+        // calculate error
+        check_error(C, C_blocked);
+    }
+
+    blocked_gemm_test()
+    {
+        std::vector<enum AMPBLAS_TRANSPOSE> transa;
+        transa.push_back(AmpblasNoTrans);
+        transa.push_back(AmpblasTrans);
+        transa.push_back(AmpblasConjTrans);
+
+        std::vector<enum AMPBLAS_TRANSPOSE> transb;
+        transb.push_back(AmpblasNoTrans);
+        transb.push_back(AmpblasTrans);
+        transb.push_back(AmpblasConjTrans);
+
+        // within one block, and past one m, n and k block respectively
+        std::vector<int> m;
+        m.push_back(37);
+        m.push_back(130);
+
+        std::vector<int> n;
+        n.push_back(7);
+        n.push_back(141);
+
+        std::vector<int> k;
+        k.push_back(5);
+        k.push_back(300);
+
+        paramter_exploder(transa, transb, m, n, k);
+    }
+};
+
+REGISTER_TEST(blocked_gemm_test, float);
+REGISTER_TEST(blocked_gemm_test, double);
+REGISTER_TEST(blocked_gemm_test, complex_float);
+REGISTER_TEST(blocked_gemm_test, complex_double);
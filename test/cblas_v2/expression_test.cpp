@@ -0,0 +1,227 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * expression_test.cpp
+ *
+ * Checks that expressions on ampblas::vector and ampblas::matrix lower to
+ * the same results as the equivalent reference calls.
+ *
+ *---------------------------------------------------------------------------*/
+
+// expression template interfaces
+#include "ampblas_matrix.h"
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+#include <limits>
+
+// unique paramaters for expressions
+template <typename value_type>
+struct expression_parameters
+{
+    expression_parameters(enum AMPBLAS_TRANSPOSE transa, int m, int n, value_type alpha, value_type beta)
+      : transa(transa), m(m), n(n), alpha(alpha), beta(beta)
+    {}
+
+    enum AMPBLAS_TRANSPOSE transa;
+    int m;
+    int n;
+    value_type alpha;
+    value_type beta;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(transa)
+            << AMPBLAS_NAMED_TYPE(m)
+            << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(alpha)
+            << AMPBLAS_NAMED_TYPE(beta);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class expression_test : public test_case<value_type,expression_parameters>
+{
+public:
+
+    std::string name() const
+    {
+        return "EXPRESSION";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        const int x_size = (p.transa == AmpblasNoTrans ? p.n : p.m);
+        const int y_size = (p.transa == AmpblasNoTrans ? p.m : p.n);
+
+        // reference data
+        ampblas_test_matrix<value_type> A(p.m, p.n);
+        ampblas_test_vector<value_type> x(x_size);
+        ampblas_test_vector<value_type> w(y_size);
+        test_vector<value_type> y(y_size);
+        test_vector<value_type> z(y_size);
+        test_vector<value_type> u(y_size);
+
+        // generate data
+        randomize(A);
+        randomize(x);
+        randomize(w);
+        randomize(y);
+
+        // ampblas data
+        ampblas_test_vector<value_type> y_amp(y);
+        ampblas_test_vector<value_type> z_amp(z);
+
+        // a plain product must not read its destination
+        test_vector<value_type> u_nan(y_size);
+        for (int i=0; i<y_size; i++)
+            u_nan[i] = std::numeric_limits<value_type>::quiet_NaN();
+        ampblas_test_vector<value_type> u_amp(u_nan);
+
+        // gemm operands: op(A) * B is y_size by y_size
+        ampblas_test_matrix<value_type> B(x_size, y_size);
+        ampblas_test_matrix<value_type> D(y_size, y_size);
+        test_matrix<value_type> C(y_size, y_size);
+        test_matrix<value_type> E(y_size, y_size);
+        randomize(B);
+        randomize(D);
+        randomize(C);
+        randomize(E);
+
+        // the bias is added to the product; E is both an operand and the destination
+        test_matrix<value_type> G(D);
+        test_matrix<value_type> E_ref(E);
+        ampblas_test_matrix<value_type> C_amp(C);
+        ampblas_test_matrix<value_type> G_amp(y_size, y_size);
+        ampblas_test_matrix<value_type> E_amp(E);
+
+        // test references
+        start_reference_test();
+        cblas::xGEMV(cblas_cast(p.transa), p.m, p.n, cblas_cast(p.alpha), cblas_cast(A.data()), A.ld(), cblas_cast(x.data()), x.inc(), cblas_cast(p.beta), cblas_cast(y.data()), y.inc());
+        for (int i=0; i<y_size; i++)
+            z[i] = y[i] + p.alpha * w[i] - y[i] * p.beta;
+        cblas::xGEMV(cblas_cast(p.transa), p.m, p.n, cblas_cast(p.alpha), cblas_cast(A.data()), A.ld(), cblas_cast(x.data()), x.inc(), cblas_cast(value_type()), cblas_cast(u.data()), u.inc());
+        cblas::xGEMM(cblas_cast(p.transa), cblas_cast(AmpblasNoTrans), y_size, y_size, x_size, cblas_cast(p.alpha), cblas_cast(A.data()), A.ld(), cblas_cast(B.data()), B.ld(), cblas_cast(p.beta), cblas_cast(C.data()), C.ld());
+        cblas::xGEMM(cblas_cast(p.transa), cblas_cast(AmpblasNoTrans), y_size, y_size, x_size, cblas_cast(value_type(1)), cblas_cast(A.data()), A.ld(), cblas_cast(B.data()), B.ld(), cblas_cast(value_type(1)), cblas_cast(G.data()), G.ld());
+        cblas::xGEMM(cblas_cast(AmpblasNoTrans), cblas_cast(AmpblasNoTrans), y_size, y_size, y_size, cblas_cast(p.alpha), cblas_cast(E.data()), E.ld(), cblas_cast(E.data()), E.ld(), cblas_cast(p.beta), cblas_cast(E_ref.data()), E_ref.ld());
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        const concurrency::accelerator_view& av = ampcblas::get_current_accelerator_view();
+        ampblas::matrix<value_type> a_mat(ampcblas::make_matrix_view(p.m, p.n, A.data(), A.ld()), av);
+        ampblas::vector<value_type> x_vec(ampcblas::get_array_view(x.data(), x_size), av);
+        ampblas::vector<value_type> w_vec(ampcblas::get_array_view(w.data(), y_size), av);
+        ampblas::vector<value_type> y_vec(ampcblas::get_array_view(y_amp.data(), y_size), av);
+        ampblas::vector<value_type> z_vec(ampcblas::get_array_view(z_amp.data(), y_size), av);
+        ampblas::vector<value_type> u_vec(ampcblas::get_array_view(u_amp.data(), y_size), av);
+        ampblas::matrix<value_type> b_mat(ampcblas::make_matrix_view(x_size, y_size, B.data(), B.ld()), av);
+        ampblas::matrix<value_type> c_mat(ampcblas::make_matrix_view(y_size, y_size, C_amp.data(), C_amp.ld()), av);
+        ampblas::matrix<value_type> d_mat(ampcblas::make_matrix_view(y_size, y_size, D.data(), D.ld()), av);
+        ampblas::matrix<value_type> g_mat(ampcblas::make_matrix_view(y_size, y_size, G_amp.data(), G_amp.ld()), av);
+        ampblas::matrix<value_type> e_mat(ampcblas::make_matrix_view(y_size, y_size, E_amp.data(), E_amp.ld()), av);
+
+        // single gemv
+        if (p.transa == AmpblasNoTrans)
+            y_vec = p.alpha * a_mat * x_vec + p.beta * y_vec;
+        else
+            y_vec = p.alpha * ampblas::trans(a_mat) * x_vec + p.beta * y_vec;
+
+        // single elementwise kernel
+        z_vec = y_vec + p.alpha * w_vec - y_vec * p.beta;
+
+        // gemv with a zero beta
+        if (p.transa == AmpblasNoTrans)
+            u_vec = p.alpha * a_mat * x_vec;
+        else
+            u_vec = p.alpha * ampblas::trans(a_mat) * x_vec;
+
+        // single gemm, and gemm with a bias
+        if (p.transa == AmpblasNoTrans)
+        {
+            c_mat = p.alpha * a_mat * b_mat + p.beta * c_mat;
+            g_mat = a_mat * b_mat + d_mat;
+        }
+        else
+        {
+            c_mat = p.alpha * ampblas::trans(a_mat) * b_mat + p.beta * c_mat;
+            g_mat = ampblas::trans(a_mat) * b_mat + d_mat;
+        }
+
+        // the destination is an operand of the product, so it is evaluated through a temporary
+        e_mat = p.alpha * e_mat * e_mat + p.beta * e_mat;
+        stop_ampblas_test();
+
+        // synchronize outputs
+        y_amp.synchronize();
+        z_amp.synchronize();
+        u_amp.synchronize();
+        C_amp.synchronize();
+        G_amp.synchronize();
+        E_amp.synchronize();
+
+        // calculate error
+        check_error(y, y_amp);
+        check_error(z, z_amp);
+        check_error(u, u_amp);
+        check_error(C, C_amp);
+        check_error(G, G_amp);
+        check_error(E_ref, E_amp);
+    }
+
+    expression_test()
+    {
+        // bulk test example
+        std::vector<enum AMPBLAS_TRANSPOSE> transa;
+        transa.push_back(AmpblasNoTrans);
+        transa.push_back(AmpblasTrans);
+
+        std::vector<int> m;
+        m.push_back(16);
+        m.push_back(64);
+
+        std::vector<int> n;
+        n.push_back(16);
+        n.push_back(64);
+
+        std::vector<value_type> alpha;
+        alpha.push_back( value_type(1) );
+        alpha.push_back( value_type(-1) );
+        alpha.push_back( value_type(0) );
+
+        std::vector<value_type> beta;
+        beta.push_back( value_type(1) );
+        beta.push_back( value_type(0) );
+        beta.push_back( value_type(2) );
+
+        paramter_exploder(transa, m, n, alpha, beta);
+    }
+};
+
+REGISTER_TEST(expression_test, float);
+REGISTER_TEST(expression_test, double);
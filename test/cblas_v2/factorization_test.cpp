@@ -0,0 +1,336 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * factorization_test.cpp
+ *
+ * The factorizations are checked by rebuilding the input from the factors
+ * with the reference GEMM, for both the accelerator and the host path.
+ *
+ *---------------------------------------------------------------------------*/
+
+// c++ interfaces
+#include "ampblas.h"
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+
+// unique paramaters for the factorizations
+template <typename value_type>
+struct factorization_parameters
+{
+    factorization_parameters(enum AMPBLAS_UPLO uplo, int m, int n)
+      : uplo(uplo), m(m), n(n)
+    {}
+
+    enum AMPBLAS_UPLO uplo;
+    int m;
+    int n;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(uplo)
+            << AMPBLAS_NAMED_TYPE(m)
+            << AMPBLAS_NAMED_TYPE(n);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class factorization_test : public test_case<value_type,factorization_parameters>
+{
+protected:
+
+    bool requires_full_double() const
+    {
+        // uses division
+        return true;
+    }
+
+    // rebuilt from products of n-length sums
+    real_type fudge_factor() const
+    {
+        return real_type(4096);
+    }
+
+    factorization_test()
+    {
+        std::vector<enum AMPBLAS_UPLO> uplo;
+        uplo.push_back(AmpblasUpper);
+        uplo.push_back(AmpblasLower);
+
+        // crosses the panel width with a partial last panel
+        std::vector<int> m;
+        m.push_back(64);
+        m.push_back(200);
+        m.push_back(300);
+
+        std::vector<int> n;
+        n.push_back(64);
+        n.push_back(200);
+        n.push_back(300);
+
+        paramter_exploder(uplo, m, n);
+    }
+
+    // C = op(A) * op(B) with the reference GEMM
+    static void multiply(cblas::transpose transa, cblas::transpose transb, const test_matrix<value_type>& A, const test_matrix<value_type>& B, test_matrix<value_type>& C, int k)
+    {
+        cblas::xGEMM(transa, transb, C.m(), C.n(), k, cblas_cast(value_type(1)), cblas_cast(const_cast<value_type*>(A.data())), A.ld(), cblas_cast(const_cast<value_type*>(B.data())), B.ld(), cblas_cast(value_type(0)), cblas_cast(C.data()), C.ld());
+    }
+};
+
+template <typename value_type>
+class potrf_test : public factorization_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "POTRF";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // square problems only
+        if (p.m != p.n)
+            return;
+
+        const int n = p.n;
+        const ampblas::uplo tri = (p.uplo == AmpblasUpper ? ampblas::uplo::upper : ampblas::uplo::lower);
+
+        // A = B * B' / n + I is well conditioned
+        test_matrix<value_type> B(n, n);
+        test_matrix<value_type> A(n, n);
+        randomize(B);
+        multiply(cblas::transpose::no_trans, cblas::transpose::trans, B, B, A, n);
+        for (int j=0; j<n; j++)
+            for (int i=0; i<n; i++)
+                A(i,j) = A(i,j) / value_type(n) + (i == j ? value_type(1) : value_type(0));
+
+        ampblas_test_matrix<value_type> A_amp(A);
+        test_matrix<value_type> A_host(A);
+
+        // host path
+        start_reference_test();
+        int host_info = ampblas::host::potrf(tri, n, A_host.data(), A_host.ld());
+        stop_reference_test();
+
+        // accelerator path
+        start_ampblas_test();
+        int amp_info = ampblas::potrf(ampcblas::get_current_accelerator_view(), tri, ampcblas::make_matrix_view(n, n, A_amp.data(), A_amp.ld()));
+        stop_ampblas_test();
+
+        // synchronize outputs
+        A_amp.synchronize();
+
+        check_error(0, host_info);
+        check_error(0, amp_info);
+        check_error(A, rebuild(p.uplo, A_host));
+        check_error(A, rebuild(p.uplo, A_amp));
+    }
+
+private:
+
+    // L * L' or U' * U from the referenced triangle
+    test_matrix<value_type> rebuild(enum AMPBLAS_UPLO uplo, const test_matrix<value_type>& F)
+    {
+        const int n = F.n();
+
+        test_matrix<value_type> T(n, n);
+        for (int j=0; j<n; j++)
+            for (int i=0; i<n; i++)
+                if (uplo == AmpblasLower ? i >= j : i <= j)
+                    T(i,j) = F(i,j);
+
+        test_matrix<value_type> R(n, n);
+        if (uplo == AmpblasLower)
+            multiply(cblas::transpose::no_trans, cblas::transpose::trans, T, T, R, n);
+        else
+            multiply(cblas::transpose::trans, cblas::transpose::no_trans, T, T, R, n);
+
+        return R;
+    }
+};
+
+template <typename value_type>
+class getrf_test : public factorization_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "GETRF";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // no triangle
+        if (p.uplo != AmpblasLower)
+            return;
+
+        test_matrix<value_type> A(p.m, p.n);
+        randomize(A);
+
+        ampblas_test_matrix<value_type> A_amp(A);
+        test_matrix<value_type> A_host(A);
+
+        const int mn = std::min(p.m, p.n);
+        std::vector<int> ipiv_host(mn), ipiv_amp;
+
+        // host path
+        start_reference_test();
+        ampblas::host::getrf(p.m, p.n, A_host.data(), A_host.ld(), ipiv_host.data());
+        stop_reference_test();
+
+        // accelerator path
+        start_ampblas_test();
+        ampblas::getrf(ampcblas::get_current_accelerator_view(), ampcblas::make_matrix_view(p.m, p.n, A_amp.data(), A_amp.ld()), ipiv_amp);
+        stop_ampblas_test();
+
+        // synchronize outputs
+        A_amp.synchronize();
+
+        check_error(permute(A, ipiv_host), rebuild(A_host));
+        check_error(permute(A, ipiv_amp), rebuild(A_amp));
+    }
+
+private:
+
+    // P * A
+    static test_matrix<value_type> permute(const test_matrix<value_type>& A, const std::vector<int>& ipiv)
+    {
+        test_matrix<value_type> PA(A);
+        for (int i=0; i<static_cast<int>(ipiv.size()); i++)
+            for (int j=0; j<A.n(); j++)
+                std::swap(PA(i,j), PA(ipiv[i],j));
+        return PA;
+    }
+
+    // L * U
+    test_matrix<value_type> rebuild(const test_matrix<value_type>& F)
+    {
+        const int m = F.m();
+        const int n = F.n();
+        const int mn = std::min(m, n);
+
+        test_matrix<value_type> L(m, mn);
+        test_matrix<value_type> U(mn, n);
+        for (int j=0; j<mn; j++)
+            for (int i=0; i<m; i++)
+                L(i,j) = (i > j ? F(i,j) : i == j ? value_type(1) : value_type(0));
+        for (int j=0; j<n; j++)
+            for (int i=0; i<=std::min(j, mn-1); i++)
+                U(i,j) = F(i,j);
+
+        test_matrix<value_type> R(m, n);
+        multiply(cblas::transpose::no_trans, cblas::transpose::no_trans, L, U, R, mn);
+        return R;
+    }
+};
+
+template <typename value_type>
+class geqrf_test : public factorization_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "GEQRF";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // no triangle
+        if (p.uplo != AmpblasLower)
+            return;
+
+        test_matrix<value_type> A(p.m, p.n);
+        randomize(A);
+
+        ampblas_test_matrix<value_type> A_amp(A);
+        test_matrix<value_type> A_host(A);
+
+        std::vector<value_type> tau_host(std::min(p.m, p.n)), tau_amp;
+
+        // host path
+        start_reference_test();
+        ampblas::host::geqrf(p.m, p.n, A_host.data(), A_host.ld(), tau_host.data());
+        stop_reference_test();
+
+        // accelerator path
+        start_ampblas_test();
+        ampblas::geqrf(ampcblas::get_current_accelerator_view(), ampcblas::make_matrix_view(p.m, p.n, A_amp.data(), A_amp.ld()), tau_amp);
+        stop_ampblas_test();
+
+        // synchronize outputs
+        A_amp.synchronize();
+
+        check_error(A, rebuild(A_host, tau_host));
+        check_error(A, rebuild(A_amp, tau_amp));
+    }
+
+private:
+
+    // Q * R, applying the reflectors to R from the last to the first
+    test_matrix<value_type> rebuild(const test_matrix<value_type>& F, const std::vector<value_type>& tau)
+    {
+        const int m = F.m();
+        const int n = F.n();
+        const int mn = std::min(m, n);
+
+        test_matrix<value_type> R(m, n);
+        for (int j=0; j<n; j++)
+            for (int i=0; i<=std::min(j, m-1); i++)
+                R(i,j) = F(i,j);
+
+        for (int k=mn-1; k>=0; k--)
+        {
+            for (int j=0; j<n; j++)
+            {
+                value_type w = R(k,j);
+                for (int i=k+1; i<m; i++)
+                    w += F(i,k) * R(i,j);
+                w *= tau[k];
+
+                R(k,j) -= w;
+                for (int i=k+1; i<m; i++)
+                    R(i,j) -= w * F(i,k);
+            }
+        }
+
+        return R;
+    }
+};
+
+REGISTER_TEST(potrf_test, float);
+REGISTER_TEST(potrf_test, double);
+
+REGISTER_TEST(getrf_test, float);
+REGISTER_TEST(getrf_test, double);
+
+REGISTER_TEST(geqrf_test, float);
+REGISTER_TEST(geqrf_test, double);
@@ -0,0 +1,429 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * fused_test.cpp
+ *
+ * The fused Level 1 routines only exist in the C++ interface, so these tests
+ * call it directly on views of the bound test vectors and compare against the
+ * sequence of reference calls each routine replaces.
+ *
+ *---------------------------------------------------------------------------*/
+
+// c++ interfaces
+#include "ampblas.h"
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+#include <type_traits>
+
+// unique paramaters for the fused routines
+template <typename value_type>
+struct fused_parameters
+{
+    fused_parameters(int n, value_type alpha, int incx, int incy)
+      : n(n), alpha(alpha), incx(incx), incy(incy)
+    {}
+
+    int n;
+    value_type alpha;
+    int incx;
+    int incy;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(alpha)
+            << AMPBLAS_NAMED_TYPE(incx)
+            << AMPBLAS_NAMED_TYPE(incy);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class fused_test : public test_case<value_type,fused_parameters>
+{
+protected:
+
+    fused_test()
+    {
+        std::vector<int> n;
+        n.push_back(16);
+        n.push_back(64);
+        n.push_back(256);
+        n.push_back(2048);
+
+        std::vector<value_type> alpha;
+        alpha.push_back( value_type(1) );
+        alpha.push_back( value_type(-1) );
+        alpha.push_back( value_type(0) );
+
+        std::vector<int> incx;
+        incx.push_back(1);
+        incx.push_back(-1);
+        incx.push_back(2);
+
+        std::vector<int> incy;
+        incy.push_back(1);
+        incy.push_back(-1);
+        incy.push_back(2);
+
+        paramter_exploder(n, alpha, incx, incy);
+    }
+};
+
+// y = alpha * x + y followed by dot(y, z)
+template <typename value_type>
+class axpy_dot_test : public fused_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "AXPY_DOT";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // reference data
+        ampblas_test_vector<value_type> x(p.n, p.incx);
+        ampblas_test_vector<value_type> z(p.n, p.incx);
+        test_vector<value_type> y(p.n, p.incy);
+
+        // generate data
+        randomize(x);
+        randomize(y);
+        randomize(z);
+
+        // ampblas data
+        ampblas_test_vector<value_type> y_amp(y);
+
+        typedef typename cblas_type<value_type>::type cblas_type;
+
+        // test references
+        start_reference_test();
+        cblas::xAXPY( p.n, cblas_cast(p.alpha), cblas_cast(x.data()), x.inc(), cblas_cast(y.data()), y.inc() );
+        cblas_type cblas = cblas::xDOT<cblas_type,cblas_type>( p.n, cblas_cast(y.data()), y.inc(), cblas_cast(z.data()), z.inc() );
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        auto x_view = ampcblas::make_vector_view(p.n, x.data(), x.inc());
+        auto y_view = ampcblas::make_vector_view(p.n, y_amp.data(), y_amp.inc());
+        auto z_view = ampcblas::make_vector_view(p.n, z.data(), z.inc());
+        value_type amp = ampblas::axpy_dot<value_type>(ampcblas::get_current_accelerator_view(), p.alpha, x_view, y_view, z_view);
+        stop_ampblas_test();
+
+        // synchronize outputs
+        y_amp.synchronize();
+
+        // calculate error
+        check_error(y, y_amp);
+        check_error(p.n, *reinterpret_cast<value_type*>(&cblas), amp);
+    }
+};
+
+// dot(x, y) and dot(x, z) in a single pass
+template <typename value_type>
+class dot2_test : public fused_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "DOT2";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // input data
+        ampblas_test_vector<value_type> x(p.n, p.incx);
+        ampblas_test_vector<value_type> y(p.n, p.incy);
+        ampblas_test_vector<value_type> z(p.n, p.incy);
+
+        // generate data
+        randomize(x);
+        randomize(y);
+        randomize(z);
+
+        typedef typename cblas_type<value_type>::type cblas_type;
+
+        // test references
+        start_reference_test();
+        cblas_type cblas_xy = cblas::xDOT<cblas_type,cblas_type>( p.n, cblas_cast(x.data()), x.inc(), cblas_cast(y.data()), y.inc() );
+        cblas_type cblas_xz = cblas::xDOT<cblas_type,cblas_type>( p.n, cblas_cast(x.data()), x.inc(), cblas_cast(z.data()), z.inc() );
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        auto x_view = ampcblas::make_vector_view(p.n, x.data(), x.inc());
+        auto y_view = ampcblas::make_vector_view(p.n, y.data(), y.inc());
+        auto z_view = ampcblas::make_vector_view(p.n, z.data(), z.inc());
+        ampblas::_detail::value_pair<value_type> amp = ampblas::dot2<value_type>(ampcblas::get_current_accelerator_view(), x_view, y_view, z_view);
+        stop_ampblas_test();
+
+        // calculate error
+        check_error(p.n, *reinterpret_cast<value_type*>(&cblas_xy), amp.first);
+        check_error(p.n, *reinterpret_cast<value_type*>(&cblas_xz), amp.second);
+    }
+};
+
+// unique paramaters for the two scalar updates
+template <typename value_type>
+struct axpby_parameters
+{
+    axpby_parameters(int n, value_type alpha, value_type beta, int incx, int incy)
+      : n(n), alpha(alpha), beta(beta), incx(incx), incy(incy)
+    {}
+
+    int n;
+    value_type alpha;
+    value_type beta;
+    int incx;
+    int incy;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(alpha)
+            << AMPBLAS_NAMED_TYPE(beta)
+            << AMPBLAS_NAMED_TYPE(incx)
+            << AMPBLAS_NAMED_TYPE(incy);
+
+        return out.str();
+    }
+
+};
+
+// The reference for both updates is SCAL by beta followed by AXPY by alpha. The host kernels
+// exist for the real types only and take contiguous vectors, so they are checked for those.
+template <typename value_type>
+class axpby_fused_test : public test_case<value_type,axpby_parameters>
+{
+protected:
+
+    axpby_fused_test()
+    {
+        std::vector<int> n;
+        n.push_back(1);
+        n.push_back(17);
+        n.push_back(256);
+        n.push_back(2049);
+
+        std::vector<value_type> alpha;
+        alpha.push_back( value_type(2) );
+        alpha.push_back( value_type(-1) );
+        alpha.push_back( value_type(0) );
+
+        std::vector<value_type> beta;
+        beta.push_back( value_type(1) );
+        beta.push_back( value_type(-0.5) );
+        beta.push_back( value_type(0) );
+
+        std::vector<int> incx;
+        incx.push_back(1);
+        incx.push_back(2);
+
+        std::vector<int> incy;
+        incy.push_back(1);
+        incy.push_back(3);
+
+        paramter_exploder(n, alpha, beta, incx, incy);
+    }
+
+    // y = beta * y + alpha * x by the reference routines
+    void reference_axpby(const typed_parameters& p, const test_vector<value_type>& x, test_vector<value_type>& y)
+    {
+        cblas::xSCAL( p.n, cblas_cast(p.beta), cblas_cast(y.data()), y.inc() );
+        cblas::xAXPY( p.n, cblas_cast(p.alpha), cblas_cast(const_cast<value_type*>(x.data())), x.inc(), cblas_cast(y.data()), y.inc() );
+    }
+
+    bool host_variant(const typed_parameters& p) const
+    {
+        return p.incx == 1 && p.incy == 1;
+    }
+};
+
+// y = alpha * x + beta * y
+template <typename value_type>
+class axpby_test : public axpby_fused_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "AXPBY";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // reference data
+        ampblas_test_vector<value_type> x(p.n, p.incx);
+        test_vector<value_type> y(p.n, p.incy);
+
+        // generate data
+        randomize(x);
+        randomize(y);
+
+        // ampblas and host data
+        ampblas_test_vector<value_type> y_amp(y);
+        test_vector<value_type> y_host(y);
+
+        // test references
+        start_reference_test();
+        reference_axpby(p, x, y);
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        auto x_view = ampcblas::make_vector_view(p.n, x.data(), x.inc());
+        auto y_view = ampcblas::make_vector_view(p.n, y_amp.data(), y_amp.inc());
+        ampblas::axpby(ampcblas::get_current_accelerator_view(), p.alpha, x_view, p.beta, y_view);
+        stop_ampblas_test();
+
+        // synchronize outputs
+        y_amp.synchronize();
+
+        // calculate error
+        check_error(y, y_amp);
+
+        if (host_variant(p))
+        {
+            run_host(p, x, y_host, std::is_floating_point<value_type>());
+            check_error(y, y_host);
+        }
+    }
+
+private:
+
+    void run_host(const typed_parameters& p, const test_vector<value_type>& x, test_vector<value_type>& y, std::true_type)
+    {
+        ampblas::_detail::host_axpby(p.n, p.alpha, x.data(), p.beta, y.data());
+    }
+
+    void run_host(const typed_parameters&, const test_vector<value_type>&, test_vector<value_type>&, std::false_type)
+    {
+    }
+};
+
+// w = alpha * x + beta * y into a separate w, and into y itself
+template <typename value_type>
+class waxpby_test : public axpby_fused_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "WAXPBY";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // reference data
+        ampblas_test_vector<value_type> x(p.n, p.incx);
+        ampblas_test_vector<value_type> y(p.n, p.incy);
+        test_vector<value_type> w(p.n, p.incy);
+
+        // generate data
+        randomize(x);
+        randomize(y);
+        randomize(w);
+
+        // the aliased update overwrites y, so it runs on a copy
+        test_vector<value_type> y_ref(y);
+        ampblas_test_vector<value_type> w_amp(w);
+        ampblas_test_vector<value_type> y_amp(y_ref);
+        test_vector<value_type> w_host(w);
+        test_vector<value_type> y_host(y_ref);
+
+        // test references
+        start_reference_test();
+        cblas::xCOPY( p.n, cblas_cast(y_ref.data()), y_ref.inc(), cblas_cast(w.data()), w.inc() );
+        reference_axpby(p, x, w);
+        reference_axpby(p, x, y_ref);
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        const concurrency::accelerator_view& av = ampcblas::get_current_accelerator_view();
+        auto x_view = ampcblas::make_vector_view(p.n, x.data(), x.inc());
+        auto y_view = ampcblas::make_vector_view(p.n, y.data(), y.inc());
+        auto w_view = ampcblas::make_vector_view(p.n, w_amp.data(), w_amp.inc());
+        auto y_alias = ampcblas::make_vector_view(p.n, y_amp.data(), y_amp.inc());
+        ampblas::waxpby(av, p.alpha, x_view, p.beta, y_view, w_view);
+        ampblas::waxpby(av, p.alpha, x_view, p.beta, y_alias, y_alias);
+        stop_ampblas_test();
+
+        // synchronize outputs
+        w_amp.synchronize();
+        y_amp.synchronize();
+
+        // calculate error
+        check_error(w, w_amp);
+        check_error(y_ref, y_amp);
+
+        if (host_variant(p))
+        {
+            run_host(p, x, y_host, w_host, std::is_floating_point<value_type>());
+            check_error(w, w_host);
+            check_error(y_ref, y_host);
+        }
+    }
+
+private:
+
+    void run_host(const typed_parameters& p, const test_vector<value_type>& x, test_vector<value_type>& y, test_vector<value_type>& w, std::true_type)
+    {
+        ampblas::_detail::host_waxpby(p.n, p.alpha, x.data(), p.beta, y.data(), w.data());
+        ampblas::_detail::host_waxpby(p.n, p.alpha, x.data(), p.beta, y.data(), y.data());
+    }
+
+    void run_host(const typed_parameters&, const test_vector<value_type>&, test_vector<value_type>&, test_vector<value_type>&, std::false_type)
+    {
+    }
+};
+
+REGISTER_TEST(axpy_dot_test, float);
+REGISTER_TEST(axpy_dot_test, double);
+REGISTER_TEST(axpy_dot_test, complex_float);
+REGISTER_TEST(axpy_dot_test, complex_double);
+
+REGISTER_TEST(dot2_test, float);
+REGISTER_TEST(dot2_test, double);
+REGISTER_TEST(dot2_test, complex_float);
+REGISTER_TEST(dot2_test, complex_double);
+
+REGISTER_TEST(axpby_test, float);
+REGISTER_TEST(axpby_test, double);
+REGISTER_TEST(axpby_test, complex_float);
+REGISTER_TEST(axpby_test, complex_double);
+
+REGISTER_TEST(waxpby_test, float);
+REGISTER_TEST(waxpby_test, double);
+REGISTER_TEST(waxpby_test, complex_float);
+REGISTER_TEST(waxpby_test, complex_double);
@@ -173,6 +173,14 @@ public:
 		ldc_offset.push_back(4);
 
         paramter_exploder(transa,transb,m,n,k,alpha,beta,lda_offset,ldb_offset,ldc_offset);
+
+        // production sized problems; verified by the blocked reference backend
+        if (is_double())
+        {
+            add_test(typed_parameters(AmpblasNoTrans, AmpblasNoTrans, 2048, 2048, 2048, value_type(1), value_type(-1), 0, 0, 0));
+            add_test(typed_parameters(AmpblasTrans, AmpblasNoTrans, 2048, 2048, 2048, value_type(-1), value_type(1), 0, 0, 0));
+            add_test(typed_parameters(AmpblasNoTrans, AmpblasConjTrans, 1500, 1700, 1900, value_type(1), value_type(0), 4, 4, 4));
+        }
     }
 };
 
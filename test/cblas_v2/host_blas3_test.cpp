@@ -0,0 +1,199 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * host_blas3_test.cpp
+ *
+ * The parallel host BLAS 3 drivers split the output into blocks of
+ * host_column_block columns. Column counts that are not a multiple of the
+ * block leave a ragged last block, and padded leading dimensions check the
+ * offsets of every block.
+ *
+ *---------------------------------------------------------------------------*/
+
+// c++ interfaces
+#include "ampblas.h"
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+
+// unique paramaters for the host drivers
+template <typename value_type>
+struct host_blas3_parameters
+{
+    host_blas3_parameters(enum AMPBLAS_UPLO uplo, enum AMPBLAS_DIAG diag, int m, int n, int ld_offset)
+      : uplo(uplo), diag(diag), m(m), n(n), ld_offset(ld_offset)
+    {}
+
+    enum AMPBLAS_UPLO uplo;
+    enum AMPBLAS_DIAG diag;
+    int m;
+    int n;
+    int ld_offset;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(uplo)
+            << AMPBLAS_NAMED_TYPE(diag)
+            << AMPBLAS_NAMED_TYPE(m)
+            << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(ld_offset);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class host_blas3_test : public test_case<value_type,host_blas3_parameters>
+{
+protected:
+
+    host_blas3_test()
+    {
+        std::vector<enum AMPBLAS_UPLO> uplo;
+        uplo.push_back(AmpblasUpper);
+        uplo.push_back(AmpblasLower);
+
+        std::vector<enum AMPBLAS_DIAG> diag;
+        diag.push_back(AmpblasNonUnit);
+        diag.push_back(AmpblasUnit);
+
+        std::vector<int> m;
+        m.push_back(17);
+        m.push_back(64);
+
+        // less than one block, whole blocks, and a ragged last block
+        std::vector<int> n;
+        n.push_back(40);
+        n.push_back(128);
+        n.push_back(150);
+
+        std::vector<int> ld_offset;
+        ld_offset.push_back(0);
+        ld_offset.push_back(3);
+
+        paramter_exploder(uplo, diag, m, n, ld_offset);
+    }
+
+    static ampblas::uplo amp_uplo(enum AMPBLAS_UPLO uplo)
+    {
+        return uplo == AmpblasUpper ? ampblas::uplo::upper : ampblas::uplo::lower;
+    }
+};
+
+// C += alpha * A * A' on the n x n triangle; m is the inner dimension
+template <typename value_type>
+class host_syrk_test : public host_blas3_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "HOST_SYRK";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // no diagonal option
+        if (p.diag != AmpblasNonUnit)
+            return;
+
+        const int n = p.n;
+        const int k = p.m;
+
+        // reference data
+        test_matrix<value_type> A(n, k, n + p.ld_offset);
+        test_matrix<value_type> C(n, n, n + p.ld_offset);
+
+        // generate data
+        randomize(A);
+        randomize(C);
+
+        // host data
+        test_matrix<value_type> C_host(C);
+
+        const value_type alpha = value_type(-1);
+
+        // test references
+        start_reference_test();
+        cblas::xSYRK(cblas_cast(p.uplo), cblas::transpose::no_trans, n, k, cblas_cast(alpha), cblas_cast(A.data()), A.ld(), cblas_cast(value_type(1)), cblas_cast(C.data()), C.ld());
+        stop_reference_test();
+
+        // test host driver
+        start_ampblas_test();
+        ampblas::_detail::host_parallel_syrk(amp_uplo(p.uplo), n, k, alpha, A.data(), A.ld(), C_host.data(), C_host.ld());
+        stop_ampblas_test();
+
+        // calculate error; the other triangle is untouched by both
+        check_error(C, C_host);
+    }
+};
+
+// B = alpha * A * B with A an m x m triangle
+template <typename value_type>
+class host_trmm_test : public host_blas3_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "HOST_TRMM";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // reference data
+        test_matrix<value_type> A(p.m, p.m, p.m + p.ld_offset);
+        test_matrix<value_type> B(p.m, p.n, p.m + p.ld_offset);
+
+        // generate data
+        randomize(A);
+        randomize(B);
+
+        // host data
+        test_matrix<value_type> B_host(B);
+
+        const value_type alpha = value_type(2);
+
+        // test references
+        start_reference_test();
+        cblas::xTRMM(cblas::side::left, cblas_cast(p.uplo), cblas::transpose::no_trans, cblas_cast(p.diag), p.m, p.n, cblas_cast(alpha), cblas_cast(A.data()), A.ld(), cblas_cast(B.data()), B.ld());
+        stop_reference_test();
+
+        // test host driver
+        start_ampblas_test();
+        ampblas::_detail::host_parallel_trmm(amp_uplo(p.uplo), p.diag == AmpblasUnit ? ampblas::diag::unit : ampblas::diag::non_unit, p.m, p.n, alpha, A.data(), A.ld(), B_host.data(), B_host.ld());
+        stop_ampblas_test();
+
+        // calculate error
+        check_error(B, B_host);
+    }
+};
+
+REGISTER_TEST(host_syrk_test, float);
+REGISTER_TEST(host_syrk_test, double);
+
+REGISTER_TEST(host_trmm_test, float);
+REGISTER_TEST(host_trmm_test, double);
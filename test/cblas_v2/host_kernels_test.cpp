@@ -0,0 +1,305 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * host_kernels_test.cpp
+ *
+ * Runs the host kernel table of every instruction set level that this machine
+ * supports, not only the one selected at load time. Lengths are not multiples
+ * of any vector width so the remainder loops run, and the operands start at
+ * unaligned offsets with padded leading dimensions. The kernels only take
+ * contiguous vectors, so the padding is the stride that is exercised.
+ *
+ *---------------------------------------------------------------------------*/
+
+// c++ interfaces
+#include "ampblas.h"
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+
+// unique paramaters for the host kernels
+template <typename value_type>
+struct host_kernel_parameters
+{
+    host_kernel_parameters(int isa, int n, int offset)
+      : isa(isa), n(n), offset(offset)
+    {}
+
+    int isa;
+    int n;
+    int offset;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(isa)
+            << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(offset);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class host_kernel_test : public test_case<value_type,host_kernel_parameters>
+{
+protected:
+
+    host_kernel_test()
+    {
+        // every level; the ones this host lacks are skipped when run
+        std::vector<int> isa;
+        isa.push_back(static_cast<int>(ampblas::_detail::host_isa::generic));
+        isa.push_back(static_cast<int>(ampblas::_detail::host_isa::sse42));
+        isa.push_back(static_cast<int>(ampblas::_detail::host_isa::avx2));
+        isa.push_back(static_cast<int>(ampblas::_detail::host_isa::avx512));
+
+        // shorter than one vector, and odd lengths past several
+        std::vector<int> n;
+        n.push_back(1);
+        n.push_back(7);
+        n.push_back(33);
+        n.push_back(1023);
+
+        // element offset of each operand and padding of each leading dimension
+        std::vector<int> offset;
+        offset.push_back(0);
+        offset.push_back(1);
+        offset.push_back(3);
+
+        paramter_exploder(isa, n, offset);
+    }
+
+    // the table for the requested level; false when the host cannot run it
+    static bool get_table(const typed_parameters& p, ampblas::_detail::host_kernel_table<value_type>& table)
+    {
+        const ampblas::_detail::host_isa isa = static_cast<ampblas::_detail::host_isa>(p.isa);
+        const ampblas::_detail::host_isa supported = ampblas::_detail::select_host_isa(ampblas::_detail::detect_host_features());
+
+        if (static_cast<int>(isa) > static_cast<int>(supported))
+            return false;
+
+        table = ampblas::_detail::get_host_kernel_table<value_type>(isa);
+        return true;
+    }
+};
+
+// y += alpha * x
+template <typename value_type>
+class host_axpy_test : public host_kernel_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "HOST_AXPY";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        ampblas::_detail::host_kernel_table<value_type> table;
+        if (!get_table(p, table))
+            return;
+
+        // reference data
+        test_vector<value_type> x(p.n + p.offset);
+        test_vector<value_type> y(p.n + p.offset);
+
+        // generate data
+        randomize(x);
+        randomize(y);
+
+        // host data
+        test_vector<value_type> y_host(y);
+
+        const value_type alpha = value_type(-2);
+
+        // test references
+        start_reference_test();
+        cblas::xAXPY(p.n, cblas_cast(alpha), cblas_cast(x.data() + p.offset), 1, cblas_cast(y.data() + p.offset), 1);
+        stop_reference_test();
+
+        // test host kernel
+        start_ampblas_test();
+        table.axpy(p.n, alpha, x.data() + p.offset, y_host.data() + p.offset);
+        stop_ampblas_test();
+
+        // calculate error
+        check_error(y, y_host);
+    }
+};
+
+// x' * y
+template <typename value_type>
+class host_dot_test : public host_kernel_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "HOST_DOT";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        ampblas::_detail::host_kernel_table<value_type> table;
+        if (!get_table(p, table))
+            return;
+
+        // reference data
+        test_vector<value_type> x(p.n + p.offset);
+        test_vector<value_type> y(p.n + p.offset);
+
+        // generate data
+        randomize(x);
+        randomize(y);
+
+        // test references
+        start_reference_test();
+        value_type ref = cblas::xDOT<value_type,value_type>(p.n, x.data() + p.offset, 1, y.data() + p.offset, 1);
+        stop_reference_test();
+
+        // test host kernel
+        start_ampblas_test();
+        value_type res = table.dot(p.n, x.data() + p.offset, y.data() + p.offset);
+        stop_ampblas_test();
+
+        // calculate error
+        check_error(p.n, ref, res);
+    }
+};
+
+// y += alpha * A * x with A an n x 11 matrix
+template <typename value_type>
+class host_gemv_test : public host_kernel_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "HOST_GEMV";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        ampblas::_detail::host_kernel_table<value_type> table;
+        if (!get_table(p, table))
+            return;
+
+        const int m = p.n;
+        const int n = 11;
+
+        // reference data
+        test_matrix<value_type> A(m + p.offset, n, m + 2*p.offset);
+        test_vector<value_type> x(n + p.offset);
+        test_vector<value_type> y(m + p.offset);
+
+        // generate data
+        randomize(A);
+        randomize(x);
+        randomize(y);
+
+        // host data
+        test_vector<value_type> y_host(y);
+
+        const value_type alpha = value_type(2);
+
+        // test references
+        start_reference_test();
+        cblas::xGEMV(cblas::transpose::no_trans, m, n, alpha, A.data() + p.offset, A.ld(), x.data() + p.offset, 1, value_type(1), y.data() + p.offset, 1);
+        stop_reference_test();
+
+        // test host kernel
+        start_ampblas_test();
+        table.gemv(m, n, alpha, A.data() + p.offset, A.ld(), x.data() + p.offset, y_host.data() + p.offset);
+        stop_ampblas_test();
+
+        // calculate error
+        check_error(y, y_host);
+    }
+};
+
+// C += alpha * A * B with A an n x 19 and B a 19 x 5 matrix
+template <typename value_type>
+class host_gemm_test : public host_kernel_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "HOST_GEMM";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        ampblas::_detail::host_kernel_table<value_type> table;
+        if (!get_table(p, table))
+            return;
+
+        const int m = p.n;
+        const int n = 5;
+        const int k = 19;
+
+        // reference data
+        test_matrix<value_type> A(m + p.offset, k, m + 2*p.offset);
+        test_matrix<value_type> B(k + p.offset, n, k + 2*p.offset);
+        test_matrix<value_type> C(m + p.offset, n, m + 2*p.offset);
+
+        // generate data
+        randomize(A);
+        randomize(B);
+        randomize(C);
+
+        // host data
+        test_matrix<value_type> C_host(C);
+
+        const value_type alpha = value_type(-1);
+
+        // test references
+        start_reference_test();
+        cblas::xGEMM(cblas::transpose::no_trans, cblas::transpose::no_trans, m, n, k, alpha, A.data() + p.offset, A.ld(), B.data() + p.offset, B.ld(), value_type(1), C.data() + p.offset, C.ld());
+        stop_reference_test();
+
+        // test host kernel
+        start_ampblas_test();
+        table.gemm(m, n, k, alpha, A.data() + p.offset, A.ld(), B.data() + p.offset, B.ld(), C_host.data() + p.offset, C_host.ld());
+        stop_ampblas_test();
+
+        // calculate error
+        check_error(C, C_host);
+    }
+};
+
+REGISTER_TEST(host_axpy_test, float);
+REGISTER_TEST(host_axpy_test, double);
+
+REGISTER_TEST(host_dot_test, float);
+REGISTER_TEST(host_dot_test, double);
+
+REGISTER_TEST(host_gemv_test, float);
+REGISTER_TEST(host_gemv_test, double);
+
+REGISTER_TEST(host_gemm_test, float);
+REGISTER_TEST(host_gemm_test, double);
@@ -0,0 +1,345 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * ilp64_test.cpp
+ *
+ * Operands of these sizes fit a single segment of the default length, so each
+ * ILP64 routine makes one int sized call; these check the argument and
+ * increment handling of the 64-bit entry points against the reference. Each
+ * case also runs with the segment length of its buffers lowered so that the
+ * operands cross segment boundaries and the routines split their work.
+ *
+ *---------------------------------------------------------------------------*/
+
+// overloaded interfaces (basic tests)
+#include "ampxblas.h"
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+
+// Buffers bound while this is in scope are split into segments of length int32 elements;
+// 0 keeps the default. Declare it before the test data so it outlives the bindings.
+class segment_length_scope
+{
+public:
+    explicit segment_length_scope(int length)
+    {
+        ampcblas::_details::set_segment_length(length);
+    }
+
+    ~segment_length_scope()
+    {
+        ampcblas::_details::set_segment_length(0);
+    }
+
+private:
+    segment_length_scope(const segment_length_scope&);
+    segment_length_scope& operator=(const segment_length_scope&);
+};
+
+// unique paramaters for the level 1 routines
+template <typename value_type>
+struct level1_64_parameters
+{
+    level1_64_parameters(int n, value_type alpha, int incx, int incy, int segment_length)
+      : n(n), alpha(alpha), incx(incx), incy(incy), segment_length(segment_length)
+    {}
+
+    int n;
+    value_type alpha;
+    int incx;
+    int incy;
+    int segment_length;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(alpha)
+            << AMPBLAS_NAMED_TYPE(incx)
+            << AMPBLAS_NAMED_TYPE(incy)
+            << AMPBLAS_NAMED_TYPE(segment_length);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class level1_64_test : public test_case<value_type,level1_64_parameters>
+{
+protected:
+
+    level1_64_test()
+    {
+        std::vector<int> n;
+        n.push_back(16);
+        n.push_back(256);
+        n.push_back(2048);
+
+        std::vector<value_type> alpha;
+        alpha.push_back( value_type(1) );
+        alpha.push_back( value_type(-1) );
+
+        std::vector<int> incx;
+        incx.push_back(1);
+        incx.push_back(-1);
+        incx.push_back(2);
+
+        std::vector<int> incy;
+        incy.push_back(1);
+        incy.push_back(-1);
+        incy.push_back(2);
+
+        // 256 bytes; every vector but the shortest spans several segments
+        std::vector<int> segment_length;
+        segment_length.push_back(0);
+        segment_length.push_back(64);
+
+        paramter_exploder(n, alpha, incx, incy, segment_length);
+    }
+};
+
+template <typename value_type>
+class axpy_64_test : public level1_64_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "AXPY_64";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        const segment_length_scope segments(p.segment_length);
+
+        // reference data
+        ampblas_test_vector<value_type> x(p.n, p.incx);
+        test_vector<value_type> y(p.n, p.incy);
+
+        // generate data
+        randomize(x);
+        randomize(y);
+
+        // ampblas data
+        ampblas_test_vector<value_type> y_amp(y);
+
+        // test references
+        start_reference_test();
+        cblas::xAXPY( p.n, cblas_cast(p.alpha), cblas_cast(x.data()), x.inc(), cblas_cast(y.data()), y.inc() );
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        ampblas_xaxpy_64( p.n, ampcblas_cast(p.alpha), ampcblas_cast(x.data()), x.inc(), ampcblas_cast(y_amp.data()), y_amp.inc() );
+        stop_ampblas_test();
+
+        // synchronize outputs
+        y_amp.synchronize();
+
+        // calculate error
+        check_error(y, y_amp);
+    }
+};
+
+template <typename value_type>
+class dot_64_test : public level1_64_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "DOT_64";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        const segment_length_scope segments(p.segment_length);
+
+        // input data
+        ampblas_test_vector<value_type> x(p.n, p.incx);
+        ampblas_test_vector<value_type> y(p.n, p.incy);
+
+        // generate data
+        randomize(x);
+        randomize(y);
+
+        typedef typename cblas_type<value_type>::type cblas_type;
+        typedef typename ampcblas_type<value_type>::type ampcblas_type;
+
+        // test references
+        start_reference_test();
+        cblas_type cblas = cblas::xDOT<cblas_type,cblas_type>(p.n, cblas_cast(x.data()), x.inc(), cblas_cast(y.data()), y.inc());
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        ampcblas_type amp = ampblas_xdot_64(p.n, ampcblas_cast(x.data()), x.inc(), ampcblas_cast(y.data()), y.inc());
+        stop_ampblas_test();
+
+        // calculate error
+        value_type cblas_val = *reinterpret_cast<value_type*>(&cblas);
+        value_type amp_val   = *reinterpret_cast<value_type*>(&amp);
+        check_error(p.n, cblas_val, amp_val);
+    }
+};
+
+// unique paramaters for gemv
+template <typename value_type>
+struct gemv_64_parameters
+{
+    gemv_64_parameters(enum AMPBLAS_TRANSPOSE transa, int m, int n, int lda_offset, int incx, value_type beta, int incy, int segment_length)
+      : transa(transa), m(m), n(n), lda_offset(lda_offset), incx(incx), beta(beta), incy(incy), segment_length(segment_length)
+    {}
+
+    enum AMPBLAS_TRANSPOSE transa;
+    int m;
+    int n;
+    int lda_offset;
+    int incx;
+    value_type beta;
+    int incy;
+    int segment_length;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(transa)
+            << AMPBLAS_NAMED_TYPE(m)
+            << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(lda_offset)
+            << AMPBLAS_NAMED_TYPE(incx)
+            << AMPBLAS_NAMED_TYPE(beta)
+            << AMPBLAS_NAMED_TYPE(incy)
+            << AMPBLAS_NAMED_TYPE(segment_length);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class gemv_64_test : public test_case<value_type,gemv_64_parameters>
+{
+public:
+
+    std::string name() const
+    {
+        return "GEMV_64";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        const segment_length_scope segments(p.segment_length);
+
+        const value_type alpha = value_type(1);
+        int lda = p.m + p.lda_offset;
+
+        // reference data
+        ampblas_test_matrix<value_type> A(p.m, p.n, lda);
+        ampblas_test_vector<value_type> x((p.transa == AmpblasNoTrans ? p.n : p.m), p.incx);
+        test_vector<value_type> y((p.transa == AmpblasNoTrans ? p.m : p.n), p.incy);
+
+        // generate data
+        randomize(A);
+        randomize(x);
+        randomize(y);
+
+        // ampblas data
+        ampblas_test_vector<value_type> y_amp(y);
+
+        // test references
+        start_reference_test();
+        cblas::xGEMV(cblas_cast(p.transa), p.m, p.n, cblas_cast(alpha), cblas_cast(A.data()), A.ld(), cblas_cast(x.data()), x.inc(), cblas_cast(p.beta), cblas_cast(y.data()), y.inc());
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        ampblas_xgemv_64(AmpblasColMajor, p.transa, p.m, p.n, ampcblas_cast(alpha), ampcblas_cast(A.data()), A.ld(), ampcblas_cast(x.data()), x.inc(), ampcblas_cast(p.beta), ampcblas_cast(y_amp.data()), y_amp.inc());
+        stop_ampblas_test();
+
+        // synchronize outputs
+        y_amp.synchronize();
+
+        // calculate error
+        check_error(y, y_amp);
+    }
+
+    gemv_64_test()
+    {
+        std::vector<enum AMPBLAS_TRANSPOSE> transa;
+        transa.push_back(AmpblasNoTrans);
+        transa.push_back(AmpblasTrans);
+
+        std::vector<int> m;
+        m.push_back(16);
+        m.push_back(64);
+
+        std::vector<int> n;
+        n.push_back(16);
+        n.push_back(64);
+
+        std::vector<int> lda_offset;
+        lda_offset.push_back(0);
+        lda_offset.push_back(4);
+
+        std::vector<int> incx;
+        incx.push_back(1);
+        incx.push_back(-1);
+
+        std::vector<value_type> beta;
+        beta.push_back( value_type(1) );
+        beta.push_back( value_type(0) );
+
+        std::vector<int> incy;
+        incy.push_back(1);
+        incy.push_back(2);
+
+        // 4 KB; the larger matrices span several segments and, with a padded lda, have 
+        // columns that cross a boundary. A column and the vector that is not split still
+        // fit in one.
+        std::vector<int> segment_length;
+        segment_length.push_back(0);
+        segment_length.push_back(1024);
+
+        paramter_exploder(transa, m, n, lda_offset, incx, beta, incy, segment_length);
+    }
+};
+
+REGISTER_TEST(axpy_64_test, float);
+REGISTER_TEST(axpy_64_test, double);
+REGISTER_TEST(axpy_64_test, complex_float);
+REGISTER_TEST(axpy_64_test, complex_double);
+
+REGISTER_TEST(dot_64_test, float);
+REGISTER_TEST(dot_64_test, double);
+REGISTER_TEST(dot_64_test, complex_float);
+REGISTER_TEST(dot_64_test, complex_double);
+
+REGISTER_TEST(gemv_64_test, float);
+REGISTER_TEST(gemv_64_test, double);
+REGISTER_TEST(gemv_64_test, complex_float);
+REGISTER_TEST(gemv_64_test, complex_double);
@@ -0,0 +1,209 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * out_of_core_test.cpp
+ *
+ * The smallest budget forces 64 x 64 panels, so these sizes stream several
+ * panels per tile and finish with partial tiles in every dimension.
+ *
+ *---------------------------------------------------------------------------*/
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+// routine details
+#include "detail/out_of_core.h"
+
+#include <vector>
+#include <sstream>
+
+// unique paramaters for out-of-core gemm
+template <typename value_type>
+struct gemm_out_of_core_parameters
+{
+    gemm_out_of_core_parameters(enum AMPBLAS_TRANSPOSE transa, enum AMPBLAS_TRANSPOSE transb, int m, int n, int k, value_type beta)
+      : transa(transa), transb(transb), m(m), n(n), k(k), beta(beta)
+    {}
+
+    enum AMPBLAS_TRANSPOSE transa;
+    enum AMPBLAS_TRANSPOSE transb;
+    int m;
+    int n;
+    int k;
+    value_type beta;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(transa)
+            << AMPBLAS_NAMED_TYPE(transb)
+            << AMPBLAS_NAMED_TYPE(m)
+            << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(k)
+            << AMPBLAS_NAMED_TYPE(beta);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class out_of_core_test : public test_case<value_type,gemm_out_of_core_parameters>
+{
+protected:
+
+    out_of_core_test()
+    {
+        std::vector<enum AMPBLAS_TRANSPOSE> transa;
+        transa.push_back(AmpblasNoTrans);
+        transa.push_back(AmpblasTrans);
+
+        std::vector<enum AMPBLAS_TRANSPOSE> transb;
+        transb.push_back(AmpblasNoTrans);
+        transb.push_back(AmpblasConjTrans);
+
+        std::vector<int> m;
+        m.push_back(20);
+        m.push_back(150);
+
+        std::vector<int> n;
+        n.push_back(130);
+
+        std::vector<int> k;
+        k.push_back(40);
+        k.push_back(200);
+
+        std::vector<value_type> beta;
+        beta.push_back( value_type(-1) );
+        beta.push_back( value_type(0) );
+
+        paramter_exploder(transa, transb, m, n, k, beta);
+    }
+
+    // the smallest budget; rounded up to a single 64 x 64 block
+    static const size_t budget = 1;
+};
+
+// through the C interface, on bound operands
+template <typename value_type>
+class gemm_out_of_core_test : public out_of_core_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "GEMM_OUT_OF_CORE";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // derived parameters
+        const int row_a = (p.transa == AmpblasNoTrans ? p.m : p.k);
+        const int col_a = (p.transa == AmpblasNoTrans ? p.k : p.m);
+        const int row_b = (p.transb == AmpblasNoTrans ? p.k : p.n);
+        const int col_b = (p.transb == AmpblasNoTrans ? p.n : p.k);
+
+        const value_type alpha = value_type(2);
+
+        // reference data
+        ampblas_test_matrix<value_type> A(row_a, col_a);
+        ampblas_test_matrix<value_type> B(row_b, col_b);
+        test_matrix<value_type> C(p.m, p.n);
+
+        // generate data
+        randomize(A);
+        randomize(B);
+        randomize(C);
+
+        // ampblas data
+        ampblas_test_matrix<value_type> C_amp(C);
+
+        // test references
+        start_reference_test();
+        cblas::xGEMM(cblas_cast(p.transa), cblas_cast(p.transb), p.m, p.n, p.k, cblas_cast(alpha), cblas_cast(A.data()), A.ld(), cblas_cast(B.data()), B.ld(), cblas_cast(p.beta), cblas_cast(C.data()), C.ld());
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        ampblas_xgemm_out_of_core(AmpblasColMajor, p.transa, p.transb, p.m, p.n, p.k, ampcblas_cast(alpha), ampcblas_cast(A.data()), A.ld(), ampcblas_cast(B.data()), B.ld(), ampcblas_cast(p.beta), ampcblas_cast(C_amp.data()), C_amp.ld(), budget);
+        stop_ampblas_test();
+
+        // synchronize outputs
+        C_amp.synchronize();
+
+        // calculate error
+        check_error(C, C_amp);
+    }
+};
+
+// the host schedule
+template <typename value_type>
+class host_gemm_out_of_core_test : public out_of_core_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "HOST_GEMM_OUT_OF_CORE";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // derived parameters
+        const int row_a = (p.transa == AmpblasNoTrans ? p.m : p.k);
+        const int col_a = (p.transa == AmpblasNoTrans ? p.k : p.m);
+        const int row_b = (p.transb == AmpblasNoTrans ? p.k : p.n);
+        const int col_b = (p.transb == AmpblasNoTrans ? p.n : p.k);
+
+        const value_type alpha = value_type(2);
+
+        // reference data
+        test_matrix<value_type> A(row_a, col_a);
+        test_matrix<value_type> B(row_b, col_b);
+        test_matrix<value_type> C(p.m, p.n);
+
+        // generate data
+        randomize(A);
+        randomize(B);
+        randomize(C);
+
+        // host data
+        test_matrix<value_type> C_host(C);
+
+        // test references
+        start_reference_test();
+        cblas::xGEMM(cblas_cast(p.transa), cblas_cast(p.transb), p.m, p.n, p.k, alpha, A.data(), A.ld(), B.data(), B.ld(), p.beta, C.data(), C.ld());
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        ampblas::host::gemm_out_of_core(ampcblas::cast(p.transa), ampcblas::cast(p.transb), p.m, p.n, p.k, alpha, A.data(), A.ld(), B.data(), B.ld(), p.beta, C_host.data(), C_host.ld(), budget);
+        stop_ampblas_test();
+
+        // calculate error
+        check_error(C, C_host);
+    }
+};
+
+REGISTER_TEST(gemm_out_of_core_test, float);
+REGISTER_TEST(gemm_out_of_core_test, double);
+REGISTER_TEST(gemm_out_of_core_test, complex_float);
+REGISTER_TEST(gemm_out_of_core_test, complex_double);
+
+REGISTER_TEST(host_gemm_out_of_core_test, float);
+REGISTER_TEST(host_gemm_out_of_core_test, double);
@@ -0,0 +1,267 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * shard_test.cpp
+ *
+ * Sharded routines split the output over a list of views. The current view
+ * is listed several times so the partitioning is exercised on any machine.
+ *
+ *---------------------------------------------------------------------------*/
+
+// c++ interfaces
+#include "ampblas.h"
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+
+// unique paramaters for sharding
+template <typename value_type>
+struct shard_parameters
+{
+    shard_parameters(int shards, enum AMPBLAS_UPLO uplo, enum AMPBLAS_TRANSPOSE trans, int m, int n)
+      : shards(shards), uplo(uplo), trans(trans), m(m), n(n)
+    {}
+
+    int shards;
+    enum AMPBLAS_UPLO uplo;
+    enum AMPBLAS_TRANSPOSE trans;
+    int m;
+    int n;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(shards)
+            << AMPBLAS_NAMED_TYPE(uplo)
+            << AMPBLAS_NAMED_TYPE(trans)
+            << AMPBLAS_NAMED_TYPE(m)
+            << AMPBLAS_NAMED_TYPE(n);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class shard_test : public test_case<value_type,shard_parameters>
+{
+protected:
+
+    shard_test()
+    {
+        std::vector<int> shards;
+        shards.push_back(1);
+        shards.push_back(3);
+
+        std::vector<enum AMPBLAS_UPLO> uplo;
+        uplo.push_back(AmpblasUpper);
+        uplo.push_back(AmpblasLower);
+
+        std::vector<enum AMPBLAS_TRANSPOSE> trans;
+        trans.push_back(AmpblasNoTrans);
+        trans.push_back(AmpblasTrans);
+
+        // wide, tall and narrower than a shard
+        std::vector<int> m;
+        m.push_back(40);
+        m.push_back(150);
+
+        std::vector<int> n;
+        n.push_back(40);
+        n.push_back(150);
+
+        paramter_exploder(shards, uplo, trans, m, n);
+    }
+
+    static std::vector<concurrency::accelerator_view> views(int shards)
+    {
+        return std::vector<concurrency::accelerator_view>(shards, ampcblas::get_current_accelerator_view());
+    }
+};
+
+template <typename value_type>
+class gemm_shard_test : public shard_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "GEMM_SHARD";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // no triangle
+        if (p.uplo != AmpblasLower)
+            return;
+
+        const int k = 48;
+        const int a_rows = (p.trans == AmpblasNoTrans ? p.m : k);
+        const int a_cols = (p.trans == AmpblasNoTrans ? k : p.m);
+
+        // reference data
+        ampblas_test_matrix<value_type> A(a_rows, a_cols);
+        ampblas_test_matrix<value_type> B(k, p.n);
+        test_matrix<value_type> C(p.m, p.n);
+
+        // generate data
+        randomize(A);
+        randomize(B);
+        randomize(C);
+
+        // ampblas data
+        ampblas_test_matrix<value_type> C_amp(C);
+
+        const value_type alpha = value_type(2);
+        const value_type beta = value_type(-1);
+
+        // test references
+        start_reference_test();
+        cblas::xGEMM(cblas_cast(p.trans), cblas::transpose::no_trans, p.m, p.n, k, cblas_cast(alpha), cblas_cast(A.data()), A.ld(), cblas_cast(B.data()), B.ld(), cblas_cast(beta), cblas_cast(C.data()), C.ld());
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        ampblas::gemm(views(p.shards), p.trans == AmpblasNoTrans ? ampblas::transpose::no_trans : ampblas::transpose::trans, ampblas::transpose::no_trans, alpha,
+            ampcblas::make_matrix_view(a_rows, a_cols, A.data(), A.ld()), ampcblas::make_matrix_view(k, p.n, B.data(), B.ld()), beta, ampcblas::make_matrix_view(p.m, p.n, C_amp.data(), C_amp.ld()));
+        stop_ampblas_test();
+
+        // synchronize outputs
+        C_amp.synchronize();
+
+        // calculate error
+        check_error(C, C_amp);
+    }
+};
+
+template <typename value_type>
+class syrk_shard_test : public shard_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "SYRK_SHARD";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // square output
+        if (p.m != p.n)
+            return;
+
+        const int n = p.n;
+        const int k = 48;
+        const int a_rows = (p.trans == AmpblasNoTrans ? n : k);
+        const int a_cols = (p.trans == AmpblasNoTrans ? k : n);
+
+        // reference data
+        ampblas_test_matrix<value_type> A(a_rows, a_cols);
+        test_matrix<value_type> C(n, n);
+
+        // generate data
+        randomize(A);
+        randomize(C);
+
+        // ampblas data
+        ampblas_test_matrix<value_type> C_amp(C);
+
+        const value_type alpha = value_type(2);
+        const value_type beta = value_type(-1);
+
+        // test references
+        start_reference_test();
+        cblas::xSYRK(cblas_cast(p.uplo), cblas_cast(p.trans), n, k, cblas_cast(alpha), cblas_cast(A.data()), A.ld(), cblas_cast(beta), cblas_cast(C.data()), C.ld());
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        ampblas::syrk(views(p.shards), p.uplo == AmpblasUpper ? ampblas::uplo::upper : ampblas::uplo::lower, p.trans == AmpblasNoTrans ? ampblas::transpose::no_trans : ampblas::transpose::trans, alpha,
+            ampcblas::make_matrix_view(a_rows, a_cols, A.data(), A.ld()), beta, ampcblas::make_matrix_view(n, n, C_amp.data(), C_amp.ld()));
+        stop_ampblas_test();
+
+        // synchronize outputs
+        C_amp.synchronize();
+
+        // calculate error
+        check_error(C, C_amp);
+    }
+};
+
+template <typename value_type>
+class trsm_shard_test : public shard_test<value_type>
+{
+public:
+
+    std::string name() const
+    {
+        return "TRSM_SHARD";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // wide right hand sides are split by column, tall ones by row
+        const enum AMPBLAS_SIDE side = (p.m >= p.n ? AmpblasLeft : AmpblasRight);
+        const int k = (side == AmpblasLeft ? p.m : p.n);
+
+        // reference data
+        ampblas_test_matrix<value_type> A(k, k);
+        test_matrix<value_type> B(p.m, p.n);
+
+        // generate data
+        randomize(A, value_type(1), value_type(2));
+        randomize(B);
+
+        // ampblas data
+        ampblas_test_matrix<value_type> B_amp(B);
+
+        const value_type alpha = value_type(2);
+
+        // test references
+        start_reference_test();
+        cblas::xTRSM(cblas_cast(side), cblas_cast(p.uplo), cblas_cast(p.trans), cblas::diag::non_unit, p.m, p.n, cblas_cast(alpha), cblas_cast(A.data()), A.ld(), cblas_cast(B.data()), B.ld());
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        ampblas::trsm(views(p.shards), side == AmpblasLeft ? ampblas::side::left : ampblas::side::right, p.uplo == AmpblasUpper ? ampblas::uplo::upper : ampblas::uplo::lower, p.trans == AmpblasNoTrans ? ampblas::transpose::no_trans : ampblas::transpose::trans, ampblas::diag::non_unit, alpha,
+            ampcblas::make_matrix_view(k, k, A.data(), A.ld()), ampcblas::make_matrix_view(p.m, p.n, B_amp.data(), B_amp.ld()));
+        stop_ampblas_test();
+
+        // synchronize outputs
+        B_amp.synchronize();
+
+        // calculate error
+        check_error(B, B_amp);
+    }
+};
+
+REGISTER_TEST(gemm_shard_test, float);
+REGISTER_TEST(gemm_shard_test, double);
+
+REGISTER_TEST(syrk_shard_test, float);
+REGISTER_TEST(syrk_shard_test, double);
+
+REGISTER_TEST(trsm_shard_test, float);
+REGISTER_TEST(trsm_shard_test, double);
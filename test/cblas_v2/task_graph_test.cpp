@@ -0,0 +1,205 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * task_graph_test.cpp
+ *
+ * Records a recursive TRSM followed by a recursive SYRK that reads the solved
+ * matrix into one task graph and compares both results against the reference
+ * calls made in sequence. A small crossover splits the operands into many
+ * blocks, so the graph sees overlapping sections within each routine and a
+ * read-after-write dependency between the two; with two queues the tasks are
+ * spread over both.
+ *
+ *---------------------------------------------------------------------------*/
+
+// c++ interfaces
+#include "ampblas.h"
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+
+// unique paramaters for the task graph
+template <typename value_type>
+struct task_graph_parameters
+{
+    task_graph_parameters(int queues, enum AMPBLAS_SIDE side, enum AMPBLAS_UPLO uplo, enum AMPBLAS_TRANSPOSE trans, int m, int n)
+      : queues(queues), side(side), uplo(uplo), trans(trans), m(m), n(n)
+    {}
+
+    int queues;
+    enum AMPBLAS_SIDE side;
+    enum AMPBLAS_UPLO uplo;
+    enum AMPBLAS_TRANSPOSE trans;
+    int m;
+    int n;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(queues)
+            << AMPBLAS_NAMED_TYPE(side)
+            << AMPBLAS_NAMED_TYPE(uplo)
+            << AMPBLAS_NAMED_TYPE(trans)
+            << AMPBLAS_NAMED_TYPE(m)
+            << AMPBLAS_NAMED_TYPE(n);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class task_graph_test : public test_case<value_type,task_graph_parameters>
+{
+public:
+
+    std::string name() const
+    {
+        return "TASK_GRAPH";
+    }
+
+    bool requires_full_double() const
+    {
+        // uses division
+        return true;
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // derived parameters
+        const int k = (p.side == AmpblasLeft ? p.m : p.n);
+        const int c_n = (p.trans == AmpblasNoTrans ? p.m : p.n);
+        const int c_k = (p.trans == AmpblasNoTrans ? p.n : p.m);
+
+        // reference data
+        ampblas_test_matrix<value_type> A(k, k);
+        test_matrix<value_type> B(p.m, p.n);
+        test_matrix<value_type> C(c_n, c_n);
+
+        // generate data
+        randomize(A, value_type(1), value_type(2));
+        randomize(B);
+        randomize(C);
+
+        // scale the off diagonal so the solve stays bounded
+        for (int i=0; i<k; i++)
+        {
+            value_type Aii = A(i,i);
+            A(i,i) = value_type(1);
+            real_type scale = cblas::xNRM2(k, cblas_cast(A.data()+i*A.ld()), 1);
+            cblas::xSCAL(k, real_type(1)/scale, cblas_cast(A.data()+i*A.ld()), 1);
+            A(i,i) = Aii;
+        }
+
+        // ampblas data
+        ampblas_test_matrix<value_type> B_amp(B);
+        ampblas_test_matrix<value_type> C_amp(C);
+
+        const value_type alpha = value_type(2);
+        const value_type beta = value_type(-1);
+
+        const ampblas::side side = (p.side == AmpblasLeft ? ampblas::side::left : ampblas::side::right);
+        const ampblas::uplo uplo = (p.uplo == AmpblasUpper ? ampblas::uplo::upper : ampblas::uplo::lower);
+        const ampblas::transpose trans = (p.trans == AmpblasNoTrans ? ampblas::transpose::no_trans : ampblas::transpose::trans);
+
+        // test references
+        start_reference_test();
+        cblas::xTRSM(cblas_cast(p.side), cblas_cast(p.uplo), cblas_cast(p.trans), cblas::diag::non_unit, p.m, p.n, cblas_cast(alpha), cblas_cast(A.data()), A.ld(), cblas_cast(B.data()), B.ld());
+        cblas::xSYRK(cblas_cast(p.uplo), cblas_cast(p.trans), c_n, c_k, cblas_cast(alpha), cblas_cast(B.data()), B.ld(), cblas_cast(beta), cblas_cast(C.data()), C.ld());
+        stop_reference_test();
+
+        // test ampblas
+        start_ampblas_test();
+        {
+            ampblas::task_graph graph(graph_queues(p.queues));
+
+            auto a = graph.track(ampcblas::make_matrix_view(k, k, A.data(), A.ld()));
+            auto b = graph.track(ampcblas::make_matrix_view(p.m, p.n, B_amp.data(), B_amp.ld()));
+            auto c = graph.track(ampcblas::make_matrix_view(c_n, c_n, C_amp.data(), C_amp.ld()));
+
+            ampblas::_detail::recursive_trsm<crossover>(graph, side, uplo, trans, ampblas::diag::non_unit, p.m, p.n, alpha, a, b);
+            ampblas::_detail::recursive_syrk<crossover, ampblas::_detail::noop>(graph, uplo, trans, c_n, c_k, alpha, b, beta, c);
+
+            graph.wait();
+        }
+        stop_ampblas_test();
+
+        // synchronize outputs
+        B_amp.synchronize();
+        C_amp.synchronize();
+
+        // calculate error
+        check_error(B, B_amp);
+        check_error(C, C_amp);
+    }
+
+    task_graph_test()
+    {
+        std::vector<int> queues;
+        queues.push_back(1);
+        queues.push_back(2);
+
+        std::vector<enum AMPBLAS_SIDE> side;
+        side.push_back(AmpblasLeft);
+        side.push_back(AmpblasRight);
+
+        std::vector<enum AMPBLAS_UPLO> uplo;
+        uplo.push_back(AmpblasUpper);
+        uplo.push_back(AmpblasLower);
+
+        std::vector<enum AMPBLAS_TRANSPOSE> trans;
+        trans.push_back(AmpblasNoTrans);
+        trans.push_back(AmpblasTrans);
+
+        // one uneven split, and several levels of them
+        std::vector<int> m;
+        m.push_back(24);
+        m.push_back(100);
+
+        std::vector<int> n;
+        n.push_back(24);
+        n.push_back(100);
+
+        paramter_exploder(queues, side, uplo, trans, m, n);
+    }
+
+private:
+
+    // recursive crossover; small enough that the test sizes split into many tasks
+    static const int crossover = 16;
+
+    // the current view, and a second queue on the same accelerator
+    static std::vector<concurrency::accelerator_view> graph_queues(int count)
+    {
+        const concurrency::accelerator_view av = ampcblas::get_current_accelerator_view();
+
+        std::vector<concurrency::accelerator_view> ret(1, av);
+        for (int i=1; i<count; i++)
+            ret.push_back(av.accelerator.create_view(av.queuing_mode));
+        return ret;
+    }
+};
+
+REGISTER_TEST(task_graph_test, float);
+REGISTER_TEST(task_graph_test, double);
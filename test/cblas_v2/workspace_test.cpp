@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * workspace_test.cpp
+ *
+ * Repeated reductions drawing their partial results from the workspace pool:
+ * every call must match the reference, and once the first call has created
+ * the block no further accelerator allocations may happen.
+ *
+ *---------------------------------------------------------------------------*/
+
+// overloaded interfaces (basic tests)
+#include "ampxblas.h"
+
+// c++ interfaces
+#include "ampblas.h"
+
+// cblas reference impletnation
+#include "cblas_wrapper.h"
+
+// testing headers
+#include "ampblas_test_bench.h"
+#include "ampblas_test_util.h"
+
+#include <vector>
+#include <sstream>
+
+// unique paramaters for workspace
+template <typename value_type>
+struct workspace_parameters
+{
+    workspace_parameters(int n, int calls)
+      : n(n), calls(calls)
+    {}
+
+    int n;
+    int calls;
+
+    std::string name() const
+    {
+        std::stringstream out;
+
+        out << AMPBLAS_NAMED_TYPE(n)
+            << AMPBLAS_NAMED_TYPE(calls);
+
+        return out.str();
+    }
+
+};
+
+template <typename value_type>
+class workspace_test : public test_case<value_type,workspace_parameters>
+{
+public:
+
+    std::string name() const
+    {
+        return "WORKSPACE";
+    }
+
+    void run_cblas_test(const typed_parameters& p)
+    {
+        // input data
+        ampblas_test_vector<value_type> x(p.n);
+        ampblas_test_vector<value_type> y(p.n);
+
+        // generate data
+        randomize(x);
+        randomize(y);
+
+        // test references
+        start_reference_test();
+        value_type cblas = cblas::xDOT<value_type,value_type>(p.n, cblas_cast(x.data()), x.inc(), cblas_cast(y.data()), y.inc());
+        stop_reference_test();
+
+        const concurrency::accelerator_view av = ampcblas::get_current_accelerator_view();
+
+        // the first call may have to create the block
+        value_type amp = ampblas_xdot(p.n, x.data(), x.inc(), y.data(), y.inc());
+        check_error(p.n, cblas, amp);
+
+        // test ampblas
+        const ampblas::workspace_stats before = ampblas::get_workspace_stats(av);
+        start_ampblas_test();
+        for (int i = 0; i < p.calls; i++)
+        {
+            amp = ampblas_xdot(p.n, x.data(), x.inc(), y.data(), y.inc());
+            check_error(p.n, cblas, amp);
+        }
+        stop_ampblas_test();
+        const ampblas::workspace_stats after = ampblas::get_workspace_stats(av);
+
+        // every block was served from the pool and returned to it
+        if (after.allocations != before.allocations || after.bytes_in_use != before.bytes_in_use)
+            ampblas_test_runtime_error(AMPBLAS_INTERNAL_ERROR);
+    }
+
+    workspace_test()
+    {
+        // bulk test example
+        std::vector<int> n;
+        n.push_back(16);
+        n.push_back(256);
+        n.push_back(65536);
+
+        std::vector<int> calls;
+        calls.push_back(1);
+        calls.push_back(32);
+
+        paramter_exploder(n, calls);
+    }
+};
+
+REGISTER_TEST(workspace_test, float);
+REGISTER_TEST(workspace_test, double);
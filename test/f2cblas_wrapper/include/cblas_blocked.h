@@ -0,0 +1,69 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License.  You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE,
+ * MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * cblas_blocked.h
+ *
+ * Cache blocked, multi-threaded host kernels used by the reference wrapper
+ * to verify large problems. The F2C translated routines remain the bit-level
+ * reference for small problems.
+ *
+ *---------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef CBLAS_BLOCKED_H
+#define CBLAS_BLOCKED_H
+
+#include <functional>
+
+#include "cblas_wrapper.h"
+
+namespace cblas {
+namespace blocked {
+
+    // ------------------------------------------------------------------------
+    // Tuning
+    // ------------------------------------------------------------------------
+
+    // blocking factors for the packed GEMM kernel (in elements)
+    static const int m_block = 128;
+    static const int n_block = 128;
+    static const int k_block = 256;
+
+    // columns (or rows) handed to each task when splitting independent panels
+    static const int panel_size = 64;
+
+    // ------------------------------------------------------------------------
+    // Parallel Helpers
+    // ------------------------------------------------------------------------
+
+    // splits [0,n) into chunks of at most panel and invokes func(offset, count)
+    // on each chunk using the host thread pool
+    void parallel_panels( int n, int panel, const std::function<void(int,int)>& func );
+
+    // ------------------------------------------------------------------------
+    // BLAS 3
+    // ------------------------------------------------------------------------
+
+    // GEMM
+    void gemm( enum class transpose TRANSA, enum class transpose TRANSB, int M, int N, int K, float          ALPHA, const float*          A, int LDA, const float*          B, int LDB, float          BETA, float*          C, int LDC );
+    void gemm( enum class transpose TRANSA, enum class transpose TRANSB, int M, int N, int K, double         ALPHA, const double*         A, int LDA, const double*         B, int LDB, double         BETA, double*         C, int LDC );
+    void gemm( enum class transpose TRANSA, enum class transpose TRANSB, int M, int N, int K, complex_float  ALPHA, const complex_float*  A, int LDA, const complex_float*  B, int LDB, complex_float  BETA, complex_float*  C, int LDC );
+    void gemm( enum class transpose TRANSA, enum class transpose TRANSB, int M, int N, int K, complex_double ALPHA, const complex_double* A, int LDA, const complex_double* B, int LDB, complex_double BETA, complex_double* C, int LDC );
+
+} // namespace blocked
+} // namespace cblas
+
+#endif // CBLAS_BLOCKED_H
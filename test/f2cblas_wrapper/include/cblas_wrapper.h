@@ -58,6 +58,22 @@ namespace cblas {
 	enum class diag {non_unit, unit};
 	enum class side {left, right};
 
+    // ------------------------------------------------------------------------
+    // Verification Backend
+    // ------------------------------------------------------------------------
+
+    // f2c:       single threaded F2C translated reference (bit-level reference)
+    // blocked:   cache blocked, multi-threaded host kernels
+    // automatic: blocked kernels once the problem exceeds the blocked threshold
+    enum class reference_backend {f2c, blocked, automatic};
+
+    void set_reference_backend( enum class reference_backend backend );
+    enum class reference_backend get_reference_backend();
+
+    // number of multiply-adds above which the automatic backend uses the blocked kernels
+    void set_blocked_threshold( double flops );
+    double get_blocked_threshold();
+
     // ------------------------------------------------------------------------
     // BLAS 1
     // ------------------------------------------------------------------------
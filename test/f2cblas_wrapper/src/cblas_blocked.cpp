@@ -0,0 +1,178 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * cblas_blocked.cpp
+ *
+ * Cache blocked, multi-threaded host kernels used to verify large problems.
+ * Operands are packed into contiguous blocks so the inner product loop runs
+ * over unit stride memory, and independent blocks of C are distributed over
+ * the Concurrency Runtime's work-stealing scheduler.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <complex>
+#include <vector>
+#include <algorithm>
+
+#include <ppl.h>
+
+#include "cblas_blocked.h"
+
+namespace cblas {
+namespace blocked {
+
+    // ------------------------------------------------------------------------
+    // Type Adapters
+    // ------------------------------------------------------------------------
+
+    // cblas::complex is layout compatible with std::complex
+    template <typename T> struct host_type                 { typedef T                    type; };
+    template <>           struct host_type<complex_float>  { typedef std::complex<float>  type; };
+    template <>           struct host_type<complex_double> { typedef std::complex<double> type; };
+
+    template <typename T> inline typename host_type<T>::type* host_cast( T* ptr ) { return reinterpret_cast<typename host_type<T>::type*>(ptr); }
+    template <typename T> inline const typename host_type<T>::type* host_cast( const T* ptr ) { return reinterpret_cast<const typename host_type<T>::type*>(ptr); }
+    template <typename T> inline typename host_type<T>::type host_cast( const T& val ) { return *reinterpret_cast<const typename host_type<T>::type*>(&val); }
+
+    template <typename T> inline T conjugate( const T& val ) { return val; }
+    template <typename T> inline std::complex<T> conjugate( const std::complex<T>& val ) { return std::conj(val); }
+
+    // element (i,l) of op(A) where A is column major
+    template <typename T>
+    inline T op_element( enum class transpose trans, const T* A, int LDA, int i, int l )
+    {
+        if (trans == transpose::no_trans)
+            return A[i + l*LDA];
+        else if (trans == transpose::trans)
+            return A[l + i*LDA];
+        else
+            return conjugate(A[l + i*LDA]);
+    }
+
+    // ------------------------------------------------------------------------
+    // Parallel Helpers
+    // ------------------------------------------------------------------------
+
+    void parallel_panels( int n, int panel, const std::function<void(int,int)>& func )
+    {
+        if (n <= 0)
+            return;
+
+        const int panels = (n + panel - 1) / panel;
+
+        concurrency::parallel_for(0, panels, [&](int p)
+        {
+            const int offset = p * panel;
+            func(offset, std::min(panel, n - offset));
+        });
+    }
+
+    // ------------------------------------------------------------------------
+    // GEMM
+    // ------------------------------------------------------------------------
+
+    // C = beta * C on a column major M x N matrix; beta == 0 clears C without reading it
+    template <typename T>
+    void scale( int M, int N, T BETA, T* C, int LDC )
+    {
+        parallel_panels(N, panel_size, [=](int offset, int count)
+        {
+            for (int j=offset; j<offset+count; j++)
+                for (int i=0; i<M; i++)
+                    C[i + j*LDC] = (BETA == T() ? T() : BETA * C[i + j*LDC]);
+        });
+    }
+
+    template <typename T>
+    void gemm_kernel( enum class transpose TRANSA, enum class transpose TRANSB, int M, int N, int K, T ALPHA, const T* A, int LDA, const T* B, int LDB, T BETA, T* C, int LDC )
+    {
+        // quick return
+        if (M == 0 || N == 0)
+            return;
+
+        if (ALPHA == T() || K == 0)
+        {
+            if (BETA != T(1))
+                scale(M, N, BETA, C, LDC);
+            return;
+        }
+
+        const int m_tiles = (M + m_block - 1) / m_block;
+        const int n_tiles = (N + n_block - 1) / n_block;
+
+        // each task owns one [m_block x n_block] tile of C, so no synchronization is required
+        concurrency::parallel_for(0, m_tiles * n_tiles, [=](int tile)
+        {
+            const int i0 = (tile % m_tiles) * m_block;
+            const int j0 = (tile / m_tiles) * n_block;
+            const int mb = std::min(m_block, M - i0);
+            const int nb = std::min(n_block, N - j0);
+
+            // packed operands; rows of op(A) and columns of op(B) are stored contiguously
+            std::vector<T> a_pack(m_block * k_block);
+            std::vector<T> b_pack(n_block * k_block);
+            std::vector<T> c_tile(m_block * n_block, T());
+
+            for (int l0=0; l0<K; l0+=k_block)
+            {
+                const int kb = std::min(k_block, K - l0);
+
+                // pack op(A)(i0:i0+mb, l0:l0+kb)
+                for (int l=0; l<kb; l++)
+                    for (int i=0; i<mb; i++)
+                        a_pack[i*k_block + l] = op_element(TRANSA, A, LDA, i0+i, l0+l);
+
+                // pack op(B)(l0:l0+kb, j0:j0+nb)
+                for (int j=0; j<nb; j++)
+                    for (int l=0; l<kb; l++)
+                        b_pack[j*k_block + l] = op_element(TRANSB, B, LDB, l0+l, j0+j);
+
+                // accumulate the block product
+                for (int j=0; j<nb; j++)
+                {
+                    const T* b_col = &b_pack[j*k_block];
+                    for (int i=0; i<mb; i++)
+                    {
+                        const T* a_row = &a_pack[i*k_block];
+
+                        T sum = T();
+                        for (int l=0; l<kb; l++)
+                            sum += a_row[l] * b_col[l];
+
+                        c_tile[i + j*m_block] += sum;
+                    }
+                }
+            }
+
+            // write back with the usual BLAS scaling; beta == 0 must not read C
+            for (int j=0; j<nb; j++)
+            {
+                for (int i=0; i<mb; i++)
+                {
+                    T& c = C[(i0+i) + (j0+j)*LDC];
+                    c = (BETA == T() ? ALPHA * c_tile[i + j*m_block] : ALPHA * c_tile[i + j*m_block] + BETA * c);
+                }
+            }
+        });
+    }
+
+    void gemm( enum class transpose TRANSA, enum class transpose TRANSB, int M, int N, int K, float          ALPHA, const float*          A, int LDA, const float*          B, int LDB, float          BETA, float*          C, int LDC ) { gemm_kernel(TRANSA, TRANSB, M, N, K, ALPHA, A, LDA, B, LDB, BETA, C, LDC); }
+    void gemm( enum class transpose TRANSA, enum class transpose TRANSB, int M, int N, int K, double         ALPHA, const double*         A, int LDA, const double*         B, int LDB, double         BETA, double*         C, int LDC ) { gemm_kernel(TRANSA, TRANSB, M, N, K, ALPHA, A, LDA, B, LDB, BETA, C, LDC); }
+    void gemm( enum class transpose TRANSA, enum class transpose TRANSB, int M, int N, int K, complex_float  ALPHA, const complex_float*  A, int LDA, const complex_float*  B, int LDB, complex_float  BETA, complex_float*  C, int LDC ) { gemm_kernel(TRANSA, TRANSB, M, N, K, host_cast(ALPHA), host_cast(A), LDA, host_cast(B), LDB, host_cast(BETA), host_cast(C), LDC); }
+    void gemm( enum class transpose TRANSA, enum class transpose TRANSB, int M, int N, int K, complex_double ALPHA, const complex_double* A, int LDA, const complex_double* B, int LDB, complex_double BETA, complex_double* C, int LDC ) { gemm_kernel(TRANSA, TRANSB, M, N, K, host_cast(ALPHA), host_cast(A), LDA, host_cast(B), LDB, host_cast(BETA), host_cast(C), LDC); }
+
+} // namespace blocked
+} // namespace cblas
@@ -23,6 +23,7 @@
  *---------------------------------------------------------------------------*/
 
 #include "cblas_wrapper.h"
+#include "cblas_blocked.h"
 
 namespace f2c_cblas {
 
@@ -33,6 +34,24 @@ namespace f2c_cblas {
 
 namespace cblas {
 
+    // ------------------------------------------------------------------------
+    // Verification Backend
+    // ------------------------------------------------------------------------
+
+    static enum class reference_backend g_backend = reference_backend::automatic;
+    static double g_blocked_threshold = 512.0 * 512.0 * 512.0;
+
+    void set_reference_backend( enum class reference_backend backend ) { g_backend = backend; }
+    enum class reference_backend get_reference_backend() { return g_backend; }
+
+    void set_blocked_threshold( double flops ) { g_blocked_threshold = flops; }
+    double get_blocked_threshold() { return g_blocked_threshold; }
+
+    inline bool use_blocked( double flops )
+    {
+        return g_backend == reference_backend::blocked || (g_backend == reference_backend::automatic && flops >= g_blocked_threshold);
+    }
+
 	// ------------------------------------------------------------------------
 	// F2C CBLAS Type Adapters
 	// ------------------------------------------------------------------------
@@ -240,23 +259,39 @@ namespace cblas {
 	// BLAS 3
 	// ------------------------------------------------------------------------
 
+    // TRMM and TRSM act on the columns (side left) or rows (side right) of B
+    // independently, so large problems are split into panels that are each
+    // handed to the F2C routine; the result is bit-identical to a single call
+    template <typename T, typename Func>
+    void triangular_panels( enum class side SIDE, int M, int N, T* B, int LDB, const Func& func )
+    {
+        const double flops = (SIDE == side::left ? double(M)*M*N : double(M)*N*N);
+
+        if (!use_blocked(flops))
+            func(M, N, B);
+        else if (SIDE == side::left)
+            blocked::parallel_panels(N, blocked::panel_size, [&](int offset, int count) { func(M, count, B + offset*LDB); });
+        else
+            blocked::parallel_panels(M, blocked::panel_size, [&](int offset, int count) { func(count, N, B + offset); });
+    }
+
 	// GEMM
-	void SGEMM( enum class transpose TRANSA, enum class transpose TRANBS, int M, int N, int K, float          ALPHA, float*          A, int LDA, float*          B, int LDB, float          beta, float*          C, int LDC ) { f2c_cblas::sgemm_( Option(TRANSA), Option(TRANBS), Integer(M), Integer(N), Integer(K), Real(ALPHA),          Real(A),          Integer(LDA), Real(B),          Integer(LDB), Real(beta),          Real(C),          Integer(LDC) ); }
-	void DGEMM( enum class transpose TRANSA, enum class transpose TRANBS, int M, int N, int K, double         ALPHA, double*         A, int LDA, double*         B, int LDB, double         beta, double*         C, int LDC ) { f2c_cblas::dgemm_( Option(TRANSA), Option(TRANBS), Integer(M), Integer(N), Integer(K), DoubleReal(ALPHA),    DoubleReal(A),    Integer(LDA), DoubleReal(B),    Integer(LDB), DoubleReal(beta),    DoubleReal(C),    Integer(LDC) ); }
-    void CGEMM( enum class transpose TRANSA, enum class transpose TRANBS, int M, int N, int K, complex_float  ALPHA, complex_float*  A, int LDA, complex_float*  B, int LDB, complex_float  beta, complex_float*  C, int LDC ) { f2c_cblas::cgemm_( Option(TRANSA), Option(TRANBS), Integer(M), Integer(N), Integer(K), Complex(ALPHA),       Complex(A),       Integer(LDA), Complex(B),       Integer(LDB), Complex(beta),       Complex(C),       Integer(LDC) ); }
-	void ZGEMM( enum class transpose TRANSA, enum class transpose TRANBS, int M, int N, int K, complex_double ALPHA, complex_double* A, int LDA, complex_double* B, int LDB, complex_double beta, complex_double* C, int LDC ) { f2c_cblas::zgemm_( Option(TRANSA), Option(TRANBS), Integer(M), Integer(N), Integer(K), DoubleComplex(ALPHA), DoubleComplex(A), Integer(LDA), DoubleComplex(B), Integer(LDB), DoubleComplex(beta), DoubleComplex(C), Integer(LDC) ); }
+	void SGEMM( enum class transpose TRANSA, enum class transpose TRANBS, int M, int N, int K, float          ALPHA, float*          A, int LDA, float*          B, int LDB, float          beta, float*          C, int LDC ) { if (use_blocked(double(M)*N*K)) { blocked::gemm(TRANSA, TRANBS, M, N, K, ALPHA, A, LDA, B, LDB, beta, C, LDC); return; } f2c_cblas::sgemm_( Option(TRANSA), Option(TRANBS), Integer(M), Integer(N), Integer(K), Real(ALPHA),          Real(A),          Integer(LDA), Real(B),          Integer(LDB), Real(beta),          Real(C),          Integer(LDC) ); }
+	void DGEMM( enum class transpose TRANSA, enum class transpose TRANBS, int M, int N, int K, double         ALPHA, double*         A, int LDA, double*         B, int LDB, double         beta, double*         C, int LDC ) { if (use_blocked(double(M)*N*K)) { blocked::gemm(TRANSA, TRANBS, M, N, K, ALPHA, A, LDA, B, LDB, beta, C, LDC); return; } f2c_cblas::dgemm_( Option(TRANSA), Option(TRANBS), Integer(M), Integer(N), Integer(K), DoubleReal(ALPHA),    DoubleReal(A),    Integer(LDA), DoubleReal(B),    Integer(LDB), DoubleReal(beta),    DoubleReal(C),    Integer(LDC) ); }
+    void CGEMM( enum class transpose TRANSA, enum class transpose TRANBS, int M, int N, int K, complex_float  ALPHA, complex_float*  A, int LDA, complex_float*  B, int LDB, complex_float  beta, complex_float*  C, int LDC ) { if (use_blocked(double(M)*N*K)) { blocked::gemm(TRANSA, TRANBS, M, N, K, ALPHA, A, LDA, B, LDB, beta, C, LDC); return; } f2c_cblas::cgemm_( Option(TRANSA), Option(TRANBS), Integer(M), Integer(N), Integer(K), Complex(ALPHA),       Complex(A),       Integer(LDA), Complex(B),       Integer(LDB), Complex(beta),       Complex(C),       Integer(LDC) ); }
+	void ZGEMM( enum class transpose TRANSA, enum class transpose TRANBS, int M, int N, int K, complex_double ALPHA, complex_double* A, int LDA, complex_double* B, int LDB, complex_double beta, complex_double* C, int LDC ) { if (use_blocked(double(M)*N*K)) { blocked::gemm(TRANSA, TRANBS, M, N, K, ALPHA, A, LDA, B, LDB, beta, C, LDC); return; } f2c_cblas::zgemm_( Option(TRANSA), Option(TRANBS), Integer(M), Integer(N), Integer(K), DoubleComplex(ALPHA), DoubleComplex(A), Integer(LDA), DoubleComplex(B), Integer(LDB), DoubleComplex(beta), DoubleComplex(C), Integer(LDC) ); }
 
     // TRMM
-	void STRMM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, float          ALPHA, float*          A, int LDA, float*          B, int LDB ) { f2c_cblas::strmm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(M), Integer(N), Real(ALPHA),		     Real(A),          Integer(LDA), Real(B),          Integer(LDB) ); }
-	void DTRMM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, double         ALPHA, double*         A, int LDA, double*         B, int LDB ) { f2c_cblas::dtrmm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(M), Integer(N), DoubleReal(ALPHA),    DoubleReal(A),    Integer(LDA), DoubleReal(B),    Integer(LDB) ); }
-    void CTRMM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, complex_float  ALPHA, complex_float*  A, int LDA, complex_float*  B, int LDB ) { f2c_cblas::ctrmm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(M), Integer(N), Complex(ALPHA),		 Complex(A),       Integer(LDA), Complex(B),       Integer(LDB) ); }
-	void ZTRMM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, complex_double ALPHA, complex_double* A, int LDA, complex_double* B, int LDB ) { f2c_cblas::ztrmm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(M), Integer(N), DoubleComplex(ALPHA), DoubleComplex(A), Integer(LDA), DoubleComplex(B), Integer(LDB) ); }
+	void STRMM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, float          ALPHA, float*          A, int LDA, float*          B, int LDB ) { triangular_panels(SIDE, M, N, B, LDB, [&](int m, int n, float* b) { f2c_cblas::strmm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(m), Integer(n), Real(ALPHA),		     Real(A),          Integer(LDA), Real(b),          Integer(LDB) ); }); }
+	void DTRMM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, double         ALPHA, double*         A, int LDA, double*         B, int LDB ) { triangular_panels(SIDE, M, N, B, LDB, [&](int m, int n, double* b) { f2c_cblas::dtrmm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(m), Integer(n), DoubleReal(ALPHA),    DoubleReal(A),    Integer(LDA), DoubleReal(b),    Integer(LDB) ); }); }
+    void CTRMM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, complex_float  ALPHA, complex_float*  A, int LDA, complex_float*  B, int LDB ) { triangular_panels(SIDE, M, N, B, LDB, [&](int m, int n, complex_float* b) { f2c_cblas::ctrmm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(m), Integer(n), Complex(ALPHA),		 Complex(A),       Integer(LDA), Complex(b),       Integer(LDB) ); }); }
+	void ZTRMM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, complex_double ALPHA, complex_double* A, int LDA, complex_double* B, int LDB ) { triangular_panels(SIDE, M, N, B, LDB, [&](int m, int n, complex_double* b) { f2c_cblas::ztrmm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(m), Integer(n), DoubleComplex(ALPHA), DoubleComplex(A), Integer(LDA), DoubleComplex(b), Integer(LDB) ); }); }
 
 	// TRSM
-	void STRSM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, float          ALPHA, float*          A, int LDA, float*          B, int LDB ) { f2c_cblas::strsm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(M), Integer(N), Real(ALPHA),		     Real(A),          Integer(LDA), Real(B),          Integer(LDB) ); }
-	void DTRSM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, double         ALPHA, double*         A, int LDA, double*         B, int LDB ) { f2c_cblas::dtrsm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(M), Integer(N), DoubleReal(ALPHA),    DoubleReal(A),    Integer(LDA), DoubleReal(B),    Integer(LDB) ); }
-    void CTRSM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, complex_float  ALPHA, complex_float*  A, int LDA, complex_float*  B, int LDB ) { f2c_cblas::ctrsm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(M), Integer(N), Complex(ALPHA),		 Complex(A),       Integer(LDA), Complex(B),       Integer(LDB) ); }
-	void ZTRSM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, complex_double ALPHA, complex_double* A, int LDA, complex_double* B, int LDB ) { f2c_cblas::ztrsm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(M), Integer(N), DoubleComplex(ALPHA), DoubleComplex(A), Integer(LDA), DoubleComplex(B), Integer(LDB) ); }
+	void STRSM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, float          ALPHA, float*          A, int LDA, float*          B, int LDB ) { triangular_panels(SIDE, M, N, B, LDB, [&](int m, int n, float* b) { f2c_cblas::strsm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(m), Integer(n), Real(ALPHA),		     Real(A),          Integer(LDA), Real(b),          Integer(LDB) ); }); }
+	void DTRSM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, double         ALPHA, double*         A, int LDA, double*         B, int LDB ) { triangular_panels(SIDE, M, N, B, LDB, [&](int m, int n, double* b) { f2c_cblas::dtrsm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(m), Integer(n), DoubleReal(ALPHA),    DoubleReal(A),    Integer(LDA), DoubleReal(b),    Integer(LDB) ); }); }
+    void CTRSM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, complex_float  ALPHA, complex_float*  A, int LDA, complex_float*  B, int LDB ) { triangular_panels(SIDE, M, N, B, LDB, [&](int m, int n, complex_float* b) { f2c_cblas::ctrsm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(m), Integer(n), Complex(ALPHA),		 Complex(A),       Integer(LDA), Complex(b),       Integer(LDB) ); }); }
+	void ZTRSM( enum class side SIDE, enum class uplo UPLO, enum class transpose TRANSA, enum class diag DIAG, int M, int N, complex_double ALPHA, complex_double* A, int LDA, complex_double* B, int LDB ) { triangular_panels(SIDE, M, N, B, LDB, [&](int m, int n, complex_double* b) { f2c_cblas::ztrsm_( Option(SIDE), Option(UPLO), Option(TRANSA), Option(DIAG), Integer(m), Integer(n), DoubleComplex(ALPHA), DoubleComplex(A), Integer(LDA), DoubleComplex(b), Integer(LDB) ); }); }
 	
     // SYMM
 	void SSYMM( enum class side SIDE, enum class uplo UPLO, int M, int N, float  ALPHA, float*  A, int LDA, float*  B, int LDB, float  BETA, float*  C, int LDC) { f2c_cblas::ssymm_( Option(SIDE), Option(UPLO), Integer(M), Integer(N), Real(ALPHA),       Real(A),       Integer(LDA), Real(B),       Integer(LDB), Real(BETA),       Real(C),       Integer(LDC)); }
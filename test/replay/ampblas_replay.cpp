@@ -0,0 +1,577 @@
+/*----------------------------------------------------------------------------
+ * Copyright  Microsoft Corp.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not 
+ * use this file except in compliance with the License.  You may obtain a copy 
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0  
+ * 
+ * THIS CODE IS PROVIDED *AS IS* BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION ANY IMPLIED 
+ * WARRANTIES OR CONDITIONS OF TITLE, FITNESS FOR A PARTICULAR PURPOSE, 
+ * MERCHANTABLITY OR NON-INFRINGEMENT. 
+ *
+ * See the Apache Version 2.0 License for specific language governing 
+ * permissions and limitations under the License.
+ *---------------------------------------------------------------------------
+ *
+ * ampblas_replay.cpp
+ *
+ * Runs the calls of a trace recorded with ampblas_set_trace_file or the
+ * AMPBLAS_TRACE environment variable again, with the same shapes and options
+ * on synthetic data, and reports the time spent in each routine.
+ *
+ *   ampblas_replay trace.csv [--dispatch accelerator|host|auto] [--device n] [--repeat n]
+ *
+ * The dispatch mode selects where the routines with host kernels run and
+ * --device the accelerator, numbered as by concurrency::accelerator::get_all,
+ * so a trace captured on one machine can be timed on any backend. One pass
+ * over the trace runs untimed before the timed ones. The operands are bound
+ * buffers that stay resident between calls, so the times exclude the host
+ * transfers of unbound callers, and the results are not checked.
+ *
+ *---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <amp.h>
+
+#include "ampcblas.h"
+#include "ampcblas_runtime.h"
+
+namespace {
+
+// a line of the trace
+struct record
+{
+    std::string routine;
+    char type, order, trans_a, trans_b, uplo, side, diag;
+    ampblas_int64 m, n, k;
+    ampblas_int64 lda, ldb, ldc;
+    ampblas_int64 incx, incy;
+    double time_us;
+};
+
+// the synthetic operands, large enough for every call of the trace
+struct operands
+{
+    void *a, *b, *c, *x, *y;
+};
+
+typedef std::function<void(const record&, const operands&)> replayer;
+
+bool parse(const std::string& line, record& r)
+{
+    std::vector<std::string> fields;
+    std::istringstream in(line);
+    std::string field;
+    while (std::getline(in, field, ','))
+        fields.push_back(field);
+
+    if (fields.size() != 17 || fields[1].size() != 1)
+        return false;
+
+    r.routine = fields[0];
+    r.type    = fields[1][0];
+    r.order   = fields[2][0];
+    r.trans_a = fields[3][0];
+    r.trans_b = fields[4][0];
+    r.uplo    = fields[5][0];
+    r.side    = fields[6][0];
+    r.diag    = fields[7][0];
+    r.m   = _atoi64(fields[8].c_str());
+    r.n   = _atoi64(fields[9].c_str());
+    r.k   = _atoi64(fields[10].c_str());
+    r.lda = _atoi64(fields[11].c_str());
+    r.ldb = _atoi64(fields[12].c_str());
+    r.ldc = _atoi64(fields[13].c_str());
+    r.incx = _atoi64(fields[14].c_str());
+    r.incy = _atoi64(fields[15].c_str());
+    r.time_us = atof(fields[16].c_str());
+    return true;
+}
+
+size_t element_size(char type)
+{
+    switch (type)
+    {
+    case 's': return sizeof(float);
+    case 'd': return sizeof(double);
+    case 'c': return sizeof(ampblas_fcomplex);
+    default:  return sizeof(ampblas_dcomplex);
+    }
+}
+
+// Bytes of an operand of a call; the largest size of the call bounds the columns of every
+// matrix and the elements of every vector
+size_t matrix_bytes(const record& r, ampblas_int64 ld)
+{
+    const ampblas_int64 dim = std::max(std::max(r.m, r.n), std::max(r.k, ampblas_int64(1)));
+    return size_t(std::max(ld, ampblas_int64(1)) * dim) * element_size(r.type);
+}
+
+size_t vector_bytes(const record& r, ampblas_int64 inc)
+{
+    const ampblas_int64 dim = std::max(std::max(r.m, r.n), std::max(r.k, ampblas_int64(1)));
+    return size_t(std::max(std::abs(inc), ampblas_int64(1)) * dim) * element_size(r.type);
+}
+
+enum AMPBLAS_ORDER order(char c)         { return c == 'R' ? AmpblasRowMajor : AmpblasColMajor; }
+enum AMPBLAS_TRANSPOSE trans(char c)     { return c == 'N' ? AmpblasNoTrans : c == 'T' ? AmpblasTrans : AmpblasConjTrans; }
+enum AMPBLAS_UPLO uplo(char c)           { return c == 'U' ? AmpblasUpper : AmpblasLower; }
+enum AMPBLAS_SIDE side(char c)           { return c == 'L' ? AmpblasLeft : AmpblasRight; }
+enum AMPBLAS_DIAG diag(char c)           { return c == 'U' ? AmpblasUnit : AmpblasNonUnit; }
+
+// Scalars of the calls; halving keeps repeated updates of an operand from growing quickly
+template <typename scalar_type> scalar_type scalar();
+template <> float scalar<float>()   { return 0.5f; }
+template <> double scalar<double>() { return 0.5; }
+
+template <> const ampblas_fcomplex *scalar<const ampblas_fcomplex*>()
+{
+    static const ampblas_fcomplex value = { 0.5f, 0.0f };
+    return &value;
+}
+
+template <> const ampblas_dcomplex *scalar<const ampblas_dcomplex*>()
+{
+    static const ampblas_dcomplex value = { 0.5, 0.0 };
+    return &value;
+}
+
+template <typename value_type>
+value_type *as(void *ptr)
+{
+    return static_cast<value_type*>(ptr);
+}
+
+// Replayers by signature. The size type I is int or ampblas_int64, and T is the element type
+// of the operands, deduced from the routine.
+
+// iamax, asum and nrm2
+template <typename R, typename I, typename T>
+replayer reduce(R (*fn)(I, const T*, I))
+{
+    return [=](const record& r, const operands& p) { fn(I(r.n), as<T>(p.x), I(r.incx)); };
+}
+
+template <typename R, typename I, typename T>
+replayer dot(R (*fn)(I, const T*, I, const T*, I))
+{
+    return [=](const record& r, const operands& p) { fn(I(r.n), as<T>(p.x), I(r.incx), as<T>(p.y), I(r.incy)); };
+}
+
+template <typename I, typename T>
+replayer dot_sub(void (*fn)(I, const T*, I, const T*, I, T*))
+{
+    return [=](const record& r, const operands& p) { T result; fn(I(r.n), as<T>(p.x), I(r.incx), as<T>(p.y), I(r.incy), &result); };
+}
+
+template <typename I, typename S, typename T>
+replayer scal(void (*fn)(I, S, T*, I))
+{
+    return [=](const record& r, const operands& p) { fn(I(r.n), scalar<S>(), as<T>(p.x), I(r.incx)); };
+}
+
+template <typename I, typename S, typename T>
+replayer axpy(void (*fn)(I, S, const T*, I, T*, I))
+{
+    return [=](const record& r, const operands& p) { fn(I(r.n), scalar<S>(), as<T>(p.x), I(r.incx), as<T>(p.y), I(r.incy)); };
+}
+
+// copy and swap
+template <typename I, typename X, typename T>
+replayer pair(void (*fn)(I, X*, I, T*, I))
+{
+    return [=](const record& r, const operands& p) { fn(I(r.n), as<X>(p.x), I(r.incx), as<T>(p.y), I(r.incy)); };
+}
+
+template <typename I, typename T>
+replayer rot(void (*fn)(I, T*, I, T*, I, T, T))
+{
+    return [=](const record& r, const operands& p) { fn(I(r.n), as<T>(p.x), I(r.incx), as<T>(p.y), I(r.incy), T(0.6), T(0.8)); };
+}
+
+template <typename I, typename S, typename T>
+replayer gemv(void (*fn)(AMPBLAS_ORDER, AMPBLAS_TRANSPOSE, I, I, S, const T*, I, const T*, I, S, T*, I))
+{
+    return [=](const record& r, const operands& p)
+    {
+        fn(order(r.order), trans(r.trans_a), I(r.m), I(r.n), scalar<S>(), as<T>(p.a), I(r.lda), as<T>(p.x), I(r.incx), scalar<S>(), as<T>(p.y), I(r.incy));
+    };
+}
+
+template <typename I, typename S, typename T>
+replayer ger(void (*fn)(AMPBLAS_ORDER, I, I, S, const T*, I, const T*, I, T*, I))
+{
+    return [=](const record& r, const operands& p)
+    {
+        fn(order(r.order), I(r.m), I(r.n), scalar<S>(), as<T>(p.x), I(r.incx), as<T>(p.y), I(r.incy), as<T>(p.a), I(r.lda));
+    };
+}
+
+// symv and hemv
+template <typename S, typename T>
+replayer symv(void (*fn)(AMPBLAS_ORDER, AMPBLAS_UPLO, int, S, const T*, int, const T*, int, S, T*, int))
+{
+    return [=](const record& r, const operands& p)
+    {
+        fn(order(r.order), uplo(r.uplo), int(r.n), scalar<S>(), as<T>(p.a), int(r.lda), as<T>(p.x), int(r.incx), scalar<S>(), as<T>(p.y), int(r.incy));
+    };
+}
+
+// syr and her
+template <typename S, typename T>
+replayer syr(void (*fn)(AMPBLAS_ORDER, AMPBLAS_UPLO, int, S, const T*, int, T*, int))
+{
+    return [=](const record& r, const operands& p)
+    {
+        fn(order(r.order), uplo(r.uplo), int(r.n), scalar<S>(), as<T>(p.x), int(r.incx), as<T>(p.a), int(r.lda));
+    };
+}
+
+// trmv and trsv
+template <typename T>
+replayer trmv(void (*fn)(AMPBLAS_ORDER, AMPBLAS_UPLO, AMPBLAS_TRANSPOSE, AMPBLAS_DIAG, int, const T*, int, T*, int))
+{
+    return [=](const record& r, const operands& p)
+    {
+        fn(order(r.order), uplo(r.uplo), trans(r.trans_a), diag(r.diag), int(r.n), as<T>(p.a), int(r.lda), as<T>(p.x), int(r.incx));
+    };
+}
+
+template <typename S, typename T>
+replayer gemm(void (*fn)(AMPBLAS_ORDER, AMPBLAS_TRANSPOSE, AMPBLAS_TRANSPOSE, int, int, int, S, const T*, int, const T*, int, S, T*, int))
+{
+    return [=](const record& r, const operands& p)
+    {
+        fn(order(r.order), trans(r.trans_a), trans(r.trans_b), int(r.m), int(r.n), int(r.k),
+           scalar<S>(), as<T>(p.a), int(r.lda), as<T>(p.b), int(r.ldb), scalar<S>(), as<T>(p.c), int(r.ldc));
+    };
+}
+
+// the out-of-core routines run with their default budget
+template <typename S, typename T>
+replayer gemm(void (*fn)(AMPBLAS_ORDER, AMPBLAS_TRANSPOSE, AMPBLAS_TRANSPOSE, int, int, int, S, const T*, int, const T*, int, S, T*, int, size_t))
+{
+    return [=](const record& r, const operands& p)
+    {
+        fn(order(r.order), trans(r.trans_a), trans(r.trans_b), int(r.m), int(r.n), int(r.k),
+           scalar<S>(), as<T>(p.a), int(r.lda), as<T>(p.b), int(r.ldb), scalar<S>(), as<T>(p.c), int(r.ldc), 0);
+    };
+}
+
+// syrk and herk
+template <typename S, typename SB, typename T>
+replayer syrk(void (*fn)(AMPBLAS_ORDER, AMPBLAS_UPLO, AMPBLAS_TRANSPOSE, int, int, S, const T*, int, SB, T*, int))
+{
+    return [=](const record& r, const operands& p)
+    {
+        fn(order(r.order), uplo(r.uplo), trans(r.trans_a), int(r.n), int(r.k), scalar<S>(), as<T>(p.a), int(r.lda), scalar<SB>(), as<T>(p.c), int(r.ldc));
+    };
+}
+
+// syr2k and her2k
+template <typename S, typename SB, typename T>
+replayer syr2k(void (*fn)(AMPBLAS_ORDER, AMPBLAS_UPLO, AMPBLAS_TRANSPOSE, int, int, S, const T*, int, const T*, int, SB, T*, int))
+{
+    return [=](const record& r, const operands& p)
+    {
+        fn(order(r.order), uplo(r.uplo), trans(r.trans_a), int(r.n), int(r.k),
+           scalar<S>(), as<T>(p.a), int(r.lda), as<T>(p.b), int(r.ldb), scalar<SB>(), as<T>(p.c), int(r.ldc));
+    };
+}
+
+// trmm and trsm
+template <typename S, typename T>
+replayer trmm(void (*fn)(AMPBLAS_ORDER, AMPBLAS_SIDE, AMPBLAS_UPLO, AMPBLAS_TRANSPOSE, AMPBLAS_DIAG, int, int, S, const T*, int, T*, int))
+{
+    return [=](const record& r, const operands& p)
+    {
+        fn(order(r.order), side(r.side), uplo(r.uplo), trans(r.trans_a), diag(r.diag), int(r.m), int(r.n), scalar<S>(), as<T>(p.a), int(r.lda), as<T>(p.b), int(r.ldb));
+    };
+}
+
+#define REPLAY(family, name) replayers[#name] = family(ampblas_##name)
+
+std::map<std::string, replayer> make_replayers()
+{
+    std::map<std::string, replayer> replayers;
+
+    REPLAY(reduce, isamax);  REPLAY(reduce, idamax);  REPLAY(reduce, icamax);  REPLAY(reduce, izamax);
+    REPLAY(reduce, isamax_64); REPLAY(reduce, idamax_64); REPLAY(reduce, icamax_64); REPLAY(reduce, izamax_64);
+    REPLAY(reduce, sasum);   REPLAY(reduce, dasum);   REPLAY(reduce, scasum);  REPLAY(reduce, dzasum);
+    REPLAY(reduce, sasum_64); REPLAY(reduce, dasum_64); REPLAY(reduce, scasum_64); REPLAY(reduce, dzasum_64);
+    REPLAY(reduce, snrm2);   REPLAY(reduce, dnrm2);   REPLAY(reduce, snrm2_64); REPLAY(reduce, dnrm2_64);
+
+    REPLAY(dot, dsdot);      REPLAY(dot, sdot);       REPLAY(dot, ddot);
+    REPLAY(dot, dsdot_64);   REPLAY(dot, sdot_64);    REPLAY(dot, ddot_64);
+    REPLAY(dot_sub, cdotu_sub); REPLAY(dot_sub, cdotc_sub); REPLAY(dot_sub, zdotu_sub); REPLAY(dot_sub, zdotc_sub);
+    REPLAY(dot_sub, cdotu_sub_64); REPLAY(dot_sub, cdotc_sub_64); REPLAY(dot_sub, zdotu_sub_64); REPLAY(dot_sub, zdotc_sub_64);
+
+    REPLAY(scal, sscal);     REPLAY(scal, dscal);     REPLAY(scal, cscal);     REPLAY(scal, zscal);
+    REPLAY(scal, csscal);    REPLAY(scal, zdscal);
+    REPLAY(scal, sscal_64);  REPLAY(scal, dscal_64);  REPLAY(scal, cscal_64);  REPLAY(scal, zscal_64);
+    REPLAY(scal, csscal_64); REPLAY(scal, zdscal_64);
+
+    REPLAY(axpy, saxpy);     REPLAY(axpy, daxpy);     REPLAY(axpy, caxpy);     REPLAY(axpy, zaxpy);
+    REPLAY(axpy, saxpy_64);  REPLAY(axpy, daxpy_64);  REPLAY(axpy, caxpy_64);  REPLAY(axpy, zaxpy_64);
+
+    REPLAY(pair, scopy);     REPLAY(pair, dcopy);     REPLAY(pair, ccopy);     REPLAY(pair, zcopy);
+    REPLAY(pair, scopy_64);  REPLAY(pair, dcopy_64);  REPLAY(pair, ccopy_64);  REPLAY(pair, zcopy_64);
+    REPLAY(pair, sswap);     REPLAY(pair, dswap);     REPLAY(pair, cswap);     REPLAY(pair, zswap);
+    REPLAY(pair, sswap_64);  REPLAY(pair, dswap_64);  REPLAY(pair, cswap_64);  REPLAY(pair, zswap_64);
+
+    REPLAY(rot, srot);       REPLAY(rot, drot);       REPLAY(rot, srot_64);    REPLAY(rot, drot_64);
+
+    REPLAY(gemv, sgemv);     REPLAY(gemv, dgemv);     REPLAY(gemv, cgemv);     REPLAY(gemv, zgemv);
+    REPLAY(gemv, sgemv_64);  REPLAY(gemv, dgemv_64);  REPLAY(gemv, cgemv_64);  REPLAY(gemv, zgemv_64);
+
+    REPLAY(ger, sger);       REPLAY(ger, dger);       REPLAY(ger, cgeru);      REPLAY(ger, zgeru);
+    REPLAY(ger, cgerc);      REPLAY(ger, zgerc);
+    REPLAY(ger, sger_64);    REPLAY(ger, dger_64);    REPLAY(ger, cgeru_64);   REPLAY(ger, zgeru_64);
+    REPLAY(ger, cgerc_64);   REPLAY(ger, zgerc_64);
+
+    REPLAY(symv, ssymv);     REPLAY(symv, dsymv);     REPLAY(symv, chemv);     REPLAY(symv, zhemv);
+    REPLAY(syr, ssyr);       REPLAY(syr, dsyr);       REPLAY(syr, cher);       REPLAY(syr, zher);
+    REPLAY(trmv, strmv);     REPLAY(trmv, dtrmv);     REPLAY(trmv, ctrmv);     REPLAY(trmv, ztrmv);
+    REPLAY(trmv, strsv);     REPLAY(trmv, dtrsv);     REPLAY(trmv, ctrsv);     REPLAY(trmv, ztrsv);
+
+    REPLAY(gemm, sgemm);     REPLAY(gemm, dgemm);     REPLAY(gemm, cgemm);     REPLAY(gemm, zgemm);
+    REPLAY(gemm, sgemm_out_of_core); REPLAY(gemm, dgemm_out_of_core); REPLAY(gemm, cgemm_out_of_core); REPLAY(gemm, zgemm_out_of_core);
+    REPLAY(syrk, ssyrk);     REPLAY(syrk, dsyrk);     REPLAY(syrk, csyrk);     REPLAY(syrk, zsyrk);
+    REPLAY(syrk, cherk);     REPLAY(syrk, zherk);
+    REPLAY(syr2k, ssyr2k);   REPLAY(syr2k, dsyr2k);   REPLAY(syr2k, csyr2k);   REPLAY(syr2k, zsyr2k);
+    REPLAY(syr2k, cher2k);   REPLAY(syr2k, zher2k);
+    REPLAY(trmm, strmm);     REPLAY(trmm, dtrmm);     REPLAY(trmm, ctrmm);     REPLAY(trmm, ztrmm);
+    REPLAY(trmm, strsm);     REPLAY(trmm, dtrsm);     REPLAY(trmm, ctrsm);     REPLAY(trmm, ztrsm);
+
+    return replayers;
+}
+
+#undef REPLAY
+
+// Operands are shared by the routines of every type, so they hold doubles of magnitude at
+// most 1/2 whose low halves are zero; read as floats, these are zeros and numbers near 1.
+// Neither reading gives denormals, which would slow the host kernels.
+void fill(void *ptr, size_t bytes, int seed)
+{
+    double *d = static_cast<double*>(ptr);
+    for (size_t i = 0; i < bytes / sizeof(double); i++)
+        d[i] = double(int((i * 7 + seed * 13) % 17) - 8) / 16.0;
+    memset(d + bytes / sizeof(double), 0, bytes % sizeof(double));
+}
+
+// a unit diagonal keeps the triangular solves well conditioned
+
+template <typename T>
+void set_diagonal(void *a, ampblas_int64 n, ampblas_int64 lda, T one)
+{
+    for (ampblas_int64 i = 0; i < n; i++)
+        static_cast<T*>(a)[i * lda + i] = one;
+}
+
+void set_diagonal(const record& r, void *a)
+{
+    const bool triangular = r.routine.size() > 4 && r.routine.compare(1, 2, "tr") == 0;
+    if (!triangular)
+        return;
+
+    const ampblas_int64 n = (r.side == 'L' ? r.m : r.n);
+    const ampblas_fcomplex fone = { 1.0f, 0.0f };
+    const ampblas_dcomplex done = { 1.0, 0.0 };
+    switch (r.type)
+    {
+    case 's': set_diagonal(a, n, r.lda, 1.0f); break;
+    case 'd': set_diagonal(a, n, r.lda, 1.0); break;
+    case 'c': set_diagonal(a, n, r.lda, fone); break;
+    default:  set_diagonal(a, n, r.lda, done); break;
+    }
+}
+
+double now_us()
+{
+    LARGE_INTEGER frequency, count;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&count);
+    return 1e6 * double(count.QuadPart) / double(frequency.QuadPart);
+}
+
+struct routine_time
+{
+    routine_time() : calls(0), replay_us(0), traced_us(0), failures(0) {}
+
+    long long calls;
+    double replay_us;
+    double traced_us;
+    long long failures;
+};
+
+int usage()
+{
+    fprintf(stderr, "usage: ampblas_replay trace.csv [--dispatch accelerator|host|auto] [--device n] [--repeat n]\n");
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+        return usage();
+
+    enum AMPBLAS_DISPATCH_MODE mode = AmpblasDispatchAccelerator;
+    int repeat = 1;
+    concurrency::accelerator_view accl_view = concurrency::accelerator().default_view;
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        if (strcmp(argv[i], "--dispatch") == 0)
+        {
+            if (strcmp(argv[i+1], "host") == 0)
+                mode = AmpblasDispatchHost;
+            else if (strcmp(argv[i+1], "auto") == 0)
+                mode = AmpblasDispatchAuto;
+            else if (strcmp(argv[i+1], "accelerator") != 0)
+                return usage();
+        }
+        else if (strcmp(argv[i], "--device") == 0)
+        {
+            const std::vector<concurrency::accelerator> accelerators = concurrency::accelerator::get_all();
+            const size_t device = static_cast<size_t>(atoi(argv[i+1]));
+            if (device >= accelerators.size())
+                return usage();
+            accl_view = accelerators[device].default_view;
+        }
+        else if (strcmp(argv[i], "--repeat") == 0)
+        {
+            repeat = std::max(atoi(argv[i+1]), 1);
+        }
+        else
+        {
+            return usage();
+        }
+    }
+
+    // read the trace
+    std::ifstream in(argv[1]);
+    if (!in)
+    {
+        fprintf(stderr, "unable to open %s\n", argv[1]);
+        return 1;
+    }
+
+    const std::map<std::string, replayer> replayers = make_replayers();
+    std::vector<record> trace;
+    std::map<std::string, routine_time> times;
+    long long skipped = 0;
+
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line))
+    {
+        record r;
+        if (!parse(line, r) || replayers.find(r.routine) == replayers.end())
+        {
+            skipped++;
+            continue;
+        }
+        trace.push_back(r);
+        times[r.routine].traced_us += r.time_us;
+    }
+
+    // allocate operands for the largest call
+    size_t bytes[5] = {};
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        const record& r = trace[i];
+        bytes[0] = std::max(bytes[0], matrix_bytes(r, r.lda));
+        bytes[1] = std::max(bytes[1], matrix_bytes(r, r.ldb));
+        bytes[2] = std::max(bytes[2], matrix_bytes(r, r.ldc));
+        bytes[3] = std::max(bytes[3], vector_bytes(r, r.incx));
+        bytes[4] = std::max(bytes[4], vector_bytes(r, r.incy));
+    }
+
+    void *buffers[5] = {};
+    for (int i = 0; i < 5; i++)
+    {
+        buffers[i] = ampblas_malloc(bytes[i], AmpblasAllocDefault);
+        if (buffers[i] == nullptr)
+        {
+            fprintf(stderr, "unable to allocate %llu bytes of operands\n", static_cast<unsigned long long>(bytes[i]));
+            return 1;
+        }
+        fill(buffers[i], bytes[i], i);
+    }
+    const operands p = { buffers[0], buffers[1], buffers[2], buffers[3], buffers[4] };
+    for (size_t i = 0; i < trace.size(); i++)
+        set_diagonal(trace[i], p.a);
+
+    ampblas_set_current_accelerator_view(&accl_view);
+    ampblas_set_dispatch_mode(mode);
+
+    // the first pass compiles kernels and measures the dispatch model
+    for (int pass = 0; pass <= repeat; pass++)
+    {
+        for (size_t i = 0; i < trace.size(); i++)
+        {
+            const record& r = trace[i];
+
+            const double start = now_us();
+            replayers.find(r.routine)->second(r, p);
+            accl_view.wait();
+            const double elapsed = now_us() - start;
+
+            if (pass == 0)
+                continue;
+
+            routine_time& t = times[r.routine];
+            t.calls++;
+            t.replay_us += elapsed;
+            if (ampblas_get_last_error() != AMPBLAS_OK)
+                t.failures++;
+        }
+    }
+
+    for (int i = 0; i < 5; i++)
+        ampblas_free(buffers[i]);
+
+    // report routines by the time they take, per pass
+    std::vector<std::pair<double, std::string>> ranking;
+    for (auto it = times.begin(); it != times.end(); ++it)
+        ranking.push_back(std::make_pair(it->second.replay_us, it->first));
+    std::sort(ranking.rbegin(), ranking.rend());
+
+    printf("%-20s %10s %14s %12s %14s %9s\n", "routine", "calls", "replay ms", "mean us", "traced ms", "failures");
+
+    routine_time total;
+    for (size_t i = 0; i < ranking.size(); i++)
+    {
+        const routine_time& t = times[ranking[i].second];
+        const long long calls = t.calls / repeat;
+        printf("%-20s %10lld %14.3f %12.1f %14.3f %9lld\n", ranking[i].second.c_str(), calls, t.replay_us / repeat / 1e3,
+               calls == 0 ? 0.0 : t.replay_us / double(t.calls), t.traced_us / 1e3, t.failures / repeat);
+
+        total.calls += calls;
+        total.replay_us += t.replay_us / repeat;
+        total.traced_us += t.traced_us;
+        total.failures += t.failures / repeat;
+    }
+    printf("%-20s %10lld %14.3f %12s %14.3f %9lld\n", "total", total.calls, total.replay_us / 1e3, "", total.traced_us / 1e3, total.failures);
+
+    if (skipped != 0)
+        printf("%lld lines of the trace were not recognized\n", skipped);
+
+    return 0;
+}